@@ -0,0 +1,75 @@
+#include <queue>
+#include <stack>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::SetItems;
+
+// У stack верхний элемент - top(), у queue - front()
+template <typename T>
+int Peek(const std::stack<T>& s) { return s.top(); }
+template <typename T>
+int Peek(const s21::stack<T>& s) { return s.top(); }
+template <typename T>
+int Peek(const std::queue<T>& q) { return q.front(); }
+template <typename T>
+int Peek(const s21::queue<T>& q) { return q.front(); }
+template <typename T, std::size_t Cap>
+int Peek(const s21::ring_buffer<T, Cap>& r) { return r.front(); }
+
+// n вставок и n извлечений
+template <typename Adaptor>
+void BM_PushPop(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Adaptor a;
+    for (int i = 0; i < n; ++i) a.push(i);
+    long long sum = 0;
+    while (!a.empty()) {
+      sum += Peek(a);
+      a.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+// Очередь постоянной длины: на каждую вставку одно извлечение
+template <typename Adaptor>
+void BM_SteadyState(benchmark::State& state) {
+  Adaptor a;
+  for (int i = 0; i < 64; ++i) a.push(i);
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) {
+      a.push(i);
+      a.pop();
+    }
+    benchmark::DoNotOptimize(Peek(a));
+  }
+  SetItems(state);
+}
+
+using S21Stack = s21::stack<int>;
+using StdStack = std::stack<int>;
+using S21Queue = s21::queue<int>;
+using StdQueue = std::queue<int>;
+// В кольцевом буфере 128 ячеек, в BM_SteadyState в нем всегда 64-65 элементов
+using RingBuffer = s21::ring_buffer<int, 128>;
+
+BENCHMARK_TEMPLATE(BM_PushPop, S21Stack)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_PushPop, StdStack)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SteadyState, S21Stack)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SteadyState, StdStack)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_PushPop, S21Queue)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_PushPop, StdQueue)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SteadyState, S21Queue)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SteadyState, StdQueue)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SteadyState, RingBuffer)->Apply(AllSizes);
+
+}  // namespace
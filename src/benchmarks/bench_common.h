@@ -0,0 +1,60 @@
+#ifndef SRC_BENCHMARKS_BENCH_COMMON_H_
+#define SRC_BENCHMARKS_BENCH_COMMON_H_
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Общие помощники для бенчмарков: каждый случай запускается в паре s21:: и std::
+// на одинаковых входных данных, размеры от 1e2 до 1e7
+namespace s21_bench {
+
+constexpr int64_t kMinSize = 100;
+constexpr int64_t kMaxSize = 10000000;
+
+// Размеры 1e2, 1e3, ..., max_size
+inline void Sizes(benchmark::internal::Benchmark* b, int64_t max_size) {
+  b->RangeMultiplier(10)->Range(kMinSize, max_size)->Unit(benchmark::kMicrosecond);
+}
+
+inline void AllSizes(benchmark::internal::Benchmark* b) { Sizes(b, kMaxSize); }
+
+// Для операций O(n^2) у обоих контейнеров (например вставка в начало vector)
+inline void QuadraticSizes(benchmark::internal::Benchmark* b) { Sizes(b, 10000); }
+
+// Случайные ключи с фиксированным зерном, чтобы прогоны были сравнимы
+inline std::vector<int> RandomKeys(int64_t n, int max_key = 0) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, max_key > 0 ? max_key : static_cast<int>(n) * 4);
+  std::vector<int> keys(static_cast<size_t>(n));
+  for (auto &key : keys) key = dist(gen);
+  return keys;
+}
+
+// Ключи 0..n-1 в возрастающем порядке
+inline std::vector<int> SortedKeys(int64_t n) {
+  std::vector<int> keys(static_cast<size_t>(n));
+  for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int>(i);
+  return keys;
+}
+
+// Уничтожает содержимое контейнера вне замера, чтобы не мерить деструктор
+template <typename C>
+void DiscardUntimed(benchmark::State& state, C& c) {
+  state.PauseTiming();
+  {
+    C garbage;
+    garbage.swap(c);
+  }
+  state.ResumeTiming();
+}
+
+inline void SetItems(benchmark::State& state) {
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace s21_bench
+
+#endif  // SRC_BENCHMARKS_BENCH_COMMON_H_
@@ -0,0 +1,92 @@
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::DiscardUntimed;
+using s21_bench::RandomKeys;
+using s21_bench::SetItems;
+
+using BTreeMap = s21::map<int, int, std::less<int>, std::allocator<std::pair<const int, int>>, s21::BTreePolicy>;
+using RedBlackMap = s21::map<int, int>;
+using StdMap = std::map<int, int>;
+
+template <typename Map>
+Map Build(const std::vector<int>& keys) {
+  Map m;
+  for (int key : keys) m.insert({key, key});
+  return m;
+}
+
+template <typename Map>
+void BM_TreeInsert(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    Map m;
+    for (int key : keys) m.insert({key, key});
+    benchmark::DoNotOptimize(m.size());
+    DiscardUntimed(state, m);
+  }
+  SetItems(state);
+}
+
+// Точечный поиск в случайном порядке: упирается в промахи кэша на каждом уровне дерева
+template <typename Map>
+void BM_TreeFind(benchmark::State& state) {
+  Map m = Build<Map>(RandomKeys(state.range(0)));
+  auto probes = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    size_t found = 0;
+    for (int key : probes) found += m.find(key) != m.end();
+    benchmark::DoNotOptimize(found);
+  }
+  SetItems(state);
+}
+
+// Полный проход по возрастанию, как при сканировании диапазона
+template <typename Map>
+void BM_TreeScan(benchmark::State& state) {
+  Map m = Build<Map>(RandomKeys(state.range(0)));
+  for (auto _ : state) {
+    long long sum = 0;
+    for (auto it = m.begin(); it != m.end(); ++it) sum += (*it).second;
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+template <typename Map>
+void BM_TreeEraseAll(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Map m = Build<Map>(keys);
+    state.ResumeTiming();
+    for (int key : keys) {
+      auto it = m.find(key);
+      if (it != m.end()) m.erase(it);
+    }
+    benchmark::DoNotOptimize(m.size());
+  }
+  SetItems(state);
+}
+
+BENCHMARK_TEMPLATE(BM_TreeInsert, BTreeMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeInsert, RedBlackMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeInsert, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeFind, BTreeMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeFind, RedBlackMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeFind, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeScan, BTreeMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeScan, RedBlackMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeScan, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeEraseAll, BTreeMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeEraseAll, RedBlackMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_TreeEraseAll, StdMap)->Apply(AllSizes);
+
+}  // namespace
@@ -0,0 +1,62 @@
+#include <mutex>
+#include <shared_mutex>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench_common.h"
+
+namespace {
+
+constexpr int kKeys = 100000;
+
+// s21::map под одним общим мьютексом - так словарь делили между потоками раньше
+class LockedMap {
+ public:
+  bool contains(int key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+  void insert_or_assign(int key, int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.insert_or_assign(key, value);
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  s21::map<int, int> map_;
+};
+
+using Sharded = s21::concurrent_map<int, int, 64>;
+
+// Общий словарь для всех потоков одного запуска
+template <typename Map>
+Map& Shared() {
+  static Map m;
+  static std::once_flag filled;
+  std::call_once(filled, [] {
+    for (int key : s21_bench::RandomKeys(kKeys)) m.insert_or_assign(key, key);
+  });
+  return m;
+}
+
+// Каждый поток: 9 поисков на 1 запись по случайным ключам
+template <typename Map>
+void BM_ConcurrentMixed(benchmark::State& state) {
+  Map& m = Shared<Map>();
+  auto keys = s21_bench::RandomKeys(kKeys);
+  size_t i = static_cast<size_t>(state.thread_index()) * 7919;
+  for (auto _ : state) {
+    int key = keys[i++ % keys.size()];
+    if (i % 10 == 0) {
+      m.insert_or_assign(key, key);
+    } else {
+      benchmark::DoNotOptimize(m.contains(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_ConcurrentMixed, LockedMap)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentMixed, Sharded)->ThreadRange(1, 64)->UseRealTime();
+
+}  // namespace
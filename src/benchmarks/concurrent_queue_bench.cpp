@@ -0,0 +1,86 @@
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::SetItems;
+
+// s21::queue под мьютексом - так очередь делили между потоками раньше
+class LockedQueue {
+ public:
+  bool try_push(int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(value);
+    return true;
+  }
+  bool try_pop(int& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) return false;
+    value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::queue<int> queue_;
+};
+
+template <typename Queue>
+struct Make {
+  static Queue* New() { return new Queue; }
+};
+template <>
+struct Make<s21::mpmc_queue<int>> {
+  static s21::mpmc_queue<int>* New() { return new s21::mpmc_queue<int>(1024); }
+};
+
+// Один писатель в отдельном потоке, один читатель - поток бенчмарка
+template <typename Queue>
+void BM_ProducerConsumer(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    std::unique_ptr<Queue> q(Make<Queue>::New());
+    std::thread producer([&q, n] {
+      for (int i = 0; i < n;) {
+        if (q->try_push(i)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    long long sum = 0;
+    int value = 0;
+    for (int popped = 0; popped < n;) {
+      if (q->try_pop(value)) {
+        sum += value;
+        ++popped;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+void TransferSizes(benchmark::internal::Benchmark* b) {
+  s21_bench::Sizes(b, 1000000);
+  b->UseRealTime();
+}
+
+using Spsc = s21::spsc_queue<int, 1024>;
+using Mpmc = s21::mpmc_queue<int>;
+
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, LockedQueue)->Apply(TransferSizes);
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, Spsc)->Apply(TransferSizes);
+BENCHMARK_TEMPLATE(BM_ProducerConsumer, Mpmc)->Apply(TransferSizes);
+
+}  // namespace
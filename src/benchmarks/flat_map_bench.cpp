@@ -0,0 +1,74 @@
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::DiscardUntimed;
+using s21_bench::RandomKeys;
+using s21_bench::SetItems;
+
+using FlatMap = s21::flat_map<int, int>;
+using S21Map = s21::map<int, int>;
+using StdMap = std::map<int, int>;
+
+std::vector<std::pair<int, int>> Items(const std::vector<int>& keys) {
+  std::vector<std::pair<int, int>> items;
+  items.reserve(keys.size());
+  for (int key : keys) items.emplace_back(key, key);
+  return items;
+}
+
+// Таблица, которая строится разом и потом только читается
+template <typename Map>
+void BM_LookupTableBuild(benchmark::State& state) {
+  auto items = Items(RandomKeys(state.range(0)));
+  for (auto _ : state) {
+    Map m(items.begin(), items.end());
+    benchmark::DoNotOptimize(m.size());
+    DiscardUntimed(state, m);
+  }
+  SetItems(state);
+}
+
+template <typename Map>
+void BM_LookupTableFind(benchmark::State& state) {
+  auto items = Items(RandomKeys(state.range(0)));
+  Map m(items.begin(), items.end());
+  auto probes = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    size_t found = 0;
+    for (int key : probes) found += m.find(key) != m.end();
+    benchmark::DoNotOptimize(found);
+  }
+  SetItems(state);
+}
+
+template <typename Map>
+void BM_LookupTableIterate(benchmark::State& state) {
+  auto items = Items(RandomKeys(state.range(0)));
+  Map m(items.begin(), items.end());
+  for (auto _ : state) {
+    long long sum = 0;
+    for (auto it = m.begin(); it != m.end(); ++it) sum += (*it).second;
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+BENCHMARK_TEMPLATE(BM_LookupTableBuild, FlatMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableBuild, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableBuild, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableFind, FlatMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableFind, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableFind, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableIterate, FlatMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableIterate, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_LookupTableIterate, StdMap)->Apply(AllSizes);
+
+}  // namespace
@@ -0,0 +1,90 @@
+#include <list>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::DiscardUntimed;
+using s21_bench::RandomKeys;
+using s21_bench::SetItems;
+
+template <typename List>
+List Build(const std::vector<int>& values) {
+  List l;
+  for (int value : values) l.push_back(value);
+  return l;
+}
+
+template <typename List>
+void BM_ListPushBack(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    List l;
+    for (int i = 0; i < n; ++i) l.push_back(i);
+    benchmark::DoNotOptimize(l.size());
+    DiscardUntimed(state, l);
+  }
+  SetItems(state);
+}
+
+template <typename List>
+void BM_ListPushPopFront(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    List l;
+    for (int i = 0; i < n; ++i) l.push_front(i);
+    while (!l.empty()) l.pop_front();
+    benchmark::DoNotOptimize(l.size());
+  }
+  SetItems(state);
+}
+
+template <typename List>
+void BM_ListSort(benchmark::State& state) {
+  auto values = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    List l = Build<List>(values);
+    state.ResumeTiming();
+    l.sort();
+    benchmark::DoNotOptimize(l.front());
+    DiscardUntimed(state, l);
+  }
+  SetItems(state);
+}
+
+// Слияние двух отсортированных списков по n/2 элементов
+template <typename List>
+void BM_ListMerge(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    List even;
+    List odd;
+    for (int i = 0; i < n; i += 2) {
+      even.push_back(i);
+      odd.push_back(i + 1);
+    }
+    state.ResumeTiming();
+    even.merge(odd);
+    benchmark::DoNotOptimize(even.size());
+    DiscardUntimed(state, even);
+  }
+  SetItems(state);
+}
+
+using S21List = s21::list<int>;
+using StdList = std::list<int>;
+
+BENCHMARK_TEMPLATE(BM_ListPushBack, S21List)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_ListPushBack, StdList)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_ListPushPopFront, S21List)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_ListPushPopFront, StdList)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_ListSort, S21List)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_ListSort, StdList)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_ListMerge, S21List)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_ListMerge, StdList)->Apply(AllSizes);
+
+}  // namespace
@@ -0,0 +1,169 @@
+#include <map>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::DiscardUntimed;
+using s21_bench::RandomKeys;
+using s21_bench::SetItems;
+
+// В C++17 у std::map нет contains, поэтому поиск через count
+bool Contains(const std::map<int, int>& m, int key) { return m.count(key) != 0; }
+bool Contains(const s21::map<int, int>& m, int key) { return m.contains(key); }
+
+template <typename Map>
+Map Build(const std::vector<int>& keys) {
+  Map m;
+  for (int key : keys) m.insert({key, key});
+  return m;
+}
+
+template <typename Map>
+void BM_MapInsert(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    Map m;
+    for (int key : keys) m.insert({key, key});
+    benchmark::DoNotOptimize(m.size());
+    DiscardUntimed(state, m);
+  }
+  SetItems(state);
+}
+
+// Возрастающие ключи с подсказкой end(), как при загрузке упорядоченных данных
+template <typename Map>
+void BM_MapInsertSortedHint(benchmark::State& state) {
+  auto keys = s21_bench::SortedKeys(state.range(0));
+  for (auto _ : state) {
+    Map m;
+    for (int key : keys) m.insert(m.end(), {key, key});
+    benchmark::DoNotOptimize(m.size());
+    DiscardUntimed(state, m);
+  }
+  SetItems(state);
+}
+
+template <typename Map>
+void BM_MapFind(benchmark::State& state) {
+  Map m = Build<Map>(RandomKeys(state.range(0)));
+  auto probes = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    size_t found = 0;
+    for (int key : probes) found += Contains(m, key);
+    benchmark::DoNotOptimize(found);
+  }
+  SetItems(state);
+}
+
+// Счетчики через operator[]: в основном попадания в уже имеющиеся ключи
+template <typename Map>
+void BM_MapSubscript(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0), static_cast<int>(state.range(0) / 8 + 1));
+  for (auto _ : state) {
+    Map m;
+    for (int key : keys) ++m[key];
+    benchmark::DoNotOptimize(m.size());
+    DiscardUntimed(state, m);
+  }
+  SetItems(state);
+}
+
+template <typename Map>
+void BM_MapErase(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Map m = Build<Map>(keys);
+    state.ResumeTiming();
+    while (!m.empty()) m.erase(m.begin());
+    benchmark::DoNotOptimize(m.size());
+  }
+  SetItems(state);
+}
+
+template <typename Map>
+void BM_MapIterate(benchmark::State& state) {
+  Map m = Build<Map>(RandomKeys(state.range(0)));
+  for (auto _ : state) {
+    long long sum = 0;
+    for (const auto& item : m) sum += item.second;
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+// Копирование всего словаря (снимок конфигурации)
+template <typename Map>
+void BM_MapCopy(benchmark::State& state) {
+  Map m = Build<Map>(RandomKeys(state.range(0)));
+  for (auto _ : state) {
+    Map copy(m);
+    benchmark::DoNotOptimize(copy.size());
+    DiscardUntimed(state, copy);
+  }
+  SetItems(state);
+}
+
+// Копирование и удаление копии: у s21 с int-ключами удаление не обходит узлы
+template <typename Map>
+void BM_MapCopyDestroy(benchmark::State& state) {
+  Map m = Build<Map>(RandomKeys(state.range(0)));
+  for (auto _ : state) {
+    Map copy(m);
+    benchmark::DoNotOptimize(copy.size());
+  }
+  SetItems(state);
+}
+
+// Перенос старейших 10% словаря в архив и обратно: у s21 split + join,
+// у std - extract + insert по одному узлу
+void MoveOldest(s21::map<int, int>& live, s21::map<int, int>& archive, int cut) {
+  s21::map<int, int> recent = live.split(cut);
+  archive.join(live);
+  live.swap(recent);
+}
+
+void MoveOldest(std::map<int, int>& live, std::map<int, int>& archive, int cut) {
+  auto last = live.lower_bound(cut);
+  while (live.begin() != last) archive.insert(archive.end(), live.extract(live.begin()));
+}
+
+template <typename Map>
+void BM_MapMoveRange(benchmark::State& state) {
+  Map live = Build<Map>(s21_bench::SortedKeys(state.range(0)));
+  Map archive;
+  int cut = static_cast<int>(state.range(0) / 10);
+  for (auto _ : state) {
+    MoveOldest(live, archive, cut);
+    // Возвращаем все назад, чтобы следующая итерация начиналась с того же словаря
+    MoveOldest(archive, live, static_cast<int>(state.range(0)));
+    benchmark::DoNotOptimize(live.size());
+  }
+}
+
+using S21Map = s21::map<int, int>;
+using StdMap = std::map<int, int>;
+
+BENCHMARK_TEMPLATE(BM_MapInsert, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapInsert, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapInsertSortedHint, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapInsertSortedHint, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapFind, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapFind, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapSubscript, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapSubscript, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapErase, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapErase, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapIterate, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapIterate, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapCopy, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapCopy, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapCopyDestroy, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapCopyDestroy, StdMap)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapMoveRange, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MapMoveRange, StdMap)->Apply(AllSizes);
+
+}  // namespace
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::DiscardUntimed;
+using s21_bench::RandomKeys;
+using s21_bench::SetItems;
+
+// Одни и те же случаи для set и multiset: у обоих insert(key), find, erase(iterator)
+template <typename Set>
+Set Build(const std::vector<int>& keys) {
+  Set s;
+  for (int key : keys) s.insert(key);
+  return s;
+}
+
+template <typename Set>
+void BM_SetInsert(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    Set s;
+    for (int key : keys) s.insert(key);
+    benchmark::DoNotOptimize(s.size());
+    DiscardUntimed(state, s);
+  }
+  SetItems(state);
+}
+
+// Построение из уже отсортированного диапазона (конструктор из итераторов)
+template <typename Set>
+void BM_SetConstructSorted(benchmark::State& state) {
+  auto keys = s21_bench::SortedKeys(state.range(0));
+  for (auto _ : state) {
+    Set s(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(s.size());
+    DiscardUntimed(state, s);
+  }
+  SetItems(state);
+}
+
+template <typename Set>
+void BM_SetFind(benchmark::State& state) {
+  Set s = Build<Set>(RandomKeys(state.range(0)));
+  auto probes = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    size_t found = 0;
+    for (int key : probes) found += s.find(key) != s.end();
+    benchmark::DoNotOptimize(found);
+  }
+  SetItems(state);
+}
+
+template <typename Set>
+void BM_SetErase(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Set s = Build<Set>(keys);
+    state.ResumeTiming();
+    for (int key : keys) {
+      auto it = s.find(key);
+      if (it != s.end()) s.erase(it);
+    }
+    benchmark::DoNotOptimize(s.size());
+  }
+  SetItems(state);
+}
+
+template <typename Set>
+void BM_SetIterate(benchmark::State& state) {
+  Set s = Build<Set>(RandomKeys(state.range(0)));
+  for (auto _ : state) {
+    long long sum = 0;
+    for (int key : s) sum += key;
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+// k-й элемент: у ранжированного дерева спуск от корня, у std - проход итератором
+template <typename Set>
+typename Set::const_iterator NthElement(const Set& s, size_t k) {
+  return s.nth_element(k);
+}
+
+inline std::multiset<int>::const_iterator NthElement(const std::multiset<int>& s, size_t k) {
+  return std::next(s.begin(), static_cast<std::ptrdiff_t>(k));
+}
+
+// Трекер перцентилей: p50 и p99 по мультимножеству замеров
+template <typename Set>
+void BM_MultisetPercentile(benchmark::State& state) {
+  Set s = Build<Set>(RandomKeys(state.range(0)));
+  for (auto _ : state) {
+    int p50 = *NthElement(s, s.size() / 2);
+    int p99 = *NthElement(s, s.size() * 99 / 100);
+    benchmark::DoNotOptimize(p50 + p99);
+  }
+}
+
+// count по ключу с большим количеством повторов (n / 16 на ключ)
+template <typename Set>
+void BM_MultisetCountHot(benchmark::State& state) {
+  Set s = Build<Set>(RandomKeys(state.range(0), 15));
+  for (auto _ : state) {
+    size_t total = 0;
+    for (int key = 0; key < 16; ++key) total += s.count(key);
+    benchmark::DoNotOptimize(total);
+  }
+}
+
+// Пересечение двух множеств по n элементов в новое множество
+inline s21::set<int> Intersect(const s21::set<int>& a, const s21::set<int>& b) { return a & b; }
+
+inline std::set<int> Intersect(const std::set<int>& a, const std::set<int>& b) {
+  std::set<int> result;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(result, result.end()));
+  return result;
+}
+
+template <typename Set>
+void BM_SetIntersect(benchmark::State& state) {
+  Set a = Build<Set>(RandomKeys(state.range(0)));
+  Set b = Build<Set>(RandomKeys(state.range(0), static_cast<int>(state.range(0)) * 2));
+  for (auto _ : state) {
+    Set result = Intersect(a, b);
+    benchmark::DoNotOptimize(result.size());
+    DiscardUntimed(state, result);
+  }
+  SetItems(state);
+}
+
+using S21Set = s21::set<int>;
+using StdSet = std::set<int>;
+using S21Multiset = s21::multiset<int>;
+using StdMultiset = std::multiset<int>;
+using S21RankedMultiset = s21::multiset<int, std::less<int>, std::allocator<int>, true>;
+
+BENCHMARK_TEMPLATE(BM_SetInsert, S21Set)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetInsert, StdSet)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetConstructSorted, S21Set)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetConstructSorted, StdSet)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetFind, S21Set)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetFind, StdSet)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetErase, S21Set)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetErase, StdSet)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetIterate, S21Set)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetIterate, StdSet)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetIntersect, S21Set)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetIntersect, StdSet)->Apply(AllSizes);
+
+BENCHMARK_TEMPLATE(BM_SetInsert, S21Multiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetInsert, StdMultiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetFind, S21Multiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetFind, StdMultiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetErase, S21Multiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetErase, StdMultiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetIterate, S21Multiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetIterate, StdMultiset)->Apply(AllSizes);
+
+BENCHMARK_TEMPLATE(BM_SetInsert, S21RankedMultiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_SetErase, S21RankedMultiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MultisetPercentile, S21RankedMultiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MultisetPercentile, StdMultiset)->Apply(s21_bench::QuadraticSizes);
+BENCHMARK_TEMPLATE(BM_MultisetCountHot, S21Multiset)->Apply(s21_bench::QuadraticSizes);
+BENCHMARK_TEMPLATE(BM_MultisetCountHot, S21RankedMultiset)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_MultisetCountHot, StdMultiset)->Apply(s21_bench::QuadraticSizes);
+
+}  // namespace
@@ -0,0 +1,40 @@
+#include <utility>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::SetItems;
+
+// Много коротких векторов по 1-4 элемента, как токены разбора строки:
+// для vector каждый - malloc/free, для small_vector и static_vector - ни одного
+template <typename Vector>
+void BM_ShortLivedVectors(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    long long sum = 0;
+    for (int i = 0; i < n; ++i) {
+      Vector tokens;
+      for (int j = 0; j <= i % 4; ++j) tokens.push_back(i + j);
+      Vector moved(std::move(tokens));
+      sum += moved.back() + static_cast<long long>(moved.size());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+using S21Vector = s21::vector<int>;
+using SmallVector = s21::small_vector<int, 4>;
+using StaticVector = s21::static_vector<int, 4>;
+using StdVector = std::vector<int>;
+
+BENCHMARK_TEMPLATE(BM_ShortLivedVectors, S21Vector)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ShortLivedVectors, SmallVector)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ShortLivedVectors, StaticVector)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ShortLivedVectors, StdVector)->Arg(1 << 16);
+
+}  // namespace
@@ -0,0 +1,76 @@
+#include <map>
+#include <unordered_map>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::DiscardUntimed;
+using s21_bench::RandomKeys;
+using s21_bench::SetItems;
+
+using S21Hash = s21::unordered_map<int, int>;
+using StdHash = std::unordered_map<int, int>;
+using S21Map = s21::map<int, int>;
+
+template <typename Map>
+Map Build(const std::vector<int>& keys) {
+  Map m;
+  for (int key : keys) m.insert({key, key});
+  return m;
+}
+
+template <typename Map>
+void BM_HashInsert(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    Map m;
+    for (int key : keys) m.insert({key, key});
+    benchmark::DoNotOptimize(m.size());
+    DiscardUntimed(state, m);
+  }
+  SetItems(state);
+}
+
+// Точечные запросы, как у кэша сессий: примерно половина ключей есть в словаре
+template <typename Map>
+void BM_HashFind(benchmark::State& state) {
+  Map m = Build<Map>(RandomKeys(state.range(0)));
+  auto probes = RandomKeys(state.range(0) + 1);
+  for (auto _ : state) {
+    size_t found = 0;
+    for (int key : probes) found += m.find(key) != m.end();
+    benchmark::DoNotOptimize(found);
+  }
+  SetItems(state);
+}
+
+// Удаление всех ключей по одному через find
+template <typename Map>
+void BM_HashErase(benchmark::State& state) {
+  auto keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Map m = Build<Map>(keys);
+    state.ResumeTiming();
+    for (int key : keys) {
+      auto it = m.find(key);
+      if (it != m.end()) m.erase(it);
+    }
+    benchmark::DoNotOptimize(m.size());
+  }
+  SetItems(state);
+}
+
+BENCHMARK_TEMPLATE(BM_HashInsert, S21Hash)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_HashInsert, StdHash)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_HashFind, S21Hash)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_HashFind, StdHash)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_HashFind, S21Map)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_HashErase, S21Hash)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_HashErase, StdHash)->Apply(AllSizes);
+
+}  // namespace
@@ -0,0 +1,75 @@
+#include <vector>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21_bench::AllSizes;
+using s21_bench::DiscardUntimed;
+using s21_bench::QuadraticSizes;
+using s21_bench::SetItems;
+
+template <typename Vector>
+void BM_VectorPushBack(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    for (int i = 0; i < n; ++i) v.push_back(i);
+    benchmark::DoNotOptimize(v.data());
+    DiscardUntimed(state, v);
+  }
+  SetItems(state);
+}
+
+template <typename Vector>
+void BM_VectorReservePushBack(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    v.reserve(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) v.push_back(i);
+    benchmark::DoNotOptimize(v.data());
+    DiscardUntimed(state, v);
+  }
+  SetItems(state);
+}
+
+// Вставка в начало - O(n^2) у обоих, поэтому размеры ограничены
+template <typename Vector>
+void BM_VectorInsertFront(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    for (int i = 0; i < n; ++i) v.insert(v.begin(), i);
+    benchmark::DoNotOptimize(v.data());
+    DiscardUntimed(state, v);
+  }
+  SetItems(state);
+}
+
+template <typename Vector>
+void BM_VectorIterate(benchmark::State& state) {
+  Vector v;
+  for (int i = 0; i < state.range(0); ++i) v.push_back(i);
+  for (auto _ : state) {
+    long long sum = 0;
+    for (int value : v) sum += value;
+    benchmark::DoNotOptimize(sum);
+  }
+  SetItems(state);
+}
+
+using S21Vector = s21::vector<int>;
+using StdVector = std::vector<int>;
+
+BENCHMARK_TEMPLATE(BM_VectorPushBack, S21Vector)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_VectorPushBack, StdVector)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_VectorReservePushBack, S21Vector)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_VectorReservePushBack, StdVector)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_VectorInsertFront, S21Vector)->Apply(QuadraticSizes);
+BENCHMARK_TEMPLATE(BM_VectorInsertFront, StdVector)->Apply(QuadraticSizes);
+BENCHMARK_TEMPLATE(BM_VectorIterate, S21Vector)->Apply(AllSizes);
+BENCHMARK_TEMPLATE(BM_VectorIterate, StdVector)->Apply(AllSizes);
+
+}  // namespace
@@ -2,6 +2,7 @@
 #define S21_ARRAY_H_
 #include <iostream>
 #include <initializer_list>
+#include "s21_debug.h"
 
 namespace s21 {
     /**
@@ -136,24 +137,27 @@ namespace s21 {
             }
 
             /**
-             * @brief Доступ к указанному элементу
+             * @brief Доступ к указанному элементу без проверки границ
+             * @details Проверка только в сборке с S21_CONTAINERS_DEBUG (см. s21_debug.h)
              * 
              * @param pos 
              * @return reference 
              */
             reference operator[](size_type pos) {
-                return this->at(pos);
+                S21_DEBUG_ASSERT(pos < Size, "s21::array::operator[]: The index is out of range");
+                return this->array_[pos];
             }
 
             /**
-             * @brief Доступ к указанному элементу
+             * @brief Доступ к указанному элементу без проверки границ
              * @details Для конст объектов
              * 
              * @param pos 
              * @return reference 
              */
             const_reference operator[](size_type pos) const {
-                return this->at(pos);
+                S21_DEBUG_ASSERT(pos < Size, "s21::array::operator[]: The index is out of range");
+                return this->array_[pos];
             }
 
             /**
@@ -0,0 +1,1828 @@
+#ifndef SRC_S21_BTREE_H_
+#define SRC_S21_BTREE_H_
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "s21_slot_policy.h"
+
+namespace s21 {
+    /**
+     * @brief B-дерево - второй движок для map, set и multiset (см. BTreePolicy)
+     * @details У красно-черного дерева (s21_tree.h) в каждом узле один ключ, и поиск среди
+     * n элементов проходит около log2(n) узлов, разбросанных по памяти: на больших деревьях
+     * почти каждый шаг - промах кэша. Здесь в узле лежит до kNodeSlots элементов подряд,
+     * а размер узла подобран под kTargetNodeSize байт (четыре кэш-линии). Внутри узла
+     * ищем двоичным поиском по плотному массиву, а высота дерева - log(n) по основанию
+     * kNodeSlots / 2 и больше: для 50 млн int это 5 уровней вместо 26.
+     *
+     * Устройство:
+     * 1. Узел хранит count_ элементов по возрастанию, внутренний узел еще и count_ + 1 детей.
+     * Все элементы поддерева child(i) лежат между элементами i - 1 и i;
+     * 2. Все листья на одной глубине. Переполненный узел делится пополам, средний элемент
+     * поднимается в родителя; когда элементов в узле меньше kMinNodeValues (кроме корня),
+     * узел занимает элемент у соседа или сливается с ним;
+     * 3. Элементы лежат и во внутренних узлах (классическое B-дерево, не B+): у map элемент -
+     * pair<const Key, T>, и копии ключей-разделителей во внутренних узлах тащили бы за
+     * собой копии значений;
+     * 4. Итератор - пара (узел, позиция). end() - позиция за последним элементом самого
+     * правого листа, для пустого дерева - (nullptr, 0).
+     *
+     * Отличия от BinaryTree, которые видны снаружи:
+     * - элементы переезжают между узлами (перемещением), поэтому вставка и удаление
+     * делают недействительными все итераторы, а конструктор перемещения Key не должен
+     * бросать исключений (проверяется static_assert). Переезжает ячейка (см. SlotPolicy):
+     * у map в ней пара с изменяемым ключом, так что ключ перемещается, а не копируется;
+     * - память берется у аллокатора по узлу на каждые несколько десятков элементов,
+     * пул узлов (s21_node_pool.h) не нужен. Узлы разных типов (лист и внутренний)
+     * берутся через перепривязанные аллокаторы;
+     * - merge, split и join переносят элементы по одному: O(k log n) или O(k) вместо O(log n)
+     * перевешивания узлов. Если выделение памяти в них бросит исключение, оба дерева
+     * остаются корректными и каждый элемент лежит ровно в одном из них, но часть
+     * элементов могла уже переехать.
+     *
+     * Если OrderStatistics == true, каждый узел хранит количество элементов в своем
+     * поддереве, и nthElement, rank, countRange работают за O(log n), как у BinaryTree.
+     */
+    template<typename Key, typename Comparator = std::less<Key>, typename Allocator = std::allocator<Key>,
+             bool OrderStatistics = false>
+    class BTree {
+        class BTreeNode;
+        class BTreeInternalNode;
+        class BTreeIterator;
+        class BTreeConstIterator;
+        using tree_node = BTreeNode;
+        using slot_policy = SlotPolicy<Key>;
+        using slot_type = typename slot_policy::slot_type;
+        using value_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot_type>;
+        using value_traits = std::allocator_traits<value_allocator>;
+        using value_holder = SlotHolder<Key, value_allocator>;
+        using leaf_allocator = typename value_traits::template rebind_alloc<BTreeNode>;
+        using leaf_traits = std::allocator_traits<leaf_allocator>;
+        using internal_allocator = typename value_traits::template rebind_alloc<BTreeInternalNode>;
+        using internal_traits = std::allocator_traits<internal_allocator>;
+        using reference = Key&;
+        using const_reference = const Key&;
+        using size_type = std::size_t;
+        // Тип для позиции и количества элементов в узле
+        using field_type = std::uint16_t;
+
+        // Желаемый размер узла в байтах
+        static constexpr size_type kTargetNodeSize = 256;
+        // Сколько байт узла занимают служебные поля (см. BTreeNode)
+        static constexpr size_type kNodeHeaderSize = sizeof(void*) + 2 * sizeof(field_type) + sizeof(bool) +
+                                                     (OrderStatistics ? sizeof(size_type) : 0);
+        // Сколько элементов помещается в узел, но не меньше трех
+        static constexpr int kNodeSlots = static_cast<int>(
+            std::max<size_type>(3, (kTargetNodeSize - kNodeHeaderSize) / sizeof(slot_type)));
+        // Меньше элементов может быть только в корне
+        static constexpr int kMinNodeValues = kNodeSlots / 2;
+        static_assert(kNodeSlots < std::numeric_limits<field_type>::max(), "s21::BTree: too many slots per node");
+        // Переносы элементов между узлами (relocate) не должны бросать исключений
+        static_assert(slot_policy::kNothrowTake,
+                      "s21::BTree: Key must be nothrow move constructible");
+
+        public:
+            using iterator = BTreeIterator;
+            using const_iterator = BTreeConstIterator;
+            using allocator_type = Allocator;
+
+            // Операции над множествами для combineWith и assignCombined
+            // (с повторами работают как std::set_union и т.д.)
+            enum class SetOperation {
+                Union,
+                Intersection,
+                Difference,
+                SymmetricDifference
+            };
+
+            /*----------------------------constructors and operators--------------------------------*/
+
+            // Конструктор пустого дерева, память под узлы берется только при вставке
+            BTree() : BTree(Comparator(), Allocator()) {}
+
+            // Конструктор с аллокатором
+            explicit BTree(const Allocator& alloc) : BTree(Comparator(), alloc) {}
+
+            // Конструктор с компаратором и аллокатором
+            explicit BTree(const Comparator& comparator, const Allocator& alloc = Allocator())
+                : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0),
+                  comparator_(comparator), alloc_(alloc), tracked_(nullptr) {}
+
+            // Конструктор копирования дерева
+            // Аллокатор для копии выбирает сам аллокатор (select_on_container_copy_construction)
+            BTree(const BTree& other)
+                : BTree(other.comparator_, value_traits::select_on_container_copy_construction(other.alloc_)) {
+                this->copyTreeFrom(other);
+            }
+
+            // Конструктор перемещения дерева: забираем узлы целиком,
+            // бросить может только копирование компаратора
+            BTree(BTree&& other) noexcept(std::is_nothrow_copy_constructible<Comparator>::value)
+                : BTree(other.comparator_, other.alloc_) {
+                this->swapNodes(other);
+            }
+
+            // Деструктор - удаление дерева
+            ~BTree() {
+                this->clear();
+            }
+
+            // Оператор присваивания копированием
+            // Копию собираем во временном дереве, а потом меняемся с ним содержимым,
+            // так старые узлы освобождаются тем же аллокатором, которым выделялись
+            BTree& operator=(const BTree& other) {
+                if (this != &other) {
+                    BTree temp(other.comparator_,
+                        value_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : this->alloc_);
+                    temp.copyTreeFrom(other);
+                    this->swapTree(temp);
+                }
+                return *this;
+            }
+
+            // Оператор присваивания перемещением
+            // Если аллокаторы равны (или аллокатор переезжает вместе с деревом),
+            // просто меняемся узлами, иначе перемещаем элементы по одному в свои узлы
+            BTree& operator=(BTree&& other) noexcept(value_traits::propagate_on_container_move_assignment::value ||
+                                                    value_traits::is_always_equal::value) {
+                if (this != &other) {
+                    this->clear();
+                    if (value_traits::propagate_on_container_move_assignment::value || this->alloc_ == other.alloc_) {
+                        this->swapTree(other);
+                    } else {
+                        this->comparator_ = other.comparator_;
+                        for (iterator it = other.begin(); it != other.end(); ++it) {
+                            this->insertAt(this->end(), takeSlot(it));
+                        }
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+
+            /*----------------------------------------------------------------------------------*/
+
+            /*---------------------------------methods----------------------------------*/
+
+            /**
+             * @brief Возвращает копию аллокатора дерева
+             *
+             */
+            allocator_type get_allocator() const noexcept {
+                return allocator_type(this->alloc_);
+            }
+
+            /**
+             * @brief Меняет содержимое деревьев вместе с компараторами и аллокаторами
+             *
+             */
+            void swap(BTree& other) noexcept {
+                this->swapTree(other);
+            }
+
+            /**
+             * @brief Удаляет все элементы и отдает память всех узлов
+             *
+             */
+            void clear() noexcept {
+                if (this->root_ != nullptr) {
+                    this->destroySubtree(this->root_);
+                }
+                this->root_ = nullptr;
+                this->leftmost_ = nullptr;
+                this->rightmost_ = nullptr;
+                this->size_ = 0;
+            }
+
+            /**
+             * @brief Возвращает iterator на первый (самый маленький) элемент
+             *
+             */
+            iterator begin() noexcept {
+                return iterator(this->leftmost_, 0);
+            }
+
+            /**
+             * @brief Аналогично begin только для конст объекта
+             *
+             */
+            const_iterator begin() const noexcept {
+                return const_iterator(this->leftmost_, 0);
+            }
+
+            /**
+             * @brief Возвращает iterator за последним элементом
+             * @details Это позиция за последним элементом самого правого листа,
+             * поэтому --end() - последний элемент
+             *
+             */
+            iterator end() noexcept {
+                return iterator(this->rightmost_, this->rightmost_ == nullptr ? 0 : this->rightmost_->count_);
+            }
+
+            /**
+             * @brief Аналогично end только для конст объекта
+             *
+             */
+            const_iterator end() const noexcept {
+                return const_iterator(this->rightmost_, this->rightmost_ == nullptr ? 0 : this->rightmost_->count_);
+            }
+
+            /**
+             * @brief Количество элементов в дереве
+             *
+             */
+            size_type size() const noexcept {
+                return this->size_;
+            }
+
+            /**
+             * @brief Проверяет пустое ли дерево
+             *
+             */
+            bool empty() const noexcept {
+                return this->size_ == 0;
+            }
+
+            /**
+             * @brief Возвращает максимальное количество элементов, которое может содержать дерево
+             * @details Как у BinaryTree: половина адресного пространства без самого дерева,
+             * только считаем заполненными листьями по kNodeSlots элементов
+             *
+             */
+            size_type max_size() const noexcept {
+                return ((std::numeric_limits<size_type>::max() / 2) - sizeof(BTree)) / sizeof(tree_node) * kNodeSlots;
+            }
+
+            /**
+             * @brief Вставляет элемент (повторы разрешены)
+             * @details Равный элемент встает после уже имеющихся равных
+             *
+             * @return iterator - указывает на вставленный элемент
+             */
+            iterator insert(const Key& key) {
+                return this->insertAt(this->searchMultiPos(key), key);
+            }
+
+            /**
+             * @brief Вставляет элемент, если такого еще нет
+             *
+             * @return pair<iterator, bool> - iterator указывает на вставленный элемент
+             * или на уже имеющийся с таким же ключом, bool - была ли вставка
+             */
+            std::pair<iterator, bool> insertUnique(const Key& key) {
+                return this->emplaceUniqueKey(key, key);
+            }
+
+            /**
+             * @brief Вставляет элемент с ключом key, если такого ключа еще нет
+             * @details Место ищется за один спуск от корня, и только если ключа нет,
+             * элемент создается из args (см. BinaryTree::emplaceUniqueKey)
+             *
+             * @return pair<iterator, bool> - как у insertUnique
+             */
+            template<typename K, typename... Args>
+            std::pair<iterator, bool> emplaceUniqueKey(const K& key, Args&&... args) {
+                std::pair<iterator, bool> pos = this->searchUniquePos(key);
+                if (pos.second) {
+                    return {pos.first, false};
+                }
+                return {this->insertAt(pos.first, std::forward<Args>(args)...), true};
+            }
+
+            /**
+             * @brief Вставляет элемент перед подсказкой hint, если он туда подходит
+             * @details Подходит - значит не нарушает порядок с соседями hint; тогда
+             * спуска от корня нет. Иначе обычная вставка
+             *
+             * @return iterator - указывает на вставленный элемент
+             */
+            iterator insert(const_iterator hint, const Key& key) {
+                return this->insertHint(hint, key, false, key).first;
+            }
+
+            /**
+             * @brief Аналогично insert(hint, key), но вставляет только уникальные элементы
+             *
+             * @return iterator - указывает на вставленный элемент или на уже
+             * имеющийся элемент с таким ключом
+             */
+            iterator insertUnique(const_iterator hint, const Key& key) {
+                return this->insertHint(hint, key, true, key).first;
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его с подсказкой hint
+             *
+             * @return iterator - указывает на вставленный элемент
+             */
+            template<typename... Args>
+            iterator emplaceHint(const_iterator hint, Args&&... args) {
+                value_holder holder(this->alloc_, std::forward<Args>(args)...);
+                return this->insertHint(hint, holder.value(), false, holder.take()).first;
+            }
+
+            /**
+             * @brief Аналогично emplaceHint, но вставляет только уникальные элементы
+             *
+             */
+            template<typename... Args>
+            iterator emplaceHintUnique(const_iterator hint, Args&&... args) {
+                value_holder holder(this->alloc_, std::forward<Args>(args)...);
+                return this->insertHint(hint, holder.value(), true, holder.take()).first;
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева элементами из [first, last)
+             * @details Элементы должны идти по возрастанию. Каждый добавляется в конец
+             * самого правого листа, а переполненный крайний узел делится так, что
+             * в старом остаются все элементы, - итого O(n) и узлы заполнены целиком
+             *
+             */
+            template<typename InputIt>
+            void assignSorted(InputIt first, InputIt last) {
+                this->assignRange(first, last, false);
+            }
+
+            /**
+             * @brief Аналогично assignSorted, но из повторяющихся элементов
+             * остается только первый
+             *
+             */
+            template<typename InputIt>
+            void assignSortedUnique(InputIt first, InputIt last) {
+                this->assignRange(first, last, true);
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева элементами из [first, last) в любом порядке
+             * @details Каждый элемент сначала пробуем поставить в конец (как в assignSorted),
+             * поэтому отсортированный диапазон собирается за O(n), а остальные - обычной
+             * вставкой за O(n log n). Равные элементы остаются в порядке следования
+             *
+             */
+            template<typename InputIt>
+            void assign(InputIt first, InputIt last) {
+                this->assignRange(first, last, false);
+            }
+
+            /**
+             * @brief Аналогично assign, но из повторяющихся элементов
+             * остается только первый
+             *
+             */
+            template<typename InputIt>
+            void assignUnique(InputIt first, InputIt last) {
+                this->assignRange(first, last, true);
+            }
+
+            /**
+             * @brief Удаляет элемент с позиции
+             * @details Элемент внутреннего узла заменяется предыдущим элементом (он всегда
+             * в листе), так что удаление всегда идет из листа. Если лист стал слишком
+             * маленьким, он занимает элемент у соседа или сливается с ним (см. rebalanceAfterErase)
+             *
+             */
+            void erase(iterator pos) noexcept {
+                tree_node* node = pos.node_;
+                int i = pos.position_;
+                slot_policy::destroy(this->alloc_, node->slot(i));
+                if (!node->leaf_) {
+                    tree_node* leaf = node->child(i);
+                    while (!leaf->leaf_) {
+                        leaf = leaf->child(leaf->count_);
+                    }
+                    this->relocate(node->slot(i), leaf->slot(leaf->count_ - 1));
+                    node = leaf;
+                    i = leaf->count_ - 1;
+                }
+                this->closeSlot(node, i);
+                --this->size_;
+                this->addSubtreeSizeUp(node, static_cast<size_type>(-1));
+                this->rebalanceAfterErase(node);
+            }
+
+            /**
+             * @brief Находит элемент по ключу
+             * @details Как у BinaryTree - через lowerBound, поэтому из равных
+             * элементов находится первый
+             *
+             * @return iterator - найденный элемент или end()
+             */
+            iterator find(const_reference key) {
+                return this->findPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции find только для конст объекта
+             *
+             */
+            const_iterator find(const_reference key) const {
+                return this->findPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции find для ключа другого типа (см. BinaryTree::find(const K&))
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            iterator find(const K& key) {
+                return this->findPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции find(const K&) только для конст объекта
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            const_iterator find(const K& key) const {
+                return this->findPos(key);
+            }
+
+            /**
+             * @brief Переносит все элементы other в this
+             * @details Элементы other перемещаются по одному с начала, равные встают после
+             * уже имеющихся. Перенесенный элемент сразу удаляется из other, поэтому если
+             * выделение узла бросит исключение, каждый элемент лежит ровно в одном из деревьев.
+             * other становится пустым
+             *
+             */
+            void merge(BTree& other) {
+                if (this != &other) {
+                    while (other.size_ != 0) {
+                        iterator first = other.begin();
+                        this->insertAt(this->searchMultiPos(*first), takeSlot(first));
+                        other.erase(first);
+                    }
+                }
+            }
+
+            /**
+             * @brief Переносит из other элементы, которых еще нет в this
+             * @details Остальные элементы остаются в other. Перенесенный элемент сразу
+             * удаляется из other (как в merge), удаление сдвигает элементы other,
+             * поэтому следующий ищется заново по ключу только что перенесенного
+             *
+             */
+            void mergeUnique(BTree& other) {
+                if (this != &other) {
+                    iterator it = other.begin();
+                    while (it != other.end()) {
+                        std::pair<iterator, bool> pos = this->searchUniquePos(*it);
+                        if (pos.second) {
+                            ++it;
+                        } else {
+                            iterator inserted = this->insertAt(pos.first, takeSlot(it));
+                            other.erase(it);
+                            it = other.upperBoundPos(*inserted);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева результатом операции op над this и other
+             * @details Оба дерева обходятся по возрастанию один раз, как в std::set_union,
+             * результат собирается в новом дереве добавлением в конец - O(n + m).
+             * Элементы this копируются, а не перемещаются: если копирование бросит
+             * исключение, дерево остается как было
+             *
+             */
+            void combineWith(const BTree& other, SetOperation op) {
+                BTree result(this->comparator_, this->alloc_);
+                auto append = [&result](const Key& key) { result.insertAt(result.end(), key); };
+                this->walkCombined(this->begin(), this->end(), other.begin(), other.end(), op, append, append);
+                this->swapNodes(result);
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева результатом операции op над a и b
+             * @details Как combineWith, только все элементы копируются: O(n + m).
+             * Компаратор берется у a
+             *
+             */
+            void assignCombined(const BTree& a, const BTree& b, SetOperation op) {
+                this->clear();
+                this->comparator_ = a.comparator_;
+                auto append = [this](const Key& key) { this->insertAt(this->end(), key); };
+                try {
+                    this->walkCombined(a.begin(), a.end(), b.begin(), b.end(), op, append, append);
+                } catch (...) {
+                    this->clear();
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Переносит все элементы, которые >= key, в дерево upper
+             * @details В this остаются элементы меньше key, прежнее содержимое upper удаляется.
+             * Элементы по одному перемещаются с конца this в начало upper, так что время O(k),
+             * где k - количество перенесенных элементов. Как в merge, если выделение узла
+             * бросит исключение, каждый элемент лежит ровно в одном из деревьев
+             *
+             */
+            void split(const_reference key, BTree& upper) {
+                this->splitTo(key, upper);
+            }
+
+            /**
+             * @brief Аналогично функции split для ключа другого типа (см. find(const K&))
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            void split(const K& key, BTree& upper) {
+                this->splitTo(key, upper);
+            }
+
+            /**
+             * @brief Переносит все элементы other в this, если диапазоны ключей не пересекаются
+             * @details Условие как у BinaryTree::join. Элементы other перемещаются к краю this
+             * по одному (в конец или, с обратного конца, в начало), каждый за O(1) - итого O(m),
+             * и сразу удаляются из other (см. merge). Если this пуст, узлы other просто
+             * переходят к this. other становится пустым
+             *
+             * @param unique - в дереве не может быть равных ключей (set, map)
+             * @throw std::invalid_argument - диапазоны ключей пересекаются
+             */
+            void join(BTree& other, bool unique) {
+                if (this == &other || other.size_ == 0) {
+                    return;
+                }
+                bool other_after = true;
+                if (this->size_ > 0) {
+                    other_after = this->notAfter(*this->lastPos(), *other.begin(), unique);
+                    if (!other_after && !this->notAfter(*other.lastPos(), *this->begin(), unique)) {
+                        throw std::invalid_argument("s21::BTree::join: key ranges overlap");
+                    }
+                }
+                if (this->size_ == 0 && this->alloc_ == other.alloc_) {
+                    this->swapNodes(other);
+                    return;
+                }
+                while (other.size_ != 0) {
+                    if (other_after) {
+                        iterator first = other.begin();
+                        this->insertAt(this->end(), takeSlot(first));
+                        other.erase(first);
+                    } else {
+                        iterator last = other.lastPos();
+                        this->insertAt(this->begin(), takeSlot(last));
+                        other.erase(last);
+                    }
+                }
+            }
+
+            /**
+             * @brief Находит первый элемент, который >= key
+             *
+             * @return iterator - найденный элемент или end()
+             */
+            iterator lowerBound(const_reference key) noexcept {
+                return this->lowerBoundPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции lowerBound только для конст объекта
+             *
+             */
+            const_iterator lowerBound(const_reference key) const noexcept {
+                return this->lowerBoundPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции lowerBound для ключа другого типа (см. find(const K&))
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            iterator lowerBound(const K& key) noexcept {
+                return this->lowerBoundPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции lowerBound(const K&) только для конст объекта
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            const_iterator lowerBound(const K& key) const noexcept {
+                return this->lowerBoundPos(key);
+            }
+
+            /**
+             * @brief Находит первый элемент, который больше key
+             *
+             */
+            iterator upperBound(const_reference key) noexcept {
+                return this->upperBoundPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции upperBound только для конст объекта
+             *
+             */
+            const_iterator upperBound(const_reference key) const noexcept {
+                return this->upperBoundPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции upperBound для ключа другого типа (см. find(const K&))
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            iterator upperBound(const K& key) noexcept {
+                return this->upperBoundPos(key);
+            }
+
+            /**
+             * @brief Аналогично функции upperBound(const K&) только для конст объекта
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            const_iterator upperBound(const K& key) const noexcept {
+                return this->upperBoundPos(key);
+            }
+
+            /**
+             * @brief Возвращает диапазон [lowerBound(key), upperBound(key)) элементов, равных key
+             *
+             */
+            std::pair<iterator, iterator> equalRange(const_reference key) noexcept {
+                return {this->lowerBoundPos(key), this->upperBoundPos(key)};
+            }
+
+            /**
+             * @brief Аналогично функции equalRange только для конст объекта
+             *
+             */
+            std::pair<const_iterator, const_iterator> equalRange(const_reference key) const noexcept {
+                return {this->lowerBoundPos(key), this->upperBoundPos(key)};
+            }
+
+            /**
+             * @brief Количество элементов, равных key
+             * @details При OrderStatistics == true это разность двух рангов - O(log n),
+             * иначе равные элементы пересчитываются итератором: O(log n + k)
+             *
+             */
+            size_type count(const_reference key) const noexcept {
+                if constexpr (OrderStatistics) {
+                    return this->rankOf(key, true) - this->rankOf(key, false);
+                } else {
+                    size_type result = 0;
+                    for (const_iterator it = this->lowerBound(key), last = this->upperBound(key); it != last; ++it) {
+                        ++result;
+                    }
+                    return result;
+                }
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его, если в дереве еще нет такого ключа
+             * @details Чтобы найти место, элемент нужно сначала создать: он создается
+             * во временной ячейке и при вставке перемещается в узел
+             *
+             * @return pair<iterator, bool> - как у insertUnique
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplaceUnique(Args&&... args) {
+                value_holder holder(this->alloc_, std::forward<Args>(args)...);
+                return this->emplaceUniqueKey(holder.value(), holder.take());
+            }
+
+            /**
+             * @brief Аналогично emplaceUnique только вставляет элемент всегда
+             *
+             * @return iterator - указывает на вставленный элемент
+             */
+            template<typename... Args>
+            iterator emplace(Args&&... args) {
+                value_holder holder(this->alloc_, std::forward<Args>(args)...);
+                return this->insertAt(this->searchMultiPos(holder.value()), holder.take());
+            }
+
+            /**
+             * @brief Вставляет новые элеметы в контейнер, если контейнер
+             * не содержит таких ключей
+             * @details Каждая вставка сдвигает элементы в узлах, поэтому итераторы уже
+             * записанных результатов на время вставок отслеживаются (см. moveTracked) -
+             * в конце все они действительны
+             *
+             * @return vector<std::pair<iterator,bool>>
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insertManyUnique(Args&&... args) {
+                std::vector<std::pair<iterator, bool>> v;
+                v.reserve(sizeof...(args));
+                this->tracked_ = &v;
+                try {
+                    (v.push_back(this->emplaceUnique(std::forward<Args>(args))), ...);
+                } catch (...) {
+                    this->tracked_ = nullptr;
+                    throw;
+                }
+                this->tracked_ = nullptr;
+                return v;
+            }
+
+            /**
+             * @brief Аналогично insertManyUnique только вставляет все элементы
+             *
+             * @return vector<std::pair<iterator,bool>>
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insertMany(Args&&... args) {
+                std::vector<std::pair<iterator, bool>> v;
+                v.reserve(sizeof...(args));
+                this->tracked_ = &v;
+                try {
+                    (v.push_back({this->emplace(std::forward<Args>(args)), true}), ...);
+                } catch (...) {
+                    this->tracked_ = nullptr;
+                    throw;
+                }
+                this->tracked_ = nullptr;
+                return v;
+            }
+
+            /**
+             * @brief Возвращает iterator на k-й по порядку элемент (считая с 0)
+             * @details Спускаемся от корня, вычитая размеры поддеревьев левее - O(log n).
+             * Доступно только при OrderStatistics == true
+             *
+             * @return iterator - k-й элемент или end(), если k >= size()
+             */
+            iterator nthElement(size_type k) noexcept {
+                return this->nthPos(k);
+            }
+
+            /**
+             * @brief Аналогично функции nthElement только для конст объекта
+             *
+             */
+            const_iterator nthElement(size_type k) const noexcept {
+                return this->nthPos(k);
+            }
+
+            /**
+             * @brief Количество элементов, меньших key, то есть номер lowerBound(key)
+             * @details O(log n). Доступно только при OrderStatistics == true
+             *
+             */
+            size_type rank(const_reference key) const noexcept {
+                return this->rankOf(key, false);
+            }
+
+            /**
+             * @brief Аналогично функции rank для ключа другого типа (см. find(const K&))
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            size_type rank(const K& key) const noexcept {
+                return this->rankOf(key, false);
+            }
+
+            /**
+             * @brief Количество элементов из полуинтервала [lo, hi)
+             * @details Разность двух rank - O(log n). Доступно только при OrderStatistics == true
+             *
+             */
+            size_type countRange(const_reference lo, const_reference hi) const noexcept {
+                if (!this->comparator_(lo, hi)) {
+                    return 0;
+                }
+                return this->rankOf(hi, false) - this->rankOf(lo, false);
+            }
+
+            /*----------------------------------------------------------------------------------*/
+
+        private:
+
+            /*----------------------------------search----------------------------------*/
+
+            // Номер первого элемента узла, который не меньше key (двоичный поиск)
+            template<typename K>
+            int lowerIndex(const tree_node* node, const K& key) const {
+                int lo = 0;
+                int hi = node->count_;
+                while (lo < hi) {
+                    int mid = (lo + hi) / 2;
+                    if (this->comparator_(*node->key(mid), key)) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                return lo;
+            }
+
+            // Номер первого элемента узла, который больше key
+            template<typename K>
+            int upperIndex(const tree_node* node, const K& key) const {
+                int lo = 0;
+                int hi = node->count_;
+                while (lo < hi) {
+                    int mid = (lo + hi) / 2;
+                    if (!this->comparator_(key, *node->key(mid))) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                return lo;
+            }
+
+            /**
+             * @brief Первый элемент, который >= key, или end()
+             * @details На каждом уровне запоминаем найденный в узле элемент: все, что
+             * ниже по пути, меньше его, так что ответ - последний запомненный
+             *
+             */
+            template<typename K>
+            iterator lowerBoundPos(const K& key) const {
+                tree_node* result = nullptr;
+                int position = 0;
+                for (tree_node* node = this->root_; node != nullptr; ) {
+                    int i = this->lowerIndex(node, key);
+                    if (i < node->count_) {
+                        result = node;
+                        position = i;
+                    }
+                    node = node->leaf_ ? nullptr : node->child(i);
+                }
+                return result == nullptr ? this->endPos() : iterator(result, position);
+            }
+
+            // Аналогично lowerBoundPos: первый элемент, который больше key, или end()
+            template<typename K>
+            iterator upperBoundPos(const K& key) const {
+                tree_node* result = nullptr;
+                int position = 0;
+                for (tree_node* node = this->root_; node != nullptr; ) {
+                    int i = this->upperIndex(node, key);
+                    if (i < node->count_) {
+                        result = node;
+                        position = i;
+                    }
+                    node = node->leaf_ ? nullptr : node->child(i);
+                }
+                return result == nullptr ? this->endPos() : iterator(result, position);
+            }
+
+            // Первый элемент, равный key, или end()
+            template<typename K>
+            iterator findPos(const K& key) const {
+                iterator it = this->lowerBoundPos(key);
+                if (it != this->endPos() && this->comparator_(key, *it)) {
+                    return this->endPos();
+                }
+                return it;
+            }
+
+            /**
+             * @brief Ищет уникальный ключ key за один спуск
+             *
+             * @return pair<iterator, bool> - {элемент с таким же ключом, true}, если ключ есть,
+             * иначе {позиция в листе, куда ключ встанет, false}
+             */
+            template<typename K>
+            std::pair<iterator, bool> searchUniquePos(const K& key) const {
+                tree_node* node = this->root_;
+                if (node == nullptr) {
+                    return {this->endPos(), false};
+                }
+                while (true) {
+                    int i = this->lowerIndex(node, key);
+                    if (i < node->count_ && !this->comparator_(key, *node->key(i))) {
+                        return {iterator(node, i), true};
+                    }
+                    if (node->leaf_) {
+                        return {iterator(node, i), false};
+                    }
+                    node = node->child(i);
+                }
+            }
+
+            // Позиция в листе после всех элементов, равных key (для вставки с повторами)
+            template<typename K>
+            iterator searchMultiPos(const K& key) const {
+                tree_node* node = this->root_;
+                if (node == nullptr) {
+                    return this->endPos();
+                }
+                while (!node->leaf_) {
+                    node = node->child(this->upperIndex(node, key));
+                }
+                return iterator(node, this->upperIndex(node, key));
+            }
+
+            // end() без const-перегрузки, чтобы поиск работал и в конст методах
+            iterator endPos() const noexcept {
+                return iterator(this->rightmost_, this->rightmost_ == nullptr ? 0 : this->rightmost_->count_);
+            }
+
+            // Последний элемент непустого дерева
+            iterator lastPos() const noexcept {
+                return iterator(this->rightmost_, this->rightmost_->count_ - 1);
+            }
+
+            // left_key <= right_key (при strict - строго меньше)
+            bool notAfter(const Key& left_key, const Key& right_key, bool strict) const {
+                return strict ? this->comparator_(left_key, right_key) : !this->comparator_(right_key, left_key);
+            }
+
+            /*--------------------------------order statistics--------------------------------*/
+
+            // Размер поддерева node
+            static size_type subtreeSize(const tree_node* node) noexcept {
+                if constexpr (OrderStatistics) {
+                    return node->subtree_size_;
+                } else {
+                    return 0;
+                }
+            }
+
+            // Пересчитывает размер поддерева node по его элементам и детям
+            static void recountSubtreeSize(tree_node* node) noexcept {
+                if constexpr (OrderStatistics) {
+                    size_type size = node->count_;
+                    if (!node->leaf_) {
+                        for (int i = 0; i <= node->count_; ++i) {
+                            size += node->child(i)->subtree_size_;
+                        }
+                    }
+                    node->subtree_size_ = size;
+                }
+            }
+
+            // Прибавляет delta (по модулю size_type) к размерам поддеревьев от node до корня
+            static void addSubtreeSizeUp(tree_node* node, size_type delta) noexcept {
+                if constexpr (OrderStatistics) {
+                    for (; node != nullptr; node = node->parent_) {
+                        node->subtree_size_ += delta;
+                    }
+                }
+            }
+
+            // k-й по порядку элемент или end()
+            iterator nthPos(size_type k) const noexcept {
+                static_assert(OrderStatistics, "s21::BTree: nthElement requires OrderStatistics");
+                if (k >= this->size_) {
+                    return this->endPos();
+                }
+                tree_node* node = this->root_;
+                while (!node->leaf_) {
+                    int i = 0;
+                    while (true) {
+                        size_type child_size = node->child(i)->subtree_size_;
+                        if (k < child_size) {
+                            break;
+                        }
+                        k -= child_size;
+                        if (k == 0) {
+                            return iterator(node, i);
+                        }
+                        --k;
+                        ++i;
+                    }
+                    node = node->child(i);
+                }
+                return iterator(node, static_cast<int>(k));
+            }
+
+            // Количество элементов, меньших key (при upper - не больших key)
+            template<typename K>
+            size_type rankOf(const K& key, bool upper) const noexcept {
+                static_assert(OrderStatistics, "s21::BTree: rank requires OrderStatistics");
+                size_type result = 0;
+                for (tree_node* node = this->root_; node != nullptr; ) {
+                    int i = upper ? this->upperIndex(node, key) : this->lowerIndex(node, key);
+                    result += static_cast<size_type>(i);
+                    if (node->leaf_) {
+                        break;
+                    }
+                    for (int j = 0; j < i; ++j) {
+                        result += node->child(j)->subtree_size_;
+                    }
+                    node = node->child(i);
+                }
+                return result;
+            }
+
+            /*-----------------------------------insert-----------------------------------*/
+
+            /**
+             * @brief Создает элемент из args в позиции pos
+             * @details pos - позиция, перед которой встанет элемент. Если конструктор
+             * элемента может бросить исключение, элемент сначала создается во временной
+             * ячейке: так дерево меняется, только когда элемент уже создан
+             *
+             * @return iterator - указывает на вставленный элемент
+             */
+            template<typename... Args>
+            iterator insertAt(iterator pos, Args&&... args) {
+                if constexpr (std::is_nothrow_constructible<Key, Args&&...>::value) {
+                    return this->insertSlot(pos, [&](slot_type* slot) {
+                        slot_policy::construct(this->alloc_, slot, std::forward<Args>(args)...);
+                    });
+                } else {
+                    value_holder holder(this->alloc_, std::forward<Args>(args)...);
+                    return this->insertSlot(pos, [&](slot_type* slot) {
+                        slot_policy::construct(this->alloc_, slot, holder.take());
+                    });
+                }
+            }
+
+            /**
+             * @brief Освобождает ячейку перед pos и создает в ней элемент через init
+             * @details Вставка всегда идет в лист: позиция во внутреннем узле - это место
+             * сразу после предыдущего элемента, а он последний в листе левого поддерева.
+             * Полный лист сначала делится (см. splitNode)
+             *
+             */
+            template<typename Init>
+            iterator insertSlot(iterator pos, Init init) {
+                tree_node* node = pos.node_;
+                int i = pos.position_;
+                if (node == nullptr) {
+                    node = this->createNode(nullptr, true);
+                    this->root_ = node;
+                    this->leftmost_ = node;
+                    this->rightmost_ = node;
+                    i = 0;
+                } else if (!node->leaf_) {
+                    node = node->child(i);
+                    while (!node->leaf_) {
+                        node = node->child(node->count_);
+                    }
+                    i = node->count_;
+                }
+                if (node->count_ == kNodeSlots) {
+                    this->splitNode(node, i);
+                    if (i > node->count_) {
+                        i -= node->count_ + 1;
+                        node = node->parent_->child(node->position_ + 1);
+                    }
+                }
+                this->openSlot(node, i);
+                init(node->slot(i));
+                ++node->count_;
+                ++this->size_;
+                this->addSubtreeSizeUp(node, 1);
+                return iterator(node, i);
+            }
+
+            /**
+             * @brief Вставляет элемент key с подсказкой hint
+             * @details Элемент встает перед hint, если не меньше предыдущего и не больше hint
+             * (для unique - строго). Если unique и key равен hint или предыдущему,
+             * вставки нет. Иначе обычная вставка со спуском от корня
+             *
+             * @param key - элемент, по которому ищем место (args создают равный ему)
+             * @return pair<iterator, bool> - как у insertUnique
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> insertHint(const_iterator hint, const Key& key, bool unique, Args&&... args) {
+                iterator pos(const_cast<tree_node*>(hint.node_), hint.position_);
+                if (pos == this->end() || (unique ? this->comparator_(key, *pos) : !this->comparator_(*pos, key))) {
+                    if (pos == this->begin()) {
+                        return {this->insertAt(pos, std::forward<Args>(args)...), true};
+                    }
+                    iterator before = pos;
+                    --before;
+                    if (this->notAfter(*before, key, unique)) {
+                        return {this->insertAt(pos, std::forward<Args>(args)...), true};
+                    }
+                } else if (unique && !this->comparator_(*pos, key)) {
+                    // Такой ключ уже есть - это и есть hint
+                    return {pos, false};
+                }
+                // Подсказка не подошла
+                if (unique) {
+                    return this->emplaceUniqueKey(key, std::forward<Args>(args)...);
+                }
+                return {this->insertAt(this->searchMultiPos(key), std::forward<Args>(args)...), true};
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева элементами из [first, last)
+             * @details Каждый элемент вставляется с подсказкой end() (см. assign)
+             *
+             * @param unique - оставить только первый из равных элементов
+             */
+            template<typename InputIt>
+            void assignRange(InputIt first, InputIt last, bool unique) {
+                this->clear();
+                for (; first != last; ++first) {
+                    if constexpr (std::is_same<typename std::decay<decltype(*first)>::type, Key>::value) {
+                        const Key& key = *first;
+                        this->insertHint(this->end(), key, unique, key);
+                    } else {
+                        value_holder holder(this->alloc_, *first);
+                        this->insertHint(this->end(), holder.value(), unique, holder.take());
+                    }
+                }
+            }
+
+            /**
+             * @brief Делит полный узел node пополам перед вставкой в позицию insert_position
+             * @details Верхняя часть переезжает в новый правый сосед, средний элемент -
+             * в родителя (полный родитель сначала делится сам, полный корень - дает новый
+             * корень). Если вставка в самый конец узла, в нем остаются все элементы, кроме
+             * последнего (в самое начало - наоборот): так при вставке по возрастанию или
+             * по убыванию узлы остаются заполнены целиком.
+             * Все узлы выделяются до первого изменения дерева, так что при исключении
+             * дерево остается как было
+             *
+             */
+            void splitNode(tree_node* node, int insert_position) {
+                tree_node* sibling = this->createNode(nullptr, node->leaf_);
+                try {
+                    if (node->parent_ == nullptr) {
+                        tree_node* root = this->createNode(nullptr, false);
+                        root->setChild(0, node);
+                        if constexpr (OrderStatistics) {
+                            root->subtree_size_ = node->subtree_size_;
+                        }
+                        this->root_ = root;
+                    } else if (node->parent_->count_ == kNodeSlots) {
+                        this->splitNode(node->parent_, node->position_);
+                    }
+                } catch (...) {
+                    this->freeNode(sibling);
+                    throw;
+                }
+
+                int move_count = node->count_ / 2;
+                if (insert_position == 0) {
+                    move_count = node->count_ - 1;
+                } else if (insert_position == kNodeSlots) {
+                    move_count = 0;
+                }
+                int keep = node->count_ - move_count - 1;
+                for (int j = 0; j < move_count; ++j) {
+                    this->relocate(sibling->slot(j), node->slot(keep + 1 + j));
+                }
+                if (!node->leaf_) {
+                    for (int j = 0; j <= move_count; ++j) {
+                        sibling->setChild(j, node->child(keep + 1 + j));
+                    }
+                }
+                sibling->count_ = static_cast<field_type>(move_count);
+                this->moveTracked(node, keep + 1, node->count_, sibling, -(keep + 1));
+
+                // Средний элемент уходит в родителя, новый сосед встает справа от node
+                tree_node* parent = node->parent_;
+                int position = node->position_;
+                this->openSlot(parent, position);
+                this->relocate(parent->slot(position), node->slot(keep));
+                this->moveTracked(node, keep, keep + 1, parent, position - keep);
+                parent->setChild(position + 1, sibling);
+                ++parent->count_;
+                node->count_ = static_cast<field_type>(keep);
+                recountSubtreeSize(node);
+                recountSubtreeSize(sibling);
+                if (this->rightmost_ == node) {
+                    this->rightmost_ = sibling;
+                }
+            }
+
+            /*-----------------------------------erase-----------------------------------*/
+
+            /**
+             * @brief Восстанавливает заполненность узлов после удаления из node
+             * @details Пока узел (не корень) меньше kMinNodeValues: если у соседа есть лишний
+             * элемент, он переходит к node через родителя, и дерево готово. Иначе node
+             * сливается с соседом вместе с разделяющим элементом родителя, и проверяем
+             * уже родителя. Пустой корень заменяется своим единственным ребенком
+             *
+             */
+            void rebalanceAfterErase(tree_node* node) noexcept {
+                while (node != this->root_ && node->count_ < kMinNodeValues) {
+                    tree_node* parent = node->parent_;
+                    int position = node->position_;
+                    if (position > 0 && parent->child(position - 1)->count_ > kMinNodeValues) {
+                        this->rotateRight(parent, position - 1);
+                        return;
+                    }
+                    if (position < parent->count_ && parent->child(position + 1)->count_ > kMinNodeValues) {
+                        this->rotateLeft(parent, position);
+                        return;
+                    }
+                    this->mergeChildren(parent, position > 0 ? position - 1 : position);
+                    node = parent;
+                }
+                if (this->root_->count_ == 0) {
+                    tree_node* old_root = this->root_;
+                    if (old_root->leaf_) {
+                        this->root_ = nullptr;
+                        this->leftmost_ = nullptr;
+                        this->rightmost_ = nullptr;
+                    } else {
+                        this->root_ = old_root->child(0);
+                        this->root_->parent_ = nullptr;
+                        this->root_->position_ = 0;
+                    }
+                    this->freeNode(old_root);
+                }
+            }
+
+            // Переносит последний элемент ребенка separator через родителя в начало ребенка separator + 1
+            void rotateRight(tree_node* parent, int separator) noexcept {
+                tree_node* left = parent->child(separator);
+                tree_node* right = parent->child(separator + 1);
+                for (int j = right->count_; j > 0; --j) {
+                    this->relocate(right->slot(j), right->slot(j - 1));
+                }
+                this->relocate(right->slot(0), parent->slot(separator));
+                this->relocate(parent->slot(separator), left->slot(left->count_ - 1));
+                size_type moved = 1;
+                if (!right->leaf_) {
+                    for (int j = right->count_ + 1; j > 0; --j) {
+                        right->setChild(j, right->child(j - 1));
+                    }
+                    tree_node* child = left->child(left->count_);
+                    right->setChild(0, child);
+                    moved += subtreeSize(child);
+                }
+                --left->count_;
+                ++right->count_;
+                if constexpr (OrderStatistics) {
+                    left->subtree_size_ -= moved;
+                    right->subtree_size_ += moved;
+                }
+            }
+
+            // Переносит первый элемент ребенка separator + 1 через родителя в конец ребенка separator
+            void rotateLeft(tree_node* parent, int separator) noexcept {
+                tree_node* left = parent->child(separator);
+                tree_node* right = parent->child(separator + 1);
+                this->relocate(left->slot(left->count_), parent->slot(separator));
+                this->relocate(parent->slot(separator), right->slot(0));
+                size_type moved = 1;
+                if (!right->leaf_) {
+                    tree_node* child = right->child(0);
+                    left->setChild(left->count_ + 1, child);
+                    moved += subtreeSize(child);
+                    for (int j = 1; j <= right->count_; ++j) {
+                        right->setChild(j - 1, right->child(j));
+                    }
+                }
+                for (int j = 1; j < right->count_; ++j) {
+                    this->relocate(right->slot(j - 1), right->slot(j));
+                }
+                ++left->count_;
+                --right->count_;
+                if constexpr (OrderStatistics) {
+                    left->subtree_size_ += moved;
+                    right->subtree_size_ -= moved;
+                }
+            }
+
+            // Сливает детей separator и separator + 1 вместе с разделяющим элементом родителя
+            void mergeChildren(tree_node* parent, int separator) noexcept {
+                tree_node* left = parent->child(separator);
+                tree_node* right = parent->child(separator + 1);
+                int base = left->count_ + 1;
+                this->relocate(left->slot(left->count_), parent->slot(separator));
+                for (int j = 0; j < right->count_; ++j) {
+                    this->relocate(left->slot(base + j), right->slot(j));
+                }
+                if (!right->leaf_) {
+                    for (int j = 0; j <= right->count_; ++j) {
+                        left->setChild(base + j, right->child(j));
+                    }
+                }
+                if constexpr (OrderStatistics) {
+                    left->subtree_size_ += 1 + right->subtree_size_;
+                }
+                left->count_ = static_cast<field_type>(base + right->count_);
+                this->closeSlot(parent, separator);
+                if (this->rightmost_ == right) {
+                    this->rightmost_ = left;
+                }
+                this->freeNode(right);
+            }
+
+            /*----------------------------------helpers----------------------------------*/
+
+            /**
+             * @brief Освобождает ячейку i в узле: элементы [i, count_) сдвигаются вправо,
+             * у внутреннего узла - и дети после i
+             * @details count_ не меняется, ячейку заполняет вызывающий
+             *
+             */
+            void openSlot(tree_node* node, int i) noexcept {
+                for (int j = node->count_; j > i; --j) {
+                    this->relocate(node->slot(j), node->slot(j - 1));
+                }
+                if (!node->leaf_) {
+                    for (int j = node->count_ + 1; j > i + 1; --j) {
+                        node->setChild(j, node->child(j - 1));
+                    }
+                }
+                this->moveTracked(node, i, node->count_, node, 1);
+            }
+
+            // Закрывает пустую ячейку i: элементы правее сдвигаются влево, ребенок i + 1 выпадает
+            void closeSlot(tree_node* node, int i) noexcept {
+                for (int j = i + 1; j < node->count_; ++j) {
+                    this->relocate(node->slot(j - 1), node->slot(j));
+                }
+                if (!node->leaf_) {
+                    for (int j = i + 2; j <= node->count_; ++j) {
+                        node->setChild(j - 1, node->child(j));
+                    }
+                }
+                --node->count_;
+            }
+
+            // Ячейка элемента it для переноса в другое дерево: перемещается вместе с ключом
+            static decltype(auto) takeSlot(iterator it) noexcept {
+                return slot_policy::take(it.node_->slot(it.position_));
+            }
+
+            // Перемещает элемент из from в пустую ячейку to (не бросает, см. static_assert в начале класса)
+            void relocate(slot_type* to, slot_type* from) noexcept {
+                slot_policy::construct(this->alloc_, to, slot_policy::take(from));
+                slot_policy::destroy(this->alloc_, from);
+            }
+
+            /**
+             * @brief Сдвигает запомненные итераторы (см. insertManyUnique), указывающие
+             * на позиции [first, last) узла from: они переезжают в узел to со сдвигом shift
+             *
+             */
+            void moveTracked(const tree_node* from, int first, int last, tree_node* to, int shift) noexcept {
+                if (this->tracked_ != nullptr) {
+                    for (std::pair<iterator, bool>& item : *this->tracked_) {
+                        iterator& it = item.first;
+                        if (it.node_ == from && it.position_ >= first && it.position_ < last) {
+                            it.node_ = to;
+                            it.position_ += shift;
+                        }
+                    }
+                }
+            }
+
+            // Обходит два отсортированных диапазона как std::set_union и другие алгоритмы;
+            // из пары равных элементов в результат идет элемент из a
+            template<typename ItA, typename ItB, typename TakeA, typename TakeB>
+            void walkCombined(ItA a, ItA a_end, ItB b, ItB b_end, SetOperation op, TakeA take_a, TakeB take_b) const {
+                const bool keep_a = op != SetOperation::Intersection;
+                const bool keep_b = op == SetOperation::Union || op == SetOperation::SymmetricDifference;
+                const bool keep_equal = op == SetOperation::Union || op == SetOperation::Intersection;
+                while (a != a_end && b != b_end) {
+                    if (this->comparator_(*a, *b)) {
+                        if (keep_a) {
+                            take_a(*a);
+                        }
+                        ++a;
+                    } else if (this->comparator_(*b, *a)) {
+                        if (keep_b) {
+                            take_b(*b);
+                        }
+                        ++b;
+                    } else {
+                        if (keep_equal) {
+                            take_a(*a);
+                        }
+                        ++a;
+                        ++b;
+                    }
+                }
+                for (; keep_a && a != a_end; ++a) {
+                    take_a(*a);
+                }
+                for (; keep_b && b != b_end; ++b) {
+                    take_b(*b);
+                }
+            }
+
+            /**
+             * @brief Переносит элементы >= key в upper (см. split)
+             *
+             */
+            template<typename K>
+            void splitTo(const K& key, BTree& upper) {
+                if (this == &upper) {
+                    return;
+                }
+                // key может быть элементом this, поэтому сначала считаем, сколько переносить
+                size_type count = 0;
+                for (iterator it = this->lowerBoundPos(key); it != this->end(); ++it) {
+                    ++count;
+                }
+                upper.clear();
+                upper.comparator_ = this->comparator_;
+                for (; count > 0; --count) {
+                    iterator last = this->lastPos();
+                    upper.insertAt(upper.begin(), takeSlot(last));
+                    this->erase(last);
+                }
+            }
+
+            /**
+             * @brief Копирует все элементы other в пустое дерево this
+             *
+             */
+            void copyTreeFrom(const BTree& other) {
+                if (other.root_ != nullptr) {
+                    this->root_ = this->copySubtree(other.root_, nullptr);
+                    tree_node* node = this->root_;
+                    while (!node->leaf_) {
+                        node = node->child(0);
+                    }
+                    this->leftmost_ = node;
+                    node = this->root_;
+                    while (!node->leaf_) {
+                        node = node->child(node->count_);
+                    }
+                    this->rightmost_ = node;
+                    this->size_ = other.size_;
+                }
+                this->comparator_ = other.comparator_;
+            }
+
+            /**
+             * @brief Копирует поддерево source, копия получает родителя parent
+             * @details Рекурсия глубиной в высоту дерева, а она для B-дерева мала (десяток
+             * уровней на любом объеме памяти). Если копирование элемента бросит исключение,
+             * уже скопированная часть удаляется
+             *
+             */
+            tree_node* copySubtree(const tree_node* source, tree_node* parent) {
+                tree_node* node = this->createNode(parent, source->leaf_);
+                try {
+                    if (!source->leaf_) {
+                        node->setChild(0, this->copySubtree(source->child(0), node));
+                    }
+                    for (int i = 0; i < source->count_; ++i) {
+                        slot_policy::construct(this->alloc_, node->slot(i), slot_policy::element(source->slot(i)));
+                        ++node->count_;
+                        if (!source->leaf_) {
+                            node->setChild(i + 1, this->copySubtree(source->child(i + 1), node));
+                        }
+                    }
+                } catch (...) {
+                    this->destroySubtree(node);
+                    throw;
+                }
+                if constexpr (OrderStatistics) {
+                    node->subtree_size_ = source->subtree_size_;
+                }
+                return node;
+            }
+
+            // Уничтожает элементы поддерева и отдает память его узлов
+            void destroySubtree(tree_node* node) noexcept {
+                if (!node->leaf_) {
+                    for (int i = 0; i <= node->count_; ++i) {
+                        if (node->child(i) != nullptr) {
+                            this->destroySubtree(node->child(i));
+                        }
+                    }
+                }
+                for (int i = 0; i < node->count_; ++i) {
+                    slot_policy::destroy(this->alloc_, node->slot(i));
+                }
+                this->freeNode(node);
+            }
+
+            // Меняет местами только узлы деревьев (аллокаторы должны быть равны)
+            void swapNodes(BTree& other) noexcept {
+                std::swap(this->root_, other.root_);
+                std::swap(this->leftmost_, other.leftmost_);
+                std::swap(this->rightmost_, other.rightmost_);
+                std::swap(this->size_, other.size_);
+            }
+
+            // Меняет местами содержимое деревьев вместе с компараторами и аллокаторами
+            void swapTree(BTree& other) noexcept {
+                this->swapNodes(other);
+                std::swap(this->comparator_, other.comparator_);
+                std::swap(this->alloc_, other.alloc_);
+            }
+
+            // Выделяет пустой узел (лист или внутренний)
+            tree_node* createNode(tree_node* parent, bool leaf) {
+                if (leaf) {
+                    leaf_allocator alloc(this->alloc_);
+                    tree_node* node = leaf_traits::allocate(alloc, 1);
+                    leaf_traits::construct(alloc, node, parent, true);
+                    return node;
+                }
+                internal_allocator alloc(this->alloc_);
+                BTreeInternalNode* node = internal_traits::allocate(alloc, 1);
+                internal_traits::construct(alloc, node, parent);
+                return node;
+            }
+
+            // Отдает память узла, его элементы уже уничтожены или перемещены
+            void freeNode(tree_node* node) noexcept {
+                if (node->leaf_) {
+                    leaf_allocator alloc(this->alloc_);
+                    leaf_traits::destroy(alloc, node);
+                    leaf_traits::deallocate(alloc, node, 1);
+                } else {
+                    internal_allocator alloc(this->alloc_);
+                    BTreeInternalNode* internal = static_cast<BTreeInternalNode*>(node);
+                    internal_traits::destroy(alloc, internal);
+                    internal_traits::deallocate(alloc, internal, 1);
+                }
+            }
+
+            /*---------------------------------node----------------------------------*/
+
+            // Размер поддерева узла, хранится только при OrderStatistics == true
+            struct NodeSubtreeSize {
+                size_type subtree_size_ = 0;
+            };
+
+            // Пустая база: без OrderStatistics узел не растет
+            struct NodeNoSubtreeSize {};
+
+            /**
+             * @brief Узел дерева (он же лист): служебные поля и место под kNodeSlots элементов
+             * @details Элементы в storage_ создаются и уничтожаются деревом, узел о них не знает
+             *
+             */
+            class BTreeNode : public std::conditional_t<OrderStatistics, NodeSubtreeSize, NodeNoSubtreeSize> {
+                public:
+                    BTreeNode(BTreeNode* parent, bool leaf) : parent_(parent), position_(0), count_(0), leaf_(leaf) {}
+
+                    // Ячейка i - ее создает, переносит и уничтожает дерево
+                    slot_type* slot(int i) noexcept {
+                        return std::launder(reinterpret_cast<slot_type*>(this->storage_)) + i;
+                    }
+
+                    const slot_type* slot(int i) const noexcept {
+                        return std::launder(reinterpret_cast<const slot_type*>(this->storage_)) + i;
+                    }
+
+                    // Элемент i так, как его видят сравнение и итераторы (у map - с const ключом)
+                    Key* key(int i) noexcept {
+                        return &slot_policy::element(this->slot(i));
+                    }
+
+                    const Key* key(int i) const noexcept {
+                        return &slot_policy::element(this->slot(i));
+                    }
+
+                    // Ребенок i (только для внутреннего узла)
+                    BTreeNode* child(int i) const noexcept {
+                        return static_cast<const BTreeInternalNode*>(this)->children_[i];
+                    }
+
+                    // Делает node ребенком i (только для внутреннего узла)
+                    void setChild(int i, BTreeNode* node) noexcept {
+                        static_cast<BTreeInternalNode*>(this)->children_[i] = node;
+                        node->parent_ = this;
+                        node->position_ = static_cast<field_type>(i);
+                    }
+
+                    // родитель, у корня - nullptr
+                    BTreeNode* parent_;
+                    // номер узла среди детей родителя
+                    field_type position_;
+                    // количество элементов в узле
+                    field_type count_;
+                    bool leaf_;
+                    alignas(slot_type) unsigned char storage_[kNodeSlots * sizeof(slot_type)];
+            };
+
+            /**
+             * @brief Внутренний узел: узел и kNodeSlots + 1 указателей на детей
+             *
+             */
+            class BTreeInternalNode : public BTreeNode {
+                public:
+                    explicit BTreeInternalNode(BTreeNode* parent) : BTreeNode(parent, false), children_() {}
+
+                    BTreeNode* children_[kNodeSlots + 1];
+            };
+
+            /**
+             * @brief Переход к следующему элементу (node, position)
+             * @details В листе просто сдвигаемся, а с конца листа поднимаемся к родителю,
+             * пока не найдется элемент правее. Из внутреннего узла спускаемся в самый
+             * левый лист следующего ребенка. После последнего элемента остаемся
+             * в позиции end() - за последним элементом самого правого листа
+             *
+             */
+            template<typename Node>
+            static void increment(Node*& node, int& position) noexcept {
+                if (node->leaf_) {
+                    if (++position < node->count_) {
+                        return;
+                    }
+                    Node* last_node = node;
+                    int last_position = position;
+                    while (position == node->count_ && node->parent_ != nullptr) {
+                        position = node->position_;
+                        node = node->parent_;
+                    }
+                    if (position == node->count_) {
+                        node = last_node;
+                        position = last_position;
+                    }
+                } else {
+                    node = node->child(position + 1);
+                    while (!node->leaf_) {
+                        node = node->child(0);
+                    }
+                    position = 0;
+                }
+            }
+
+            // Переход к предыдущему элементу, зеркально increment
+            template<typename Node>
+            static void decrement(Node*& node, int& position) noexcept {
+                if (node->leaf_) {
+                    if (--position >= 0) {
+                        return;
+                    }
+                    Node* first_node = node;
+                    while (position < 0 && node->parent_ != nullptr) {
+                        position = node->position_ - 1;
+                        node = node->parent_;
+                    }
+                    if (position < 0) {
+                        node = first_node;
+                        position = 0;
+                    }
+                } else {
+                    node = node->child(position);
+                    while (!node->leaf_) {
+                        node = node->child(node->count_);
+                    }
+                    position = node->count_ - 1;
+                }
+            }
+
+            /*-----------------------iterator-----------------------------*/
+
+            /**
+             * @brief Итератор по элементам: узел и позиция в нем
+             *
+             */
+            class BTreeIterator {
+                friend BTree;
+                public:
+                    // Типы для std::iterator_traits, чтобы итератор работал со стандартными алгоритмами
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = Key;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = Key*;
+                    using reference = Key&;
+
+                    // Пустой итератор нам не нужен - удаляем конструктор по умолчанию
+                    BTreeIterator() = delete;
+
+                    reference operator*() const {
+                        return *this->node_->key(this->position_);
+                    }
+
+                    pointer operator->() const {
+                        return this->node_->key(this->position_);
+                    }
+
+                    iterator &operator++() noexcept {
+                        BTree::increment(this->node_, this->position_);
+                        return *this;
+                    }
+
+                    iterator operator++(int) noexcept {
+                        iterator temp(*this);
+                        ++(*this);
+                        return temp;
+                    }
+
+                    iterator &operator--() noexcept {
+                        BTree::decrement(this->node_, this->position_);
+                        return *this;
+                    }
+
+                    iterator operator--(int) noexcept {
+                        iterator temp(*this);
+                        --(*this);
+                        return temp;
+                    }
+
+                    bool operator==(const iterator& other) const noexcept {
+                        return this->node_ == other.node_ && this->position_ == other.position_;
+                    }
+
+                    bool operator!=(const iterator& other) const noexcept {
+                        return !(*this == other);
+                    }
+
+                private:
+                    BTreeIterator(tree_node* node, int position) : node_(node), position_(position) {}
+
+                    tree_node* node_;
+                    int position_;
+            };
+
+            /*--------------------------------------------------------------*/
+
+            /*------------------------const_iterator------------------------*/
+
+            /**
+             * @brief Итератор по элементам, через который элемент нельзя изменить
+             *
+             */
+            class BTreeConstIterator {
+                friend BTree;
+                // Как дружественные, почему так - смотрите в s21::list::const_iterator
+                friend bool operator==(const const_iterator& it1, const const_iterator& it2) noexcept {
+                    return it1.node_ == it2.node_ && it1.position_ == it2.position_;
+                }
+
+                friend bool operator!=(const const_iterator& it1, const const_iterator& it2) noexcept {
+                    return !(it1 == it2);
+                }
+                public:
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = Key;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const Key*;
+                    using reference = const Key&;
+
+                    // Пустой итератор нам не нужен - удаляем конструктор по умолчанию
+                    BTreeConstIterator() = delete;
+
+                    BTreeConstIterator(const iterator& other) : node_(other.node_), position_(other.position_) {}
+
+                    const_reference operator*() const noexcept {
+                        return *this->node_->key(this->position_);
+                    }
+
+                    pointer operator->() const noexcept {
+                        return this->node_->key(this->position_);
+                    }
+
+                    const_iterator& operator++() noexcept {
+                        BTree::increment(this->node_, this->position_);
+                        return *this;
+                    }
+
+                    const_iterator operator++(int) noexcept {
+                        const_iterator temp(*this);
+                        ++(*this);
+                        return temp;
+                    }
+
+                    const_iterator& operator--() noexcept {
+                        BTree::decrement(this->node_, this->position_);
+                        return *this;
+                    }
+
+                    const_iterator operator--(int) noexcept {
+                        const_iterator temp(*this);
+                        --(*this);
+                        return temp;
+                    }
+
+                private:
+                    BTreeConstIterator(const tree_node* node, int position) : node_(node), position_(position) {}
+
+                    const tree_node* node_;
+                    int position_;
+            };
+
+            /*---------------------------------------------------------------*/
+            // корень, у пустого дерева - nullptr
+            tree_node* root_;
+            // самый левый и самый правый листья (begin() и end())
+            tree_node* leftmost_;
+            tree_node* rightmost_;
+            // количество элементов в дереве
+            size_type size_;
+            // компоратор для сравнивания элементов
+            Comparator comparator_;
+            // аллокатор элементов, узлы берутся через его перепривязанные копии
+            value_allocator alloc_;
+            // итераторы, которые нужно сдвигать при переезде элементов (см. insertManyUnique)
+            std::vector<std::pair<iterator, bool>>* tracked_;
+    }; // BTree
+
+    /**
+     * @brief Политика дерева для map, set и multiset: B-дерево (см. BTree)
+     * @details Например s21::set<int, std::less<int>, std::allocator<int>, false, s21::BTreePolicy>.
+     * Красно-черное дерево по умолчанию - RedBlackTreePolicy из s21_tree.h
+     *
+     */
+    struct BTreePolicy {
+        template<typename Key, typename Comparator, typename Allocator, bool OrderStatistics>
+        using tree = BTree<Key, Comparator, Allocator, OrderStatistics>;
+    };
+} // s21
+
+#endif // SRC_S21_BTREE_H_
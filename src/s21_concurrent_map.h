@@ -0,0 +1,331 @@
+#ifndef SRC_S21_CONCURRENT_MAP_H_
+#define SRC_S21_CONCURRENT_MAP_H_
+#include "s21_map.h"
+#include "s21_concurrent_queue.h"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+    /**
+     * @brief Словарь для работы из многих потоков, разбитый на Shards независимых частей
+     * @details Каждая часть (шард) - обычный s21::map (то есть BinaryTree) со своим
+     * std::shared_mutex: чтения одной части идут параллельно, запись блокирует только ее.
+     * Часть для ключа выбирается по Hash(key), поэтому операции с разными ключами
+     * почти всегда попадают в разные части и не мешают друг другу.
+     * Шарды выровнены по кэш-линии, чтобы мьютексы соседних частей не делили одну линию.
+     * Итераторы наружу не отдаются - после снятия блокировки они могли бы стать
+     * недействительными, поэтому find возвращает копию значения, а обход идет через for_each_shard.
+     *
+     * @tparam Key - тип ключа
+     * @tparam T - тип значения
+     * @tparam Shards - количество частей
+     * @tparam Hash - хэш ключа для выбора части
+     * @tparam Compare - компаратор ключей внутри части
+     * @tparam Allocator - аллокатор пар ключ-значение
+     */
+    template<typename Key, typename T, std::size_t Shards = 16, typename Hash = std::hash<Key>,
+             typename Compare = std::less<Key>, typename Allocator = std::allocator<std::pair<const Key, T>>>
+    class concurrent_map {
+        static_assert(Shards > 0, "s21::concurrent_map: Shards must be positive");
+        public:
+            using key_type = Key;
+            using mapped_type = T;
+            using value_type = std::pair<const key_type, mapped_type>;
+            using size_type = std::size_t;
+            using shard_type = s21::map<Key, T, Compare, Allocator>;
+            using hasher = Hash;
+
+            /*------------------constructors and operators concurrent_map----------------------*/
+
+            /**
+             * @brief Создает пустой словарь
+             *
+             */
+            concurrent_map() = default;
+
+            /**
+             * @brief Создает словарь из пар items
+             *
+             * @param items
+             */
+            concurrent_map(std::initializer_list<value_type> const &items) {
+                for (const value_type& item : items) {
+                    this->insert(item);
+                }
+            }
+
+            // Мьютексы не копируются и не перемещаются
+            concurrent_map(const concurrent_map&) = delete;
+            concurrent_map& operator=(const concurrent_map&) = delete;
+
+            /*------------------------------------------------------------------------------*/
+
+            /*------------------------------methods concurrent_map---------------------------*/
+
+            /**
+             * @brief Количество частей
+             *
+             * @return size_type
+             */
+            static constexpr size_type shard_count() noexcept {
+                return Shards;
+            }
+
+            /**
+             * @brief Номер части, в которой лежит ключ key
+             *
+             * @param key
+             * @return size_type
+             */
+            size_type shard_of(const Key& key) const {
+                // Перемешиваем биты: std::hash для целых - тождественная функция
+                std::uint64_t h = static_cast<std::uint64_t>(this->hash_(key));
+                h ^= h >> 33;
+                h *= 0xff51afd7ed558ccdULL;
+                h ^= h >> 33;
+                return static_cast<size_type>(h % Shards);
+            }
+
+            /**
+             * @brief Количество элементов
+             * @details Части блокируются по очереди, поэтому при одновременных
+             * изменениях результат - сумма размеров частей в разные моменты
+             *
+             * @return size_type
+             */
+            size_type size() const {
+                size_type result = 0;
+                for (const Shard& shard : this->shards_) {
+                    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+                    result += shard.map_.size();
+                }
+                return result;
+            }
+
+            /**
+             * @brief Проверяет, пуст ли словарь (с той же оговоркой, что и size)
+             *
+             * @return true - если пустой
+             * @return false - если не пуст
+             */
+            bool empty() const {
+                for (const Shard& shard : this->shards_) {
+                    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+                    if (!shard.map_.empty()) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief Удаляет все элементы
+             *
+             */
+            void clear() {
+                for (Shard& shard : this->shards_) {
+                    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+                    shard.map_.clear();
+                }
+            }
+
+            /**
+             * @brief Возвращает копию значения по ключу
+             *
+             * @param key
+             * @return std::optional<mapped_type> - пусто, если ключа нет
+             */
+            std::optional<mapped_type> find(const Key& key) const {
+                const Shard& shard = this->shardFor(key);
+                std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+                auto it = shard.map_.find(key);
+                if (it == shard.map_.end()) {
+                    return std::nullopt;
+                }
+                return (*it).second;
+            }
+
+            /**
+             * @brief Проверяет, есть ли элемент с ключом key
+             *
+             * @param key
+             * @return true - есть элемент в контенере
+             * @return false - нет элемента в контейнере
+             */
+            bool contains(const Key& key) const {
+                const Shard& shard = this->shardFor(key);
+                std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+                return shard.map_.contains(key);
+            }
+
+            /**
+             * @brief Вставляет пару, если такого ключа еще нет
+             *
+             * @param value
+             * @return true - вставка была
+             * @return false - ключ уже есть, значение не изменено
+             */
+            bool insert(const value_type& value) {
+                Shard& shard = this->shardFor(value.first);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+                return shard.map_.insert(value).second;
+            }
+
+            /**
+             * @brief Вставляет значение по ключу, если такого ключа еще нет
+             *
+             * @param key
+             * @param obj
+             * @return true - вставка была
+             * @return false - ключ уже есть, значение не изменено
+             */
+            bool insert(const Key& key, const mapped_type& obj) {
+                Shard& shard = this->shardFor(key);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+                return shard.map_.try_emplace(key, obj).second;
+            }
+
+            /**
+             * @brief Вставляет значение или присваивает его, если ключ уже есть
+             *
+             * @param key
+             * @param obj
+             * @return true - вставка была
+             * @return false - было присваивание
+             */
+            bool insert_or_assign(const Key& key, const mapped_type& obj) {
+                Shard& shard = this->shardFor(key);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+                return shard.map_.insert_or_assign(key, obj).second;
+            }
+
+            /**
+             * @brief Удаляет элемент с ключом key
+             *
+             * @param key
+             * @return size_type - сколько элементов удалено (0 или 1)
+             */
+            size_type erase(const Key& key) {
+                Shard& shard = this->shardFor(key);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+                auto it = shard.map_.find(key);
+                if (it == shard.map_.end()) {
+                    return 0;
+                }
+                shard.map_.erase(it);
+                return 1;
+            }
+
+            /**
+             * @brief Атомарно изменяет значение по ключу
+             * @details fn(mapped_type&) вызывается под блокировкой части на запись,
+             * поэтому чтение-изменение-запись значения не пересекается с другими операциями
+             * с этим ключом. Внутри fn нельзя обращаться к этому же словарю
+             *
+             * @tparam Fn
+             * @param key
+             * @param fn
+             * @return true - ключ найден, fn вызвана
+             * @return false - ключа нет
+             */
+            template<typename Fn>
+            bool update(const Key& key, Fn&& fn) {
+                Shard& shard = this->shardFor(key);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+                auto it = shard.map_.find(key);
+                if (it == shard.map_.end()) {
+                    return false;
+                }
+                fn((*it).second);
+                return true;
+            }
+
+            /**
+             * @brief Обходит все части, каждую под блокировкой на чтение
+             * @details fn(size_type index, const shard_type& shard) вызывается для каждой части.
+             * При threads > 1 части раздаются threads потокам (текущий поток - один из них),
+             * и fn вызывается параллельно для разных частей - она должна быть потокобезопасной.
+             * Исключение из fn пробрасывается наружу после завершения всех потоков.
+             * Внутри fn нельзя изменять этот же словарь
+             *
+             * @tparam Fn
+             * @param fn
+             * @param threads - количество потоков
+             */
+            template<typename Fn>
+            void for_each_shard(Fn&& fn, size_type threads = 1) const {
+                if (threads > Shards) {
+                    threads = Shards;
+                }
+                std::atomic<size_type> next{0};
+                std::exception_ptr error;
+                std::mutex error_mutex;
+                auto worker = [this, &fn, &next, &error, &error_mutex] {
+                    for (size_type i = next++; i < Shards; i = next++) {
+                        try {
+                            std::shared_lock<std::shared_mutex> lock(this->shards_[i].mutex_);
+                            fn(i, static_cast<const shard_type&>(this->shards_[i].map_));
+                        } catch (...) {
+                            std::lock_guard<std::mutex> guard(error_mutex);
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                    }
+                };
+                std::vector<std::thread> pool;
+                // Место под все потоки заранее: если бы вектор рос, когда часть потоков уже
+                // запущена, bad_alloc уничтожил бы их неприсоединенными (std::terminate)
+                if (threads > 1) {
+                    pool.reserve(threads - 1);
+                }
+                for (size_type t = 1; t < threads; ++t) {
+                    try {
+                        pool.emplace_back(worker);
+                    } catch (const std::system_error&) {
+                        // Поток не создался - оставшиеся части разберут уже запущенные
+                        break;
+                    }
+                }
+                worker();
+                for (std::thread& thread : pool) {
+                    thread.join();
+                }
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+
+            /*------------------------------------------------------------------------------*/
+
+        private:
+            // Часть словаря: свой мьютекс и свое дерево
+            struct alignas(kCacheLineSize) Shard {
+                mutable std::shared_mutex mutex_;
+                shard_type map_;
+            };
+
+            Shard& shardFor(const Key& key) {
+                return this->shards_[this->shard_of(key)];
+            }
+
+            const Shard& shardFor(const Key& key) const {
+                return this->shards_[this->shard_of(key)];
+            }
+
+            Hash hash_;
+            Shard shards_[Shards];
+    }; // concurrent_map
+} // s21
+
+#endif // SRC_S21_CONCURRENT_MAP_H_
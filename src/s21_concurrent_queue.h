@@ -0,0 +1,569 @@
+#ifndef SRC_S21_CONCURRENT_QUEUE_H_
+#define SRC_S21_CONCURRENT_QUEUE_H_
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+    // Размер кэш-линии, по которому разносятся индексы, изменяемые разными потоками
+    constexpr std::size_t kCacheLineSize = 64;
+
+    /**
+     * @brief Ограниченная очередь без блокировок для одного писателя и одного читателя
+     * @details Кольцевой буфер на N ячеек внутри объекта, как у s21::array.
+     * tail_ двигает только писатель, head_ - только читатель, индексы растут монотонно,
+     * ячейка = индекс & (N - 1). Каждый индекс лежит в своей кэш-линии вместе с копией
+     * чужого индекса, которую поток перечитывает, только когда по копии места (или элементов) не хватает.
+     * Поэтому в обычном случае try_push и try_pop не трогают кэш-линию другого потока.
+     * try_push вызывает только поток-писатель, try_pop - только поток-читатель.
+     *
+     * @tparam T
+     * @tparam N - количество ячеек, степень двойки
+     */
+    template<typename T, std::size_t N>
+    class spsc_queue {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "s21::spsc_queue: N must be a power of two");
+        public:
+            using value_type = T;
+            using reference = T&;
+            using const_reference = const T&;
+            using size_type = std::size_t;
+
+            /*--------------------constructors and operators spsc_queue--------------------*/
+
+            /**
+             * @brief Создает пустую очередь
+             *
+             */
+            spsc_queue() noexcept : head_(0), cachedTail_(0), tail_(0), cachedHead_(0) {}
+
+            // Атомарные индексы не копируются и не перемещаются
+            spsc_queue(const spsc_queue&) = delete;
+            spsc_queue& operator=(const spsc_queue&) = delete;
+
+            /**
+             * @brief Деструктор уничтожает оставшиеся элементы
+             * @details Вызывается, когда оба потока уже закончили работу с очередью
+             *
+             */
+            ~spsc_queue() {
+                size_type tail = this->tail_.load(std::memory_order_relaxed);
+                for (size_type head = this->head_.load(std::memory_order_relaxed); head != tail; ++head) {
+                    this->slot(head)->~T();
+                }
+            }
+
+            /*------------------------------------------------------------------------------*/
+
+            /*-----------------------------methods spsc_queue-------------------------------*/
+
+            /**
+             * @brief Вместимость очереди
+             *
+             * @return size_type
+             */
+            static constexpr size_type capacity() noexcept {
+                return N;
+            }
+
+            /**
+             * @brief Количество элементов
+             * @details Пока другие потоки работают с очередью, значение приблизительное
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                size_type head = this->head_.load(std::memory_order_acquire);
+                size_type tail = this->tail_.load(std::memory_order_acquire);
+                return tail - head;
+            }
+
+            /**
+             * @brief Проверяет, пуста ли очередь (с той же оговоркой, что и size)
+             *
+             * @return true - если пустая
+             * @return false - если не пуста
+             */
+            bool empty() const noexcept {
+                return this->size() == 0;
+            }
+
+            /**
+             * @brief Добавляет элемент в конец, если есть место
+             *
+             * @param value
+             * @return true - элемент добавлен
+             * @return false - очередь заполнена
+             */
+            bool try_push(const_reference value) {
+                return this->try_emplace(value);
+            }
+
+            /**
+             * @brief Добавляет элемент в конец перемещением, если есть место
+             *
+             * @param value
+             * @return true - элемент добавлен
+             * @return false - очередь заполнена, value не тронут
+             */
+            bool try_push(value_type&& value) {
+                return this->try_emplace(std::move(value));
+            }
+
+            /**
+             * @brief Создает элемент из args прямо в ячейке очереди, если есть место
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return true - элемент добавлен
+             * @return false - очередь заполнена
+             */
+            template<typename... Args>
+            bool try_emplace(Args&&... args) {
+                size_type tail = this->tail_.load(std::memory_order_relaxed);
+                if (this->freeSlots(tail, 1) == 0) {
+                    return false;
+                }
+                ::new (static_cast<void*>(this->slot(tail))) T(std::forward<Args>(args)...);
+                this->tail_.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Забирает первый элемент, если он есть
+             *
+             * @param value - сюда перемещается элемент
+             * @return true - элемент забран
+             * @return false - очередь пуста
+             */
+            bool try_pop(reference value) {
+                size_type head = this->head_.load(std::memory_order_relaxed);
+                if (this->readySlots(head, 1) == 0) {
+                    return false;
+                }
+                T* item = this->slot(head);
+                value = std::move(*item);
+                item->~T();
+                this->head_.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Добавляет до n элементов из first за одну публикацию
+             * @details tail_ сдвигается один раз на все добавленные элементы
+             *
+             * @tparam InputIt
+             * @param first
+             * @param n
+             * @return size_type - сколько элементов добавлено (меньше n, если место кончилось)
+             */
+            template<typename InputIt>
+            size_type push_n(InputIt first, size_type n) {
+                size_type tail = this->tail_.load(std::memory_order_relaxed);
+                size_type free = this->freeSlots(tail, n);
+                if (n > free) {
+                    n = free;
+                }
+                size_type i = 0;
+                try {
+                    for (; i < n; ++i, ++first) {
+                        ::new (static_cast<void*>(this->slot(tail + i))) T(*first);
+                    }
+                } catch (...) {
+                    // Уже созданные элементы публикуем, они корректны
+                    this->tail_.store(tail + i, std::memory_order_release);
+                    throw;
+                }
+                this->tail_.store(tail + n, std::memory_order_release);
+                return n;
+            }
+
+            /**
+             * @brief Забирает до n элементов в out за одну публикацию
+             * @details head_ сдвигается один раз на все забранные элементы
+             *
+             * @tparam OutputIt
+             * @param out
+             * @param n
+             * @return size_type - сколько элементов забрано
+             */
+            template<typename OutputIt>
+            size_type pop_n(OutputIt out, size_type n) {
+                size_type head = this->head_.load(std::memory_order_relaxed);
+                size_type ready = this->readySlots(head, n);
+                if (n > ready) {
+                    n = ready;
+                }
+                size_type i = 0;
+                try {
+                    for (; i < n; ++i, ++out) {
+                        T* item = this->slot(head + i);
+                        *out = std::move(*item);
+                        item->~T();
+                    }
+                } catch (...) {
+                    // Уже забранные элементы уничтожены, их ячейки отдаем писателю
+                    this->head_.store(head + i, std::memory_order_release);
+                    throw;
+                }
+                this->head_.store(head + n, std::memory_order_release);
+                return n;
+            }
+
+            /*------------------------------------------------------------------------------*/
+
+        private:
+            // Ячейка под один элемент, объект в ней живет только между push и pop
+            struct Slot {
+                alignas(T) unsigned char data_[sizeof(T)];
+            };
+
+            T* slot(size_type index) noexcept {
+                return std::launder(reinterpret_cast<T*>(this->buffer_[index & (N - 1)].data_));
+            }
+
+            // Свободные ячейки для писателя, head_ перечитывается только если по копии их меньше wanted
+            size_type freeSlots(size_type tail, size_type wanted) noexcept {
+                if (N - (tail - this->cachedHead_) < wanted) {
+                    this->cachedHead_ = this->head_.load(std::memory_order_acquire);
+                }
+                return N - (tail - this->cachedHead_);
+            }
+
+            // Готовые элементы для читателя, tail_ перечитывается только если по копии их меньше wanted
+            size_type readySlots(size_type head, size_type wanted) noexcept {
+                if (this->cachedTail_ - head < wanted) {
+                    this->cachedTail_ = this->tail_.load(std::memory_order_acquire);
+                }
+                return this->cachedTail_ - head;
+            }
+
+            // Линия читателя: его индекс и копия индекса писателя
+            alignas(kCacheLineSize) std::atomic<size_type> head_;
+            size_type cachedTail_;
+            // Линия писателя: его индекс и копия индекса читателя
+            alignas(kCacheLineSize) std::atomic<size_type> tail_;
+            size_type cachedHead_;
+            alignas(kCacheLineSize) Slot buffer_[N];
+    }; // spsc_queue
+
+    /**
+     * @brief Ограниченная очередь без блокировок для многих писателей и читателей
+     * @details Кольцо ячеек (алгоритм Д. Вьюкова). У каждой ячейки есть номер sequence_:
+     * sequence_ == pos - ячейка свободна для записи с индексом pos,
+     * sequence_ == pos + 1 - в ней лежит элемент, записанный с индексом pos.
+     * Писатель занимает индекс сдвигом tail_ через compare_exchange, пишет элемент и
+     * публикует его записью sequence_. Читатель так же с head_, а после чтения
+     * освобождает ячейку для следующего круга: sequence_ = pos + capacity.
+     * head_ и tail_ лежат в разных кэш-линиях. Вместимость задается в конструкторе
+     * и округляется вверх до степени двойки, память берется у аллокатора один раз.
+     * Занятую ячейку уже ждут другие потоки, поэтому после compare_exchange не должно
+     * быть ничего, что бросает: элемент создается заранее и только перемещается в ячейку,
+     * а перемещение T (конструктор и присваивание) обязано быть noexcept.
+     *
+     * @tparam T
+     * @tparam Allocator - аллокатор элементов
+     */
+    template<typename T, typename Allocator = std::allocator<T>>
+    class mpmc_queue {
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "s21::mpmc_queue: T must be nothrow move constructible");
+        static_assert(std::is_nothrow_move_assignable<T>::value,
+                      "s21::mpmc_queue: T must be nothrow move assignable");
+        struct Cell;
+        using cell_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Cell>;
+        using cell_traits = std::allocator_traits<cell_allocator>;
+        public:
+            using value_type = T;
+            using allocator_type = Allocator;
+            using reference = T&;
+            using const_reference = const T&;
+            using size_type = std::size_t;
+
+            /*--------------------constructors and operators mpmc_queue--------------------*/
+
+            /**
+             * @brief Создает пустую очередь не меньше чем на capacity элементов
+             *
+             * @param capacity
+             * @param alloc
+             */
+            explicit mpmc_queue(size_type capacity, const Allocator& alloc = Allocator())
+                : alloc_(alloc), mask_(roundCapacity(capacity) - 1), head_(0), tail_(0) {
+                this->cells_ = cell_traits::allocate(this->alloc_, this->mask_ + 1);
+                for (size_type i = 0; i <= this->mask_; ++i) {
+                    cell_traits::construct(this->alloc_, this->cells_ + i, i);
+                }
+            }
+
+            // Атомарные индексы не копируются и не перемещаются
+            mpmc_queue(const mpmc_queue&) = delete;
+            mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+            /**
+             * @brief Деструктор уничтожает оставшиеся элементы и возвращает память
+             * @details Вызывается, когда все потоки уже закончили работу с очередью
+             *
+             */
+            ~mpmc_queue() {
+                size_type tail = this->tail_.load(std::memory_order_relaxed);
+                for (size_type head = this->head_.load(std::memory_order_relaxed); head != tail; ++head) {
+                    this->cells_[head & this->mask_].item()->~T();
+                }
+                for (size_type i = 0; i <= this->mask_; ++i) {
+                    cell_traits::destroy(this->alloc_, this->cells_ + i);
+                }
+                cell_traits::deallocate(this->alloc_, this->cells_, this->mask_ + 1);
+            }
+
+            /*------------------------------------------------------------------------------*/
+
+            /*-----------------------------methods mpmc_queue-------------------------------*/
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return allocator_type(this->alloc_);
+            }
+
+            /**
+             * @brief Вместимость очереди (степень двойки)
+             *
+             * @return size_type
+             */
+            size_type capacity() const noexcept {
+                return this->mask_ + 1;
+            }
+
+            /**
+             * @brief Количество элементов
+             * @details Пока другие потоки работают с очередью, значение приблизительное.
+             * Учитываются и занятые ячейки, элемент в которых еще пишется или читается
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                size_type head = this->head_.load(std::memory_order_acquire);
+                size_type tail = this->tail_.load(std::memory_order_acquire);
+                return (tail > head) ? tail - head : 0;
+            }
+
+            /**
+             * @brief Проверяет, пуста ли очередь (с той же оговоркой, что и size)
+             *
+             * @return true - если пустая
+             * @return false - если не пуста
+             */
+            bool empty() const noexcept {
+                return this->size() == 0;
+            }
+
+            /**
+             * @brief Добавляет элемент в конец, если есть место
+             *
+             * @param value
+             * @return true - элемент добавлен
+             * @return false - очередь заполнена
+             */
+            bool try_push(const_reference value) {
+                return this->try_emplace(value);
+            }
+
+            /**
+             * @brief Добавляет элемент в конец перемещением, если есть место
+             *
+             * @param value
+             * @return true - элемент добавлен
+             * @return false - очередь заполнена, value не тронут
+             */
+            bool try_push(value_type&& value) {
+                return this->try_emplace(std::move(value));
+            }
+
+            /**
+             * @brief Создает элемент из args в ячейке очереди, если есть место
+             * @details Если конструктор элемента не бросает, элемент создается прямо в ячейке.
+             * Иначе он создается во временном объекте до того, как занята ячейка (ее сразу
+             * ждут читатели), и в ячейку только перемещается. В этом случае args расходуются,
+             * даже если очередь окажется заполненной
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return true - элемент добавлен
+             * @return false - очередь заполнена
+             */
+            template<typename... Args>
+            bool try_emplace(Args&&... args) {
+                if constexpr (std::is_nothrow_constructible<T, Args&&...>::value) {
+                    return this->produce([&](void* data) noexcept {
+                        ::new (data) T(std::forward<Args>(args)...);
+                    });
+                } else {
+                    T value(std::forward<Args>(args)...);
+                    return this->produce([&value](void* data) noexcept {
+                        ::new (data) T(std::move(value));
+                    });
+                }
+            }
+
+            /**
+             * @brief Забирает первый элемент, если он есть
+             *
+             * @param value - сюда перемещается элемент
+             * @return true - элемент забран
+             * @return false - очередь пуста
+             */
+            bool try_pop(reference value) {
+                return this->consume([&value](T& item) { value = std::move(item); });
+            }
+
+            /**
+             * @brief Добавляет до n элементов из first
+             * @details Каждый элемент занимает свою ячейку отдельно, поэтому элементы
+             * одной пачки могут перемежаться с элементами других писателей
+             *
+             * @tparam InputIt
+             * @param first
+             * @param n
+             * @return size_type - сколько элементов добавлено (меньше n, если место кончилось)
+             */
+            template<typename InputIt>
+            size_type push_n(InputIt first, size_type n) {
+                size_type i = 0;
+                for (; i < n && this->try_push(*first); ++i, ++first) {}
+                return i;
+            }
+
+            /**
+             * @brief Забирает до n элементов в out
+             * @details Каждый элемент забирается отдельно, как в try_pop. Если запись в out
+             * бросит исключение, ячейка все равно освобождается, а ее элемент теряется
+             *
+             * @tparam OutputIt
+             * @param out
+             * @param n
+             * @return size_type - сколько элементов забрано (меньше n, если очередь опустела)
+             */
+            template<typename OutputIt>
+            size_type pop_n(OutputIt out, size_type n) {
+                size_type i = 0;
+                for (; i < n && this->consume([&out](T& item) { *out = std::move(item); }); ++i, ++out) {}
+                return i;
+            }
+
+            /*------------------------------------------------------------------------------*/
+
+        private:
+            // Ячейка кольца: номер круга и место под элемент
+            struct Cell {
+                explicit Cell(size_type sequence) : sequence_(sequence) {}
+
+                T* item() noexcept {
+                    return std::launder(reinterpret_cast<T*>(this->data_));
+                }
+
+                std::atomic<size_type> sequence_;
+                alignas(T) unsigned char data_[sizeof(T)];
+            };
+
+            /**
+             * @brief Занимает первую свободную ячейку, создает в ней элемент через init
+             * и публикует его читателям
+             * @details init не бросает (см. try_emplace): занятая ячейка без элемента
+             * остановила бы всех читателей на ней
+             *
+             * @return true - элемент добавлен
+             * @return false - очередь заполнена
+             */
+            template<typename Init>
+            bool produce(Init&& init) noexcept {
+                size_type pos = this->tail_.load(std::memory_order_relaxed);
+                Cell* cell = nullptr;
+                for (;;) {
+                    cell = &this->cells_[pos & this->mask_];
+                    size_type seq = cell->sequence_.load(std::memory_order_acquire);
+                    std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - pos);
+                    if (diff == 0) {
+                        if (this->tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (diff < 0) {
+                        // Ячейку еще не освободили с прошлого круга - очередь заполнена
+                        return false;
+                    } else {
+                        pos = this->tail_.load(std::memory_order_relaxed);
+                    }
+                }
+                init(static_cast<void*>(cell->data_));
+                cell->sequence_.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Занимает первую заполненную ячейку, отдает ее элемент в take
+             * и освобождает ячейку для следующего круга
+             * @details Ячейка освобождается и тогда, когда take бросает исключение
+             * (например, запись в итератор pop_n): иначе писатели ждали бы ее вечно
+             *
+             * @return true - элемент забран
+             * @return false - очередь пуста
+             */
+            template<typename Take>
+            bool consume(Take&& take) {
+                size_type pos = this->head_.load(std::memory_order_relaxed);
+                Cell* cell = nullptr;
+                for (;;) {
+                    cell = &this->cells_[pos & this->mask_];
+                    size_type seq = cell->sequence_.load(std::memory_order_acquire);
+                    std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+                    if (diff == 0) {
+                        if (this->head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (diff < 0) {
+                        // Элемент в ячейку еще не записан - очередь пуста
+                        return false;
+                    } else {
+                        pos = this->head_.load(std::memory_order_relaxed);
+                    }
+                }
+                // Уничтожает элемент и освобождает ячейку при любом выходе из take
+                struct Release {
+                    ~Release() {
+                        this->cell_->item()->~T();
+                        this->cell_->sequence_.store(this->sequence_, std::memory_order_release);
+                    }
+
+                    Cell* cell_;
+                    size_type sequence_;
+                } release{cell, pos + this->mask_ + 1};
+                take(*cell->item());
+                return true;
+            }
+
+            // Ближайшая степень двойки, не меньше capacity и не меньше 2
+            static size_type roundCapacity(size_type capacity) noexcept {
+                size_type result = 2;
+                while (result < capacity) {
+                    result <<= 1;
+                }
+                return result;
+            }
+
+            cell_allocator alloc_;
+            Cell* cells_;
+            // Вместимость - 1, для индекса ячейки pos & mask_
+            size_type mask_;
+            alignas(kCacheLineSize) std::atomic<size_type> head_;
+            // Из-за alignas размер очереди кратен кэш-линии, так что tail_ ни с чем ее не делит
+            alignas(kCacheLineSize) std::atomic<size_type> tail_;
+    }; // mpmc_queue
+} // s21
+
+#endif // SRC_S21_CONCURRENT_QUEUE_H_
@@ -2,6 +2,16 @@
 #define SRC_S21_CONTAINETSPLUS_H_
 
 #include "s21_array.h"
+#include "s21_concurrent_map.h"
+#include "s21_concurrent_queue.h"
+#include "s21_deque.h"
+#include "s21_flat_map.h"
+#include "s21_flat_set.h"
 #include "s21_multiset.h"
+#include "s21_ring_buffer.h"
+#include "s21_small_vector.h"
+#include "s21_static_vector.h"
+#include "s21_unordered_map.h"
+#include "s21_unordered_set.h"
 
 #endif // SRC_S21_CONTAINETSPLUS_H_
\ No newline at end of file
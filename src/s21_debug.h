@@ -0,0 +1,37 @@
+#ifndef SRC_S21_DEBUG_H_
+#define SRC_S21_DEBUG_H_
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief Проверки контейнеров в отладочной сборке
+ * @details По умолчанию operator[] у vector и array границы не проверяет - как и в std,
+ * за корректный индекс отвечает вызывающий (проверку с исключением дает at()).
+ * Если собрать с -DS21_CONTAINERS_DEBUG, S21_DEBUG_ASSERT проверяет условие и при
+ * нарушении печатает сообщение и завершает программу через std::abort(). Исключение
+ * не бросается, так что поведение кода, который ловит out_of_range от at(), не меняется.
+ * Работает независимо от NDEBUG.
+ */
+#ifdef S21_CONTAINERS_DEBUG
+#define S21_DEBUG_ASSERT(cond, msg) \
+    ((cond) ? static_cast<void>(0) : ::s21::debugAssertFail(#cond, msg, __FILE__, __LINE__))
+#else
+#define S21_DEBUG_ASSERT(cond, msg) static_cast<void>(0)
+#endif
+
+namespace s21 {
+    /**
+     * @brief Печатает проваленную проверку и аварийно завершает программу
+     *
+     * @param cond - текст условия
+     * @param msg - сообщение контейнера
+     * @param file
+     * @param line
+     */
+    [[noreturn]] inline void debugAssertFail(const char* cond, const char* msg, const char* file, int line) noexcept {
+        std::fprintf(stderr, "%s:%d: %s: assertion `%s` failed\n", file, line, msg, cond);
+        std::abort();
+    }
+}
+
+#endif // SRC_S21_DEBUG_H_
@@ -0,0 +1,732 @@
+#ifndef SRC_S21_DEQUE_H_
+#define SRC_S21_DEQUE_H_
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "s21_debug.h"
+
+namespace s21 {
+    /**
+     * @brief Класс deque - двусторонняя очередь из блоков
+     * @details Элементы хранятся в блоках по kBlockSize штук, указатели на блоки лежат в
+     * массиве map_. Все ячейки блоков образуют одно кольцо из capacity() ячеек:
+     * элемент i лежит в ячейке (start_ + i) % capacity(). Вставка и удаление с обоих концов
+     * работают за O(1) и не трогают остальные элементы.
+     * Блоки выделяются при первой записи в них и не освобождаются при удалении элементов,
+     * поэтому очередь постоянной длины после разогрева работает без обращений к аллокатору.
+     * Вернуть пустые блоки можно через shrink_to_fit().
+     * Когда кольцо почти заполнено, map_ увеличивается в два раза, а сами блоки
+     * и элементы в них остаются на месте - переносятся только указатели на блоки.
+     *
+     * @tparam T
+     * @tparam Allocator - аллокатор элементов
+     */
+    template<typename T, typename Allocator = std::allocator<T>>
+    class deque {
+        class DequeIterator;
+        class DequeConstIterator;
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using map_allocator = typename alloc_traits::template rebind_alloc<T*>;
+        using map_traits = std::allocator_traits<map_allocator>;
+        public:
+            using value_type = T;
+            using allocator_type = Allocator;
+            using reference = T&;
+            using const_reference = const T&;
+            using size_type = std::size_t;
+            using iterator = DequeIterator;
+            using const_iterator = DequeConstIterator;
+
+            // Количество элементов в блоке: блок около 512 байт, но не меньше 16 элементов
+            static constexpr size_type kBlockSize = (512 / sizeof(T) > 16) ? 512 / sizeof(T) : 16;
+
+            /*--------------------constructors and operators deque--------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустую очередь без памяти
+             *
+             */
+            deque() : deque(Allocator()) {}
+
+            /**
+             * @brief Создает пустую очередь с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit deque(const Allocator& alloc) : alloc_(alloc) {
+                this->map_ = nullptr;
+                this->map_size_ = 0;
+                this->start_ = 0;
+                this->size_ = 0;
+            }
+
+            /**
+             * @brief Создает очередь из n элементов с инициализацией по умолчанию
+             *
+             * @param n
+             */
+            explicit deque(size_type n, const Allocator& alloc = Allocator()) : deque(alloc) {
+                for (; n > 0; --n) {
+                    this->emplace_back();
+                }
+            }
+
+            /**
+             * @brief Конструктор списка инициализаторов
+             *
+             * @param items
+             */
+            deque(std::initializer_list<value_type> const &items, const Allocator& alloc = Allocator())
+                : deque(alloc) {
+                for (const_reference item : items) {
+                    this->push_back(item);
+                }
+            }
+
+            /**
+             * @brief Конструктор копирования
+             * @details Аллокатор для копии выбирает сам аллокатор (select_on_container_copy_construction)
+             *
+             * @param other
+             */
+            deque(const deque& other) : deque(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+                for (size_type i = 0; i < other.size_; ++i) {
+                    this->push_back(other[i]);
+                }
+            }
+
+            /**
+             * @brief Конструктор перемещения, забирает блоки other
+             *
+             * @param other
+             */
+            deque(deque&& other) noexcept : deque(other.alloc_) {
+                this->swapStorage(other);
+            }
+
+            /**
+             * @brief Деструктор
+             *
+             */
+            ~deque() {
+                this->freeStorage();
+            }
+
+            /**
+             * @brief Оператор присваивания копированием
+             * @details Блоки this переиспользуются, если аллокатор не переезжает из other
+             *
+             * @param other
+             * @return deque&
+             */
+            deque& operator=(const deque& other) {
+                if (this != &other) {
+                    if (alloc_traits::propagate_on_container_copy_assignment::value && this->alloc_ != other.alloc_) {
+                        this->freeStorage();
+                    }
+                    if (alloc_traits::propagate_on_container_copy_assignment::value) {
+                        this->alloc_ = other.alloc_;
+                    }
+                    this->clear();
+                    for (size_type i = 0; i < other.size_; ++i) {
+                        this->push_back(other[i]);
+                    }
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Оператор присваивания перемещением
+             * @details Если аллокаторы не равны и аллокатор не переезжает вместе
+             * с содержимым, забрать чужие блоки нельзя - перемещаем элементы по одному
+             *
+             * @param other
+             * @return deque&
+             */
+            deque& operator=(deque&& other) {
+                if (this != &other) {
+                    if (alloc_traits::propagate_on_container_move_assignment::value || this->alloc_ == other.alloc_) {
+                        this->freeStorage();
+                        if (alloc_traits::propagate_on_container_move_assignment::value) {
+                            this->alloc_ = std::move(other.alloc_);
+                        }
+                        this->swapStorage(other);
+                    } else {
+                        this->clear();
+                        for (size_type i = 0; i < other.size_; ++i) {
+                            this->emplace_back(std::move(other[i]));
+                        }
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+
+            /*------------------------------------------------------------------------*/
+
+            /*-----------------------------methods deque------------------------------*/
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->alloc_;
+            }
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             *
+             * @param pos
+             * @return reference
+             */
+            reference at(size_type pos) {
+                if (pos >= this->size_)
+                    throw std::out_of_range("s21::deque::at: The index is out of range");
+
+                return (*this)[pos];
+            }
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             * @details Для конст объекта
+             *
+             * @param pos
+             * @return const_reference
+             */
+            const_reference at(size_type pos) const {
+                if (pos >= this->size_)
+                    throw std::out_of_range("s21::deque::at: The index is out of range");
+
+                return (*this)[pos];
+            }
+
+            /**
+             * @brief Доступ к указанному элементу без проверки границ
+             *
+             * @param pos
+             * @return reference
+             */
+            reference operator[](size_type pos) noexcept {
+                return *this->slot(this->start_ + pos);
+            }
+
+            /**
+             * @brief Доступ к указанному элементу без проверки границ
+             * @details Для конст объекта
+             *
+             * @param pos
+             * @return const_reference
+             */
+            const_reference operator[](size_type pos) const noexcept {
+                return *this->slot(this->start_ + pos);
+            }
+
+            /**
+             * @brief Доступ к первому элементу
+             * @details Контейнер не должен быть пустым, проверка только в сборке
+             * с S21_CONTAINERS_DEBUG (см. s21_debug.h)
+             *
+             * @return reference
+             */
+            reference front() noexcept {
+                S21_DEBUG_ASSERT(this->size_ != 0, "s21::deque::front: Using methods on a zero sized container");
+                return (*this)[0];
+            }
+
+            /**
+             * @brief Доступ к первому элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            const_reference front() const noexcept {
+                S21_DEBUG_ASSERT(this->size_ != 0, "s21::deque::front: Using methods on a zero sized container");
+                return (*this)[0];
+            }
+
+            /**
+             * @brief Доступ к последнему элементу
+             * @details Контейнер не должен быть пустым, проверка только в сборке
+             * с S21_CONTAINERS_DEBUG (см. s21_debug.h)
+             *
+             * @return reference
+             */
+            reference back() noexcept {
+                S21_DEBUG_ASSERT(this->size_ != 0, "s21::deque::back: Using methods on a zero sized container");
+                return (*this)[this->size_ - 1];
+            }
+
+            /**
+             * @brief Доступ к последнему элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            const_reference back() const noexcept {
+                S21_DEBUG_ASSERT(this->size_ != 0, "s21::deque::back: Using methods on a zero sized container");
+                return (*this)[this->size_ - 1];
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             *
+             * @return iterator
+             */
+            iterator begin() noexcept {
+                return iterator(this, 0);
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator begin() const noexcept {
+                return const_iterator(this, 0);
+            }
+
+            /**
+             * @brief Возвращает итератор на элемент после последнего
+             *
+             * @return iterator
+             */
+            iterator end() noexcept {
+                return iterator(this, this->size_);
+            }
+
+            /**
+             * @brief Возвращает итератор на элемент после последнего
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator end() const noexcept {
+                return const_iterator(this, this->size_);
+            }
+
+            /**
+             * @brief Проверяет, пуст ли контейнер
+             *
+             * @return true - если пустой
+             * @return false - если не пуст
+             */
+            bool empty() const noexcept {
+                return this->size_ == 0;
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                return this->size_;
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             * @details Как и в s21::list: половина адресного пространства, деленная на размер элемента
+             *
+             * @return size_type
+             */
+            size_type max_size() const noexcept {
+                return (std::numeric_limits<size_type>::max() / 2) / sizeof(value_type);
+            }
+
+            /**
+             * @brief Удаляет все элементы
+             * @details Блоки остаются у контейнера и будут переиспользованы
+             *
+             */
+            void clear() noexcept {
+                while (this->size_ > 0) {
+                    this->pop_back();
+                }
+                this->start_ = 0;
+            }
+
+            /**
+             * @brief Возвращает аллокатору блоки, в которых нет элементов
+             *
+             */
+            void shrink_to_fit() noexcept {
+                if (this->size_ == 0) {
+                    this->freeStorage();
+                    return;
+                }
+                size_type first = this->start_ / kBlockSize;
+                size_type last = this->index(this->start_ + this->size_ - 1) / kBlockSize;
+                for (size_type b = this->nextBlock(last); b != first; b = this->nextBlock(b)) {
+                    if (this->map_[b] != nullptr) {
+                        alloc_traits::deallocate(this->alloc_, this->map_[b], kBlockSize);
+                        this->map_[b] = nullptr;
+                    }
+                }
+            }
+
+            /**
+             * @brief Добавляет элемент в конец
+             *
+             * @param value
+             */
+            void push_back(const_reference value) {
+                this->emplace_back(value);
+            }
+
+            /**
+             * @brief Добавляет элемент в конец перемещением
+             *
+             * @param value
+             */
+            void push_back(value_type&& value) {
+                this->emplace_back(std::move(value));
+            }
+
+            /**
+             * @brief Добавляет элемент в начало
+             *
+             * @param value
+             */
+            void push_front(const_reference value) {
+                this->emplace_front(value);
+            }
+
+            /**
+             * @brief Добавляет элемент в начало перемещением
+             *
+             * @param value
+             */
+            void push_front(value_type&& value) {
+                this->emplace_front(std::move(value));
+            }
+
+            /**
+             * @brief Создает новый элемент прямо в конце контейнера
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            reference emplace_back(Args&&... args) {
+                this->reserveSlot();
+                T* place = this->blockSlot(this->index(this->start_ + this->size_));
+                alloc_traits::construct(this->alloc_, place, std::forward<Args>(args)...);
+                ++this->size_;
+                return *place;
+            }
+
+            /**
+             * @brief Создает новый элемент прямо в начале контейнера
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            reference emplace_front(Args&&... args) {
+                this->reserveSlot();
+                size_type pos = (this->start_ == 0) ? this->capacity() - 1 : this->start_ - 1;
+                T* place = this->blockSlot(pos);
+                alloc_traits::construct(this->alloc_, place, std::forward<Args>(args)...);
+                this->start_ = pos;
+                ++this->size_;
+                return *place;
+            }
+
+            /**
+             * @brief Удаляет последний элемент
+             * @details У пустого контейнера ничего не делает, как у s21::list
+             *
+             */
+            void pop_back() noexcept {
+                if (this->size_ == 0)
+                    return;
+
+                alloc_traits::destroy(this->alloc_, &this->back());
+                --this->size_;
+            }
+
+            /**
+             * @brief Удаляет первый элемент
+             * @details У пустого контейнера ничего не делает, как у s21::list
+             *
+             */
+            void pop_front() noexcept {
+                if (this->size_ == 0)
+                    return;
+
+                alloc_traits::destroy(this->alloc_, &this->front());
+                this->start_ = this->index(this->start_ + 1);
+                --this->size_;
+            }
+
+            /**
+             * @brief Меняет содержимое
+             *
+             * @param other
+             */
+            void swap(deque& other) noexcept {
+                if (this != &other) {
+                    if (alloc_traits::propagate_on_container_swap::value) {
+                        std::swap(this->alloc_, other.alloc_);
+                    }
+                    this->swapStorage(other);
+                }
+            }
+
+            /*------------------------------------------------------------------------*/
+
+        private:
+            // Начальное количество блоков в map_
+            static constexpr size_type kInitialMapSize = 4;
+
+            /**
+             * @brief Количество ячеек в кольце
+             *
+             * @return size_type
+             */
+            size_type capacity() const noexcept {
+                return this->map_size_ * kBlockSize;
+            }
+
+            // Номер ячейки кольца для позиции pos из [0, 2 * capacity())
+            size_type index(size_type pos) const noexcept {
+                return (pos >= this->capacity()) ? pos - this->capacity() : pos;
+            }
+
+            // Следующий блок по кольцу
+            size_type nextBlock(size_type b) const noexcept {
+                return (b + 1 == this->map_size_) ? 0 : b + 1;
+            }
+
+            // Адрес ячейки позиции pos (блок уже выделен)
+            T* slot(size_type pos) const noexcept {
+                size_type i = this->index(pos);
+                return this->map_[i / kBlockSize] + i % kBlockSize;
+            }
+
+            /**
+             * @brief Адрес ячейки i кольца, при необходимости выделяет ее блок
+             *
+             * @param i
+             * @return T*
+             */
+            T* blockSlot(size_type i) {
+                T*& block = this->map_[i / kBlockSize];
+                if (block == nullptr) {
+                    block = alloc_traits::allocate(this->alloc_, kBlockSize);
+                }
+                return block + i % kBlockSize;
+            }
+
+            /**
+             * @brief Гарантирует место под еще один элемент
+             * @details В кольце всегда остается хотя бы kBlockSize свободных ячеек.
+             * Тогда первый и последний элементы никогда не лежат в одном блоке "с разных сторон",
+             * и при росте map_ блоки можно переложить по порядку, начиная с блока start_
+             *
+             */
+            void reserveSlot() {
+                if (this->size_ + kBlockSize >= this->capacity()) {
+                    this->growMap();
+                }
+            }
+
+            /**
+             * @brief Увеличивает map_ в два раза
+             * @details Блоки переписываются в новый map_ начиная с блока первого элемента,
+             * новые места в map_ пустые - блоки для них выделятся при записи
+             *
+             */
+            void growMap() {
+                size_type new_size = (this->map_size_ == 0) ? kInitialMapSize : this->map_size_ * 2;
+                map_allocator map_alloc(this->alloc_);
+                T** new_map = map_traits::allocate(map_alloc, new_size);
+                size_type first = this->start_ / kBlockSize;
+                for (size_type b = 0; b < new_size; ++b) {
+                    new_map[b] = (b < this->map_size_) ? this->map_[(first + b) % this->map_size_] : nullptr;
+                }
+                if (this->map_ != nullptr) {
+                    map_traits::deallocate(map_alloc, this->map_, this->map_size_);
+                }
+                this->map_ = new_map;
+                this->map_size_ = new_size;
+                this->start_ %= kBlockSize;
+            }
+
+            // Уничтожает элементы и возвращает аллокатору все блоки и map_
+            void freeStorage() noexcept {
+                this->clear();
+                if (this->map_ != nullptr) {
+                    for (size_type b = 0; b < this->map_size_; ++b) {
+                        if (this->map_[b] != nullptr) {
+                            alloc_traits::deallocate(this->alloc_, this->map_[b], kBlockSize);
+                        }
+                    }
+                    map_allocator map_alloc(this->alloc_);
+                    map_traits::deallocate(map_alloc, this->map_, this->map_size_);
+                    this->map_ = nullptr;
+                    this->map_size_ = 0;
+                }
+            }
+
+            // Меняет местами блоки без аллокаторов
+            void swapStorage(deque& other) noexcept {
+                std::swap(this->map_, other.map_);
+                std::swap(this->map_size_, other.map_size_);
+                std::swap(this->start_, other.start_);
+                std::swap(this->size_, other.size_);
+            }
+
+            /*--------------------class iterator--------------------*/
+
+            /**
+             * @brief Итератор хранит контейнер и номер элемента,
+             * поэтому переход между блоками ничего не стоит
+             *
+             */
+            class DequeIterator {
+                friend deque;
+                public:
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = T*;
+                    using reference = T&;
+
+                    DequeIterator() = delete;
+
+                    reference operator*() const noexcept {
+                        return (*this->deque_)[this->pos_];
+                    }
+
+                    pointer operator->() const noexcept {
+                        return &(*this->deque_)[this->pos_];
+                    }
+
+                    iterator& operator++() noexcept {
+                        ++this->pos_;
+                        return *this;
+                    }
+
+                    iterator operator++(int) noexcept {
+                        iterator temp = *this;
+                        ++(*this);
+                        return temp;
+                    }
+
+                    iterator& operator--() noexcept {
+                        --this->pos_;
+                        return *this;
+                    }
+
+                    iterator operator--(int) noexcept {
+                        iterator temp = *this;
+                        --(*this);
+                        return temp;
+                    }
+
+                    bool operator==(const iterator& other) const noexcept {
+                        return this->pos_ == other.pos_ && this->deque_ == other.deque_;
+                    }
+
+                    bool operator!=(const iterator& other) const noexcept {
+                        return !(*this == other);
+                    }
+
+                private:
+                    DequeIterator(deque* container, size_type pos) : deque_(container), pos_(pos) {}
+
+                    deque* deque_;
+                    size_type pos_;
+            };
+
+            /*------------------------------------------------------*/
+
+            /*-----------------class const_iterator-----------------*/
+
+            /**
+             * @brief Константный итератор, элементы через него менять нельзя
+             * @details Операторы сравнения дружественные, как в s21::list::const_iterator
+             *
+             */
+            class DequeConstIterator {
+                friend deque;
+                friend bool operator==(const const_iterator& it1, const const_iterator& it2) noexcept {
+                    return it1.pos_ == it2.pos_ && it1.deque_ == it2.deque_;
+                }
+
+                friend bool operator!=(const const_iterator& it1, const const_iterator& it2) noexcept {
+                    return !(it1 == it2);
+                }
+                public:
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = T;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const T*;
+                    using reference = const T&;
+
+                    DequeConstIterator() = delete;
+
+                    DequeConstIterator(const iterator& other) : deque_(other.deque_), pos_(other.pos_) {}
+
+                    reference operator*() const noexcept {
+                        return (*this->deque_)[this->pos_];
+                    }
+
+                    pointer operator->() const noexcept {
+                        return &(*this->deque_)[this->pos_];
+                    }
+
+                    const_iterator& operator++() noexcept {
+                        ++this->pos_;
+                        return *this;
+                    }
+
+                    const_iterator operator++(int) noexcept {
+                        const_iterator temp = *this;
+                        ++(*this);
+                        return temp;
+                    }
+
+                    const_iterator& operator--() noexcept {
+                        --this->pos_;
+                        return *this;
+                    }
+
+                    const_iterator operator--(int) noexcept {
+                        const_iterator temp = *this;
+                        --(*this);
+                        return temp;
+                    }
+
+                private:
+                    DequeConstIterator(const deque* container, size_type pos) : deque_(container), pos_(pos) {}
+
+                    const deque* deque_;
+                    size_type pos_;
+            };
+
+            /*------------------------------------------------------*/
+
+            Allocator alloc_;
+            // Кольцо указателей на блоки, nullptr - блок еще не выделен
+            T** map_;
+            // Количество мест в map_
+            size_type map_size_;
+            // Ячейка первого элемента
+            size_type start_;
+            // Количество элементов
+            size_type size_;
+    }; // deque
+} // s21
+
+#endif // SRC_S21_DEQUE_H_
@@ -0,0 +1,944 @@
+#ifndef SRC_S21_FLAT_MAP_H_
+#define SRC_S21_FLAT_MAP_H_
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "s21_flat_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+    /**
+     * @brief flat_map - словарь с тем же интерфейсом, что у s21::map, но без дерева:
+     * ключи и значения лежат в двух отсортированных по ключу s21::vector одинаковой длины
+     * @details Ключ с номером i соответствует значению с номером i. Поиск идет только
+     * по плотному массиву ключей (см. branchlessLowerBound в s21_flat_set.h), значения
+     * при этом в кэш не тянутся. Никаких указателей и цветов на элемент, как в узлах дерева.
+     *
+     * Пары ключ-значение в памяти нет, поэтому итератор при разыменовании возвращает
+     * пару ссылок std::pair<const Key&, T&> по значению: (*it).first, it->second и
+     * range-for с auto/const auto& работают как у map, а вот auto& - нет.
+     *
+     * Вставка и удаление одного элемента - O(n) и делают итераторы недействительными,
+     * так что контейнер подходит для таблиц, которые в основном читаются.
+     * Массовое заполнение - через insert(first, last): сортировка один раз и одно слияние
+     *
+     * @tparam Key - тип ключа
+     * @tparam T - тип значения
+     * @tparam Compare - компаратор ключей
+     * @tparam Allocator - аллокатор пар ключ-значение, перепривязывается на Key и T
+     */
+    template<typename Key, typename T, typename Compare = std::less<Key>,
+             typename Allocator = std::allocator<std::pair<const Key, T>>>
+    class flat_map {
+        template<bool IsConst>
+        class FlatMapIterator;
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using key_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+        using mapped_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+        using key_vector = s21::vector<Key, key_allocator>;
+        using mapped_vector = s21::vector<T, mapped_allocator>;
+        // Временные пары для вставки диапазона (см. insert(first, last))
+        using item_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<Key, T>>;
+        using size_type = std::size_t;
+
+        public:
+            using iterator = FlatMapIterator<false>;
+            using const_iterator = FlatMapIterator<true>;
+            using key_compare = Compare;
+            using allocator_type = Allocator;
+
+            /*------------------constructors and operators flat_map----------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустой словарь
+             *
+             */
+            flat_map() : keys_(), values_(), comp_() {}
+
+            /**
+             * @brief Создает пустой словарь с заданным компаратором и аллокатором
+             *
+             * @param comp
+             * @param alloc
+             */
+            explicit flat_map(const Compare& comp, const Allocator& alloc = Allocator())
+                : keys_(key_allocator(alloc)), values_(mapped_allocator(alloc)), comp_(comp) {}
+
+            /**
+             * @brief Создает пустой словарь с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit flat_map(const Allocator& alloc)
+                : keys_(key_allocator(alloc)), values_(mapped_allocator(alloc)), comp_() {}
+
+            /**
+             * @brief Конструктор списка инициализаторов, создает словарь
+             * @details См. конструктор из диапазона
+             *
+             * @param items
+             */
+            flat_map(std::initializer_list<value_type> const &items, const Compare& comp = Compare(),
+                     const Allocator& alloc = Allocator()) : flat_map(comp, alloc) {
+                this->insert(items.begin(), items.end());
+            }
+
+            /**
+             * @brief Конструктор из диапазона [first, last)
+             * @details Элементы сортируются один раз, из равных ключей остается первый
+             *
+             * @tparam InputIt - итератор
+             * @param first
+             * @param last
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            flat_map(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+                : flat_map(comp, alloc) {
+                this->insert(first, last);
+            }
+
+            /**
+             * @brief Конструктор копирования
+             *
+             * @param m
+             */
+            flat_map(const flat_map &m) : keys_(m.keys_), values_(m.values_), comp_(m.comp_) {}
+
+            /**
+             * @brief Конструктор перемещения
+             *
+             * @param m
+             */
+            flat_map(flat_map &&m) noexcept(std::is_nothrow_copy_constructible<Compare>::value) : keys_(std::move(m.keys_)), values_(std::move(m.values_)), comp_(m.comp_) {}
+
+            /**
+             * @brief Деструктор будет дефолдным
+             * @details keys_ и values_ сами себя почистят
+             *
+             */
+            ~flat_map() = default;
+
+            /**
+             * @brief Перегрузка оператора присваивания копированием
+             *
+             * @param m
+             * @return flat_map&
+             */
+            flat_map& operator=(const flat_map &m) {
+                if (this != &m) {
+                    flat_map copy(m);
+                    this->swap(copy);
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Перегрузка оператора присваивания перемещением
+             *
+             * @param m
+             * @return flat_map&
+             */
+            flat_map& operator=(flat_map &&m) {
+                this->keys_ = std::move(m.keys_);
+                this->values_ = std::move(m.values_);
+                this->comp_ = m.comp_;
+                return *this;
+            }
+
+            /*------------------------------------------------------------------------------*/
+
+            /*------------------------methods flat_map-------------------------*/
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             * @details Если такого элемента нет, значит будет исключение
+             *
+             * @param key
+             * @return T&
+             */
+            mapped_type& at(const Key& key) {
+                return this->values_[this->indexOf(key)];
+            }
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             * @details Для конст объекта
+             *
+             * @param key
+             * @return T&
+             */
+            const mapped_type& at(const Key& key) const {
+                return this->values_[this->indexOf(key)];
+            }
+
+            /**
+             * @brief Аналогично at, но ключ может быть любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent (например std::less<>)
+             *
+             * @param key
+             * @return T&
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            mapped_type& at(const K& key) {
+                return this->values_[this->indexOf(key)];
+            }
+
+            /**
+             * @brief Аналогично at(const K&) для конст объекта
+             *
+             * @param key
+             * @return T&
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            const mapped_type& at(const K& key) const {
+                return this->values_[this->indexOf(key)];
+            }
+
+            /**
+             * @brief Получить доступ или вставить указанный элемент
+             * @details Если такого ключа нет, он вставляется с дефолдным значением
+             *
+             * @param key
+             * @return mapped_type&
+             */
+            mapped_type& operator[](const Key& key) {
+                return (*this->try_emplace(key).first).second;
+            }
+
+            /**
+             * @brief Аналогично operator[](const Key&), но ключ перемещается в новый элемент
+             *
+             * @param key
+             * @return mapped_type&
+             */
+            mapped_type& operator[](Key&& key) {
+                return (*this->try_emplace(std::move(key)).first).second;
+            }
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return allocator_type(this->keys_.get_allocator());
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             *
+             * @return iterator
+             */
+            iterator begin() noexcept {
+                return this->makeIterator(0);
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator begin() const noexcept {
+                return this->makeIterator(0);
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             *
+             * @return iterator
+             */
+            iterator end() noexcept {
+                return this->makeIterator(this->keys_.size());
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator end() const noexcept {
+                return this->makeIterator(this->keys_.size());
+            }
+
+            /**
+             * @brief Проверяет, пуст ли контейнер
+             *
+             * @return true - контейнер пуст
+             * @return false - контейнер не пуст
+             */
+            bool empty() const noexcept {
+                return this->keys_.empty();
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                return this->keys_.size();
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             *
+             * @return size_type
+             */
+            size_type max_size() const noexcept {
+                return std::min(this->keys_.max_size(), this->values_.max_size());
+            }
+
+            /**
+             * @brief Очищает содержимое контейнера
+             * @details Память остается за контейнером
+             *
+             */
+            void clear() noexcept {
+                this->keys_.clear();
+                this->values_.clear();
+            }
+
+            /**
+             * @brief Заменяет содержимое элементами из отсортированного диапазона [first, last)
+             * @details Диапазон должен идти по возрастанию ключей (в смысле Compare),
+             * это не проверяется. Элементы копируются по порядку за O(n), из равных ключей остается первый
+             *
+             * @tparam InputIt
+             * @param first
+             * @param last
+             */
+            template<typename InputIt>
+            void assign_sorted(InputIt first, InputIt last) {
+                this->clear();
+                try {
+                    for (; first != last; ++first) {
+                        if (this->keys_.empty() || this->comp_(this->keys_.back(), (*first).first)) {
+                            this->pushBack((*first).first, (*first).second);
+                        }
+                    }
+                } catch (...) {
+                    this->clear();
+                    throw;
+                }
+            }
+
+            /**
+             * @brief вставляет элемент и возвращает итератор туда, где элемент находится
+             * в контейнере, и логическое значение, обозначающее, имела ли место вставка
+             *
+             * @param value
+             * @return std::pair<iterator, bool>
+             */
+            std::pair<iterator, bool> insert(const value_type& value) {
+                return this->emplaceKey(value.first, value.second);
+            }
+
+            /**
+             * @brief Вставляет элемент, используя hint как подсказку, куда он должен встать
+             * @details Если ключ должен стоять прямо перед hint, бинарный поиск не нужен -
+             * удобно при вставке возрастающих ключей с подсказкой end(). Неверная
+             * подсказка просто ведет к обычной вставке
+             *
+             * @param hint
+             * @param value
+             * @return iterator - указывает на вставленный элемент или на элемент с таким же ключом
+             */
+            iterator insert(const_iterator hint, const value_type& value) {
+                size_type index = static_cast<size_type>(hint - this->cbegin());
+                if (this->fitsBefore(index, value.first)) {
+                    return this->emplaceAt(index, value.first, value.second);
+                }
+                return this->insert(value).first;
+            }
+
+            /**
+             * @brief вставляет значение по ключу и возвращает итератор туда, где элемент находится в контейнере,
+             * и логическое значение, обозначающее, имела ли место вставка
+             *
+             * @param key
+             * @param obj
+             * @return std::pair<iterator, bool>
+             */
+            std::pair<iterator, bool> insert(const Key& key, const mapped_type& obj) {
+                return this->emplaceKey(key, obj);
+            }
+
+            /**
+             * @brief Вставляет элементы из [first, last)
+             * @details Новые пары собираются во временный массив, сортируются по ключу один раз
+             * и за один проход сливаются с уже имеющимися в новые массивы ключей и значений.
+             * Итого O(n + k log k) вместо O(k * n) при вставке по одному.
+             * Из равных ключей остается элемент, который уже был в контейнере, или первый из новых
+             *
+             * @tparam InputIt
+             * @param first
+             * @param last
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            void insert(InputIt first, InputIt last) {
+                std::vector<std::pair<Key, T>, item_allocator> items(item_allocator(this->get_allocator()));
+                if (std::is_base_of<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>::value) {
+                    items.reserve(static_cast<size_type>(std::distance(first, last)));
+                }
+                for (; first != last; ++first) {
+                    items.emplace_back((*first).first, (*first).second);
+                }
+                if (items.empty()) {
+                    return;
+                }
+                auto less = [this](const std::pair<Key, T>& a, const std::pair<Key, T>& b) {
+                    return this->comp_(a.first, b.first);
+                };
+                if (!std::is_sorted(items.begin(), items.end(), less)) {
+                    std::stable_sort(items.begin(), items.end(), less);
+                }
+
+                flat_map merged(this->comp_, this->get_allocator());
+                merged.keys_.reserve(this->keys_.size() + items.size());
+                merged.values_.reserve(this->keys_.size() + items.size());
+                size_type i = 0;
+                for (auto& item : items) {
+                    while (i < this->keys_.size() && this->comp_(this->keys_[i], item.first)) {
+                        merged.pushBack(std::move(this->keys_[i]), std::move(this->values_[i]));
+                        ++i;
+                    }
+                    // Ключ уже есть: в контейнере (он впереди) или среди новых (взят первый)
+                    bool taken = !merged.empty() && !this->comp_(merged.keys_.back(), item.first);
+                    bool present = i < this->keys_.size() && !this->comp_(item.first, this->keys_[i]);
+                    if (!taken && !present) {
+                        merged.pushBack(std::move(item.first), std::move(item.second));
+                    }
+                }
+                for (; i < this->keys_.size(); ++i) {
+                    merged.pushBack(std::move(this->keys_[i]), std::move(this->values_[i]));
+                }
+                this->swap(merged);
+            }
+
+            /**
+             * @brief Вставляет элемент с ключом key, если такого ключа еще нет
+             * @details Место ищется одним бинарным поиском. Значение создается из args,
+             * только если вставка действительно будет, иначе args не трогаются
+             *
+             * @tparam Args
+             * @param key
+             * @param args - аргументы конструктора mapped_type
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с ключом key,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+                return this->emplaceKey(key, std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Аналогично try_emplace(const Key&, Args&&...), но ключ перемещается в новый элемент
+             *
+             * @tparam Args
+             * @param key
+             * @param args
+             * @return std::pair<iterator, bool>
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+                return this->emplaceKey(std::move(key), std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Вставляет элемент или присваивает значение текущему элементу, если ключ уже существует
+             *
+             * @param key
+             * @param obj
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с ключом key,
+             * bool - была ли вставка
+             */
+            std::pair<iterator, bool> insert_or_assign(const Key& key, const mapped_type& obj) {
+                std::pair<iterator, bool> result = this->emplaceKey(key, obj);
+                if (!result.second)
+                    (*result.first).second = obj;
+                return result;
+            }
+
+            /**
+             * @brief Стирает элемент в позиции
+             *
+             * @param pos
+             */
+            void erase(iterator pos) {
+                size_type index = static_cast<size_type>(pos - this->begin());
+                this->keys_.erase(this->keys_.begin() + index);
+                this->values_.erase(this->values_.begin() + index);
+            }
+
+            /**
+             * @brief Меняет содержимое
+             *
+             * @param other
+             */
+            void swap(flat_map& other) noexcept {
+                this->keys_.swap(other.keys_);
+                this->values_.swap(other.values_);
+                std::swap(this->comp_, other.comp_);
+            }
+
+            /**
+             * @brief Переносит из other элементы с ключами, которых нет в this
+             * @details Оба массива уже отсортированы, поэтому хватает одного слияния за O(n + m).
+             * Элементы с ключами, которые уже есть в this, остаются в other
+             *
+             * @param other
+             */
+            void merge(flat_map& other) {
+                if (this == &other) {
+                    return;
+                }
+                flat_map merged(this->comp_, this->get_allocator());
+                flat_map rest(other.comp_, other.get_allocator());
+                merged.keys_.reserve(this->size() + other.size());
+                merged.values_.reserve(this->size() + other.size());
+                size_type i = 0;
+                size_type j = 0;
+                while (j < other.size()) {
+                    if (i == this->size() || this->comp_(other.keys_[j], this->keys_[i])) {
+                        merged.pushBack(std::move(other.keys_[j]), std::move(other.values_[j]));
+                        ++j;
+                        continue;
+                    }
+                    if (!this->comp_(this->keys_[i], other.keys_[j])) {
+                        rest.pushBack(std::move(other.keys_[j]), std::move(other.values_[j]));
+                        ++j;
+                    }
+                    merged.pushBack(std::move(this->keys_[i]), std::move(this->values_[i]));
+                    ++i;
+                }
+                for (; i < this->size(); ++i) {
+                    merged.pushBack(std::move(this->keys_[i]), std::move(this->values_[i]));
+                }
+                this->swap(merged);
+                other.swap(rest);
+            }
+
+            /**
+             * @brief Отделяет от контейнера все элементы с ключами >= key
+             * @details В this остаются элементы с ключами меньше key, хвосты массивов
+             * перемещаются в результат
+             *
+             * @param key
+             * @return flat_map - элементы с ключами >= key
+             */
+            flat_map split(const Key& key) {
+                flat_map upper(this->comp_, this->get_allocator());
+                size_type index = this->lowerBound(key);
+                upper.keys_.reserve(this->size() - index);
+                upper.values_.reserve(this->size() - index);
+                for (size_type i = index; i < this->size(); ++i) {
+                    upper.pushBack(std::move(this->keys_[i]), std::move(this->values_[i]));
+                }
+                this->truncate(index);
+                return upper;
+            }
+
+            /**
+             * @brief Переносит в this все элементы other, если их ключи целиком больше
+             * или целиком меньше ключей this
+             * @details Массивы просто склеиваются, other становится пустым
+             *
+             * @param other
+             * @throw std::invalid_argument - диапазоны ключей пересекаются
+             */
+            void join(flat_map& other) {
+                if (this == &other || other.empty()) {
+                    return;
+                }
+                if (this->empty() || this->comp_(this->keys_.back(), other.keys_.front())) {
+                    this->appendFrom(other);
+                } else if (this->comp_(other.keys_.back(), this->keys_.front())) {
+                    other.appendFrom(*this);
+                    this->keys_.swap(other.keys_);
+                    this->values_.swap(other.values_);
+                } else {
+                    throw std::invalid_argument("s21::flat_map::join: key ranges overlap");
+                }
+                other.clear();
+            }
+
+            /**
+             * @brief Проверяет, есть ли элемент с ключом, эквивалентным ключу в контейнере
+             *
+             * @param key
+             * @return true - есть элемент в контенере
+             * @return false - нет эдемента в контейнере
+             */
+            bool contains(const Key& key) const {
+                return this->findIndex(key) != this->size();
+            }
+
+            /**
+             * @brief Аналогично contains для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent
+             *
+             * @param key
+             * @return true - есть элемент в контенере
+             * @return false - нет эдемента в контейнере
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            bool contains(const K& key) const {
+                return this->findIndex(key) != this->size();
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             *
+             * @param key
+             * @return iterator - указывает на найденный элемент или на end()
+             */
+            iterator find(const Key& key) {
+                return this->makeIterator(this->findIndex(key));
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             * @details Для конст объекта
+             *
+             * @param key
+             * @return const_iterator
+             */
+            const_iterator find(const Key& key) const {
+                return this->makeIterator(this->findIndex(key));
+            }
+
+            /**
+             * @brief Аналогично find для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent
+             *
+             * @param key
+             * @return iterator
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            iterator find(const K& key) {
+                return this->makeIterator(this->findIndex(key));
+            }
+
+            /**
+             * @brief Аналогично find(const K&) для конст объекта
+             *
+             * @param key
+             * @return const_iterator
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            const_iterator find(const K& key) const {
+                return this->makeIterator(this->findIndex(key));
+            }
+
+            /**
+             * @brief Создает пару из аргументов ее конструктора
+             * и вставляет ее, если в контейнере нет такого ключа
+             *
+             * @tparam Args - аргументы конструктора пары
+             * @param args
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с таким ключом,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                std::pair<Key, T> item(std::forward<Args>(args)...);
+                return this->emplaceKey(std::move(item.first), std::move(item.second));
+            }
+
+            /**
+             * @brief Вставляет новые элеметы в контейнер, если контейнер
+             * не содержит таких ключей
+             * @details Каждый аргумент - отдельный элемент. Каждая вставка сдвигает
+             * элементы массивов, поэтому запоминаем номера и пересчитываем их,
+             * а итераторы строим в конце - все они действительны после вызова
+             *
+             * @tparam Args
+             * @param args
+             * @return std::vector<std::pair<iterator,bool>>
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insert_many(Args&&... args) {
+                std::vector<std::pair<size_type, bool>> positions;
+                positions.reserve(sizeof...(args));
+                (this->insertTracked(positions, std::forward<Args>(args)), ...);
+                std::vector<std::pair<iterator, bool>> result;
+                result.reserve(positions.size());
+                for (const auto& position : positions) {
+                    result.emplace_back(this->makeIterator(position.first), position.second);
+                }
+                return result;
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его с подсказкой hint
+             * @details Подсказка работает так же, как в insert(hint, value)
+             *
+             * @tparam Args
+             * @param hint
+             * @param args
+             * @return iterator - указывает на вставленный элемент или на элемент с таким же ключом
+             */
+            template<typename... Args>
+            iterator emplace_hint(const_iterator hint, Args&&... args) {
+                std::pair<Key, T> item(std::forward<Args>(args)...);
+                size_type index = static_cast<size_type>(hint - this->cbegin());
+                if (this->fitsBefore(index, item.first)) {
+                    return this->emplaceAt(index, std::move(item.first), std::move(item.second));
+                }
+                return this->emplaceKey(std::move(item.first), std::move(item.second)).first;
+            }
+
+            /*------------------------------------------------------------*/
+
+        private:
+            key_vector keys_;
+            mapped_vector values_;
+            Compare comp_;
+
+            const_iterator cbegin() const noexcept {
+                return this->begin();
+            }
+
+            iterator makeIterator(size_type index) noexcept {
+                return iterator(this->keys_.data() + index, this->values_.data() + index);
+            }
+
+            const_iterator makeIterator(size_type index) const noexcept {
+                return const_iterator(this->keys_.data() + index, this->values_.data() + index);
+            }
+
+            // Номер первого ключа, не меньшего key
+            template<typename K>
+            size_type lowerBound(const K& key) const {
+                return branchlessLowerBound(this->keys_.data(), this->keys_.size(), key, this->comp_);
+            }
+
+            // Номер ключа, равного key, или size(), если его нет
+            template<typename K>
+            size_type findIndex(const K& key) const {
+                size_type index = this->lowerBound(key);
+                if (index != this->keys_.size() && !this->comp_(key, this->keys_[index])) {
+                    return index;
+                }
+                return this->keys_.size();
+            }
+
+            // Номер ключа, равного key, или исключение как у map::at
+            template<typename K>
+            size_type indexOf(const K& key) const {
+                size_type index = this->findIndex(key);
+                if (index == this->keys_.size())
+                    throw std::out_of_range("s21::flat_map::at: no such element exists");
+                return index;
+            }
+
+            // Можно ли вставить key прямо перед элементом с номером index, не нарушив порядок
+            bool fitsBefore(size_type index, const Key& key) const {
+                return index <= this->keys_.size() &&
+                    (index == 0 || this->comp_(this->keys_[index - 1], key)) &&
+                    (index == this->keys_.size() || this->comp_(key, this->keys_[index]));
+            }
+
+            /**
+             * @brief Вставляет ключ и значение на место index
+             * @details Если значение не создалось, ключ убирается обратно -
+             * массивы всегда одной длины
+             *
+             */
+            template<typename K, typename... Args>
+            iterator emplaceAt(size_type index, K&& key, Args&&... args) {
+                this->keys_.emplace(this->keys_.begin() + index, std::forward<K>(key));
+                try {
+                    this->values_.emplace(this->values_.begin() + index, std::forward<Args>(args)...);
+                } catch (...) {
+                    this->keys_.erase(this->keys_.begin() + index);
+                    throw;
+                }
+                return this->makeIterator(index);
+            }
+
+            // Вставка после одного бинарного поиска, если такого ключа еще нет
+            template<typename K, typename... Args>
+            std::pair<iterator, bool> emplaceKey(K&& key, Args&&... args) {
+                size_type index = this->lowerBound(key);
+                if (index != this->keys_.size() && !this->comp_(key, this->keys_[index])) {
+                    return {this->makeIterator(index), false};
+                }
+                return {this->emplaceAt(index, std::forward<K>(key), std::forward<Args>(args)...), true};
+            }
+
+            // Вставка для insert_many: номера уже вставленных элементов за новым сдвигаются на 1
+            template<typename V>
+            void insertTracked(std::vector<std::pair<size_type, bool>>& positions, V&& value) {
+                std::pair<iterator, bool> result = this->emplace(std::forward<V>(value));
+                size_type index = static_cast<size_type>(result.first - this->begin());
+                if (result.second) {
+                    for (auto& position : positions) {
+                        if (position.first >= index) {
+                            ++position.first;
+                        }
+                    }
+                }
+                positions.emplace_back(index, result.second);
+            }
+
+            // Дописывает элемент в конец (вызывающий следит за порядком ключей)
+            template<typename K, typename V>
+            void pushBack(K&& key, V&& value) {
+                this->keys_.push_back(std::forward<K>(key));
+                try {
+                    this->values_.push_back(std::forward<V>(value));
+                } catch (...) {
+                    this->keys_.pop_back();
+                    throw;
+                }
+            }
+
+            // Оставляет первые size элементов
+            void truncate(size_type size) noexcept {
+                while (this->keys_.size() > size) {
+                    this->keys_.pop_back();
+                    this->values_.pop_back();
+                }
+            }
+
+            // Перемещает элементы other в конец this
+            void appendFrom(flat_map& other) {
+                this->keys_.reserve(this->size() + other.size());
+                this->values_.reserve(this->size() + other.size());
+                for (size_type i = 0; i < other.size(); ++i) {
+                    this->pushBack(std::move(other.keys_[i]), std::move(other.values_[i]));
+                }
+            }
+
+            /**
+             * @brief Итератор flat_map: пара указателей на ключ и значение с одним номером
+             * @details Произвольного доступа. Разыменование дает пару ссылок,
+             * для operator-> она хранится во временном объекте ArrowProxy
+             *
+             * @tparam IsConst - значение только для чтения (const_iterator)
+             */
+            template<bool IsConst>
+            class FlatMapIterator {
+                friend class flat_map;
+                using mapped_pointer = std::conditional_t<IsConst, const T*, T*>;
+                using mapped_reference = std::conditional_t<IsConst, const T&, T&>;
+                public:
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = std::pair<const Key, T>;
+                    using difference_type = std::ptrdiff_t;
+                    using reference = std::pair<const Key&, mapped_reference>;
+
+                    // Держит пару ссылок, пока вызывающий обращается к ней через ->
+                    struct ArrowProxy {
+                        reference ref_;
+                        reference* operator->() noexcept { return &this->ref_; }
+                    };
+                    using pointer = ArrowProxy;
+
+                    FlatMapIterator() noexcept : key_(nullptr), value_(nullptr) {}
+
+                    // iterator можно превратить в const_iterator, но не наоборот
+                    template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+                    FlatMapIterator(const FlatMapIterator<OtherConst>& other) noexcept
+                        : key_(other.key_), value_(other.value_) {}
+
+                    reference operator*() const noexcept {
+                        return reference(*this->key_, *this->value_);
+                    }
+
+                    pointer operator->() const noexcept {
+                        return pointer{**this};
+                    }
+
+                    reference operator[](difference_type n) const noexcept {
+                        return *(*this + n);
+                    }
+
+                    FlatMapIterator& operator++() noexcept {
+                        ++this->key_;
+                        ++this->value_;
+                        return *this;
+                    }
+
+                    FlatMapIterator operator++(int) noexcept {
+                        FlatMapIterator tmp = *this;
+                        ++*this;
+                        return tmp;
+                    }
+
+                    FlatMapIterator& operator--() noexcept {
+                        --this->key_;
+                        --this->value_;
+                        return *this;
+                    }
+
+                    FlatMapIterator operator--(int) noexcept {
+                        FlatMapIterator tmp = *this;
+                        --*this;
+                        return tmp;
+                    }
+
+                    FlatMapIterator& operator+=(difference_type n) noexcept {
+                        this->key_ += n;
+                        this->value_ += n;
+                        return *this;
+                    }
+
+                    FlatMapIterator& operator-=(difference_type n) noexcept {
+                        return *this += -n;
+                    }
+
+                    FlatMapIterator operator+(difference_type n) const noexcept {
+                        FlatMapIterator tmp = *this;
+                        return tmp += n;
+                    }
+
+                    FlatMapIterator operator-(difference_type n) const noexcept {
+                        FlatMapIterator tmp = *this;
+                        return tmp -= n;
+                    }
+
+                    difference_type operator-(const FlatMapIterator& other) const noexcept {
+                        return this->key_ - other.key_;
+                    }
+
+                    bool operator==(const FlatMapIterator& other) const noexcept {
+                        return this->key_ == other.key_;
+                    }
+
+                    bool operator!=(const FlatMapIterator& other) const noexcept {
+                        return this->key_ != other.key_;
+                    }
+
+                    bool operator<(const FlatMapIterator& other) const noexcept {
+                        return this->key_ < other.key_;
+                    }
+
+                private:
+                    template<bool>
+                    friend class FlatMapIterator;
+
+                    FlatMapIterator(const Key* key, mapped_pointer value) noexcept : key_(key), value_(value) {}
+
+                    const Key* key_;
+                    mapped_pointer value_;
+            };
+
+    }; // flat_map
+} // s21
+
+#endif //SRC_S21_FLAT_MAP_H_
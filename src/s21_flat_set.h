@@ -0,0 +1,736 @@
+#ifndef SRC_S21_FLAT_SET_H_
+#define SRC_S21_FLAT_SET_H_
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "s21_vector.h"
+
+namespace s21 {
+    /**
+     * @brief Бинарный поиск без ветвлений: номер первого из n элементов first,
+     * который не меньше key (как std::lower_bound)
+     * @details На каждом шаге отрезок поиска уменьшается вдвое, а выбор половины
+     * записан через тернарный оператор - компилятор превращает его в cmov, и процессору
+     * нечего предсказывать. Количество шагов зависит только от n, не от ключа
+     *
+     * @param first - начало отсортированного массива
+     * @param n - количество элементов
+     * @param key
+     * @param comp
+     * @return std::size_t - от 0 до n
+     */
+    template<typename T, typename K, typename Compare>
+    std::size_t branchlessLowerBound(const T* first, std::size_t n, const K& key, const Compare& comp) {
+        if (n == 0) {
+            return 0;
+        }
+        const T* base = first;
+        while (n > 1) {
+            std::size_t half = n / 2;
+            base = comp(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<std::size_t>(base - first) + (comp(*base, key) ? 1 : 0);
+    }
+
+    /**
+     * @brief flat_set - множество уникальных элементов с тем же интерфейсом, что у s21::set,
+     * но элементы лежат подряд в отсортированном s21::vector, а не в узлах дерева
+     * @details Никаких указателей на элемент: память - ровно sizeof(Key) на элемент,
+     * поиск - бинарный поиск по непрерывному массиву (см. branchlessLowerBound).
+     * Расплата - вставка и удаление одного элемента сдвигают хвост массива (O(n)),
+     * а любая вставка делает итераторы недействительными. Поэтому контейнер хорош для
+     * таблиц, которые заполняются разом (конструктор из диапазона, insert(first, last))
+     * и дальше в основном читаются
+     *
+     * @tparam Key - тип элемента
+     * @tparam Compare - компаратор элементов
+     * @tparam Allocator - аллокатор элементов
+     */
+    template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+    class flat_set {
+        using key_type = Key;
+        using value_type = Key;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using key_vector = s21::vector<Key, Allocator>;
+        using size_type = std::size_t;
+        public:
+            // Элементы менять нельзя - сломается порядок, поэтому оба итератора константные
+            using iterator = typename key_vector::const_iterator;
+            using const_iterator = typename key_vector::const_iterator;
+            using key_compare = Compare;
+            using allocator_type = Allocator;
+
+            /*------------------constructors and operators flat_set----------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустой набор
+             *
+             */
+            flat_set() : keys_(), comp_() {}
+
+            /**
+             * @brief Создает пустой набор с заданным компаратором и аллокатором
+             *
+             * @param comp
+             * @param alloc
+             */
+            explicit flat_set(const Compare& comp, const Allocator& alloc = Allocator()) : keys_(alloc), comp_(comp) {}
+
+            /**
+             * @brief Создает пустой набор с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit flat_set(const Allocator& alloc) : keys_(alloc), comp_() {}
+
+            /**
+             * @brief Конструктор списка инициализаторов, создает набор
+             * @details См. конструктор из диапазона
+             *
+             * @param items
+             */
+            flat_set(std::initializer_list<value_type> const &items, const Compare& comp = Compare(),
+                     const Allocator& alloc = Allocator()) : keys_(alloc), comp_(comp) {
+                this->insert(items.begin(), items.end());
+            }
+
+            /**
+             * @brief Конструктор из диапазона [first, last)
+             * @details Элементы сортируются один раз, из равных остается первый
+             *
+             * @tparam InputIt - итератор
+             * @param first
+             * @param last
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            flat_set(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+                : keys_(alloc), comp_(comp) {
+                this->insert(first, last);
+            }
+
+            /**
+             * @brief Конструктор копирования
+             *
+             * @param s
+             */
+            flat_set(const flat_set &s) : keys_(s.keys_), comp_(s.comp_) {}
+
+            /**
+             * @brief Конструктор перемещения
+             *
+             * @param s
+             */
+            flat_set(flat_set &&s) noexcept(std::is_nothrow_copy_constructible<Compare>::value) : keys_(std::move(s.keys_)), comp_(s.comp_) {}
+
+            /**
+             * @brief Деструктор будет дефолдным
+             * @details keys_ сам себя почистит
+             *
+             */
+            ~flat_set() = default;
+
+            /**
+             * @brief Перегрузка оператора присваивания копированием
+             *
+             * @param s
+             * @return flat_set&
+             */
+            flat_set& operator=(const flat_set &s) {
+                this->keys_ = s.keys_;
+                this->comp_ = s.comp_;
+                return *this;
+            }
+
+            /**
+             * @brief Перегрузка оператора присваивания перемещением
+             *
+             * @param s
+             * @return flat_set&
+             */
+            flat_set& operator=(flat_set &&s) {
+                this->keys_ = std::move(s.keys_);
+                this->comp_ = s.comp_;
+                return *this;
+            }
+
+            /*------------------------------------------------------------------------*/
+
+            /*------------------------methods flat_set-------------------------*/
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->keys_.get_allocator();
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             *
+             * @return iterator
+             */
+            iterator begin() const noexcept {
+                return this->keys_.begin();
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             *
+             * @return iterator
+             */
+            iterator end() const noexcept {
+                return this->keys_.end();
+            }
+
+            /**
+             * @brief Проверяет, пуст ли контейнер
+             *
+             * @return true - контейнер пуст
+             * @return false - контейнер не пуст
+             */
+            bool empty() const noexcept {
+                return this->keys_.empty();
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                return this->keys_.size();
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             *
+             * @return size_type
+             */
+            size_type max_size() const noexcept {
+                return this->keys_.max_size();
+            }
+
+            /**
+             * @brief Очищает содержимое контейнера
+             * @details Память остается за контейнером
+             *
+             */
+            void clear() noexcept {
+                this->keys_.clear();
+            }
+
+            /**
+             * @brief Заменяет содержимое элементами из отсортированного диапазона [first, last)
+             * @details Диапазон должен идти по возрастанию (в смысле Compare), это не проверяется.
+             * Элементы просто копируются по порядку за O(n), из равных остается первый
+             *
+             * @tparam InputIt
+             * @param first
+             * @param last
+             */
+            template<typename InputIt>
+            void assign_sorted(InputIt first, InputIt last) {
+                this->keys_.clear();
+                for (; first != last; ++first) {
+                    if (this->keys_.empty() || this->comp_(this->keys_.back(), *first)) {
+                        this->keys_.push_back(*first);
+                    }
+                }
+            }
+
+            /**
+             * @brief Вставляет элемент, если такого еще нет
+             *
+             * @param value
+             * @return std::pair<iterator, bool> - iterator указывает на элемент, равный value,
+             * bool - была ли вставка
+             */
+            std::pair<iterator, bool> insert(const value_type& value) {
+                return this->emplaceKey(value);
+            }
+
+            /**
+             * @brief Аналогично insert(const value_type&), но элемент перемещается
+             *
+             * @param value
+             * @return std::pair<iterator, bool>
+             */
+            std::pair<iterator, bool> insert(value_type&& value) {
+                return this->emplaceKey(std::move(value));
+            }
+
+            /**
+             * @brief Вставляет элемент, используя hint как подсказку, куда он должен встать
+             * @details Если value должен стоять прямо перед hint, бинарный поиск не нужен -
+             * удобно при вставке возрастающих элементов с подсказкой end(). Неверная
+             * подсказка просто ведет к обычной вставке
+             *
+             * @param hint
+             * @param value
+             * @return iterator - указывает на вставленный элемент или на равный ему
+             */
+            iterator insert(const_iterator hint, const value_type& value) {
+                size_type index = static_cast<size_type>(hint - this->begin());
+                if (this->fitsBefore(index, value)) {
+                    return this->keys_.insert(hint, value);
+                }
+                return this->insert(value).first;
+            }
+
+            /**
+             * @brief Вставляет элементы из [first, last)
+             * @details Новые элементы дописываются в конец, сортируются один раз
+             * и сливаются с уже имеющимися (std::inplace_merge), потом повторы удаляются.
+             * Итого O(n + k log k) вместо O(k * n) при вставке по одному.
+             * Из равных остается элемент, который уже был в контейнере, или первый из новых
+             *
+             * @tparam InputIt
+             * @param first
+             * @param last
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            void insert(InputIt first, InputIt last) {
+                size_type old_size = this->keys_.size();
+                try {
+                    for (; first != last; ++first) {
+                        this->keys_.push_back(*first);
+                    }
+                } catch (...) {
+                    this->truncate(old_size);
+                    throw;
+                }
+                auto begin = this->keys_.begin();
+                auto middle = begin + old_size;
+                auto end = this->keys_.end();
+                if (!std::is_sorted(middle, end, this->comp_)) {
+                    std::stable_sort(middle, end, this->comp_);
+                }
+                std::inplace_merge(begin, middle, end, this->comp_);
+                auto equal = [this](const Key& a, const Key& b) { return !this->comp_(a, b); };
+                this->truncate(static_cast<size_type>(std::unique(begin, end, equal) - begin));
+            }
+
+            /**
+             * @brief Стирает элемент в позиции
+             *
+             * @param pos
+             */
+            void erase(iterator pos) {
+                this->keys_.erase(pos);
+            }
+
+            /**
+             * @brief Меняет содержимое
+             *
+             * @param other
+             */
+            void swap(flat_set& other) noexcept {
+                this->keys_.swap(other.keys_);
+                std::swap(this->comp_, other.comp_);
+            }
+
+            /**
+             * @brief Переносит из other элементы, которых нет в this
+             * @details Оба массива уже отсортированы, поэтому хватает одного слияния за O(n + m).
+             * Элементы, которые уже есть в this, остаются в other
+             *
+             * @param other
+             */
+            void merge(flat_set& other) {
+                if (this == &other) {
+                    return;
+                }
+                key_vector merged(this->keys_.get_allocator());
+                key_vector rest(other.keys_.get_allocator());
+                merged.reserve(this->keys_.size() + other.keys_.size());
+                auto i = this->keys_.begin(), i_end = this->keys_.end();
+                auto j = other.keys_.begin(), j_end = other.keys_.end();
+                while (j != j_end) {
+                    if (i == i_end || this->comp_(*j, *i)) {
+                        merged.push_back(std::move(*j++));
+                    } else if (this->comp_(*i, *j)) {
+                        merged.push_back(std::move(*i++));
+                    } else {
+                        merged.push_back(std::move(*i++));
+                        rest.push_back(std::move(*j++));
+                    }
+                }
+                for (; i != i_end; ++i) {
+                    merged.push_back(std::move(*i));
+                }
+                this->keys_.swap(merged);
+                other.keys_.swap(rest);
+            }
+
+            /**
+             * @brief Отделяет от контейнера все элементы, которые >= key
+             * @details В this остаются элементы меньше key, хвост массива перемещается в результат
+             *
+             * @param key
+             * @return flat_set - элементы >= key
+             */
+            flat_set split(const Key& key) {
+                flat_set upper(this->comp_, this->get_allocator());
+                size_type index = this->lowerBound(key);
+                upper.keys_.reserve(this->keys_.size() - index);
+                for (auto it = this->keys_.begin() + index; it != this->keys_.end(); ++it) {
+                    upper.keys_.push_back(std::move(*it));
+                }
+                this->truncate(index);
+                return upper;
+            }
+
+            /**
+             * @brief Переносит в this все элементы other, если они целиком больше
+             * или целиком меньше элементов this
+             * @details Массивы просто склеиваются, other становится пустым
+             *
+             * @param other
+             * @throw std::invalid_argument - диапазоны элементов пересекаются
+             */
+            void join(flat_set& other) {
+                if (this == &other || other.empty()) {
+                    return;
+                }
+                if (this->empty() || this->comp_(this->keys_.back(), other.keys_.front())) {
+                    this->appendFrom(this->keys_, other.keys_);
+                } else if (this->comp_(other.keys_.back(), this->keys_.front())) {
+                    this->appendFrom(other.keys_, this->keys_);
+                    this->keys_.swap(other.keys_);
+                } else {
+                    throw std::invalid_argument("s21::flat_set::join: key ranges overlap");
+                }
+                other.keys_.clear();
+            }
+
+            /**
+             * @brief Объединение: добавляет элементы other, которых нет в this
+             * @details Один проход по обоим массивам, O(n + m)
+             *
+             * @param other
+             * @return flat_set& - *this
+             */
+            flat_set& union_with(const flat_set& other) {
+                *this = flat_set::combined(*this, other, &flat_set::unionOp);
+                return *this;
+            }
+
+            /**
+             * @brief Пересечение: оставляет только элементы, которые есть и в other
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return flat_set& - *this
+             */
+            flat_set& intersect_with(const flat_set& other) {
+                *this = flat_set::combined(*this, other, &flat_set::intersectionOp);
+                return *this;
+            }
+
+            /**
+             * @brief Разность: удаляет элементы, которые есть в other
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return flat_set& - *this
+             */
+            flat_set& difference_with(const flat_set& other) {
+                *this = flat_set::combined(*this, other, &flat_set::differenceOp);
+                return *this;
+            }
+
+            /**
+             * @brief Симметрическая разность: оставляет элементы, которые есть только
+             * в одном из контейнеров
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return flat_set& - *this
+             */
+            flat_set& symmetric_difference_with(const flat_set& other) {
+                *this = flat_set::combined(*this, other, &flat_set::symmetricDifferenceOp);
+                return *this;
+            }
+
+            /**
+             * @brief Объединение a и b в новом контейнере, O(n + m). Компаратор берется у a
+             *
+             */
+            friend flat_set operator|(const flat_set& a, const flat_set& b) {
+                return flat_set::combined(a, b, &flat_set::unionOp);
+            }
+
+            /**
+             * @brief Пересечение a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend flat_set operator&(const flat_set& a, const flat_set& b) {
+                return flat_set::combined(a, b, &flat_set::intersectionOp);
+            }
+
+            /**
+             * @brief Разность a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend flat_set operator-(const flat_set& a, const flat_set& b) {
+                return flat_set::combined(a, b, &flat_set::differenceOp);
+            }
+
+            /**
+             * @brief Симметрическая разность a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend flat_set operator^(const flat_set& a, const flat_set& b) {
+                return flat_set::combined(a, b, &flat_set::symmetricDifferenceOp);
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             *
+             * @param key
+             * @return iterator - если элемента нет в контейнере - итератор
+             * будет указывать на end()
+             */
+            iterator find(const Key& key) const {
+                return this->findKey(key);
+            }
+
+            /**
+             * @brief Аналогично find для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent (например std::less<>)
+             *
+             * @param key
+             * @return iterator
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            iterator find(const K& key) const {
+                return this->findKey(key);
+            }
+
+            /**
+             * @brief Проверяет, содержит ли контейнер элемент с определенным ключом
+             *
+             * @param key
+             * @return true - в контейнере есть этот элемент
+             * @return false - в контенер нет этого элемента
+             */
+            bool contains(const Key& key) const {
+                return this->findKey(key) != this->end();
+            }
+
+            /**
+             * @brief Аналогично contains для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent
+             *
+             * @param key
+             * @return true - есть такой элемент
+             * @return false - нет такого элемента
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            bool contains(const K& key) const {
+                return this->findKey(key) != this->end();
+            }
+
+            /**
+             * @brief Создает элемент из аргументов его конструктора
+             * и вставляет его, если в контейнере нет такого же
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return std::pair<iterator, bool> - iterator указывает на элемент, равный новому,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                return this->emplaceKey(Key(std::forward<Args>(args)...));
+            }
+
+            /**
+             * @brief Вставляет новые элеметы в контейнер, если контейнер
+             * не содержит таких же
+             * @details Каждый аргумент - отдельный элемент. Каждая вставка сдвигает
+             * элементы массива, поэтому запоминаем номера и пересчитываем их,
+             * а итераторы строим в конце - все они действительны после вызова
+             *
+             * @tparam Args
+             * @param args
+             * @return std::vector<std::pair<iterator,bool>>
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insert_many(Args&&... args) {
+                std::vector<std::pair<size_type, bool>> positions;
+                positions.reserve(sizeof...(args));
+                (this->insertTracked(positions, Key(std::forward<Args>(args))), ...);
+                std::vector<std::pair<iterator, bool>> result;
+                result.reserve(positions.size());
+                for (const auto& position : positions) {
+                    result.emplace_back(this->begin() + position.first, position.second);
+                }
+                return result;
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его с подсказкой hint
+             * @details Подсказка работает так же, как в insert(hint, value)
+             *
+             * @tparam Args
+             * @param hint
+             * @param args
+             * @return iterator - указывает на вставленный элемент или на равный ему
+             */
+            template<typename... Args>
+            iterator emplace_hint(const_iterator hint, Args&&... args) {
+                Key key(std::forward<Args>(args)...);
+                size_type index = static_cast<size_type>(hint - this->begin());
+                if (this->fitsBefore(index, key)) {
+                    return this->keys_.insert(hint, std::move(key));
+                }
+                return this->emplaceKey(std::move(key)).first;
+            }
+
+            /**
+             * @brief Возвращает iterator на k-й по порядку элемент (считая с 0)
+             * @details O(1), элементы лежат подряд
+             *
+             * @param k
+             * @return iterator - k-й элемент или end(), если k >= size()
+             */
+            iterator nth_element(size_type k) const noexcept {
+                return k < this->size() ? this->begin() + k : this->end();
+            }
+
+            /**
+             * @brief Количество элементов, меньших key (номер lower_bound(key))
+             * @details O(log n)
+             *
+             * @param key
+             * @return size_type
+             */
+            size_type rank(const Key& key) const {
+                return this->lowerBound(key);
+            }
+
+            /**
+             * @brief Количество элементов из полуинтервала [lo, hi)
+             * @details O(log n)
+             *
+             * @param lo
+             * @param hi
+             * @return size_type
+             */
+            size_type count_range(const Key& lo, const Key& hi) const {
+                size_type first = this->lowerBound(lo);
+                size_type last = this->lowerBound(hi);
+                return last > first ? last - first : 0;
+            }
+
+            /*------------------------------------------------------------*/
+
+        private:
+            key_vector keys_;
+            Compare comp_;
+
+            using set_operation = void (*)(const flat_set&, const flat_set&, key_vector&);
+
+            // Номер первого элемента, не меньшего key
+            template<typename K>
+            size_type lowerBound(const K& key) const {
+                return branchlessLowerBound(this->keys_.data(), this->keys_.size(), key, this->comp_);
+            }
+
+            template<typename K>
+            iterator findKey(const K& key) const {
+                size_type index = this->lowerBound(key);
+                if (index != this->keys_.size() && !this->comp_(key, this->keys_[index])) {
+                    return this->begin() + index;
+                }
+                return this->end();
+            }
+
+            // Можно ли вставить key прямо перед элементом с номером index, не нарушив порядок
+            bool fitsBefore(size_type index, const Key& key) const {
+                return index <= this->keys_.size() &&
+                    (index == 0 || this->comp_(this->keys_[index - 1], key)) &&
+                    (index == this->keys_.size() || this->comp_(key, this->keys_[index]));
+            }
+
+            // Вставка ключа на свое место после одного бинарного поиска
+            template<typename K>
+            std::pair<iterator, bool> emplaceKey(K&& key) {
+                size_type index = this->lowerBound(key);
+                if (index != this->keys_.size() && !this->comp_(key, this->keys_[index])) {
+                    return {this->begin() + index, false};
+                }
+                return {this->keys_.insert(this->begin() + index, std::forward<K>(key)), true};
+            }
+
+            // Вставка для insert_many: номера уже вставленных элементов за новым сдвигаются на 1
+            void insertTracked(std::vector<std::pair<size_type, bool>>& positions, Key&& key) {
+                std::pair<iterator, bool> result = this->emplaceKey(std::move(key));
+                size_type index = static_cast<size_type>(result.first - this->begin());
+                if (result.second) {
+                    for (auto& position : positions) {
+                        if (position.first >= index) {
+                            ++position.first;
+                        }
+                    }
+                }
+                positions.emplace_back(index, result.second);
+            }
+
+            // Оставляет первые size элементов
+            void truncate(size_type size) noexcept {
+                while (this->keys_.size() > size) {
+                    this->keys_.pop_back();
+                }
+            }
+
+            // Перемещает элементы src в конец dst
+            static void appendFrom(key_vector& dst, key_vector& src) {
+                dst.reserve(dst.size() + src.size());
+                for (auto& key : src) {
+                    dst.push_back(std::move(key));
+                }
+            }
+
+            static void unionOp(const flat_set& a, const flat_set& b, key_vector& out) {
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out), a.comp_);
+            }
+
+            static void intersectionOp(const flat_set& a, const flat_set& b, key_vector& out) {
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out), a.comp_);
+            }
+
+            static void differenceOp(const flat_set& a, const flat_set& b, key_vector& out) {
+                std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out), a.comp_);
+            }
+
+            static void symmetricDifferenceOp(const flat_set& a, const flat_set& b, key_vector& out) {
+                std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                              std::back_inserter(out), a.comp_);
+            }
+
+            // Результат операции op над a и b в новом контейнере
+            static flat_set combined(const flat_set& a, const flat_set& b, set_operation op) {
+                flat_set result(a.comp_,
+                                std::allocator_traits<Allocator>::select_on_container_copy_construction(a.get_allocator()));
+                bool grows = op == &flat_set::unionOp || op == &flat_set::symmetricDifferenceOp;
+                result.keys_.reserve(grows ? a.size() + b.size() : a.size());
+                op(a, b, result.keys_);
+                return result;
+            }
+
+    }; // flat_set
+} // s21
+
+#endif //SRC_S21_FLAT_SET_H_
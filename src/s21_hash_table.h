@@ -0,0 +1,863 @@
+#ifndef SRC_S21_HASH_TABLE_H_
+#define SRC_S21_HASH_TABLE_H_
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "s21_slot_policy.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+    /**
+     * @brief Хеш-таблица с открытой адресацией в духе Swiss table (abseil), на ней
+     * построены unordered_map и unordered_set - так же, как map и set построены на BinaryTree
+     *
+     * @details Элементы лежат прямо в массиве ячеек slots_, без узлов и списков.
+     * Рядом - массив управляющих байтов ctrl_, по байту на ячейку:
+     * kEmpty (старший бит 1) - ячейка пустая, 0..127 - ячейка занята, и в байте
+     * хранятся младшие 7 бит хеша элемента (h2). Остальные биты хеша (h1) задают ячейку,
+     * с которой элемент начинает поиск места ("дом" элемента).
+     *
+     * Поиск смотрит сразу группу из 16 управляющих байтов (см. Group): одной SSE2-командой
+     * сравниваем все 16 байтов с h2 и получаем маску кандидатов, ключи сравниваются
+     * только у кандидатов (ложное совпадение h2 - 1 из 128). Если в группе есть пустая
+     * ячейка, дальше искать не нужно, иначе переходим к следующим 16 ячейкам.
+     * Без SSE2 группа проверяется обычным циклом, логика та же.
+     *
+     * Группы идут подряд (линейное пробирование), поэтому между домом элемента и его
+     * ячейкой нет пустых ячеек. Благодаря этому удаление обходится без "надгробий"
+     * (tombstone): освободившуюся ячейку занимает следующий элемент, которому она
+     * по пути к дому, и так далее до первой пустой (backward shift). Таблица не зарастает
+     * удаленными ячейками, и поиск никогда не идет дольше, чем нужно живым элементам.
+     *
+     * Вместимость - степень двойки, не меньше 16, заполнение не больше 7/8.
+     * Первые 15 управляющих байтов продублированы после конца массива, чтобы группу
+     * можно было прочитать с любой позиции без проверки на выход за край.
+     *
+     * Элементы перемещаются только при росте таблицы и при удалении (сдвиг),
+     * вставка без роста итераторы не портит. Перемещается ячейка (см. SlotPolicy),
+     * у map это пара с изменяемым ключом, так что ключ переезжает без копирования
+     *
+     * @tparam Value - тип элемента
+     * @tparam Hasher - хеш элемента и ключа (для map - только по first)
+     * @tparam KeyEqual - сравнение элемента с ключом или с другим элементом
+     * @tparam Allocator - аллокатор элементов
+     */
+    template<typename Value, typename Hasher, typename KeyEqual, typename Allocator = std::allocator<Value>>
+    class HashTable {
+        class HashTableIterator;
+        class HashTableConstIterator;
+        class Group;
+        using ctrl_t = signed char;
+        using slot_policy = SlotPolicy<Value>;
+        using slot_type = typename slot_policy::slot_type;
+        using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot_type>;
+        using slot_traits = std::allocator_traits<slot_allocator>;
+        using ctrl_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ctrl_t>;
+        using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+        using size_type = std::size_t;
+        using reference = Value&;
+        using const_reference = const Value&;
+        // Пустая ячейка: единственный управляющий байт со старшим битом
+        static constexpr ctrl_t kEmpty = -128;
+        // Сколько ячеек проверяет одна группа
+        static constexpr size_type kGroupWidth = 16;
+        static constexpr size_type kMinCapacity = kGroupWidth;
+        public:
+            using iterator = HashTableIterator;
+            using const_iterator = HashTableConstIterator;
+            using allocator_type = Allocator;
+
+            /*----------------------------constructors and operators--------------------------------*/
+
+            // Пустая таблица ничего не выделяет, память берется при первой вставке
+            HashTable() : HashTable(Hasher(), KeyEqual(), Allocator()) {}
+
+            // Конструктор с аллокатором
+            explicit HashTable(const Allocator& alloc) : HashTable(Hasher(), KeyEqual(), alloc) {}
+
+            // Конструктор с хешем, сравнением и аллокатором
+            HashTable(const Hasher& hasher, const KeyEqual& equal, const Allocator& alloc = Allocator())
+                : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0),
+                  hasher_(hasher), equal_(equal), alloc_(alloc) {}
+
+            // Конструктор копирования: та же вместимость, управляющие байты копируются
+            // как есть, элементы - в те же ячейки, ничего не хешируется заново
+            HashTable(const HashTable& other)
+                : HashTable(other.hasher_, other.equal_,
+                            slot_traits::select_on_container_copy_construction(other.alloc_)) {
+                this->copyTablesFrom(other);
+            }
+
+            // Конструктор перемещения: массивы просто переходят к новой таблице,
+            // бросить может только копирование хеша и сравнения
+            HashTable(HashTable&& other) noexcept(std::is_nothrow_copy_constructible<Hasher>::value &&
+                                                  std::is_nothrow_copy_constructible<KeyEqual>::value)
+                : HashTable(other.hasher_, other.equal_, other.alloc_) {
+                this->swapTables(other);
+            }
+
+            // Деструктор
+            ~HashTable() {
+                this->clear();
+                this->freeTables();
+            }
+
+            // Оператор присваивания копированием через временную таблицу
+            HashTable& operator=(const HashTable& other) {
+                if (this != &other) {
+                    HashTable temp(other.hasher_, other.equal_,
+                        slot_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : this->alloc_);
+                    temp.copyTablesFrom(other);
+                    if (slot_traits::propagate_on_container_copy_assignment::value) {
+                        // старую память должен освободить старый аллокатор
+                        this->clear();
+                        this->freeTables();
+                        this->alloc_ = other.alloc_;
+                    }
+                    this->swapTables(temp);
+                    this->hasher_ = other.hasher_;
+                    this->equal_ = other.equal_;
+                }
+                return *this;
+            }
+
+            // Оператор присваивания перемещением
+            // Если аллокаторы равны (или аллокатор переезжает вместе с таблицей),
+            // меняемся массивами, иначе перемещаем элементы по одному в свою память
+            HashTable& operator=(HashTable&& other) {
+                if (this != &other) {
+                    this->clear();
+                    this->hasher_ = other.hasher_;
+                    this->equal_ = other.equal_;
+                    if (slot_traits::propagate_on_container_move_assignment::value || this->alloc_ == other.alloc_) {
+                        if (slot_traits::propagate_on_container_move_assignment::value) {
+                            this->freeTables();
+                            this->alloc_ = other.alloc_;
+                        }
+                        this->swapTables(other);
+                    } else {
+                        this->reserve(other.size_);
+                        for (size_type i = 0; i < other.capacity_; ++i) {
+                            if (other.isFull(i)) {
+                                this->insertNew(other.hashAt(i), slot_policy::take(other.slots_ + i));
+                            }
+                        }
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+
+            /*----------------------------------------------------------------------------------*/
+
+            /*---------------------------------methods----------------------------------*/
+
+            /**
+             * @brief Возвращает копию аллокатора таблицы
+             *
+             */
+            allocator_type get_allocator() const noexcept {
+                return allocator_type(this->alloc_);
+            }
+
+            /**
+             * @brief Итератор на первую занятую ячейку
+             *
+             */
+            iterator begin() noexcept {
+                return iterator(this->ctrl_, this->slots_, this->ctrl_ + this->capacity_).skipEmpty();
+            }
+
+            const_iterator begin() const noexcept {
+                return const_iterator(this->ctrl_, this->slots_, this->ctrl_ + this->capacity_).skipEmpty();
+            }
+
+            /**
+             * @brief Итератор за последней ячейкой
+             *
+             */
+            iterator end() noexcept {
+                return this->iteratorAt(this->capacity_);
+            }
+
+            const_iterator end() const noexcept {
+                return this->iteratorAt(this->capacity_);
+            }
+
+            bool empty() const noexcept {
+                return this->size_ == 0;
+            }
+
+            size_type size() const noexcept {
+                return this->size_;
+            }
+
+            size_type max_size() const noexcept {
+                return slot_traits::max_size(this->alloc_);
+            }
+
+            /**
+             * @brief Уничтожает все элементы, память таблицы остается
+             *
+             */
+            void clear() noexcept {
+                if (this->capacity_ == 0) {
+                    return;
+                }
+                if (!std::is_trivially_destructible<Value>::value) {
+                    for (size_type i = 0; i < this->capacity_; ++i) {
+                        if (this->isFull(i)) {
+                            slot_policy::destroy(this->alloc_, this->slots_ + i);
+                        }
+                    }
+                }
+                std::memset(this->ctrl_, kEmpty, this->capacity_ + kGroupWidth - 1);
+                this->size_ = 0;
+            }
+
+            /**
+             * @brief Находит элемент с ключом key
+             * @details K - ключ или любой тип, который понимают Hasher и KeyEqual
+             *
+             * @return iterator - найденный элемент или end()
+             */
+            template<typename K>
+            iterator find(const K& key) {
+                return this->iteratorAt(this->findIndex(key, this->hashOf(key)));
+            }
+
+            template<typename K>
+            const_iterator find(const K& key) const {
+                return this->iteratorAt(this->findIndex(key, this->hashOf(key)));
+            }
+
+            /**
+             * @brief Вставляет элемент, созданный из args, если элемента с ключом key еще нет
+             * @details Ключ ищется один раз. Элемент создается прямо в ячейке и только если
+             * вставка действительно будет, иначе args не трогаются
+             *
+             * @param key - ключ, по которому ищем (должен соответствовать будущему элементу)
+             * @param args - аргументы конструктора элемента
+             * @return std::pair<iterator, bool> - элемент с ключом key и была ли вставка
+             */
+            template<typename K, typename... Args>
+            std::pair<iterator, bool> emplaceUniqueKey(const K& key, Args&&... args) {
+                size_type hash = this->hashOf(key);
+                size_type index = this->findIndex(key, hash);
+                if (index != this->capacity_) {
+                    return {this->iteratorAt(index), false};
+                }
+                this->reserve(this->size_ + 1);
+                return {this->iteratorAt(this->insertNew(hash, std::forward<Args>(args)...)), true};
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его, если такого ключа еще нет
+             * @details Ключ неизвестен до создания элемента, поэтому элемент сначала создается
+             * во временной ячейке и перемещается в таблицу только при вставке
+             *
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplaceUnique(Args&&... args) {
+                SlotHolder<Value, slot_allocator> holder(this->alloc_, std::forward<Args>(args)...);
+                return this->emplaceUniqueKey(holder.value(), holder.take());
+            }
+
+            /**
+             * @brief Вставляет элементы, каждый аргумент - отдельный элемент
+             * @details Место под все элементы резервируется заранее, поэтому таблица
+             * не растет посередине и все итераторы результата остаются действительными
+             *
+             * @return std::vector<std::pair<iterator,bool>>
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insertManyUnique(Args&&... args) {
+                std::vector<std::pair<iterator, bool>> v;
+                v.reserve(sizeof...(args));
+                this->reserve(this->size_ + sizeof...(args));
+                (v.push_back(this->emplaceUnique(std::forward<Args>(args))), ...);
+                return v;
+            }
+
+            /**
+             * @brief Удаляет элемент pos
+             * @details Без надгробий: следующие за ячейкой элементы, которым она по пути
+             * к дому, сдвигаются назад (см. описание класса). Итераторы на сдвинутые
+             * элементы становятся недействительными
+             *
+             */
+            void erase(const_iterator pos) {
+                this->eraseIndex(static_cast<size_type>(pos.ctrl_ - this->ctrl_));
+            }
+
+            /**
+             * @brief Переносит из other элементы, ключей которых нет в this
+             * @details Каждый перенесенный элемент удаляется из other обычным eraseIndex
+             * со сдвигом назад, так что other в любой момент - целая таблица, даже если
+             * рост this или перенос бросят исключение. После удаления в ячейку i может
+             * сдвинуться следующий элемент, поэтому ее проверяем еще раз. Сдвиг переносит
+             * непросмотренные элементы только назад до i, а уже просмотренные (оставшиеся
+             * в other повторы) - через конец массива в начало, их повторная проверка ничего
+             * не меняет. Хеш для this считается хешем this
+             *
+             */
+            void mergeUnique(HashTable& other) {
+                if (this == &other) {
+                    return;
+                }
+                size_type i = 0;
+                while (i < other.capacity_) {
+                    if (!other.isFull(i)) {
+                        ++i;
+                        continue;
+                    }
+                    size_type hash = this->hashOf(slot_policy::element(other.slots_ + i));
+                    if (this->findIndex(slot_policy::element(other.slots_ + i), hash) != this->capacity_) {
+                        ++i;
+                        continue;
+                    }
+                    this->reserve(this->size_ + 1);
+                    this->insertNew(hash, slot_policy::take(other.slots_ + i));
+                    other.eraseIndex(i);
+                }
+            }
+
+            /**
+             * @brief Готовит таблицу к count элементам без роста
+             *
+             */
+            void reserve(size_type count) {
+                if (count > maxLoad(this->capacity_)) {
+                    this->resize(capacityFor(count));
+                }
+            }
+
+            /**
+             * @brief Перестраивает таблицу под не меньше count ячеек
+             * @details Вместимость не станет меньше нужной для текущих элементов,
+             * rehash(0) сжимает таблицу до минимально нужной
+             *
+             */
+            void rehash(size_type count) {
+                size_type capacity = std::max(capacityFor(this->size_), normalizeCapacity(count));
+                if (this->size_ == 0 && count == 0) {
+                    capacity = 0;
+                }
+                if (capacity != this->capacity_) {
+                    this->resize(capacity);
+                }
+            }
+
+            /**
+             * @brief Количество ячеек
+             *
+             */
+            size_type bucketCount() const noexcept {
+                return this->capacity_;
+            }
+
+            /**
+             * @brief Доля занятых ячеек
+             *
+             */
+            float loadFactor() const noexcept {
+                return this->capacity_ == 0 ? 0.0f
+                    : static_cast<float>(this->size_) / static_cast<float>(this->capacity_);
+            }
+
+            /**
+             * @brief Меняет содержимое таблиц
+             *
+             */
+            void swap(HashTable& other) noexcept {
+                if (slot_traits::propagate_on_container_swap::value) {
+                    std::swap(this->alloc_, other.alloc_);
+                }
+                this->swapTables(other);
+                std::swap(this->hasher_, other.hasher_);
+                std::swap(this->equal_, other.equal_);
+            }
+
+            /*----------------------------------------------------------------------------------*/
+
+        private:
+            /**
+             * @brief Перемешивает биты хеша
+             * @details std::hash для целых чисел - тождественная функция, у последовательных
+             * ключей совпадут старшие биты (h1) и почти все h2. Умножение на нечетную
+             * константу (золотое сечение) и свертка половинок произведения разносят
+             * любой бит ключа по всем битам результата
+             *
+             */
+            static size_type mix(size_type hash) noexcept {
+                std::uint64_t product = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+                return static_cast<size_type>(product ^ (product >> 32));
+            }
+
+            template<typename K>
+            size_type hashOf(const K& key) const {
+                return mix(this->hasher_(key));
+            }
+
+            // Хеш элемента в ячейке index (хешируем const-вид, как его видит пользователь)
+            size_type hashAt(size_type index) const {
+                return this->hashOf(slot_policy::element(this->slots_ + index));
+            }
+
+            // Младшие 7 бит хеша - то, что хранится в управляющем байте
+            static ctrl_t h2(size_type hash) noexcept {
+                return static_cast<ctrl_t>(hash & 0x7F);
+            }
+
+            // Дом элемента: ячейка, с которой начинается его поиск
+            size_type homeOf(size_type hash) const noexcept {
+                return (hash >> 7) & (this->capacity_ - 1);
+            }
+
+            bool isFull(size_type index) const noexcept {
+                return this->ctrl_[index] >= 0;
+            }
+
+            // Больше стольких элементов в таблице на capacity ячеек не держим (7/8)
+            static size_type maxLoad(size_type capacity) noexcept {
+                return capacity - capacity / 8;
+            }
+
+            // Наименьшая вместимость, в которую помещается count элементов
+            static size_type capacityFor(size_type count) noexcept {
+                size_type capacity = kMinCapacity;
+                while (maxLoad(capacity) < count) {
+                    capacity *= 2;
+                }
+                return capacity;
+            }
+
+            // Степень двойки не меньше count и не меньше kMinCapacity
+            static size_type normalizeCapacity(size_type count) noexcept {
+                size_type capacity = kMinCapacity;
+                while (capacity < count) {
+                    capacity *= 2;
+                }
+                return capacity;
+            }
+
+            iterator iteratorAt(size_type index) noexcept {
+                return iterator(this->ctrl_ + index, this->slots_ + index, this->ctrl_ + this->capacity_);
+            }
+
+            const_iterator iteratorAt(size_type index) const noexcept {
+                return const_iterator(this->ctrl_ + index, this->slots_ + index, this->ctrl_ + this->capacity_);
+            }
+
+            /**
+             * @brief Ищет ячейку элемента с ключом key
+             * @details Идем группами от дома: кандидаты - ячейки с тем же h2,
+             * пустая ячейка в группе означает, что дальше элемента точно нет
+             *
+             * @return size_type - номер ячейки или capacity_, если элемента нет
+             */
+            template<typename K>
+            size_type findIndex(const K& key, size_type hash) const {
+                if (this->size_ == 0) {
+                    return this->capacity_;
+                }
+                size_type mask = this->capacity_ - 1;
+                size_type pos = this->homeOf(hash);
+                while (true) {
+                    Group group(this->ctrl_ + pos);
+                    for (std::uint32_t match = group.match(h2(hash)); match != 0; match &= match - 1) {
+                        size_type index = (pos + countTrailingZeros(match)) & mask;
+                        if (this->equal_(slot_policy::element(this->slots_ + index), key)) {
+                            return index;
+                        }
+                    }
+                    if (group.matchEmpty() != 0) {
+                        return this->capacity_;
+                    }
+                    pos = (pos + kGroupWidth) & mask;
+                }
+            }
+
+            // Первая пустая ячейка начиная с дома (место есть - заполнение не больше 7/8)
+            size_type findEmpty(size_type hash) const noexcept {
+                size_type mask = this->capacity_ - 1;
+                size_type pos = this->homeOf(hash);
+                while (true) {
+                    std::uint32_t empty = Group(this->ctrl_ + pos).matchEmpty();
+                    if (empty != 0) {
+                        return (pos + countTrailingZeros(empty)) & mask;
+                    }
+                    pos = (pos + kGroupWidth) & mask;
+                }
+            }
+
+            // Записывает управляющий байт и его копию за концом массива
+            void setCtrl(size_type index, ctrl_t value) noexcept {
+                this->ctrl_[index] = value;
+                if (index < kGroupWidth - 1) {
+                    this->ctrl_[this->capacity_ + index] = value;
+                }
+            }
+
+            /**
+             * @brief Создает элемент в первой свободной ячейке для хеша hash
+             * @details Проверку на повтор и на место делает вызывающий
+             *
+             * @return size_type - номер ячейки
+             */
+            template<typename... Args>
+            size_type insertNew(size_type hash, Args&&... args) {
+                size_type index = this->findEmpty(hash);
+                slot_policy::construct(this->alloc_, this->slots_ + index, std::forward<Args>(args)...);
+                this->setCtrl(index, h2(hash));
+                ++this->size_;
+                return index;
+            }
+
+            /**
+             * @brief Удаляет элемент в ячейке index и сдвигает назад элементы за ней
+             * @details Идем от освободившейся ячейки hole вперед до первой пустой.
+             * Элемент в ячейке next можно поставить в hole, если его дом не лежит
+             * между hole и next (по кругу) - тогда hole у него по пути от дома.
+             * Переставленный элемент оставляет новую дыру, продолжаем с нее.
+             * Управляющий байт меняется вместе с ячейкой, поэтому занятыми помечены только
+             * живые элементы, что бы ни бросило посередине. Если бросит перенос (бывает только
+             * у типов без noexcept-перемещения) или хеш, элементы за дырой могут перестать
+             * находиться - таблица перестраивается заново
+             *
+             */
+            void eraseIndex(size_type index) {
+                size_type mask = this->capacity_ - 1;
+                slot_policy::destroy(this->alloc_, this->slots_ + index);
+                this->setCtrl(index, kEmpty);
+                --this->size_;
+                try {
+                    size_type hole = index;
+                    for (size_type next = (hole + 1) & mask; this->isFull(next); next = (next + 1) & mask) {
+                        size_type home = this->homeOf(this->hashAt(next));
+                        if (((next - home) & mask) >= ((next - hole) & mask)) {
+                            this->transfer(hole, next);
+                            hole = next;
+                        }
+                    }
+                } catch (...) {
+                    this->resize(this->capacity_);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Переносит элемент из ячейки src в пустую ячейку dst
+             * @details Ячейка перемещается (у map - вместе с ключом, см. SlotPolicy),
+             * для типов с noexcept-перемещением перенос не бросает
+             *
+             */
+            void transfer(size_type dst, size_type src) noexcept(slot_policy::kNothrowTake) {
+                slot_policy::construct(this->alloc_, this->slots_ + dst, slot_policy::take(this->slots_ + src));
+                this->setCtrl(dst, this->ctrl_[src]);
+                slot_policy::destroy(this->alloc_, this->slots_ + src);
+                this->setCtrl(src, kEmpty);
+            }
+
+            /**
+             * @brief Переносит элементы в новую таблицу на capacity ячеек
+             * @details Новая таблица собирается во временном объекте: если перенос
+             * бросит исключение, this не меняется (элементы, которые нельзя переместить
+             * без исключений, копируются, как в std::move_if_noexcept; у map ключ в ячейке
+             * изменяемый, так что пары со строками и прочими обычными ключами перемещаются).
+             * После обмена временный объект уничтожает старые элементы и освобождает старую память
+             *
+             */
+            void resize(size_type capacity) {
+                HashTable table(this->hasher_, this->equal_, this->alloc_);
+                table.allocateTables(capacity);
+                for (size_type i = 0; i < this->capacity_; ++i) {
+                    if (this->isFull(i)) {
+                        if constexpr (slot_policy::kNothrowTake || !std::is_copy_constructible<Value>::value) {
+                            table.insertNew(this->hashAt(i), slot_policy::take(this->slots_ + i));
+                        } else {
+                            table.insertNew(this->hashAt(i), slot_policy::element(this->slots_ + i));
+                        }
+                    }
+                }
+                this->swapTables(table);
+            }
+
+            // Выделяет пустые массивы на capacity ячеек (таблица должна быть без памяти)
+            void allocateTables(size_type capacity) {
+                if (capacity == 0) {
+                    return;
+                }
+                ctrl_allocator ctrl_alloc(this->alloc_);
+                this->ctrl_ = ctrl_traits::allocate(ctrl_alloc, capacity + kGroupWidth - 1);
+                try {
+                    this->slots_ = slot_traits::allocate(this->alloc_, capacity);
+                } catch (...) {
+                    ctrl_traits::deallocate(ctrl_alloc, this->ctrl_, capacity + kGroupWidth - 1);
+                    this->ctrl_ = nullptr;
+                    throw;
+                }
+                std::memset(this->ctrl_, kEmpty, capacity + kGroupWidth - 1);
+                this->capacity_ = capacity;
+            }
+
+            // Освобождает массивы, элементы к этому моменту должны быть уничтожены
+            void freeTables() noexcept {
+                if (this->capacity_ == 0) {
+                    return;
+                }
+                ctrl_allocator ctrl_alloc(this->alloc_);
+                ctrl_traits::deallocate(ctrl_alloc, this->ctrl_, this->capacity_ + kGroupWidth - 1);
+                slot_traits::deallocate(this->alloc_, this->slots_, this->capacity_);
+                this->ctrl_ = nullptr;
+                this->slots_ = nullptr;
+                this->capacity_ = 0;
+            }
+
+            // Копирует other в пустую таблицу ячейка в ячейку
+            void copyTablesFrom(const HashTable& other) {
+                if (other.size_ == 0) {
+                    return;
+                }
+                this->allocateTables(other.capacity_);
+                try {
+                    for (size_type i = 0; i < other.capacity_; ++i) {
+                        if (other.isFull(i)) {
+                            slot_policy::construct(this->alloc_, this->slots_ + i, slot_policy::element(other.slots_ + i));
+                            this->setCtrl(i, other.ctrl_[i]);
+                            ++this->size_;
+                        }
+                    }
+                } catch (...) {
+                    this->clear();
+                    this->freeTables();
+                    throw;
+                }
+            }
+
+            // Обмен массивами и размерами (аллокаторы должны быть равны)
+            void swapTables(HashTable& other) noexcept {
+                std::swap(this->ctrl_, other.ctrl_);
+                std::swap(this->slots_, other.slots_);
+                std::swap(this->capacity_, other.capacity_);
+                std::swap(this->size_, other.size_);
+            }
+
+            // Номер младшего единичного бита (mask != 0)
+            static size_type countTrailingZeros(std::uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                return static_cast<size_type>(__builtin_ctz(mask));
+#else
+                size_type count = 0;
+                for (; (mask & 1) == 0; mask >>= 1) {
+                    ++count;
+                }
+                return count;
+#endif
+            }
+
+            /**
+             * @brief 16 управляющих байтов, проверяемых разом
+             * @details С SSE2 - одна загрузка, одно сравнение и movemask на запрос,
+             * без SSE2 - цикл по байтам с тем же результатом: бит i маски
+             * соответствует ячейке pos + i
+             *
+             */
+            class Group {
+                public:
+                    explicit Group(const ctrl_t* pos) noexcept {
+#if defined(__SSE2__)
+                        this->ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+#else
+                        std::memcpy(this->ctrl_, pos, kGroupWidth);
+#endif
+                    }
+
+                    // Ячейки, у которых управляющий байт равен h2
+                    std::uint32_t match(ctrl_t hash) const noexcept {
+#if defined(__SSE2__)
+                        return static_cast<std::uint32_t>(
+                            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), this->ctrl_)));
+#else
+                        std::uint32_t mask = 0;
+                        for (size_type i = 0; i < kGroupWidth; ++i) {
+                            mask |= static_cast<std::uint32_t>(this->ctrl_[i] == hash) << i;
+                        }
+                        return mask;
+#endif
+                    }
+
+                    // Пустые ячейки: старший бит есть только у kEmpty
+                    std::uint32_t matchEmpty() const noexcept {
+#if defined(__SSE2__)
+                        return static_cast<std::uint32_t>(_mm_movemask_epi8(this->ctrl_));
+#else
+                        return this->match(kEmpty);
+#endif
+                    }
+
+                private:
+#if defined(__SSE2__)
+                    __m128i ctrl_;
+#else
+                    ctrl_t ctrl_[kGroupWidth];
+#endif
+            };
+
+            /*-----------------------iterator-----------------------------*/
+
+            /**
+             * @brief Итератор по занятым ячейкам в порядке их номеров
+             * @details Хранит управляющий байт, ячейку и конец массива управляющих байтов,
+             * ++ пропускает пустые ячейки
+             *
+             */
+            class HashTableIterator {
+                friend HashTable;
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = Value;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = Value*;
+                    using reference = Value&;
+
+                    HashTableIterator() noexcept : ctrl_(nullptr), slot_(nullptr), end_(nullptr) {}
+
+                    reference operator*() const noexcept {
+                        return slot_policy::element(this->slot_);
+                    }
+
+                    pointer operator->() const noexcept {
+                        return &slot_policy::element(this->slot_);
+                    }
+
+                    iterator& operator++() noexcept {
+                        ++this->ctrl_;
+                        ++this->slot_;
+                        return this->skipEmpty();
+                    }
+
+                    iterator operator++(int) noexcept {
+                        iterator temp(*this);
+                        ++(*this);
+                        return temp;
+                    }
+
+                    bool operator==(const iterator& other) const noexcept {
+                        return this->ctrl_ == other.ctrl_;
+                    }
+
+                    bool operator!=(const iterator& other) const noexcept {
+                        return this->ctrl_ != other.ctrl_;
+                    }
+
+                private:
+                    HashTableIterator(const ctrl_t* ctrl, slot_type* slot, const ctrl_t* end) noexcept
+                        : ctrl_(ctrl), slot_(slot), end_(end) {}
+
+                    iterator& skipEmpty() noexcept {
+                        while (this->ctrl_ != this->end_ && *this->ctrl_ < 0) {
+                            ++this->ctrl_;
+                            ++this->slot_;
+                        }
+                        return *this;
+                    }
+
+                    const ctrl_t* ctrl_;
+                    slot_type* slot_;
+                    const ctrl_t* end_;
+            };
+
+            /*------------------------const_iterator------------------------*/
+
+            /**
+             * @brief Аналогично HashTableIterator, но элемент менять нельзя
+             *
+             */
+            class HashTableConstIterator {
+                friend HashTable;
+                // Как дружественные, чтобы сравнивать и с iterator (он приводится к const_iterator)
+                friend bool operator==(const const_iterator& it1, const const_iterator& it2) noexcept {
+                    return it1.ctrl_ == it2.ctrl_;
+                }
+
+                friend bool operator!=(const const_iterator& it1, const const_iterator& it2) noexcept {
+                    return it1.ctrl_ != it2.ctrl_;
+                }
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = Value;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const Value*;
+                    using reference = const Value&;
+
+                    HashTableConstIterator() noexcept : ctrl_(nullptr), slot_(nullptr), end_(nullptr) {}
+
+                    HashTableConstIterator(const iterator& other) noexcept
+                        : ctrl_(other.ctrl_), slot_(other.slot_), end_(other.end_) {}
+
+                    reference operator*() const noexcept {
+                        return slot_policy::element(this->slot_);
+                    }
+
+                    pointer operator->() const noexcept {
+                        return &slot_policy::element(this->slot_);
+                    }
+
+                    const_iterator& operator++() noexcept {
+                        ++this->ctrl_;
+                        ++this->slot_;
+                        return this->skipEmpty();
+                    }
+
+                    const_iterator operator++(int) noexcept {
+                        const_iterator temp(*this);
+                        ++(*this);
+                        return temp;
+                    }
+
+                private:
+                    HashTableConstIterator(const ctrl_t* ctrl, const slot_type* slot, const ctrl_t* end) noexcept
+                        : ctrl_(ctrl), slot_(slot), end_(end) {}
+
+                    const_iterator& skipEmpty() noexcept {
+                        while (this->ctrl_ != this->end_ && *this->ctrl_ < 0) {
+                            ++this->ctrl_;
+                            ++this->slot_;
+                        }
+                        return *this;
+                    }
+
+                    const ctrl_t* ctrl_;
+                    const slot_type* slot_;
+                    const ctrl_t* end_;
+            };
+
+            /*---------------------------------------------------------------*/
+            // управляющие байты: capacity_ + kGroupWidth - 1 (копия начала в конце)
+            ctrl_t* ctrl_;
+            // ячейки элементов (см. SlotPolicy)
+            slot_type* slots_;
+            // количество ячеек, степень двойки или 0
+            size_type capacity_;
+            // количество элементов
+            size_type size_;
+            // хеш элемента/ключа
+            Hasher hasher_;
+            // сравнение элемента с ключом
+            KeyEqual equal_;
+            // аллокатор, перепривязанный на тип ячейки
+            slot_allocator alloc_;
+    }; // HashTable
+} // s21
+
+#endif // SRC_S21_HASH_TABLE_H_
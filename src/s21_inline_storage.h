@@ -0,0 +1,82 @@
+#ifndef SRC_S21_INLINE_STORAGE_H_
+#define SRC_S21_INLINE_STORAGE_H_
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+    /**
+     * @brief Хранилище на Cap ячеек внутри объекта, как у s21::array, но без обязательства
+     * держать в каждой ячейке живой элемент
+     * @details Хранилище не знает, в каких ячейках есть элементы - это помнит контейнер
+     * (static_vector, ring_buffer), он же создает и уничтожает элементы через construct и destroy.
+     * Два варианта:
+     * - для тривиальных T (std::is_trivial) это обычный массив T[Cap], обнуленный при создании.
+     * "Создание" элемента - присваивание, уничтожение - ничего. Все операции constexpr,
+     * а контейнер над таким хранилищем - литеральный тип и работает в constexpr-вычислениях;
+     * - для остальных T это сырая память под Cap элементов, элементы создаются
+     * placement new и уничтожаются явным вызовом деструктора.
+     *
+     * @tparam T - тип элемента
+     * @tparam Cap - количество ячеек, Cap > 0
+     * @tparam Trivial - какой вариант выбран, по умолчанию по std::is_trivial<T>
+     */
+    template<typename T, std::size_t Cap, bool Trivial = std::is_trivial<T>::value>
+    class InlineStorage {
+        static_assert(Cap > 0, "s21::InlineStorage: capacity must be positive");
+        using size_type = std::size_t;
+        public:
+            constexpr T* slot(size_type i) noexcept {
+                return this->data_ + i;
+            }
+
+            constexpr const T* slot(size_type i) const noexcept {
+                return this->data_ + i;
+            }
+
+            template<typename... Args>
+            constexpr T& construct(size_type i, Args&&... args) {
+                this->data_[i] = T(std::forward<Args>(args)...);
+                return this->data_[i];
+            }
+
+            constexpr void destroy(size_type) noexcept {}
+
+        private:
+            T data_[Cap]{};
+    };
+
+    template<typename T, std::size_t Cap>
+    class InlineStorage<T, Cap, false> {
+        static_assert(Cap > 0, "s21::InlineStorage: capacity must be positive");
+        using size_type = std::size_t;
+        public:
+            InlineStorage() noexcept {}
+            // Копировать байты нельзя, элементы копирует контейнер
+            InlineStorage(const InlineStorage&) = delete;
+            InlineStorage& operator=(const InlineStorage&) = delete;
+
+            T* slot(size_type i) noexcept {
+                return std::launder(reinterpret_cast<T*>(this->storage_)) + i;
+            }
+
+            const T* slot(size_type i) const noexcept {
+                return std::launder(reinterpret_cast<const T*>(this->storage_)) + i;
+            }
+
+            template<typename... Args>
+            T& construct(size_type i, Args&&... args) {
+                return *::new (static_cast<void*>(this->slot(i))) T(std::forward<Args>(args)...);
+            }
+
+            void destroy(size_type i) noexcept {
+                this->slot(i)->~T();
+            }
+
+        private:
+            alignas(T) unsigned char storage_[Cap * sizeof(T)];
+    };
+}
+
+#endif // SRC_S21_INLINE_STORAGE_H_
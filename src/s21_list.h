@@ -1,9 +1,12 @@
 #ifndef SRC_S21_LIST_H_
 #define SRC_S21_LIST_H_
+#include <functional>
 #include <iterator>
 #include <initializer_list>
 #include <limits>
 #include <iostream>
+#include <memory>
+#include <utility>
 
 namespace s21 {
     /**
@@ -14,15 +17,21 @@ namespace s21 {
      * Наша реализация в виде двусвязного списка, где каждый узел имеет указатель на след.
      * элемент и указатель на пред. элемент.
      * поле head_ указывает наслужебный узел (заглушка) это будет концом списка (end()).
+     * Узлы выделяются аллокатором Allocator, перепривязанным на тип узла через std::allocator_traits.
      * 
+     * @tparam T
+     * @tparam Allocator - аллокатор элементов
      */
-    template<typename T>
+    template<typename T, typename Allocator = std::allocator<T>>
     class list {
         class ListNode;
         class ListIterator;
         class ListConstIterator;
+        using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ListNode>;
+        using node_traits = std::allocator_traits<node_allocator>;
         public:
             using value_type = T;
+            using allocator_type = Allocator;
             using reference = T&;
             using const_reference = const T&;
             using size_type = std::size_t;
@@ -35,9 +44,16 @@ namespace s21 {
              * @brief Конструктор создает пустой список в нем служебный узел
              * 
              */
-            list() {
+            list() : list(Allocator()) {}
+
+            /**
+             * @brief Конструктор создает пустой список с заданным аллокатором
+             *
+             * @param alloc - аллокатор
+             */
+            explicit list(const Allocator& alloc) : alloc_(alloc) {
                 this->size_ = 0;
-                this->head_ = new ListNode;
+                this->head_ = this->createNode();
             }
 
             /**
@@ -45,7 +61,7 @@ namespace s21 {
              * 
              * @param items - список элементов
              */
-            list(std::initializer_list<value_type> const &items) : list() {
+            list(std::initializer_list<value_type> const &items, const Allocator& alloc = Allocator()) : list(alloc) {
                 for (auto element : items) {
                     this->push_back(element);
                 }
@@ -57,7 +73,7 @@ namespace s21 {
              * 
              * @param n - количество узлов в списке
              */
-            explicit list(size_type n) : list() {
+            explicit list(size_type n, const Allocator& alloc = Allocator()) : list(alloc) {
                 for (; n > 0; --n) {
                     this->push_back(value_type{});
                 }
@@ -65,10 +81,11 @@ namespace s21 {
 
             /**
              * @brief Конструктор создает список путем копирования из  other
+             * @details Аллокатор для копии выбирает сам аллокатор (select_on_container_copy_construction)
              * 
              * @param other - копируемый список
              */
-            list(const list& other) : list() {
+            list(const list& other) : list(node_traits::select_on_container_copy_construction(other.alloc_)) {
                 for (auto element : other) {
                     this->push_back(element);
                 }
@@ -80,7 +97,7 @@ namespace s21 {
              * 
              * @param other - перемещаемый список
              */
-            list(list&& other) : list() {
+            list(list&& other) : list(other.alloc_) {
                 *this = std::move(other);
             }
 
@@ -90,7 +107,7 @@ namespace s21 {
              */
             ~list() {
                 this->clear();
-                delete this->head_;
+                this->destroyNode(this->head_);
             }
 
             /**
@@ -134,15 +151,29 @@ namespace s21 {
             
             /**
              * @brief Оператор присваивания перемещением
-             * @details Тут просто очищаем this и меняем указатели
+             * @details Тут просто очищаем this и меняем указатели.
+             * Если аллокаторы не равны и аллокатор не переезжает вместе со списком,
+             * чужие узлы забрать нельзя - перемещаем элементы в свои узлы по одному
              * 
              * @param other - перемещающий список
              * @return list& - возвращает перемещенный список по ссылке
              */
-            list& operator=(list&& other) noexcept {
+            list& operator=(list&& other) {
                 if (this != &other) {
                     this->clear();
-                    this->swap(other);
+                    if (node_traits::propagate_on_container_move_assignment::value) {
+                        // Служебные узлы переезжают вместе со своими аллокаторами
+                        std::swap(this->alloc_, other.alloc_);
+                        std::swap(this->head_, other.head_);
+                        std::swap(this->size_, other.size_);
+                    } else if (this->alloc_ == other.alloc_) {
+                        this->swap(other);
+                    } else {
+                        for (iterator it = other.begin(); it != other.end(); ++it) {
+                            this->linkNode(this->end(), this->createNode(std::move(*it), nullptr, nullptr));
+                        }
+                        other.clear();
+                    }
                 }
                 return *this;
             }
@@ -151,6 +182,15 @@ namespace s21 {
 
             /*----------------------------------methods list------------------------------------*/
 
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return allocator_type(this->alloc_);
+            }
+
             /**
              * @brief Получить доступ к первому элементу
              * 
@@ -311,11 +351,7 @@ namespace s21 {
              * @return iterator 
              */
             iterator insert(iterator pos, const_reference value) {
-                ListNode* new_node = new ListNode(value, pos.currentNode_, pos.currentNode_->prev_);
-                pos.currentNode_->prev_->next_ = new_node;
-                pos.currentNode_->prev_ = new_node;
-                this->size_++;
-                return iterator(new_node);
+                return this->linkNode(pos, this->createNode(value, nullptr, nullptr));
             }
 
             /**
@@ -332,7 +368,7 @@ namespace s21 {
                     // На сякий случай зануляем указатели удаляемого элемента
                     pos.currentNode_->prev_ = nullptr;
                     pos.currentNode_->next_ = nullptr;
-                    delete pos.currentNode_;
+                    this->destroyNode(pos.currentNode_);
                     this->size_--;
                 }
             }
@@ -344,6 +380,9 @@ namespace s21 {
              */
             void swap(list& other) {
                 if (this != &other) {
+                    if (node_traits::propagate_on_container_swap::value) {
+                        std::swap(this->alloc_, other.alloc_);
+                    }
                     std::swap(this->head_, other.head_);
                     std::swap(this->size_, other.size_);
                 }
@@ -355,23 +394,57 @@ namespace s21 {
              * @param other 
              */
             void merge(list& other) {
-                if (this != &other) {
-                    iterator this_begin = this->begin();
-                    iterator this_end = this->end();
-                    iterator other_begin = other.begin();
-                    iterator other_end = other.end();
-                    while (this_begin != this_end && other_begin != other_end) {
-                        if (*other_begin < *this_begin) {
-                            this->insert(this_begin, *other_begin);
-                            iterator temp = other_begin;
-                            ++other_begin;
-                            other.erase(temp);
-                        } else {
-                            ++this_begin;
+                this->merge(other, std::less<value_type>());
+            }
+
+            /**
+             * @brief Объединяет два отсортированных по comp списка
+             * @details Узлы other перепривязываются в this, ничего не создается и не копируется.
+             * Идем по this один раз: каждый узел other встает перед первым элементом this,
+             * который строго больше его, поэтому при равенстве элементы this идут раньше.
+             * Когда this закончился, оставшийся хвост other цепляется в конец целиком.
+             * Каждый узел сразу отцепляется от other вместе с размерами обоих списков,
+             * поэтому если comp бросит исключение, остаются два корректных списка
+             * (как у std::list::merge): перенесенные узлы уже в this, остальные в other
+             * 
+             * @tparam Compare - comp(a, b) == true, если a должен стоять раньше b
+             * @param other 
+             * @param comp 
+             */
+            template<typename Compare>
+            void merge(list& other, Compare comp) {
+                if (this != &other && !other.empty()) {
+                    ListNode* pos = this->head_->next_;
+                    ListNode* node = other.head_->next_;
+                    while (node != other.head_) {
+                        while (pos != this->head_ && !comp(node->data_, pos->data_)) {
+                            pos = pos->next_;
                         }
+                        if (pos == this->head_) {
+                            break;
+                        }
+                        ListNode* next = node->next_;
+                        other.head_->next_ = next;
+                        next->prev_ = other.head_;
+                        --other.size_;
+                        node->next_ = pos;
+                        node->prev_ = pos->prev_;
+                        pos->prev_->next_ = node;
+                        pos->prev_ = node;
+                        ++this->size_;
+                        node = next;
+                    }
+                    if (node != other.head_) {
+                        ListNode* last = other.head_->prev_;
+                        node->prev_ = this->head_->prev_;
+                        this->head_->prev_->next_ = node;
+                        last->next_ = this->head_;
+                        this->head_->prev_ = last;
+                        this->size_ += other.size_;
+                        other.size_ = 0;
+                        other.head_->next_ = other.head_;
+                        other.head_->prev_ = other.head_;
                     }
-
-                    this->splice(this->end(), other);
                 }
             }
 
@@ -447,79 +520,65 @@ namespace s21 {
 
             /**
              * @brief Сортирует элементы в порядке возрастания
-             * @details Алгоритм основан на быстрой сортировке, избавился от рекурсии,
-             * сделал с помощью цикла
              * 
              */
             void sort() {
+                this->sort(std::less<value_type>());
+            }
+
+            /**
+             * @brief Сортирует элементы по компаратору comp
+             * @details Восходящая сортировка слиянием, устойчивая, O(n log n).
+             * Узлы только перепривязываются, элементы не копируются и не меняются местами.
+             * Кольцо размыкается в односвязную цепочку по next_, bins[k] хранит
+             * уже отсортированный кусок из 2^k узлов (как разряды двоичного счетчика).
+             * Каждый новый узел "переносится" по занятым bins, сливаясь с ними.
+             * В конце куски сливаются в один, и по цепочке восстанавливаются prev_.
+             * Если comp бросит исключение, все узлы лежат в bins и в еще не разобранной
+             * цепочке node (см. mergeChains): они склеиваются без сравнений, список
+             * снова замыкается в кольцо и остается корректным, но порядок не определен
+             * 
+             * @tparam Compare - comp(a, b) == true, если a должен стоять раньше b
+             * @param comp 
+             */
+            template<typename Compare>
+            void sort(Compare comp) {
                 if (this->size_ > 1) {
-                    //Инициализируем переменные для работы с сортировкой
-                    //i_it и j_it - итераторы
-                    //i и j - индексы итераторов, показывают на каком индексе стоит итератор
-                    //pivot - опорный элемент
-                    //lift и right - индексы границ левого и правого
-                    iterator i_it, j_it, pivot_it;
-                    int i, j;
-                    int left = 0;
-                    int right = this->size_ - 1;
-                    value_type pivot;
-                    list<int> lt = {left, right};
-                    // В цикле до тех пор, пока наш список индексов (lt) не пуст
-                    while (!lt.empty()) {
-                        // Вытаскиваем из списка индексы
-                        right = *(--(lt.end()));
-                        lt.pop_back();
-                        left = *(--(lt.end()));
-                        lt.pop_back();
-                        i = left;
-                        j = right;
-                        i_it = this->begin();
-                        j_it = this->begin();
-                        pivot_it = this->begin();
-                        // Настраиваем наши итераторы на нужные границы и находим опорный элемент 
-                        for (int i_left = 0; i_left < i; ++i_left, ++i_it);
-                        for (int j_right = 0; j_right < j; ++j_right, ++j_it);
-                        // Опорный элемент у нас центральный
-                        for (int search_pivot = 0; search_pivot < (i + j) / 2; ++search_pivot, ++pivot_it);
-                        pivot = *pivot_it;
-                        while (i <= j) {
-                            // левая сторона - проходимся по элементам слева на право
-                            // и ищем элемент который БОЛЬШЕ опорного элемента
-                            while (*i_it < pivot) { ++i; ++i_it; }
-                            // Правая сторона - проходимся по элементам справа на лево
-                            // и ищем элемент который МЕНЬШЕ опорного элемента
-                            while (*j_it > pivot) { --j; --j_it; }
-                            // пока i находится левее отностельно j
-                            // мы будем менять местами элементы
-                            if (i <= j) {
-                                // найденные элементы  меняем местами и двигаем
-                                // итераторы и идексы т.к. индексы завязаны с итераторами
-                                std::swap(*i_it, *j_it);
-                                ++i;
-                                ++i_it;
-                                --j;
-                                --j_it;
+                    this->head_->prev_->next_ = nullptr;
+                    ListNode* bins[std::numeric_limits<size_type>::digits] = {};
+                    size_type fill = 0;
+                    ListNode* node = this->head_->next_;
+                    try {
+                        while (node != nullptr) {
+                            ListNode* carry = node;
+                            node = node->next_;
+                            carry->next_ = nullptr;
+                            size_type k = 0;
+                            // В bins[k] более ранние элементы, поэтому он идет первым - так сохраняется устойчивость
+                            for (; k < fill && bins[k] != nullptr; ++k) {
+                                mergeChains(bins[k], carry, comp);
+                                carry = bins[k];
+                                bins[k] = nullptr;
+                            }
+                            bins[k] = carry;
+                            if (k == fill) {
+                                ++fill;
                             }
                         }
-
-                        // Проверяем если левая граница левее j
-                        // тогда заносим индексы левой граница и j
-                        if (left < j) {
-                            lt.push_back(left);
-                            lt.push_back(j);
+                        for (size_type k = 1; k < fill; ++k) {
+                            ListNode* later = bins[k - 1];
+                            bins[k - 1] = nullptr;
+                            mergeChains(bins[k], later, comp);
                         }
-
-                        // Проверяем если правая граница правее i
-                        // тогда заносим индексы i и правой граница
-                        if (right > i) {
-                            lt.push_back(i);
-                            lt.push_back(right);
+                    } catch (...) {
+                        ListNode* rest = node;
+                        for (size_type k = 0; k < fill; ++k) {
+                            rest = appendChain(bins[k], rest);
                         }
-
-                        // Таким образом мы разбили список, теперь вернемся к тем е действиям
-                        // и будем сортировать наши куски на которые разбили до тех пор,
-                        // пока список индексов не пустой
+                        this->relinkChain(rest);
+                        throw;
                     }
+                    this->relinkChain(bins[fill - 1]);
                 }
             }
 
@@ -533,52 +592,179 @@ namespace s21 {
                 }
             }
 
+            /**
+             * @brief Создает новый элемент прямо в узле перед pos
+             * @details args передаются в конструктор элемента как есть, без
+             * временного объекта, поэтому работают и некопируемые типы
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param pos 
+             * @param args 
+             * @return iterator - указывает на новый элемент
+             */
+            template<typename... Args>
+            iterator emplace(const_iterator pos, Args&&... args) {
+                iterator it_pos(const_cast<ListNode *>(pos.currentNode_));
+                return this->linkNode(it_pos, this->createNode(std::in_place, std::forward<Args>(args)...));
+            }
+
+            /**
+             * @brief Создает новый элемент в конце контейнера
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            reference emplace_back(Args&&... args) {
+                return *this->emplace(this->end(), std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Создает новый элемент в начале контейнера
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            reference emplace_front(Args&&... args) {
+                return *this->emplace(this->begin(), std::forward<Args>(args)...);
+            }
+
             /**
              * @brief Вставляет новые элементы в контейнер непосредственно перед pos
-             * @details Не стал делать через insert, что бы избежать лишнего копирования
+             * @details Каждый аргумент - отдельный элемент, порядок сохраняется
              * 
              * @tparam Args 
              * @param pos 
              * @param args 
-             * @return iterator 
+             * @return iterator - указывает на последний вставленный элемент
              */
             template<typename... Args>
-            iterator emplace(const_iterator pos, Args&&... args) {
+            iterator insert_many(const_iterator pos, Args&&... args) {
                 iterator it_pos(const_cast<ListNode *>(pos.currentNode_));
-                ListNode* new_node;
-                for (auto element : {std::forward<Args>(args)...}) {
-                    new_node = new ListNode(std::move(element), it_pos.currentNode_, it_pos.currentNode_->prev_);
-                    it_pos.currentNode_->prev_->next_ = new_node;
-                    it_pos.currentNode_->prev_ = new_node;
-                    this->size_++;
-                }
-                return iterator(new_node);
+                iterator it_res = it_pos;
+                ((it_res = this->emplace(it_pos, std::forward<Args>(args))), ...);
+                return it_res;
             }
 
             /**
              * @brief Добавляет новые элементы в конец контейнера
-             * @details Схожий с emplace, только добавляет в конец
              * 
              * @param args 
              */
             template<typename... Args>
-            void emplace_back(Args&&... args) {
-                this->emplace(this->end(), std::forward<Args>(args)...);
+            void insert_many_back(Args&&... args) {
+                this->insert_many(this->end(), std::forward<Args>(args)...);
             }
 
             /**
-             * @brief Добавляет новые элементы в верхнюю часть контейнера
-             * @details Схожий с emplace, только добавляет в начало
+             * @brief Добавляет новые элементы в начало контейнера
+             * @details Элементы встают в начало в том же порядке, в котором переданы
              * 
              * @param args 
              */
             template<typename... Args>
-            void emplace_front(Args&&... args) {
-                this->emplace(this->begin(), std::forward<Args>(args)...);
+            void insert_many_front(Args&&... args) {
+                this->insert_many(this->begin(), std::forward<Args>(args)...);
             }
 
 
         private:
+            /**
+             * @brief Создает узел в памяти аллокатора
+             *
+             */
+            template<typename... Args>
+            ListNode* createNode(Args&&... args) {
+                ListNode* node = node_traits::allocate(this->alloc_, 1);
+                try {
+                    node_traits::construct(this->alloc_, node, std::forward<Args>(args)...);
+                } catch (...) {
+                    node_traits::deallocate(this->alloc_, node, 1);
+                    throw;
+                }
+                return node;
+            }
+
+            // Уничтожает узел и возвращает память аллокатору
+            void destroyNode(ListNode* node) noexcept {
+                node_traits::destroy(this->alloc_, node);
+                node_traits::deallocate(this->alloc_, node, 1);
+            }
+
+            /**
+             * @brief Вставляет готовый узел node перед позицией pos
+             *
+             * @return iterator - указывает на вставленный узел
+             */
+            iterator linkNode(iterator pos, ListNode* node) noexcept {
+                node->next_ = pos.currentNode_;
+                node->prev_ = pos.currentNode_->prev_;
+                pos.currentNode_->prev_->next_ = node;
+                pos.currentNode_->prev_ = node;
+                this->size_++;
+                return iterator(node);
+            }
+
+            /**
+             * @brief Сливает две отсортированные односвязные (по next_) цепочки, результат - в first
+             * @details При равенстве первым идет узел из first, prev_ не трогаем.
+             * Если comp бросит исключение, в first все равно окажутся все узлы обеих
+             * цепочек: уже слитая часть, а за ней остатки без сравнений
+             *
+             */
+            template<typename Compare>
+            static void mergeChains(ListNode*& first, ListNode* second, Compare& comp) {
+                ListNode* rest = first;
+                ListNode* result = nullptr;
+                ListNode** tail = &result;
+                try {
+                    while (rest != nullptr && second != nullptr) {
+                        if (comp(second->data_, rest->data_)) {
+                            *tail = second;
+                            second = second->next_;
+                        } else {
+                            *tail = rest;
+                            rest = rest->next_;
+                        }
+                        tail = &(*tail)->next_;
+                    }
+                } catch (...) {
+                    *tail = appendChain(rest, second);
+                    first = result;
+                    throw;
+                }
+                *tail = (rest != nullptr) ? rest : second;
+                first = result;
+            }
+
+            // Цепляет цепочку second в конец цепочки first, возвращает начало общей цепочки
+            static ListNode* appendChain(ListNode* first, ListNode* second) noexcept {
+                if (first == nullptr) {
+                    return second;
+                }
+                ListNode* last = first;
+                while (last->next_ != nullptr) {
+                    last = last->next_;
+                }
+                last->next_ = second;
+                return first;
+            }
+
+            // Замыкает односвязную цепочку first в кольцо вокруг head_ и восстанавливает prev_
+            void relinkChain(ListNode* first) noexcept {
+                ListNode* prev = this->head_;
+                for (ListNode* node = first; node != nullptr; node = node->next_) {
+                    prev->next_ = node;
+                    node->prev_ = prev;
+                    prev = node;
+                }
+                prev->next_ = this->head_;
+                this->head_->prev_ = prev;
+            }
+
             /*--------------------class ListNode--------------------*/
 
             /**
@@ -606,6 +792,12 @@ namespace s21 {
                         this->next_ = next_;
                         this->prev_ = prev_;
                     }
+
+                    // Конструктор, который создает значение сразу в узле из аргументов
+                    // конструктора value_type
+                    template<typename... Args>
+                    explicit ListNode(std::in_place_t, Args&&... args)
+                        : next_(nullptr), prev_(nullptr), data_(std::forward<Args>(args)...) {}
                     
                     // Указатель на след. элемент
                     ListNode* next_;
@@ -808,6 +1000,8 @@ namespace s21 {
 
             /*------------------------------------------------------*/
 
+            // Аллокатор, перепривязанный на тип узла
+            node_allocator alloc_;
             // Количество элементов в контейнере
             size_type size_;
             // Указатель на служебный узел контейнера
@@ -1,7 +1,9 @@
 #ifndef SRC_S21_MAP_H_
 #define SRC_S21_MAP_H_
+#include "s21_btree.h"
 #include "s21_tree.h"
 #include <iostream>
+#include <tuple>
 
 namespace s21 {
     /**
@@ -12,8 +14,15 @@ namespace s21 {
      * когда необходимо ассоциировать элементы с некоторым другим значением (не индексом).
      * Реализов через tree (дерева), его реализацию смотрите в s21_tree.h
      *
+     * @tparam Key - тип ключа
+     * @tparam T - тип значения
+     * @tparam Compare - компаратор ключей
+     * @tparam Allocator - аллокатор пар ключ-значение
+     * @tparam TreePolicy - движок дерева: RedBlackTreePolicy (по умолчанию) или BTreePolicy
+     * (B-дерево, см. s21_btree.h)
      */
-    template<typename Key, typename T>
+    template<typename Key, typename T, typename Compare = std::less<Key>,
+             typename Allocator = std::allocator<std::pair<const Key, T>>, typename TreePolicy = RedBlackTreePolicy>
     class map {
         class MapComparatorMy;
         using key_type = Key;
@@ -21,21 +30,44 @@ namespace s21 {
         using value_type = std::pair<const key_type, mapped_type>;
         using reference = value_type&;
         using const_reference = const value_type&;
-        using tree = BinaryTree<value_type, MapComparatorMy>;
+        using tree = typename TreePolicy::template tree<value_type, MapComparatorMy, Allocator, false>;
         using size_type = std::size_t;
         // Так как мы будем искать значения по ключу, а у нас два значения в pair 
         // - нам нужен свой компаратор
         class MapComparatorMy {
             public:
+                MapComparatorMy() = default;
+                explicit MapComparatorMy(const Compare& comp) : comp_(comp) {}
+
+                // Пару можно сравнивать не только с парой, но и сразу с ключом,
+                // поэтому дерево ищет по ключу без временной пары (см. BinaryTree::find)
+                using is_transparent = void;
+
                 //Перегружаем оператор таким образом, чтоб он проверял только ключи
-                bool operator()(const_reference v1, const_reference v2) const noexcept {
-                    return v1.first < v2.first;
+                bool operator()(const_reference v1, const_reference v2) const {
+                    return this->comp_(v1.first, v2.first);
                 }
+
+                // Сравнение пары с ключом (K - Key или тип, сравнимый с Key через Compare)
+                template<typename K>
+                bool operator()(const_reference v, const K& key) const {
+                    return this->comp_(v.first, key);
+                }
+
+                template<typename K>
+                bool operator()(const K& key, const_reference v) const {
+                    return this->comp_(key, v.first);
+                }
+
+                // компаратор ключей пользователя
+                Compare comp_;
         };
 
         public:
             using iterator = typename tree::iterator;
             using const_iterator = typename tree::const_iterator;
+            using key_compare = Compare;
+            using allocator_type = Allocator;
 
             /*------------------constructors and operators map----------------------*/
 
@@ -46,14 +78,45 @@ namespace s21 {
             map() : tree_() {}
 
             /**
-             * @brief конструктор списка инициализаторов, создает словарь уже с элементами
+             * @brief Создает пустой словарь с заданным компаратором и аллокатором
+             *
+             * @param comp
+             * @param alloc
+             */
+            explicit map(const Compare& comp, const Allocator& alloc = Allocator())
+                : tree_(MapComparatorMy(comp), alloc) {}
+
+            /**
+             * @brief Создает пустой словарь с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit map(const Allocator& alloc) : tree_(alloc) {}
+
+            /**
+             * @brief Конструктор списка инициализаторов, создает словарь
+             * @details Дерево строится сразу целиком, см. конструктор из диапазона
              * 
              * @param items 
              */
-            map(std::initializer_list<value_type> const &items) : tree_() {
-                for (auto element : items) {
-                    this->tree_.insertUnique(element);
-                }
+            map(std::initializer_list<value_type> const &items, const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator()) : tree_(MapComparatorMy(comp), alloc) {
+                this->tree_.assignUnique(items.begin(), items.end());
+            }
+
+            /**
+             * @brief Конструктор из диапазона [first, last)
+             * @details Если элементы уже отсортированы, дерево строится снизу вверх за O(n),
+             * иначе они сначала сортируются (из равных ключей остается первый)
+             * 
+             * @tparam InputIt - итератор
+             * @param first 
+             * @param last 
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            map(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+                : tree_(MapComparatorMy(comp), alloc) {
+                this->tree_.assignUnique(first, last);
             }
 
             /**
@@ -68,7 +131,7 @@ namespace s21 {
              * 
              * @param m 
              */
-            map(map &&m) : tree_(std::move(m.tree_)) {}
+            map(map &&m) noexcept(std::is_nothrow_move_constructible<tree>::value) : tree_(std::move(m.tree_)) {}
 
             /**
              * @brief Деструктор будет дефолдным
@@ -94,7 +157,7 @@ namespace s21 {
              * @param m
              * @return map& 
              */
-            map& operator=(map &&m) {
+            map& operator=(map &&m) noexcept(std::is_nothrow_move_assignable<tree>::value) {
                 this->tree_ = std::move(m.tree_);
                 return *this;
             }
@@ -111,10 +174,8 @@ namespace s21 {
              * @return T& 
              */
             mapped_type& at(const Key& key) {
-                // создаем pair для поиска ключа
-                // так как в дереве теперь наш компаратор
-                value_type pair = {key, mapped_type{}};
-                iterator it = this->tree_.find(pair);
+                // ищем сразу по ключу, наш компаратор умеет сравнивать пару с ключом
+                iterator it = this->tree_.find(key);
                 // проверяем, если it == end() зачит ключа в контейнере нет
                 if (it == this->tree_.end())
                     throw std::out_of_range("s21::map::at: no such element exists");
@@ -131,7 +192,35 @@ namespace s21 {
              * @return T& 
              */
             const mapped_type& at(const Key& key) const {
-                return const_cast<map<key_type, mapped_type> *>(this)->at(key);
+                return const_cast<map*>(this)->at(key);
+            }
+
+            /**
+             * @brief Аналогично at, но ключ может быть любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent (например std::less<>),
+             * так можно искать std::string по std::string_view без временных объектов
+             * 
+             * @param key 
+             * @return T& 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            mapped_type& at(const K& key) {
+                iterator it = this->tree_.find(key);
+                if (it == this->tree_.end())
+                    throw std::out_of_range("s21::map::at: no such element exists");
+
+                return (*it).second;
+            }
+
+            /**
+             * @brief Аналогично at(const K&) для конст объекта
+             * 
+             * @param key 
+             * @return T& 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            const mapped_type& at(const K& key) const {
+                return const_cast<map*>(this)->at(key);
             }
 
             /**
@@ -143,17 +232,28 @@ namespace s21 {
              * @return mapped_type& 
              */
             mapped_type& operator[](const Key& key) {
-                // создаем pair для поиска
-                value_type pair = {key, mapped_type{}};
-                iterator it = this->tree_.find(pair);
-                if (it == this->tree_.end()) {
-                    // если такого элемента нет, значит вставляем его
-                    // с дефолдным значением
-                    std::pair<iterator, bool> res = this->tree_.insertUnique(pair);
-                    return (*res.first).second;
-                }
-                // если есть тогда выводим то что нашли
-                return (*it).second;
+                // один спуск по дереву: если ключ есть - получим его,
+                // если нет - пара с дефолдным значением создастся сразу на своем месте
+                return (*this->try_emplace(key).first).second;
+            }
+
+            /**
+             * @brief Аналогично operator[](const Key&), но ключ перемещается в новый элемент
+             * 
+             * @param key 
+             * @return mapped_type& 
+             */
+            mapped_type& operator[](Key&& key) {
+                return (*this->try_emplace(std::move(key)).first).second;
+            }
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->tree_.get_allocator();
             }
 
             /**
@@ -231,6 +331,20 @@ namespace s21 {
                 return this->tree_.clear();
             }
 
+            /**
+             * @brief Заменяет содержимое элементами из отсортированного диапазона [first, last)
+             * @details Диапазон должен идти по возрастанию ключей (в смысле Compare),
+             * это не проверяется. Дерево строится снизу вверх за O(n), из равных ключей остается первый
+             * 
+             * @tparam InputIt 
+             * @param first 
+             * @param last 
+             */
+            template<typename InputIt>
+            void assign_sorted(InputIt first, InputIt last) {
+                this->tree_.assignSortedUnique(first, last);
+            }
+
             /**
              * @brief вставляет узел и возвращает итератор туда, где элемент находится
              * в контейнере, и логическое значение, обозначающее, имела ли место вставка
@@ -242,6 +356,20 @@ namespace s21 {
                 return this->tree_.insertUnique(value);
             }
 
+            /**
+             * @brief Вставляет элемент, используя hint как подсказку, куда он должен встать
+             * @details Если элемент должен стоять прямо перед hint (или сразу после него),
+             * вставка идет без спуска от корня - удобно при вставке почти отсортированных
+             * ключей с подсказкой end(). Неверная подсказка просто ведет к обычной вставке
+             * 
+             * @param hint 
+             * @param value 
+             * @return iterator - указывает на вставленный элемент или на элемент с таким же ключом
+             */
+            iterator insert(const_iterator hint, const value_type& value) {
+                return this->tree_.insertUnique(hint, value);
+            }
+
             /**
              * @brief вставляет значение по ключу и возвращает итератор туда, где элемент находится в контейнере,
              * и логическое значение, обозначающее, имела ли место вставка
@@ -253,7 +381,40 @@ namespace s21 {
              * @return std::pair<iterator, bool> 
              */
             std::pair<iterator, bool> insert(const Key& key, const mapped_type& obj) {
-                return this->tree_.insertUnique({key, obj});
+                return this->tree_.emplaceUniqueKey(key, key, obj);
+            }
+
+            /**
+             * @brief Вставляет элемент с ключом key, если такого ключа еще нет
+             * @details Место ищется за один спуск по дереву. Значение создается прямо
+             * в узле из args и только если вставка действительно будет, иначе args
+             * не трогаются (их можно использовать дальше, даже если это rvalue)
+             * 
+             * @tparam Args 
+             * @param key 
+             * @param args - аргументы конструктора mapped_type
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с ключом key,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+                return this->tree_.emplaceUniqueKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                                    std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            /**
+             * @brief Аналогично try_emplace(const Key&, Args&&...), но ключ перемещается в новый элемент
+             * 
+             * @tparam Args 
+             * @param key 
+             * @param args 
+             * @return std::pair<iterator, bool> 
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+                // Ключ сравнивается до того, как его переместят в узел
+                return this->tree_.emplaceUniqueKey(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                                    std::forward_as_tuple(std::forward<Args>(args)...));
             }
 
             /**
@@ -267,13 +428,10 @@ namespace s21 {
              * @return std::pair<iterator, bool> 
              */
             std::pair<iterator, bool> insert_or_assign(const Key& key, const mapped_type& obj) {
-                value_type pair = {key, obj};
-                iterator it = this->tree_.find(pair);
-                if (it == this->tree_.end())
-                    return this->tree_.insertUnique(pair);
-                
-                (*it).second = obj;
-                return {it, false};
+                std::pair<iterator, bool> result = this->tree_.emplaceUniqueKey(key, key, obj);
+                if (!result.second)
+                    (*result.first).second = obj;
+                return result;
             }
 
             /**
@@ -287,15 +445,19 @@ namespace s21 {
 
             /**
              * @brief Меняет содержимое
+             * @details Без выделения памяти: деревья меняются корнями и пулами
              * 
              * @param other 
              */
             void swap(map& other) noexcept {
-                std::swap(this->tree_, other.tree_);
+                this->tree_.swap(other.tree_);
             }
 
             /**
              * @brief Соединяет узлы из другого контейнера
+             * @details Узлы other перевешиваются без копирования, ссылки на перенесенные
+             * элементы остаются действительными. Если аллокаторы не равны, память other
+             * держать нельзя - тогда элемент перемещается в новый узел this
              * 
              * @param other 
              */
@@ -303,6 +465,36 @@ namespace s21 {
                 this->tree_.mergeUnique(other.tree_);
             }
 
+            /**
+             * @brief Отделяет от контейнера все элементы с ключами >= key
+             * @details В this остаются элементы с ключами меньше key, остальные переезжают в результат.
+             * В красно-черном дереве узлы перевешиваются без копирования и без выделения
+             * памяти: дерево разрезается за O(log n), но без OrderStatistics размеры частей
+             * пересчитываются за O(min(k, n - k)) (см. BinaryTree::split). В BTreePolicy
+             * элементы перемещаются по одному - O(k) (см. BTree::split)
+             *
+             * @param key
+             * @return map - элементы с ключами >= key
+             */
+            map split(const Key& key) {
+                map upper(this->get_allocator());
+                this->tree_.split(key, upper.tree_);
+                return upper;
+            }
+
+            /**
+             * @brief Переносит в this все элементы other, если их ключи целиком больше
+             * или целиком меньше ключей this
+             * @details Деревья склеиваются за O(log n) без копирования (см. BinaryTree::join),
+             * other становится пустым
+             *
+             * @param other
+             * @throw std::invalid_argument - диапазоны ключей пересекаются
+             */
+            void join(map& other) {
+                this->tree_.join(other.tree_, true);
+            }
+
             /**
              * @brief Проверяет, есть ли элемент с ключом, эквивалентным ключу в контейнере
              * 
@@ -311,20 +503,106 @@ namespace s21 {
              * @return false - нет эдемента в контейнере
              */
             bool contains(const Key& key) const {
-                return this->tree_.find({key, mapped_type{}}) != this->tree_.end();
+                return this->tree_.find(key) != this->tree_.end();
+            }
+
+            /**
+             * @brief Аналогично contains для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent
+             * 
+             * @param key 
+             * @return true - есть элемент в контенере
+             * @return false - нет эдемента в контейнере
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            bool contains(const K& key) const {
+                return this->tree_.find(key) != this->tree_.end();
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             * 
+             * @param key 
+             * @return iterator - указывает на найденный элемент или на end()
+             */
+            iterator find(const Key& key) {
+                return this->tree_.find(key);
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             * @details Для конст объекта
+             * 
+             * @param key 
+             * @return const_iterator 
+             */
+            const_iterator find(const Key& key) const {
+                return this->tree_.find(key);
+            }
+
+            /**
+             * @brief Аналогично find для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent
+             * 
+             * @param key 
+             * @return iterator 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            iterator find(const K& key) {
+                return this->tree_.find(key);
+            }
+
+            /**
+             * @brief Аналогично find(const K&) для конст объекта
+             * 
+             * @param key 
+             * @return const_iterator 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            const_iterator find(const K& key) const {
+                return this->tree_.find(key);
+            }
+
+            /**
+             * @brief Создает элемент прямо в узле из аргументов его конструктора
+             * и вставляет его, если в контейнере нет такого ключа
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с таким ключом,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                return this->tree_.emplaceUnique(std::forward<Args>(args)...);
             }
 
             /**
              * @brief Вставляет новые элеметы в контейнер, если контейнер
              * не содержит таких ключей
+             * @details Каждый аргумент - отдельный элемент
              * 
              * @tparam Args 
              * @param args 
              * @return std::vector<std::pair<iterator,bool>> 
              */
             template<typename... Args>
-            std::vector<std::pair<iterator,bool>> emplace(Args&&... args) {
-                return this->tree_.emplaceUnique(std::forward<Args>(args)...);
+            std::vector<std::pair<iterator,bool>> insert_many(Args&&... args) {
+                return this->tree_.insertManyUnique(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его с подсказкой hint
+             * @details Подсказка работает так же, как в insert(hint, value)
+             * 
+             * @tparam Args 
+             * @param hint 
+             * @param args 
+             * @return iterator - указывает на вставленный элемент или на элемент с таким же ключом
+             */
+            template<typename... Args>
+            iterator emplace_hint(const_iterator hint, Args&&... args) {
+                return this->tree_.emplaceHintUnique(hint, std::forward<Args>(args)...);
             }
 
         private:
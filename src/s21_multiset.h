@@ -1,5 +1,6 @@
 #ifndef SRC_S21_MULTISET_H_
 #define SRC_S21_MULTISET_H_
+#include "s21_btree.h"
 #include "s21_tree.h"
 
 namespace s21 {
@@ -9,19 +10,28 @@ namespace s21 {
      * @details Реализован через дерево точно так же как и set(), только в multiset ключи
      * могут повторятся в реализации s21_tree это предусмотренно
      * 
-     * @tparam Key 
+     * @tparam Key - тип элемента
+     * @tparam Compare - компаратор элементов
+     * @tparam Allocator - аллокатор элементов
+     * @tparam OrderStatistics - хранить в узлах размеры поддеревьев, чтобы nth_element,
+     * rank и count_range работали за O(log n) (см. BinaryTree)
+     * @tparam TreePolicy - движок дерева: RedBlackTreePolicy (по умолчанию) или BTreePolicy
+     * (B-дерево, см. s21_btree.h)
      */
-    template<typename Key>
+    template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>,
+             bool OrderStatistics = false, typename TreePolicy = RedBlackTreePolicy>
     class multiset {
         using key_type = Key;
         using value_type = Key;
         using reference = value_type&;
         using const_reference = const value_type&;
-        using tree = BinaryTree<Key>;
+        using tree = typename TreePolicy::template tree<Key, Compare, Allocator, OrderStatistics>;
         using size_type = std::size_t;
         public:
             using iterator = typename tree::iterator;
             using const_iterator = typename tree::const_iterator;
+            using key_compare = Compare;
+            using allocator_type = Allocator;
 
             /*------------------constructors and operators multiset----------------------*/
             
@@ -31,15 +41,45 @@ namespace s21 {
              */
             multiset() : tree_() {}
 
+            /**
+             * @brief Создает пустой набор с заданным компаратором и аллокатором
+             *
+             * @param comp
+             * @param alloc
+             */
+            explicit multiset(const Compare& comp, const Allocator& alloc = Allocator()) : tree_(comp, alloc) {}
+
+            /**
+             * @brief Создает пустой набор с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit multiset(const Allocator& alloc) : tree_(alloc) {}
+
             /**
              * @brief Конструктор списка инициализаторов, создает набор
+             * @details Дерево строится сразу целиком, см. конструктор из диапазона
              * 
              * @param items 
              */
-            multiset(std::initializer_list<value_type> const &items) : tree_() {
-                for (auto element : items) {
-                    this->tree_.insert(element);
-                }
+            multiset(std::initializer_list<value_type> const &items, const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator()) : tree_(comp, alloc) {
+                this->tree_.assign(items.begin(), items.end());
+            }
+
+            /**
+             * @brief Конструктор из диапазона [first, last)
+             * @details Если элементы уже отсортированы, дерево строится снизу вверх за O(n),
+             * иначе они сначала сортируются
+             * 
+             * @tparam InputIt - итератор
+             * @param first 
+             * @param last 
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            multiset(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+                : tree_(comp, alloc) {
+                this->tree_.assign(first, last);
             }
 
             /**
@@ -54,7 +94,7 @@ namespace s21 {
              * 
              * @param ms 
              */
-            multiset(multiset &&ms) : tree_(std::move(ms.tree_)) {}
+            multiset(multiset &&ms) noexcept(std::is_nothrow_move_constructible<tree>::value) : tree_(std::move(ms.tree_)) {}
 
             /**
              * @brief Оператор присваивания копированием
@@ -73,7 +113,7 @@ namespace s21 {
              * @param ms 
              * @return multiset& 
              */
-            multiset& operator=(multiset &&ms) {
+            multiset& operator=(multiset &&ms) noexcept(std::is_nothrow_move_assignable<tree>::value) {
                 this->tree_ = std::move(ms.tree_);
                 return *this;
             }
@@ -82,6 +122,15 @@ namespace s21 {
 
             /*------------------------methods multiset-------------------------*/
 
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->tree_.get_allocator();
+            }
+
             /**
              * @brief Возвращает итератор в начало
              * 
@@ -157,6 +206,20 @@ namespace s21 {
                 this->tree_.clear();
             }
 
+            /**
+             * @brief Заменяет содержимое элементами из отсортированного диапазона [first, last)
+             * @details Диапазон должен идти по возрастанию ключей (в смысле Compare),
+             * это не проверяется. Дерево строится снизу вверх за O(n)
+             * 
+             * @tparam InputIt 
+             * @param first 
+             * @param last 
+             */
+            template<typename InputIt>
+            void assign_sorted(InputIt first, InputIt last) {
+                this->tree_.assignSorted(first, last);
+            }
+
             /**
              * @brief Вставляет узел и возвращает итератор туда, где элемент находится в контейнере
              * 
@@ -167,6 +230,20 @@ namespace s21 {
                 return this->tree_.insert(value);
             }
 
+            /**
+             * @brief Вставляет элемент, используя hint как подсказку, куда он должен встать
+             * @details Если элемент должен стоять прямо перед hint (или сразу после него),
+             * вставка идет без спуска от корня - удобно при вставке почти отсортированных
+             * ключей с подсказкой end(). Неверная подсказка просто ведет к обычной вставке
+             * 
+             * @param hint 
+             * @param value 
+             * @return iterator - указывает на вставленный элемент
+             */
+            iterator insert(const_iterator hint, const value_type& value) {
+                return this->tree_.insert(hint, value);
+            }
+
             /**
              * @brief Стирает элемент в позиции
              * 
@@ -178,11 +255,12 @@ namespace s21 {
 
             /**
              * @brief Меняет содержимое
+             * @details Без выделения памяти: деревья меняются корнями и пулами
              * 
              * @param other 
              */
-            void swap(multiset& other) {
-                std::swap(this->tree_, other.tree_);
+            void swap(multiset& other) noexcept {
+                this->tree_.swap(other.tree_);
             }
 
 
@@ -195,17 +273,134 @@ namespace s21 {
                 this->tree_.merge(other.tree_);
             }
 
+            /**
+             * @brief Отделяет от контейнера все элементы, которые >= key
+             * @details В this остаются элементы меньше key, остальные переезжают в результат.
+             * В красно-черном дереве узлы перевешиваются без копирования и без выделения
+             * памяти: дерево разрезается за O(log n), но без OrderStatistics размеры частей
+             * пересчитываются за O(min(k, n - k)) (см. BinaryTree::split). В BTreePolicy
+             * элементы перемещаются по одному - O(k) (см. BTree::split)
+             *
+             * @param key
+             * @return multiset - элементы >= key
+             */
+            multiset split(const Key& key) {
+                multiset upper(this->get_allocator());
+                this->tree_.split(key, upper.tree_);
+                return upper;
+            }
+
+            /**
+             * @brief Переносит в this все элементы other, если их ключи целиком больше
+             * или целиком меньше ключей this
+             * @details Деревья склеиваются за O(log n) без копирования (см. BinaryTree::join),
+             * other становится пустым
+             *
+             * @param other
+             * @throw std::invalid_argument - диапазоны ключей пересекаются
+             */
+            void join(multiset& other) {
+                this->tree_.join(other.tree_, false);
+            }
+
+            /**
+             * @brief Объединение: добавляет элементы other, которых нет в this
+             * @details this и other обходятся по порядку один раз, свои узлы не копируются,
+             * дерево собирается заново снизу вверх - O(n + m) (см. BinaryTree::combineWith).
+             * Повторы считаются как в std::set_union: элемент, который встречается
+             * m раз в this и n раз в other, после объединения встречается max(m, n) раз,
+             * после пересечения - min(m, n), после разности - max(m - n, 0),
+             * после симметрической разности - |m - n|
+             *
+             * @param other
+             * @return multiset& - *this
+             */
+            multiset& union_with(const multiset& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::Union);
+                return *this;
+            }
+
+            /**
+             * @brief Пересечение: оставляет только элементы, которые есть и в other
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return multiset& - *this
+             */
+            multiset& intersect_with(const multiset& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::Intersection);
+                return *this;
+            }
+
+            /**
+             * @brief Разность: удаляет элементы, которые есть в other
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return multiset& - *this
+             */
+            multiset& difference_with(const multiset& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::Difference);
+                return *this;
+            }
+
+            /**
+             * @brief Симметрическая разность: оставляет элементы, которые есть только
+             * в одном из контейнеров
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return multiset& - *this
+             */
+            multiset& symmetric_difference_with(const multiset& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::SymmetricDifference);
+                return *this;
+            }
+
+            /**
+             * @brief Объединение a и b в новом контейнере
+             * @details Узлы результата создаются по одному проходу a и b, дерево строится
+             * снизу вверх - O(n + m). Компаратор берется у a
+             *
+             */
+            friend multiset operator|(const multiset& a, const multiset& b) {
+                return multiset::combined(a, b, tree::SetOperation::Union);
+            }
+
+            /**
+             * @brief Пересечение a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend multiset operator&(const multiset& a, const multiset& b) {
+                return multiset::combined(a, b, tree::SetOperation::Intersection);
+            }
+
+            /**
+             * @brief Разность a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend multiset operator-(const multiset& a, const multiset& b) {
+                return multiset::combined(a, b, tree::SetOperation::Difference);
+            }
+
+            /**
+             * @brief Симметрическая разность a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend multiset operator^(const multiset& a, const multiset& b) {
+                return multiset::combined(a, b, tree::SetOperation::SymmetricDifference);
+            }
+
             /**
              * @brief Возвращает количество элементов, соответствующих определенному ключу
+             * @details При OrderStatistics == true - O(log n) при любом количестве повторов,
+             * иначе O(log n + count) (см. BinaryTree::count)
              * 
              * @param key 
              * @return size_type 
              */
             size_type count(const Key& key) const noexcept {
-                size_type result = 0;
-                auto it_search = this->lower_bound(key);
-                for (auto it_end = this->end(); *it_search == key && it_search != it_end; ++result, ++it_search);
-                return result;
+                return this->tree_.count(key);
             }
 
             /**
@@ -229,6 +424,29 @@ namespace s21 {
                 return this->tree_.find(key);
             }
 
+            /**
+             * @brief Аналогично find для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent (например std::less<>)
+             * 
+             * @param key 
+             * @return iterator 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            iterator find(const K& key) {
+                return this->tree_.find(key);
+            }
+
+            /**
+             * @brief Аналогично find(const K&) для конст объекта
+             * 
+             * @param key 
+             * @return const_iterator 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            const_iterator find(const K& key) const {
+                return this->tree_.find(key);
+            }
+
             /**
              * @brief Проверяет, содержит ли контейнер элемент с определенным ключом
              * 
@@ -237,27 +455,34 @@ namespace s21 {
              * @return false - нет такого элемента
              */
             bool contains(const Key& key) const noexcept {
-                return *(this->tree_.find(key)) == key;
+                return this->tree_.find(key) != this->tree_.end();
+            }
+
+            /**
+             * @brief Аналогично contains для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent
+             * 
+             * @param key 
+             * @return true - есть такой элемент
+             * @return false - нет такого элемента
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            bool contains(const K& key) const {
+                return this->tree_.find(key) != this->tree_.end();
             }
 
             /**
              * @brief Возвращает диапазон элементов, соответствующих определенному ключу
              * @details Диапозон определяется двумя итераторами, один указывает на первый элемент
              * который не меньше ключа, второй указывает на первый элемент больше ключа.
-             * Можно вызвать lower_bound и upper_bound, но тогда работать функция будет
-             * медленее, так как два раза пробегаемся по дереву...
-             * Можно вызвать lower_bound, а дальше просто посчитать - так мы и сделали
+             * Обе границы находятся за один спуск по дереву (см. BinaryTree::equalRange),
+             * поэтому O(log n) при любом количестве повторов
              * 
              * @param key 
              * @return std::pair<iterator,iterator> 
              */
             std::pair<iterator, iterator> equal_range(const Key& key) {
-                iterator it_first = this->lower_bound(key);
-                iterator it_second = it_first;
-                while (*it_second == key) {
-                    ++it_second;
-                }
-                return std::pair<iterator, iterator> {it_first, it_second};
+                return this->tree_.equalRange(key);
             }
 
             /**
@@ -267,12 +492,7 @@ namespace s21 {
              * @return std::pair<const_iterator, const_iterator> 
              */
             std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
-                const_iterator it_first = this->lower_bound(key);
-                const_iterator it_second = it_first;
-                while (*it_second == key) {
-                    ++it_second;
-                }
-                return std::pair<const_iterator, const_iterator> {it_first, it_second};
+                return this->tree_.equalRange(key);
             }
 
             /**
@@ -318,20 +538,97 @@ namespace s21 {
             }
 
             /**
-             * @brief Вставляет новые элеметы в контейнер, если контейнер
-             * не содержит таких ключей
+             * @brief Создает элемент прямо в узле из аргументов его конструктора
+             * и вставляет его
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             * @return iterator - указывает на вставленный элемент
+             */
+            template<typename... Args>
+            iterator emplace(Args&&... args) {
+                return this->tree_.emplace(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Вставляет новые элеметы в контейнер
+             * @details Каждый аргумент - отдельный элемент
              * 
              * @tparam Args 
              * @param args 
              * @return std::vector<std::pair<iterator,bool>> 
              */
             template<typename... Args>
-            std::vector<std::pair<iterator,bool>> emplace(Args&&... args) {
-                return this->tree_.emplace(std::forward<Args>(args)...);
+            std::vector<std::pair<iterator,bool>> insert_many(Args&&... args) {
+                return this->tree_.insertMany(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его с подсказкой hint
+             * @details Подсказка работает так же, как в insert(hint, value)
+             * 
+             * @tparam Args 
+             * @param hint 
+             * @param args 
+             * @return iterator - указывает на вставленный элемент
+             */
+            template<typename... Args>
+            iterator emplace_hint(const_iterator hint, Args&&... args) {
+                return this->tree_.emplaceHint(hint, std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Возвращает iterator на k-й по порядку элемент (считая с 0)
+             * @details O(log n), доступно только при OrderStatistics == true
+             *
+             * @param k
+             * @return iterator - k-й элемент или end(), если k >= size()
+             */
+            iterator nth_element(size_type k) noexcept {
+                return this->tree_.nthElement(k);
+            }
+
+            /**
+             * @brief Аналогично функции nth_element только для конст объекта
+             *
+             */
+            const_iterator nth_element(size_type k) const noexcept {
+                return this->tree_.nthElement(k);
+            }
+
+            /**
+             * @brief Количество элементов, меньших key (номер lower_bound(key))
+             * @details O(log n), доступно только при OrderStatistics == true
+             *
+             * @param key
+             * @return size_type
+             */
+            size_type rank(const Key& key) const noexcept {
+                return this->tree_.rank(key);
+            }
+
+            /**
+             * @brief Количество элементов из полуинтервала [lo, hi)
+             * @details O(log n) независимо от того, сколько элементов попало в интервал,
+             * доступно только при OrderStatistics == true
+             *
+             * @param lo
+             * @param hi
+             * @return size_type
+             */
+            size_type count_range(const Key& lo, const Key& hi) const noexcept {
+                return this->tree_.countRange(lo, hi);
             }
 
         private:
             tree tree_;
+
+            // Результат операции op над a и b в новом контейнере
+            static multiset combined(const multiset& a, const multiset& b, typename tree::SetOperation op) {
+                multiset result(std::allocator_traits<Allocator>::select_on_container_copy_construction(a.get_allocator()));
+                result.tree_.assignCombined(a.tree_, b.tree_, op);
+                return result;
+            }
     }; // multiset
 } // s21
 
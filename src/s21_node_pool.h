@@ -0,0 +1,377 @@
+#ifndef SRC_S21_NODE_POOL_H_
+#define SRC_S21_NODE_POOL_H_
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+    /**
+     * @brief Пул (арена) узлов фиксированного размера
+     * @details Вместо того чтобы каждый узел дерева выделять через new, пул берет у системы
+     * большие куски памяти (chunk) и нарезает их на ячейки (slot) размером ровно с узел.
+     * - новые узлы выдаются подряд из последнего куска, поэтому соседние по времени вставки
+     * узлы лежат рядом в памяти;
+     * - удаленные узлы не отдаются системе, а складываются в список свободных ячеек (free list)
+     * и переиспользуются при следующей вставке;
+     * - вся память возвращается разом в release(), когда живых узлов больше нет.
+     *
+     * Пул не вызывает конструкторы и деструкторы узлов - он выдает только сырую память,
+     * объекты в ней создает и уничтожает сам контейнер. Сами куски пул берет у аллокатора
+     * контейнера (перепривязанного на тип ячейки через std::allocator_traits).
+     *
+     * Куски принадлежат не самому пулу, а складу кусков (Arena), которым владеют через
+     * std::shared_ptr. Склад только копит куски и отдает их все разом, когда его отпускает
+     * последний пул. Поэтому узлы можно перевешивать из дерева в дерево без копирования
+     * (split, merge, join): получатель просто тоже начинает держать склад источника (share),
+     * и память его узлов живет, пока жив хоть один из пулов. Новый кусок добавляется в склад
+     * атомарно, а список свободных ячеек и хвост последнего куска у каждого пула свои,
+     * поэтому деревья с общим складом можно менять из разных потоков.
+     * Когда все узлы одного дерева переезжают в другое (merge, join), пул получателя
+     * забирает и свободные ячейки источника (absorb), а источник отпускает свои склады.
+     * Делить склад можно только с пулом с равным аллокатором, иначе освобождать куски будет некому.
+     *
+     * @tparam Node - тип узла
+     * @tparam Allocator - аллокатор контейнера
+     */
+    template<typename Node, typename Allocator = std::allocator<Node>>
+    class NodePool {
+        using size_type = std::size_t;
+        union Slot;
+        // Заголовок куска, лежит в первой ячейке каждого куска
+        struct ChunkHeader {
+            Slot* next_;
+            size_type count_;
+        };
+        // Ячейка - либо живой узел, либо звено списка свободных ячеек
+        union Slot {
+            Slot* next_;
+            ChunkHeader chunk_;
+            alignas(Node) unsigned char storage_[sizeof(Node)];
+        };
+        using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+        using slot_traits = std::allocator_traits<slot_allocator>;
+        class Arena;
+        using arena_ptr = std::shared_ptr<Arena>;
+        using arena_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Arena>;
+        using arena_list = std::vector<arena_ptr,
+                                       typename std::allocator_traits<Allocator>::template rebind_alloc<arena_ptr>>;
+
+        public:
+            using allocator_type = Allocator;
+
+            // Пустой пул ничего не выделяет, склад создается при первом куске
+            explicit NodePool(const Allocator& alloc = Allocator()) noexcept
+                : alloc_(alloc), kept_(typename arena_list::allocator_type(alloc)) {}
+            NodePool(const NodePool&) = delete;
+            NodePool& operator=(const NodePool&) = delete;
+
+            // Перемещение забирает склады и свободные ячейки, other остается пустым
+            NodePool(NodePool&& other) noexcept
+                : alloc_(other.alloc_), arena_(std::move(other.arena_)), kept_(std::move(other.kept_)),
+                  free_(other.free_), cursor_(other.cursor_), end_(other.end_), next_chunk_(other.next_chunk_) {
+                other.forgetSlots();
+            }
+
+            ~NodePool() = default;
+
+            /**
+             * @brief Выдает память под один узел
+             * @details Сначала берем ячейку из списка свободных, потом из хвоста
+             * последнего куска, и только если и там пусто - просим у системы новый кусок
+             *
+             * @return Node* - неинициализированная память под узел
+             */
+            Node* allocate() {
+                Slot* slot = this->free_;
+                if (slot != nullptr) {
+                    this->free_ = slot->next_;
+                } else {
+                    if (this->cursor_ == this->end_) {
+                        this->grow();
+                    }
+                    slot = this->cursor_++;
+                }
+                return reinterpret_cast<Node*>(slot->storage_);
+            }
+
+            /**
+             * @brief Готовит память под count узлов одним куском
+             * @details Если в хвосте последнего куска меньше count ячеек, хвост уходит
+             * в список свободных, а новый кусок выделяется ровно на count ячеек (даже
+             * больше kMaxChunk). Следующие count вызовов allocate (после свободных
+             * ячеек) не обращаются к аллокатору, и узлы лежат в памяти подряд
+             *
+             * @param count
+             */
+            void reserve(size_type count) {
+                if (static_cast<size_type>(this->end_ - this->cursor_) >= count) {
+                    return;
+                }
+                Slot* chunk = this->allocateChunk(count);
+                this->freeTail();
+                this->addChunk(chunk, count);
+            }
+
+            /**
+             * @brief Возвращает ячейку узла в список свободных
+             * @details Деструктор узла к этому моменту уже должен быть вызван
+             *
+             */
+            void deallocate(Node* node) noexcept {
+                Slot* slot = reinterpret_cast<Slot*>(node);
+                slot->next_ = this->free_;
+                this->free_ = slot;
+            }
+
+            /**
+             * @brief Отпускает всю память пула разом
+             * @details Вызывать можно только когда в пуле не осталось живых узлов. Куски
+             * освобождаются, если склады больше никто не держит, иначе остаются другим пулам
+             *
+             */
+            void release() noexcept {
+                this->arena_.reset();
+                this->kept_.clear();
+                this->forgetSlots();
+            }
+
+            /**
+             * @brief Дает this право держать узлы из памяти other
+             * @details this начинает держать все склады other (если своего склада у this еще
+             * нет, склад other становится и складом для новых кусков this). Ничего не выделяет,
+             * если у other один склад; иначе место под ссылки резервируется до изменений,
+             * так что при исключении пул не меняется
+             *
+             * @return false - аллокаторы не равны, делить память нельзя
+             */
+            bool share(const NodePool& other) {
+                if (this == &other) {
+                    return true;
+                }
+                if (!(this->alloc_ == other.alloc_)) {
+                    return false;
+                }
+                this->keepArenas(other, true);
+                return true;
+            }
+
+            /**
+             * @brief Забирает себе всю память другого пула
+             * @details Как share, но other после этого пустой: его свободные ячейки переходят
+             * к this. Склад, который держит только other, сливается со складом this, так что
+             * список чужих складов не растет от merge к merge.
+             * Вызывать, только если все живые узлы other переезжают в this
+             *
+             * @return false - аллокаторы не равны, память забрать нельзя
+             */
+            bool absorb(NodePool& other) {
+                if (this == &other) {
+                    return true;
+                }
+                if (!(this->alloc_ == other.alloc_)) {
+                    return false;
+                }
+                bool splice = this->arena_ != nullptr && other.arena_ != nullptr && other.arena_.use_count() == 1;
+                this->keepArenas(other, !splice);
+                if (splice) {
+                    this->arena_->splice(*other.arena_);
+                }
+                other.freeTail();
+                while (other.free_ != nullptr) {
+                    Slot* slot = other.free_;
+                    other.free_ = slot->next_;
+                    slot->next_ = this->free_;
+                    this->free_ = slot;
+                }
+                other.release();
+                return true;
+            }
+
+            /**
+             * @brief Меняет содержимое пулов вместе с аллокаторами
+             *
+             */
+            void swap(NodePool& other) noexcept {
+                std::swap(this->alloc_, other.alloc_);
+                this->arena_.swap(other.arena_);
+                this->kept_.swap(other.kept_);
+                std::swap(this->free_, other.free_);
+                std::swap(this->cursor_, other.cursor_);
+                std::swap(this->end_, other.end_);
+                std::swap(this->next_chunk_, other.next_chunk_);
+            }
+
+            /**
+             * @brief Возвращает копию аллокатора пула
+             *
+             */
+            Allocator get_allocator() const noexcept {
+                return Allocator(this->alloc_);
+            }
+
+        private:
+            // Первый кусок небольшой, каждый следующий в два раза больше,
+            // но не больше kMaxChunk ячеек
+            static constexpr size_type kMinChunk = 16;
+            static constexpr size_type kMaxChunk = 4096;
+
+            /**
+             * @brief Склад кусков, общий для пулов, которые держат узлы из его памяти
+             * @details Куски только добавляются (из разных потоков - через compare_exchange)
+             * и освобождаются все в деструкторе, когда склад отпускает последний пул
+             *
+             */
+            class Arena {
+                public:
+                    explicit Arena(const slot_allocator& alloc) noexcept : alloc_(alloc), chunks_(nullptr) {}
+                    Arena(const Arena&) = delete;
+                    Arena& operator=(const Arena&) = delete;
+
+                    ~Arena() {
+                        Slot* chunk = this->chunks_.load(std::memory_order_relaxed);
+                        while (chunk != nullptr) {
+                            Slot* next = chunk->chunk_.next_;
+                            slot_traits::deallocate(this->alloc_, chunk, chunk->chunk_.count_);
+                            chunk = next;
+                        }
+                    }
+
+                    // Добавляет цепочку кусков first..last
+                    void push(Slot* first, Slot* last) noexcept {
+                        Slot* head = this->chunks_.load(std::memory_order_relaxed);
+                        do {
+                            last->chunk_.next_ = head;
+                        } while (!this->chunks_.compare_exchange_weak(head, first, std::memory_order_release,
+                                                                      std::memory_order_relaxed));
+                    }
+
+                    // Забирает все куски склада other, который больше никто не держит
+                    void splice(Arena& other) noexcept {
+                        Slot* first = other.chunks_.exchange(nullptr, std::memory_order_relaxed);
+                        if (first != nullptr) {
+                            Slot* last = first;
+                            while (last->chunk_.next_ != nullptr) {
+                                last = last->chunk_.next_;
+                            }
+                            this->push(first, last);
+                        }
+                    }
+
+                private:
+                    slot_allocator alloc_;
+                    std::atomic<Slot*> chunks_;
+            };
+
+            /**
+             * @brief Выделяет новый кусок и делает его хвост текущим
+             *
+             */
+            void grow() {
+                size_type count = this->next_chunk_;
+                this->addChunk(this->allocateChunk(count), count);
+                if (this->next_chunk_ < kMaxChunk) {
+                    this->next_chunk_ *= 2;
+                }
+            }
+
+            // Выделяет кусок на count ячеек (+1 под заголовок), склад создается заранее,
+            // чтобы кусок было куда положить
+            Slot* allocateChunk(size_type count) {
+                if (this->arena_ == nullptr) {
+                    this->arena_ = std::allocate_shared<Arena>(arena_allocator(this->alloc_), this->alloc_);
+                }
+                return slot_traits::allocate(this->alloc_, count + 1);
+            }
+
+            // Кладет кусок chunk на count ячеек в склад и делает его текущим
+            void addChunk(Slot* chunk, size_type count) noexcept {
+                chunk->chunk_.count_ = count + 1;
+                this->arena_->push(chunk, chunk);
+                this->cursor_ = chunk + 1;
+                this->end_ = chunk + count + 1;
+            }
+
+            // Нетронутый хвост последнего куска уходит в список свободных
+            void freeTail() noexcept {
+                for (; this->cursor_ != this->end_; ++this->cursor_) {
+                    this->cursor_->next_ = this->free_;
+                    this->free_ = this->cursor_;
+                }
+            }
+
+            // Забывает свободные ячейки (их память держат склады)
+            void forgetSlots() noexcept {
+                this->free_ = nullptr;
+                this->cursor_ = nullptr;
+                this->end_ = nullptr;
+                this->next_chunk_ = kMinChunk;
+            }
+
+            // Держит ли пул склад arena (пустая ссылка - держит)
+            bool holds(const arena_ptr& arena) const noexcept {
+                return arena == nullptr || arena == this->arena_ ||
+                       std::find(this->kept_.begin(), this->kept_.end(), arena) != this->kept_.end();
+            }
+
+            /**
+             * @brief Начинает держать склады other (with_main - и склад для новых кусков other)
+             * @details Сначала резервируем место под недостающие ссылки, потом добавляем:
+             * бросить может только резерв. Первый недостающий склад становится своим,
+             * если своего еще нет
+             *
+             */
+            void keepArenas(const NodePool& other, bool with_main) {
+                size_type missing = 0;
+                if (with_main && !this->holds(other.arena_)) {
+                    ++missing;
+                }
+                for (const arena_ptr& arena : other.kept_) {
+                    if (!this->holds(arena)) {
+                        ++missing;
+                    }
+                }
+                if (missing > 0 && this->arena_ == nullptr) {
+                    --missing;
+                }
+                if (missing > 0) {
+                    this->kept_.reserve(this->kept_.size() + missing);
+                }
+                auto keep = [this](const arena_ptr& arena) {
+                    if (this->holds(arena)) {
+                        return;
+                    }
+                    if (this->arena_ == nullptr) {
+                        this->arena_ = arena;
+                    } else {
+                        this->kept_.push_back(arena);
+                    }
+                };
+                if (with_main) {
+                    keep(other.arena_);
+                }
+                for (const arena_ptr& arena : other.kept_) {
+                    keep(arena);
+                }
+            }
+
+            // аллокатор, у которого берем куски
+            slot_allocator alloc_;
+            // склад, в который кладем свои новые куски (может быть общим с другими пулами)
+            arena_ptr arena_;
+            // чужие склады, из памяти которых у нас есть узлы
+            arena_list kept_;
+            // список свободных ячеек
+            Slot* free_ = nullptr;
+            // еще не выданная часть последнего куска [cursor_, end_)
+            Slot* cursor_ = nullptr;
+            Slot* end_ = nullptr;
+            // сколько ячеек будет в следующем куске
+            size_type next_chunk_ = kMinChunk;
+    }; // NodePool
+} // s21
+
+#endif // SRC_S21_NODE_POOL_H_
@@ -1,24 +1,35 @@
 #ifndef SRC_S21_QUEUE_H_
 #define SRC_S21_QUEUE_H_
-#include "s21_list.h"
+#include "s21_deque.h"
 #include <algorithm>
 #include <initializer_list>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 namespace s21 {
 /**
  * @brief Queue (очередь) - это контейнер с элементами, организованными по принцнипу FIFO (First-In, First-Out).
  * @details Так же как список, однако удаление производится строго из "головы",
  * а запись, то есть добавление новых элементов, строго в "хвост".
- * Реализован через список (s21::list)
+ * Queue - адаптер над последовательным контейнером Container, как std::queue.
+ * По умолчанию это блочная очередь s21::deque: push и pop не выделяют память на каждый элемент.
+ * Подойдет любой контейнер с front, back, push_back, emplace_back и pop_front, например
+ * s21::queue<T, s21::list<T>>. Память контейнера настраивается через его аллокатор:
+ * s21::queue<T, s21::deque<T, MyAllocator<T>>>
  * 
+ * @tparam T
+ * @tparam Container - контейнер, в котором хранятся элементы
  */
-template<typename T>
+template<typename T, typename Container = s21::deque<T>>
     class queue {
         public:
-            using value_type = T;
-            using reference = T&;
-            using const_reference = const T&;
-            using size_type = std::size_t;
+            using container_type = Container;
+            using value_type = typename Container::value_type;
+            using reference = typename Container::reference;
+            using const_reference = typename Container::const_reference;
+            using size_type = typename Container::size_type;
 
             /*---------------------------constructors and operators queue-----------------------------------*/
 
@@ -26,43 +37,67 @@ template<typename T>
              * @brief Конструктор по умолчанию, создает пустую очередь
              * 
              */
-            queue() : list_() {}
+            queue() : container_() {}
 
             /**
              * @brief Конструктор списка инициализаторов, создает очередь
              * 
              * @param items 
              */
-            explicit queue(std::initializer_list<value_type> const &items) : list_(items) {}
+            explicit queue(std::initializer_list<value_type> const &items) : container_(items) {}
+
+            /**
+             * @brief Конструктор копирует готовый контейнер
+             *
+             * @param cont
+             */
+            explicit queue(const Container& cont) : container_(cont) {}
+
+            /**
+             * @brief Конструктор забирает готовый контейнер перемещением
+             *
+             * @param cont
+             */
+            explicit queue(Container&& cont) : container_(std::move(cont)) {}
+
+            /**
+             * @brief Конструктор создает пустой контейнер с заданным аллокатором
+             * @details Доступен только если контейнер умеет работать с таким аллокатором
+             *
+             * @param alloc
+             */
+            template<typename Alloc, typename = std::enable_if_t<std::uses_allocator<Container, Alloc>::value>>
+            explicit queue(const Alloc& alloc) : container_(alloc) {}
 
             /**
              * @brief Конструктор копирования
              * 
              * @param q 
              */
-            queue(const queue &q) : list_(q.list_) {}
+            queue(const queue &q) : container_(q.container_) {}
 
             /**
              * @brief Конструктор перемещения
              * 
              * @param q 
              */
-            queue(const queue &&q) : list_(std::move(q.list_)) {}
+            queue(queue &&q) noexcept(std::is_nothrow_move_constructible<Container>::value)
+                : container_(std::move(q.container_)) {}
 
             /**
              * @brief Деструктор будет дефолдным
-             * @details list_ сам себя почистит, у него есть свой деструктор
+             * @details container_ сам себя почистит, у него есть свой деструктор
              * 
              */
             ~queue() = default;
 
             queue& operator=(queue &q) {
-                this->list_ = q.list_;
+                this->container_ = q.container_;
                 return *this;
             }
 
             queue& operator=(queue &&q) noexcept {
-                this->list_ = std::move(q.list_);
+                this->container_ = std::move(q.container_);
                 return *this;
             }
 
@@ -72,11 +107,15 @@ template<typename T>
 
             /**
              * @brief Получить доступ к первому элементу
+             * @details У пустой очереди - значение по умолчанию (см. emptyValue)
              * 
              * @return reference 
              */
-            reference front() noexcept {
-                return this->list_.front();
+            reference front() {
+                if (this->container_.empty())
+                    return this->emptyValue();
+
+                return this->container_.front();
             }
 
             /**
@@ -85,17 +124,24 @@ template<typename T>
              * 
              * @return const_reference 
              */
-            const_reference front() const noexcept {
-                return this->list_.front();
+            const_reference front() const {
+                if (this->container_.empty())
+                    return this->emptyValue();
+
+                return this->container_.front();
             }
 
             /**
              * @brief Получить доступ к последнему элементу
+             * @details У пустой очереди - значение по умолчанию (см. emptyValue)
              * 
              * @return reference 
              */
-            reference back() noexcept {
-                return this->list_.back();
+            reference back() {
+                if (this->container_.empty())
+                    return this->emptyValue();
+
+                return this->container_.back();
             }
 
             /**
@@ -104,8 +150,11 @@ template<typename T>
              * 
              * @return const_reference 
              */
-            const_reference back() const noexcept {
-                return this->list_.back();
+            const_reference back() const {
+                if (this->container_.empty())
+                    return this->emptyValue();
+
+                return this->container_.back();
             }
 
             /**
@@ -115,11 +164,11 @@ template<typename T>
              * @return false - контейнер не пуст
              */
             bool empty() const noexcept {
-                return this->list_.empty();
+                return this->container_.empty();
             }
 
             size_type size() const noexcept {
-                return this->list_.size();
+                return this->container_.size();
             }
 
             /**
@@ -128,7 +177,7 @@ template<typename T>
              * @param value 
              */
             void push(const_reference value) {
-                this->list_.push_back(value);
+                this->container_.push_back(value);
             }
 
 
@@ -137,7 +186,7 @@ template<typename T>
              * 
              */
             void pop() noexcept {
-                this->list_.pop_front();
+                this->container_.pop_front();
             }
 
             /**
@@ -146,18 +195,30 @@ template<typename T>
              * @param other 
              */
             void swap(queue& other) {
-                std::swap(this->list_, other.list_);
+                std::swap(this->container_, other.container_);
+            }
+
+            /**
+             * @brief Создает новый элемент из args прямо в конце контейнера
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             */
+            template<typename... Args>
+            void emplace(Args&&... args) {
+                this->container_.emplace_back(std::forward<Args>(args)...);
             }
 
             /**
              * @brief Добавляет новые элементы в конец контейнера
+             * @details Каждый аргумент - отдельный элемент
              * 
              * @tparam Args 
              * @param args 
              */
             template<typename... Args>
-            void emplace_back(Args&&... args) {
-                this->list_.emplace_back(std::forward<Args>(args)...);
+            void insert_many_back(Args&&... args) {
+                (this->container_.emplace_back(std::forward<Args>(args)), ...);
             }
 
 
@@ -165,7 +226,27 @@ template<typename T>
 
 
         private:
-            s21::list<T> list_;
+            /**
+             * @brief Что front() и back() возвращают у пустой очереди
+             * @details Так было, пока очередь строилась на s21::list со служебным узлом: значение
+             * по умолчанию, а не чтение свободной ячейки контейнера. Значение хранится в самой
+             * очереди и создается заново при каждом обращении, так что запись через ссылку
+             * ни на что не влияет. Если T нельзя создать по умолчанию - std::out_of_range
+             *
+             * @return reference
+             */
+            reference emptyValue() const {
+                if constexpr (std::is_default_constructible<value_type>::value) {
+                    return this->empty_value_.emplace();
+                } else {
+                    throw std::out_of_range("s21::queue: Using methods on a zero sized container");
+                }
+            }
+
+            // Контейнер с элементами (по умолчанию s21::deque)
+            Container container_;
+            // значение front() и back() у пустой очереди (см. emptyValue)
+            mutable std::optional<value_type> empty_value_;
     }; // queue
 } // s21
 
@@ -0,0 +1,413 @@
+#ifndef SRC_S21_RING_BUFFER_H_
+#define SRC_S21_RING_BUFFER_H_
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "s21_debug.h"
+#include "s21_inline_storage.h"
+
+namespace s21 {
+    /**
+     * @brief Основа ring_buffer: хранилище, начало и размер
+     * @details Как у StaticVectorBase: для тривиальных T все специальные методы тривиальные,
+     * для остальных элементы копируются, перемещаются и уничтожаются по одному (специализация ниже)
+     *
+     * @tparam T
+     * @tparam Cap
+     */
+    template<typename T, std::size_t Cap, bool = std::is_trivial<T>::value>
+    class RingBufferBase {
+        protected:
+            InlineStorage<T, Cap> storage_;
+            std::size_t head_ = 0;
+            std::size_t size_ = 0;
+    };
+
+    template<typename T, std::size_t Cap>
+    class RingBufferBase<T, Cap, false> {
+        using size_type = std::size_t;
+        protected:
+            RingBufferBase() noexcept : head_(0), size_(0) {}
+
+            // Копия укладывается с нулевой ячейки. Тело выполняется после делегирующего
+            // конструктора, так что при исключении созданные элементы уничтожит деструктор
+            RingBufferBase(const RingBufferBase& other) : RingBufferBase() {
+                for (; this->size_ < other.size_; this->size_++)
+                    this->storage_.construct(this->size_, *other.storage_.slot((other.head_ + this->size_) & (Cap - 1)));
+            }
+
+            // Как у s21::queue, other после перемещения пуст
+            RingBufferBase(RingBufferBase&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : RingBufferBase() {
+                for (; this->size_ < other.size_; this->size_++)
+                    this->storage_.construct(this->size_,
+                                             std::move(*other.storage_.slot((other.head_ + this->size_) & (Cap - 1))));
+                other.destroyAll();
+            }
+
+            ~RingBufferBase() {
+                this->destroyAll();
+            }
+
+            RingBufferBase& operator=(const RingBufferBase& other) {
+                if (this != &other) {
+                    this->destroyAll();
+                    for (; this->size_ < other.size_; this->size_++)
+                        this->storage_.construct(this->size_, *other.storage_.slot((other.head_ + this->size_) & (Cap - 1)));
+                }
+                return *this;
+            }
+
+            RingBufferBase& operator=(RingBufferBase&& other) {
+                if (this != &other) {
+                    this->destroyAll();
+                    for (; this->size_ < other.size_; this->size_++)
+                        this->storage_.construct(this->size_,
+                                                 std::move(*other.storage_.slot((other.head_ + this->size_) & (Cap - 1))));
+                    other.destroyAll();
+                }
+                return *this;
+            }
+
+            void destroyAll() noexcept {
+                for (; this->size_ > 0; this->size_--) {
+                    this->storage_.destroy(this->head_);
+                    this->head_ = (this->head_ + 1) & (Cap - 1);
+                }
+                this->head_ = 0;
+            }
+
+            InlineStorage<T, Cap> storage_;
+            size_type head_;
+            size_type size_;
+    };
+
+    /**
+     * @brief ring_buffer - ограниченная очередь FIFO на Cap ячейках внутри объекта
+     * @details Элементы лежат в InlineStorage по кругу: head_ - ячейка первого элемента,
+     * следующий за последним пишется в (head_ + size_) & (Cap - 1). Cap - степень двойки,
+     * поэтому переход по кругу - маска, а не деление. Память никогда не выделяется.
+     * push и emplace при заполненном буфере бросают std::out_of_range, try_push и
+     * try_emplace просто возвращают false - для горячего пути, где исключения не нужны.
+     * Для тривиальных T все методы constexpr (см. InlineStorage).
+     * Это однопоточный контейнер, очередь между потоками - s21::spsc_queue
+     *
+     * @tparam T - тип элемента
+     * @tparam Cap - количество ячеек, степень двойки
+     */
+    template<typename T, std::size_t Cap>
+    class ring_buffer : private RingBufferBase<T, Cap> {
+        static_assert(Cap > 0 && (Cap & (Cap - 1)) == 0, "s21::ring_buffer: Cap must be a power of two");
+        public:
+            using value_type = T;
+            using reference = T&;
+            using const_reference = const T&;
+            using size_type = std::size_t;
+
+            /*------------------constructors and operators ring_buffer----------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустой буфер
+             *
+             */
+            ring_buffer() = default;
+
+            /**
+             * @brief Конструктор списка инициализаторов, первый элемент списка окажется в начале очереди
+             *
+             * @param items
+             */
+            constexpr ring_buffer(std::initializer_list<value_type> const &items) : ring_buffer() {
+                if (items.size() > Cap)
+                    throw std::out_of_range("s21::ring_buffer: Initializer_list is larger than capacity");
+
+                for (const_reference item : items)
+                    this->emplace(item);
+            }
+
+            // Копирование, перемещение и деструктор - у RingBufferBase
+            ring_buffer(const ring_buffer&) = default;
+            ring_buffer(ring_buffer&&) = default;
+            ring_buffer& operator=(const ring_buffer&) = default;
+            ring_buffer& operator=(ring_buffer&&) = default;
+            ~ring_buffer() = default;
+
+            /*------------------------------------------------------------------------*/
+
+            /*-------------------------methods ring_buffer---------------------------*/
+
+            /**
+             * @brief Доступ к первому элементу (следующему на извлечение)
+             *
+             * @return reference
+             */
+            constexpr reference front() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::ring_buffer::front: Using methods on a zero sized container");
+
+                return *this->storage_.slot(this->head_);
+            }
+
+            /**
+             * @brief Доступ к первому элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            constexpr const_reference front() const {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::ring_buffer::front: Using methods on a zero sized container");
+
+                return *this->storage_.slot(this->head_);
+            }
+
+            /**
+             * @brief Доступ к последнему добавленному элементу
+             *
+             * @return reference
+             */
+            constexpr reference back() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::ring_buffer::back: Using methods on a zero sized container");
+
+                return *this->storage_.slot(this->slotOf(this->size_ - 1));
+            }
+
+            /**
+             * @brief Доступ к последнему добавленному элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            constexpr const_reference back() const {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::ring_buffer::back: Using methods on a zero sized container");
+
+                return *this->storage_.slot(this->slotOf(this->size_ - 1));
+            }
+
+            /**
+             * @brief Доступ к pos-му от начала очереди элементу без проверки границ
+             * @details Проверка только в сборке с S21_CONTAINERS_DEBUG (см. s21_debug.h)
+             *
+             * @param pos
+             * @return reference
+             */
+            constexpr reference operator[](size_type pos) {
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::ring_buffer::operator[]: The index is out of range");
+                return *this->storage_.slot(this->slotOf(pos));
+            }
+
+            /**
+             * @brief Доступ к pos-му от начала очереди элементу без проверки границ
+             * @details Для конст объекта
+             *
+             * @param pos
+             * @return const_reference
+             */
+            constexpr const_reference operator[](size_type pos) const {
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::ring_buffer::operator[]: The index is out of range");
+                return *this->storage_.slot(this->slotOf(pos));
+            }
+
+            /**
+             * @brief Проверяет, пуст ли буфер
+             *
+             * @return true - буфер пуст
+             * @return false - буфер не пуст
+             */
+            constexpr bool empty() const noexcept {
+                return this->size_ == 0;
+            }
+
+            /**
+             * @brief Проверяет, заполнены ли все Cap ячеек
+             *
+             * @return true - добавлять некуда
+             * @return false - место есть
+             */
+            constexpr bool full() const noexcept {
+                return this->size_ == Cap;
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            constexpr size_type size() const noexcept {
+                return this->size_;
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             *
+             * @return size_type - Cap
+             */
+            constexpr size_type max_size() const noexcept {
+                return Cap;
+            }
+
+            /**
+             * @brief Вместимость буфера, всегда Cap
+             *
+             * @return size_type
+             */
+            static constexpr size_type capacity() noexcept {
+                return Cap;
+            }
+
+            /**
+             * @brief Добавляет элемент в конец
+             * @throw std::out_of_range - буфер заполнен
+             *
+             * @param value
+             */
+            constexpr void push(const_reference value) {
+                this->emplace(value);
+            }
+
+            /**
+             * @brief Аналогично push только вставка перемещением
+             *
+             * @param value
+             */
+            constexpr void push(value_type&& value) {
+                this->emplace(std::move(value));
+            }
+
+            /**
+             * @brief Создает новый элемент из args в конце
+             * @throw std::out_of_range - буфер заполнен
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            constexpr reference emplace(Args&&... args) {
+                if (this->size_ == Cap)
+                    throw std::out_of_range("s21::ring_buffer::push: The buffer is full");
+
+                return this->emplaceBack(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Добавляет элемент в конец, если есть место
+             *
+             * @param value
+             * @return true - элемент добавлен
+             * @return false - буфер заполнен, value не тронут
+             */
+            constexpr bool try_push(const_reference value) {
+                return this->try_emplace(value);
+            }
+
+            /**
+             * @brief Аналогично try_push только вставка перемещением
+             * @details Если буфер заполнен, value не перемещается
+             *
+             * @param value
+             * @return true - элемент добавлен
+             * @return false - буфер заполнен
+             */
+            constexpr bool try_push(value_type&& value) {
+                return this->try_emplace(std::move(value));
+            }
+
+            /**
+             * @brief Создает новый элемент из args в конце, если есть место
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return true - элемент добавлен
+             * @return false - буфер заполнен
+             */
+            template<typename... Args>
+            constexpr bool try_emplace(Args&&... args) {
+                if (this->size_ == Cap)
+                    return false;
+
+                this->emplaceBack(std::forward<Args>(args)...);
+                return true;
+            }
+
+            /**
+             * @brief Удаляет первый элемент
+             * @throw std::out_of_range - буфер пуст
+             *
+             */
+            constexpr void pop() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::ring_buffer::pop: nothing to delete...");
+
+                this->popFront();
+            }
+
+            /**
+             * @brief Перемещает первый элемент в value и удаляет его, если буфер не пуст
+             *
+             * @param value
+             * @return true - элемент извлечен
+             * @return false - буфер пуст, value не тронут
+             */
+            constexpr bool try_pop(reference value) {
+                if (this->size_ == 0)
+                    return false;
+
+                value = std::move(*this->storage_.slot(this->head_));
+                this->popFront();
+                return true;
+            }
+
+            /**
+             * @brief Очищает содержимое
+             *
+             */
+            constexpr void clear() noexcept {
+                while (this->size_ > 0)
+                    this->popFront();
+                this->head_ = 0;
+            }
+
+            /**
+             * @brief Меняет содержимое
+             * @details Памяти не передать, поэтому элементы переносятся перемещением - O(size)
+             *
+             * @param other
+             */
+            constexpr void swap(ring_buffer& other) {
+                ring_buffer tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+            }
+
+        private:
+            /**
+             * @brief Ячейка pos-го от начала очереди элемента
+             *
+             * @param pos
+             * @return size_type
+             */
+            constexpr size_type slotOf(size_type pos) const noexcept {
+                return (this->head_ + pos) & (Cap - 1);
+            }
+
+            template<typename... Args>
+            constexpr reference emplaceBack(Args&&... args) {
+                reference item = this->storage_.construct(this->slotOf(this->size_), std::forward<Args>(args)...);
+                this->size_++;
+                return item;
+            }
+
+            constexpr void popFront() noexcept {
+                this->storage_.destroy(this->head_);
+                this->head_ = (this->head_ + 1) & (Cap - 1);
+                this->size_--;
+            }
+    };
+}
+
+#endif // SRC_S21_RING_BUFFER_H_
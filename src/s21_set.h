@@ -1,5 +1,6 @@
 #ifndef SRC_S21_SET_H_
 #define SRC_S21_SET_H_
+#include "s21_btree.h"
 #include "s21_tree.h"
 
 namespace s21 {
@@ -9,18 +10,29 @@ namespace s21 {
      * Контейнер множество является ассоциативным, так как внутри он также представлен в виде дерева,
      * как и контейнер map (словарь), и, соответственно, также хранит элементы в отсортированном порядке.
      * Реализов через tree (дерева), его реализацию смотрите в s21_tree.h
+     *
+     * @tparam Key - тип элемента
+     * @tparam Compare - компаратор элементов
+     * @tparam Allocator - аллокатор элементов
+     * @tparam OrderStatistics - хранить в узлах размеры поддеревьев, чтобы nth_element,
+     * rank и count_range работали за O(log n) (см. BinaryTree)
+     * @tparam TreePolicy - движок дерева: RedBlackTreePolicy (по умолчанию) или BTreePolicy
+     * (B-дерево, см. s21_btree.h)
      */
-    template<typename Key>
+    template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>,
+             bool OrderStatistics = false, typename TreePolicy = RedBlackTreePolicy>
     class set {
         using key_type = Key;
         using value_type = Key;
         using reference = value_type&;
         using const_reference = const value_type&;
-        using tree = BinaryTree<Key>;
+        using tree = typename TreePolicy::template tree<Key, Compare, Allocator, OrderStatistics>;
         using size_type = std::size_t;
         public:
             using iterator = typename tree::iterator;
             using const_iterator = typename tree::const_iterator;
+            using key_compare = Compare;
+            using allocator_type = Allocator;
 
 
             /*------------------constructors and operators set----------------------*/
@@ -31,14 +43,45 @@ namespace s21 {
              */
             set() : tree_() {}
 
+            /**
+             * @brief Создает пустой набор с заданным компаратором и аллокатором
+             *
+             * @param comp
+             * @param alloc
+             */
+            explicit set(const Compare& comp, const Allocator& alloc = Allocator()) : tree_(comp, alloc) {}
+
+            /**
+             * @brief Создает пустой набор с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit set(const Allocator& alloc) : tree_(alloc) {}
+
             /**
              * @brief Конструктор списка инициализаторов, создает набор
+             * @details Дерево строится сразу целиком, см. конструктор из диапазона
              * 
+             * @param items 
              */
-            set(std::initializer_list<value_type> const &items) : tree_() {
-                for (auto element : items) {
-                    this->tree_.insertUnique(element);
-                }
+            set(std::initializer_list<value_type> const &items, const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator()) : tree_(comp, alloc) {
+                this->tree_.assignUnique(items.begin(), items.end());
+            }
+
+            /**
+             * @brief Конструктор из диапазона [first, last)
+             * @details Если элементы уже отсортированы, дерево строится снизу вверх за O(n),
+             * иначе они сначала сортируются (из равных ключей остается первый)
+             * 
+             * @tparam InputIt - итератор
+             * @param first 
+             * @param last 
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            set(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+                : tree_(comp, alloc) {
+                this->tree_.assignUnique(first, last);
             }
 
             /**
@@ -53,7 +96,7 @@ namespace s21 {
              * 
              * @param s 
              */
-            set(set &&s) : tree_(std::move(s.tree_)) {}
+            set(set &&s) noexcept(std::is_nothrow_move_constructible<tree>::value) : tree_(std::move(s.tree_)) {}
 
             /**
              * @brief Деструктор будет дефолдным
@@ -79,7 +122,7 @@ namespace s21 {
              * @param s 
              * @return set& 
              */
-            set& operator=(set &&s) {
+            set& operator=(set &&s) noexcept(std::is_nothrow_move_assignable<tree>::value) {
                 this->tree_ = std::move(s.tree_);
                 return *this;
             }
@@ -88,6 +131,15 @@ namespace s21 {
 
             /*------------------------methods set-------------------------*/
 
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->tree_.get_allocator();
+            }
+
             /**
              * @brief Возвращает итератор в начало
              * 
@@ -164,6 +216,20 @@ namespace s21 {
                 this->tree_.clear();
             }
 
+            /**
+             * @brief Заменяет содержимое элементами из отсортированного диапазона [first, last)
+             * @details Диапазон должен идти по возрастанию ключей (в смысле Compare),
+             * это не проверяется. Дерево строится снизу вверх за O(n), из равных ключей остается первый
+             * 
+             * @tparam InputIt 
+             * @param first 
+             * @param last 
+             */
+            template<typename InputIt>
+            void assign_sorted(InputIt first, InputIt last) {
+                this->tree_.assignSortedUnique(first, last);
+            }
+
 
             /**
              * @brief Вставляет элемент со значением в контейнер,
@@ -177,6 +243,20 @@ namespace s21 {
                 return this->tree_.insertUnique(value);
             }
 
+            /**
+             * @brief Вставляет элемент, используя hint как подсказку, куда он должен встать
+             * @details Если элемент должен стоять прямо перед hint (или сразу после него),
+             * вставка идет без спуска от корня - удобно при вставке почти отсортированных
+             * ключей с подсказкой end(). Неверная подсказка просто ведет к обычной вставке
+             * 
+             * @param hint 
+             * @param value 
+             * @return iterator - указывает на вставленный элемент или на элемент с таким же ключом
+             */
+            iterator insert(const_iterator hint, const value_type& value) {
+                return this->tree_.insertUnique(hint, value);
+            }
+
             /**
              * @brief Стирает элемент в позиции
              * 
@@ -188,15 +268,19 @@ namespace s21 {
 
             /**
              * @brief Меняет содержимое
+             * @details Без выделения памяти: деревья меняются корнями и пулами
              * 
              * @param other 
              */
             void swap(set& other) noexcept {
-                std::swap(this->tree_, other.tree_);
+                this->tree_.swap(other.tree_);
             }
 
             /**
              * @brief Cоединяет узлы из другого контейнера
+             * @details Узлы other перевешиваются без копирования, ссылки на перенесенные
+             * элементы остаются действительными. Если аллокаторы не равны, память other
+             * держать нельзя - тогда элемент перемещается в новый узел this
              * 
              * @param other 
              */
@@ -204,6 +288,120 @@ namespace s21 {
                 this->tree_.mergeUnique(other.tree_);
             }
 
+            /**
+             * @brief Отделяет от контейнера все элементы, которые >= key
+             * @details В this остаются элементы меньше key, остальные переезжают в результат.
+             * В красно-черном дереве узлы перевешиваются без копирования и без выделения
+             * памяти: дерево разрезается за O(log n), но без OrderStatistics размеры частей
+             * пересчитываются за O(min(k, n - k)) (см. BinaryTree::split). В BTreePolicy
+             * элементы перемещаются по одному - O(k) (см. BTree::split)
+             *
+             * @param key
+             * @return set - элементы >= key
+             */
+            set split(const Key& key) {
+                set upper(this->get_allocator());
+                this->tree_.split(key, upper.tree_);
+                return upper;
+            }
+
+            /**
+             * @brief Переносит в this все элементы other, если их ключи целиком больше
+             * или целиком меньше ключей this
+             * @details Деревья склеиваются за O(log n) без копирования (см. BinaryTree::join),
+             * other становится пустым
+             *
+             * @param other
+             * @throw std::invalid_argument - диапазоны ключей пересекаются
+             */
+            void join(set& other) {
+                this->tree_.join(other.tree_, true);
+            }
+
+            /**
+             * @brief Объединение: добавляет элементы other, которых нет в this
+             * @details this и other обходятся по порядку один раз, свои узлы не копируются,
+             * дерево собирается заново снизу вверх - O(n + m) (см. BinaryTree::combineWith).
+             *
+             * @param other
+             * @return set& - *this
+             */
+            set& union_with(const set& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::Union);
+                return *this;
+            }
+
+            /**
+             * @brief Пересечение: оставляет только элементы, которые есть и в other
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return set& - *this
+             */
+            set& intersect_with(const set& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::Intersection);
+                return *this;
+            }
+
+            /**
+             * @brief Разность: удаляет элементы, которые есть в other
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return set& - *this
+             */
+            set& difference_with(const set& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::Difference);
+                return *this;
+            }
+
+            /**
+             * @brief Симметрическая разность: оставляет элементы, которые есть только
+             * в одном из контейнеров
+             * @details O(n + m), см. union_with
+             *
+             * @param other
+             * @return set& - *this
+             */
+            set& symmetric_difference_with(const set& other) {
+                this->tree_.combineWith(other.tree_, tree::SetOperation::SymmetricDifference);
+                return *this;
+            }
+
+            /**
+             * @brief Объединение a и b в новом контейнере
+             * @details Узлы результата создаются по одному проходу a и b, дерево строится
+             * снизу вверх - O(n + m). Компаратор берется у a
+             *
+             */
+            friend set operator|(const set& a, const set& b) {
+                return set::combined(a, b, tree::SetOperation::Union);
+            }
+
+            /**
+             * @brief Пересечение a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend set operator&(const set& a, const set& b) {
+                return set::combined(a, b, tree::SetOperation::Intersection);
+            }
+
+            /**
+             * @brief Разность a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend set operator-(const set& a, const set& b) {
+                return set::combined(a, b, tree::SetOperation::Difference);
+            }
+
+            /**
+             * @brief Симметрическая разность a и b в новом контейнере, O(n + m)
+             *
+             */
+            friend set operator^(const set& a, const set& b) {
+                return set::combined(a, b, tree::SetOperation::SymmetricDifference);
+            }
+
             /**
              * @brief Находит элемент с определенным ключом
              * 
@@ -227,6 +425,29 @@ namespace s21 {
                 return this->tree_.find(key);
             }
 
+            /**
+             * @brief Аналогично find для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent (например std::less<>)
+             * 
+             * @param key 
+             * @return iterator 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            iterator find(const K& key) {
+                return this->tree_.find(key);
+            }
+
+            /**
+             * @brief Аналогично find(const K&) для конст объекта
+             * 
+             * @param key 
+             * @return const_iterator 
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            const_iterator find(const K& key) const {
+                return this->tree_.find(key);
+            }
+
             /**
              * @brief Проверяет, содержит ли контейнер элемент с определенным ключом
              * 
@@ -238,25 +459,117 @@ namespace s21 {
                 return this->tree_.find(key) != this->tree_.end();
             }
 
+            /**
+             * @brief Аналогично contains для ключа любого типа, сравнимого с Key
+             * @details Доступно, только если у Compare есть is_transparent
+             * 
+             * @param key 
+             * @return true - есть такой элемент
+             * @return false - нет такого элемента
+             */
+            template<typename K, typename C = Compare, typename = typename C::is_transparent>
+            bool contains(const K& key) const {
+                return this->tree_.find(key) != this->tree_.end();
+            }
+
+            /**
+             * @brief Создает элемент прямо в узле из аргументов его конструктора
+             * и вставляет его, если в контейнере нет такого ключа
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с таким ключом,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                return this->tree_.emplaceUnique(std::forward<Args>(args)...);
+            }
+
             /**
              * @brief Вставляет новые элеметы в контейнер, если контейнер
              * не содержит таких ключей
+             * @details Каждый аргумент - отдельный элемент
              * 
              * @tparam Args 
              * @param args 
              * @return std::vector<std::pair<iterator,bool>> 
              */
             template<typename... Args>
-            std::vector<std::pair<iterator,bool>> emplace(Args&&... args) {
-                return this->tree_.emplaceUnique(std::forward<Args>(args)...);
+            std::vector<std::pair<iterator,bool>> insert_many(Args&&... args) {
+                return this->tree_.insertManyUnique(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его с подсказкой hint
+             * @details Подсказка работает так же, как в insert(hint, value)
+             * 
+             * @tparam Args 
+             * @param hint 
+             * @param args 
+             * @return iterator - указывает на вставленный элемент или на элемент с таким же ключом
+             */
+            template<typename... Args>
+            iterator emplace_hint(const_iterator hint, Args&&... args) {
+                return this->tree_.emplaceHintUnique(hint, std::forward<Args>(args)...);
+            }
+
+
+            /**
+             * @brief Возвращает iterator на k-й по порядку элемент (считая с 0)
+             * @details O(log n), доступно только при OrderStatistics == true
+             *
+             * @param k
+             * @return iterator - k-й элемент или end(), если k >= size()
+             */
+            iterator nth_element(size_type k) noexcept {
+                return this->tree_.nthElement(k);
+            }
+
+            /**
+             * @brief Аналогично функции nth_element только для конст объекта
+             *
+             */
+            const_iterator nth_element(size_type k) const noexcept {
+                return this->tree_.nthElement(k);
+            }
+
+            /**
+             * @brief Количество элементов, меньших key (номер lower_bound(key))
+             * @details O(log n), доступно только при OrderStatistics == true
+             *
+             * @param key
+             * @return size_type
+             */
+            size_type rank(const Key& key) const noexcept {
+                return this->tree_.rank(key);
             }
 
+            /**
+             * @brief Количество элементов из полуинтервала [lo, hi)
+             * @details O(log n) независимо от того, сколько элементов попало в интервал,
+             * доступно только при OrderStatistics == true
+             *
+             * @param lo
+             * @param hi
+             * @return size_type
+             */
+            size_type count_range(const Key& lo, const Key& hi) const noexcept {
+                return this->tree_.countRange(lo, hi);
+            }
 
             /*------------------------------------------------------------*/
 
         private:
             tree tree_;
 
+            // Результат операции op над a и b в новом контейнере
+            static set combined(const set& a, const set& b, typename tree::SetOperation op) {
+                set result(std::allocator_traits<Allocator>::select_on_container_copy_construction(a.get_allocator()));
+                result.tree_.assignCombined(a.tree_, b.tree_, op);
+                return result;
+            }
+
     }; // set
 } // s21
 
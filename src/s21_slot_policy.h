@@ -0,0 +1,183 @@
+#ifndef SRC_S21_SLOT_POLICY_H_
+#define SRC_S21_SLOT_POLICY_H_
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+    /**
+     * @brief Как элемент хранится в ячейке контейнера, который сам переносит элементы
+     * между ячейками (HashTable, BTree)
+     * @details Контейнер не трогает ячейку напрямую: создает, уничтожает и переносит
+     * элемент только через политику. По умолчанию ячейка - сам элемент
+     *
+     * @tparam Value - тип элемента
+     */
+    template<typename Value>
+    struct SlotPolicy {
+        using slot_type = Value;
+
+        // Перенос элемента в другую ячейку (take) не бросает исключений
+        static constexpr bool kNothrowTake = std::is_nothrow_move_constructible<Value>::value;
+
+        template<typename Alloc, typename... Args>
+        static void construct(Alloc& alloc, slot_type* slot, Args&&... args) {
+            std::allocator_traits<Alloc>::construct(alloc, slot, std::forward<Args>(args)...);
+        }
+
+        template<typename Alloc>
+        static void destroy(Alloc& alloc, slot_type* slot) noexcept {
+            std::allocator_traits<Alloc>::destroy(alloc, slot);
+        }
+
+        // Элемент, готовый к перемещению в другую ячейку (или в другой контейнер)
+        static Value&& take(slot_type* slot) noexcept {
+            return std::move(*slot);
+        }
+
+        static Value& element(slot_type* slot) noexcept {
+            return *slot;
+        }
+
+        static const Value& element(const slot_type* slot) noexcept {
+            return *slot;
+        }
+    };
+
+    /**
+     * @brief Ячейка map и unordered_map: одна и та же пара в двух видах
+     * @details value - пара с const ключом, как ее видит пользователь, mutable_value -
+     * пара с изменяемым ключом, через которую контейнер перемещает ключ. Как map_slot_type
+     * в abseil. Конструктор и деструктор пустые: какой член живой, решает SlotPolicy
+     *
+     */
+    template<typename K, typename V>
+    union MapSlot {
+        MapSlot() {}
+        ~MapSlot() {}
+
+        std::pair<const K, V> value;
+        std::pair<K, V> mutable_value;
+    };
+
+    /**
+     * @brief Политика ячеек map и unordered_map
+     * @details У пары с const ключом перемещение копирует ключ: строковые ключи
+     * копировались бы при каждом переносе элемента, а копия может бросить исключение
+     * посреди переноса. Поэтому элемент создается как mutable_value и переносится
+     * перемещением, а наружу отдается value. Это чтение неактивного члена union, и оно
+     * законно, только если обе пары standard-layout: тогда у них общая начальная
+     * последовательность (const K и K совместимы по раскладке) - это и проверяет
+     * kMutableKeys вместе со смещениями полей. Если пары не такие (например, у ключа
+     * виртуальные функции), живой член - всегда value, и ключ при переносе копируется
+     *
+     * @tparam K - тип ключа
+     * @tparam V - тип значения
+     */
+    template<typename K, typename V>
+    struct SlotPolicy<std::pair<const K, V>> {
+        using value_type = std::pair<const K, V>;
+        using mutable_value_type = std::pair<K, V>;
+        using slot_type = MapSlot<K, V>;
+
+        private:
+            static constexpr bool sameLayout() noexcept {
+                if constexpr (std::is_standard_layout<value_type>::value &&
+                              std::is_standard_layout<mutable_value_type>::value) {
+                    return sizeof(value_type) == sizeof(mutable_value_type) &&
+                           offsetof(value_type, first) == offsetof(mutable_value_type, first) &&
+                           offsetof(value_type, second) == offsetof(mutable_value_type, second);
+                } else {
+                    return false;
+                }
+            }
+
+        public:
+            // Можно ли держать живым mutable_value и читать его через value
+            static constexpr bool kMutableKeys = sameLayout();
+
+            static constexpr bool kNothrowTake = kMutableKeys
+                ? std::is_nothrow_move_constructible<mutable_value_type>::value
+                : std::is_nothrow_move_constructible<value_type>::value;
+
+            template<typename Alloc, typename... Args>
+            static void construct(Alloc& alloc, slot_type* slot, Args&&... args) {
+                if constexpr (kMutableKeys) {
+                    std::allocator_traits<Alloc>::construct(alloc, &slot->mutable_value, std::forward<Args>(args)...);
+                } else {
+                    std::allocator_traits<Alloc>::construct(alloc, &slot->value, std::forward<Args>(args)...);
+                }
+            }
+
+            template<typename Alloc>
+            static void destroy(Alloc& alloc, slot_type* slot) noexcept {
+                if constexpr (kMutableKeys) {
+                    std::allocator_traits<Alloc>::destroy(alloc, &slot->mutable_value);
+                } else {
+                    std::allocator_traits<Alloc>::destroy(alloc, &slot->value);
+                }
+            }
+
+            static decltype(auto) take(slot_type* slot) noexcept {
+                if constexpr (kMutableKeys) {
+                    return std::move(slot->mutable_value);
+                } else {
+                    return std::move(slot->value);
+                }
+            }
+
+            static value_type& element(slot_type* slot) noexcept {
+                return *std::launder(&slot->value);
+            }
+
+            static const value_type& element(const slot_type* slot) noexcept {
+                return *std::launder(&slot->value);
+            }
+    };
+
+    /**
+     * @brief Временная ячейка для элемента, созданного до того, как найдено его место
+     *
+     * @tparam Value - тип элемента
+     * @tparam Alloc - аллокатор ячеек контейнера
+     */
+    template<typename Value, typename Alloc>
+    class SlotHolder {
+        using slot_policy = SlotPolicy<Value>;
+        using slot_type = typename slot_policy::slot_type;
+        public:
+            template<typename... Args>
+            explicit SlotHolder(Alloc& alloc, Args&&... args) : alloc_(alloc) {
+                slot_policy::construct(this->alloc_, this->slot(), std::forward<Args>(args)...);
+            }
+
+            SlotHolder(const SlotHolder&) = delete;
+            SlotHolder& operator=(const SlotHolder&) = delete;
+
+            ~SlotHolder() {
+                slot_policy::destroy(this->alloc_, this->slot());
+            }
+
+            // Элемент для поиска места
+            const Value& value() noexcept {
+                return slot_policy::element(this->slot());
+            }
+
+            // Элемент, который перемещается в контейнер
+            decltype(auto) take() noexcept {
+                return slot_policy::take(this->slot());
+            }
+
+        private:
+            slot_type* slot() noexcept {
+                return std::launder(reinterpret_cast<slot_type*>(this->storage_));
+            }
+
+            Alloc& alloc_;
+            alignas(slot_type) unsigned char storage_[sizeof(slot_type)];
+    };
+} // s21
+
+#endif // SRC_S21_SLOT_POLICY_H_
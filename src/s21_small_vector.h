@@ -0,0 +1,853 @@
+#ifndef SRC_S21_SMALL_VECTOR_H_
+#define SRC_S21_SMALL_VECTOR_H_
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "s21_debug.h"
+
+
+namespace s21 {
+
+    /**
+     * @brief small_vector - вектор, который первые N элементов хранит прямо в себе
+     * @details Интерфейс как у s21::vector. Пока элементов не больше N, они живут во
+     * встроенном буфере inline_ и аллокатор не вызывается вовсе - короткие временные
+     * векторы обходятся без malloc. Когда элементы перестают помещаться, они переезжают
+     * в буфер из аллокатора и дальше все как у vector (рост в 2 раза). shrink_to_fit
+     * возвращает элементы во встроенный буфер, если их снова не больше N.
+     *
+     * Перемещение встроенного содержимого - это перенос не больше N элементов
+     * (для тривиально копируемых типов один memcpy), буфер из аллокатора забирается
+     * целиком, как у vector. В отличие от vector, после перемещения итераторы на
+     * встроенные элементы указывают в старый объект и недействительны
+     *
+     * @tparam T - тип элемента
+     * @tparam N - сколько элементов помещается без аллокатора, N > 0
+     * @tparam Allocator - аллокатор элементов для буфера сверх N
+     */
+    template<typename T, std::size_t N, typename Allocator = std::allocator<T>>
+    class small_vector {
+        static_assert(N > 0, "s21::small_vector: inline capacity must be positive");
+        using alloc_traits = std::allocator_traits<Allocator>;
+        public:
+            using value_type = T;
+            using allocator_type = Allocator;
+            using reference = T&;
+            using const_reference = const T&;
+            using iterator = T*;
+            using const_iterator = const T*;
+            using size_type = std::size_t;
+            /*---------------------------------constructors and operators small_vector-----------------------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустой вектор на встроенном буфере
+             *
+             */
+            small_vector() : small_vector(Allocator()) {}
+
+            /**
+             * @brief Создает пустой вектор с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit small_vector(const Allocator& alloc) : alloc_(alloc) {
+                this->size_ = 0;
+                this->capacity_ = N;
+                this->buffer_ = this->inlineBuffer();
+            }
+
+            /**
+             * @brief Параметризованный конструктор, создает вектор размера n
+             *
+             * @param n
+             */
+            explicit small_vector(size_type n, const Allocator& alloc = Allocator()) : small_vector(alloc) {
+                this->reserve(n);
+                try {
+                    for (; this->size_ < n; this->size_++)
+                        alloc_traits::construct(this->alloc_, this->buffer_ + this->size_);
+                } catch (...) {
+                    this->freeBuffer();
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Конструктор списка инициализаторов, создает вектор
+             * инициализированный с помощью std::initializer_list
+             *
+             * @param items
+             */
+            small_vector(std::initializer_list<value_type> const &items, const Allocator& alloc = Allocator())
+                : small_vector(alloc) {
+                this->reserve(items.size());
+                this->copyConstruct(items.begin(), items.end());
+            }
+
+            /**
+             * @brief Конструктор копирования
+             * @details Аллокатор для копии выбирает сам аллокатор (select_on_container_copy_construction)
+             *
+             * @param v
+             */
+            small_vector(const small_vector& v)
+                : small_vector(alloc_traits::select_on_container_copy_construction(v.alloc_)) {
+                *this = v;
+            }
+
+            /**
+             * @brief Конструктор перемещения
+             * @details Буфер из аллокатора забирается целиком, встроенные элементы
+             * переносятся по одному (см. moveConstruct), поэтому noexcept только вместе с T
+             *
+             * @param v
+             */
+            small_vector(small_vector&& v) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : small_vector(v.alloc_) {
+                if (v.isInline()) {
+                    this->moveConstruct(v);
+                } else {
+                    this->stealBuffer(v);
+                }
+            }
+
+            /**
+             * @brief Деструктор
+             *
+             */
+            ~small_vector() {
+                this->freeBuffer();
+            }
+
+            /**
+             * @brief Перегрузка оператора присваивания копированием
+             *
+             * @param v
+             * @return small_vector&
+             */
+            small_vector& operator=(const small_vector& v) {
+                if (this != &v) {
+                    this->freeBuffer();
+                    if (alloc_traits::propagate_on_container_copy_assignment::value) {
+                        this->alloc_ = v.alloc_;
+                    }
+                    this->reserve(v.size_);
+                    this->copyConstruct(v.begin(), v.end());
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Перегрузка оператора присваивания перемещением
+             * @details Чужой буфер из аллокатора забираем, если аллокатор переезжает
+             * вместе с содержимым или аллокаторы равны. Иначе, как и встроенные элементы,
+             * перемещаем по одному
+             *
+             * @param v
+             * @return small_vector&
+             */
+            small_vector& operator=(small_vector&& v) {
+                if (this != &v) {
+                    bool steal = !v.isInline() &&
+                        (alloc_traits::propagate_on_container_move_assignment::value || this->alloc_ == v.alloc_);
+                    this->freeBuffer();
+                    if (alloc_traits::propagate_on_container_move_assignment::value) {
+                        this->alloc_ = std::move(v.alloc_);
+                    }
+                    if (steal) {
+                        this->stealBuffer(v);
+                    } else {
+                        this->reserve(v.size_);
+                        this->moveConstruct(v);
+                    }
+                }
+                return *this;
+            }
+
+            /*----------------------------------------------------------------------------------------*/
+
+            /*-----------------------------------------methods small_vector-----------------------------------------------*/
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->alloc_;
+            }
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             *
+             * @param pos
+             * @return reference
+             */
+            reference at(size_type pos) {
+                if (pos >= this->size_)
+                    throw std::out_of_range("s21::small_vector::at: The index is out of range");
+
+                return this->buffer_[pos];
+            }
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             * @details Для конст объекта
+             *
+             * @param pos
+             * @return const_reference
+             */
+            const_reference at(size_type pos) const {
+                if (pos >= this->size_)
+                    throw std::out_of_range("s21::small_vector::at: The index is out of range");
+
+                return this->buffer_[pos];
+            }
+
+            /**
+             * @brief Доступ к указанному элементу без проверки границ
+             * @details Проверка только в сборке с S21_CONTAINERS_DEBUG (см. s21_debug.h)
+             *
+             * @param pos
+             * @return reference
+             */
+            reference operator[](size_type pos) {
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::small_vector::operator[]: The index is out of range");
+                return this->buffer_[pos];
+            }
+
+            /**
+             * @brief Доступ к указанному элементу без проверки границ
+             * @details Для конст объекта
+             *
+             * @param pos
+             * @return const_reference
+             */
+            const_reference operator[](size_type pos) const {
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::small_vector::operator[]: The index is out of range");
+                return this->buffer_[pos];
+            }
+
+            /**
+             * @brief Получить доступ к первому элементу
+             *
+             * @return reference
+             */
+            reference front() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::small_vector::front: Using methods on a zero sized container");
+
+                return *this->begin();
+            }
+
+            /**
+             * @brief Получить доступ к первому элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            const_reference front() const {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::small_vector::front: Using methods on a zero sized container");
+
+                return *this->begin();
+            }
+
+            /**
+             * @brief Получить доступ к последнему элементу
+             *
+             * @return reference
+             */
+            reference back() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::small_vector::back: Using methods on a zero sized container");
+
+                return *(this->end() - 1);
+            }
+
+            /**
+             * @brief Получить доступ к последнему элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            const_reference back() const {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::small_vector::back: Using methods on a zero sized container");
+
+                return *(this->end() - 1);
+            }
+
+            /**
+             * @brief Прямой доступ к базовому массиву
+             * @details В отличие от vector, никогда не nullptr: у пустого вектора
+             * это встроенный буфер
+             *
+             * @return iterator
+             */
+            iterator data() noexcept {
+                return this->buffer_;
+            }
+
+            /**
+             * @brief Прямой доступ к базовому массиву
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator data() const noexcept {
+                return this->buffer_;
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             *
+             * @return iterator
+             */
+            iterator begin() noexcept {
+                return this->buffer_;
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator begin() const noexcept {
+                return this->buffer_;
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             *
+             * @return iterator
+             */
+            iterator end() noexcept {
+                return this->buffer_ + this->size_;
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator end() const noexcept {
+                return this->buffer_ + this->size_;
+            }
+
+            /**
+             * @brief Проверяет, пуст ли контейнер
+             *
+             * @return true - контейнер пуст
+             * @return false - контейнер не пуст
+             */
+            bool empty() const noexcept {
+                return this->size_ == 0;
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                return this->size_;
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             * @details Как у vector
+             *
+             * @return size_type
+             */
+            size_type max_size() const noexcept {
+                return (std::numeric_limits<size_type>::max() / sizeof(value_type) / 2);
+            }
+
+            /**
+             * @brief Готовит место под size элементов
+             * @details Пока size не больше N, ничего не делает - место уже есть во встроенном буфере
+             *
+             * @param size - размер хранилища
+             */
+            void reserve(size_type size) {
+                if (size <= this->capacity_)
+                    return;
+
+                if (size > this->max_size())
+                    throw std::out_of_range("s21::small_vector::reserve: Reserve capacity can't be larger than max_size!");
+
+                this->reallocVector(size);
+            }
+
+            /**
+             * @brief Возвращает количество элементов,
+             * которые могут храниться без перевыделения памяти
+             * @details Не меньше N
+             *
+             * @return size_type
+             */
+            size_type capacity() const noexcept {
+                return this->capacity_;
+            }
+
+            /**
+             * @brief Уменьшает использование памяти, освобождая неиспользуемую память
+             * @details Если элементов не больше N, они возвращаются во встроенный буфер,
+             * а буфер из аллокатора освобождается
+             *
+             */
+            void shrink_to_fit() {
+                if (this->isInline() || this->capacity_ == this->size_)
+                    return;
+
+                this->reallocVector(this->size_);
+            }
+
+            /**
+             * @brief Очищает содержимое
+             * @details Элементы уничтожаются, память остается за вектором
+             *
+             */
+            void clear() noexcept {
+                this->destroyRange(this->begin(), this->end());
+                this->size_ = 0;
+            }
+
+            /**
+             * @brief Вставляет элемент в конкретную позицию
+             * и возвращает итератор, указывающий на новый элемент
+             * @details См. emplace
+             *
+             * @param pos
+             * @param value
+             * @return iterator
+             */
+            iterator insert(const_iterator pos, const_reference value) {
+                return this->emplace(pos, value);
+            }
+
+            /**
+             * @brief Аналогично insert только вставка перемещением
+             *
+             * @param pos
+             * @param value
+             * @return iterator
+             */
+            iterator insert(const_iterator pos, value_type &&value) {
+                return this->emplace(pos, std::move(value));
+            }
+
+            /**
+             * @brief Стирает элемент в позиции
+             *
+             * @param pos
+             */
+            void erase(const_iterator pos) {
+                size_type index = pos - this->begin();
+                if (index >= this->size_)
+                    throw std::out_of_range("s21::small_vector::erase: Unable to erase a position out of range of begin to end");
+
+                std::move(const_cast<iterator>(pos) + 1, this->end(), this->buffer_ + index);
+                alloc_traits::destroy(this->alloc_, this->end() - 1);
+                this->size_--;
+            }
+
+            /**
+             * @brief Добавляет элемент в конец
+             *
+             * @param value
+             */
+            void push_back(const_reference value) {
+                this->emplace_back(value);
+            }
+
+            /**
+             * @brief Аналогично push_back только вставка перемещением
+             *
+             * @param value
+             */
+            void push_back(value_type &&value) {
+                this->emplace_back(std::move(value));
+            }
+
+            /**
+             * @brief Удаляет последний элемент
+             *
+             */
+            void pop_back() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::small_vector::pop_back: nothing to delete...");
+
+                alloc_traits::destroy(this->alloc_, this->end() - 1);
+                this->size_--;
+            }
+
+            /**
+             * @brief Меняет содержимое
+             * @details Два буфера из аллокатора просто меняются местами. Встроенные
+             * элементы переносятся: если буфер из аллокатора есть только у одного
+             * вектора, встроенные элементы другого переезжают в его свободный
+             * встроенный буфер, а буфер из аллокатора переходит к другому вектору
+             * (см. swapWithHeap). Если оба встроенные, общая часть меняется
+             * поэлементно, остаток переносится. Новой памяти swap не просит
+             *
+             * @param other
+             */
+            void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                                    std::is_nothrow_swappable<T>::value) {
+                if (this == &other)
+                    return;
+
+                if (alloc_traits::propagate_on_container_swap::value) {
+                    std::swap(this->alloc_, other.alloc_);
+                }
+                if (!this->isInline() && !other.isInline()) {
+                    std::swap(this->buffer_, other.buffer_);
+                    std::swap(this->size_, other.size_);
+                    std::swap(this->capacity_, other.capacity_);
+                } else if (!this->isInline()) {
+                    this->swapWithHeap(other);
+                } else if (!other.isInline()) {
+                    other.swapWithHeap(*this);
+                } else {
+                    small_vector& longer = this->size_ < other.size_ ? other : *this;
+                    small_vector& shorter = this->size_ < other.size_ ? *this : other;
+                    size_type common = shorter.size_;
+                    std::swap_ranges(shorter.buffer_, shorter.buffer_ + common, longer.buffer_);
+                    for (; shorter.size_ < longer.size_; shorter.size_++) {
+                        alloc_traits::construct(shorter.alloc_, shorter.buffer_ + shorter.size_,
+                                                std::move(longer.buffer_[shorter.size_]));
+                    }
+                    longer.destroyRange(longer.buffer_ + common, longer.end());
+                    longer.size_ = common;
+                }
+            }
+
+            /**
+             * @brief Создает новый элемент из args непосредственно перед pos
+             * @details Как у vector: в середину элемент сначала создается во временном
+             * объекте (args могут ссылаться на элементы самого вектора), потом
+             * элементы сдвигаются перемещением
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param pos
+             * @param args
+             * @return iterator - указывает на новый элемент
+             */
+            template<typename... Args>
+            iterator emplace(const_iterator pos, Args&&... args) {
+                size_type index = pos - this->begin();
+                if (index > this->size_)
+                    throw std::out_of_range("s21::small_vector::insert Unable to insert into a position out of range of begin to end");
+
+                if (index == this->size_) {
+                    this->emplace_back(std::forward<Args>(args)...);
+                    return this->begin() + index;
+                }
+
+                value_type value(std::forward<Args>(args)...);
+                if (this->size_ == this->capacity_)
+                    this->reallocVector(this->size_ * 2);
+
+                iterator it_begin = this->begin();
+                iterator it_end = this->end();
+                alloc_traits::construct(this->alloc_, it_end, std::move(*(it_end - 1)));
+                this->size_++;
+                std::move_backward(it_begin + index, it_end - 1, it_end);
+                *(it_begin + index) = std::move(value);
+                return it_begin + index;
+            }
+
+            /**
+             * @brief Создает новый элемент из args в конце контейнера
+             * @details Как у vector: при нехватке места новый элемент создается в новом
+             * буфере до переноса старых, так что args могут ссылаться на элементы
+             * самого вектора. Пока есть место во встроенном буфере, аллокатор не нужен
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            reference emplace_back(Args&&... args) {
+                if (this->size_ == this->capacity_) {
+                    size_type new_capacity = this->size_ * 2;
+                    iterator tmp = this->allocateBuffer(new_capacity);
+                    try {
+                        alloc_traits::construct(this->alloc_, tmp + this->size_, std::forward<Args>(args)...);
+                    } catch (...) {
+                        alloc_traits::deallocate(this->alloc_, tmp, new_capacity);
+                        throw;
+                    }
+                    try {
+                        this->relocate(tmp);
+                    } catch (...) {
+                        alloc_traits::destroy(this->alloc_, tmp + this->size_);
+                        alloc_traits::deallocate(this->alloc_, tmp, new_capacity);
+                        throw;
+                    }
+                    this->replaceBuffer(tmp, new_capacity);
+                } else {
+                    alloc_traits::construct(this->alloc_, this->buffer_ + this->size_, std::forward<Args>(args)...);
+                }
+                return this->buffer_[this->size_++];
+            }
+
+            /**
+             * @brief Вставляет новые элементы в контейнер непосредственно перед pos
+             * @details Каждый аргумент - отдельный элемент, порядок сохраняется.
+             * Память под все элементы выделяем сразу
+             *
+             * @tparam Args
+             * @param pos
+             * @param args
+             * @return iterator - указывает на последний вставленный элемент
+             */
+            template<typename... Args>
+            iterator insert_many(const_iterator pos, Args&&... args) {
+                size_type index = pos - this->begin();
+                if (index > this->size_)
+                    throw std::out_of_range("s21::small_vector::insert Unable to insert into a position out of range of begin to end");
+
+                this->reserve(this->size_ + sizeof...(args));
+                iterator it_res = this->begin() + index;
+                ((it_res = this->emplace(this->begin() + index++, std::forward<Args>(args))), ...);
+                return it_res;
+            }
+
+            /**
+             * @brief Добавляет новые элементы в конец контейнера
+             *
+             * @tparam Args
+             * @param args
+             */
+            template<typename... Args>
+            void insert_many_back(Args&&... args) {
+                this->reserve(this->size_ + sizeof...(args));
+                (this->emplace_back(std::forward<Args>(args)), ...);
+            }
+
+
+        private:
+            Allocator alloc_;
+            size_type size_;
+            size_type capacity_;
+            iterator buffer_;
+            // Встроенный буфер: объекты живут в нем, только пока buffer_ указывает сюда
+            alignas(T) unsigned char inline_[N * sizeof(T)];
+
+            /**
+             * @brief Начало встроенного буфера
+             *
+             * @return iterator
+             */
+            iterator inlineBuffer() noexcept {
+                return std::launder(reinterpret_cast<T*>(this->inline_));
+            }
+
+            /**
+             * @brief Лежат ли элементы во встроенном буфере
+             *
+             * @return true - во встроенном
+             * @return false - в буфере из аллокатора
+             */
+            bool isInline() const noexcept {
+                return static_cast<const void*>(this->buffer_) == static_cast<const void*>(this->inline_);
+            }
+
+            /**
+             * @brief Выделяет у аллокатора сырой буфер на n элементов
+             * @details Объекты в буфере не создаются
+             *
+             * @param n
+             * @return iterator
+             */
+            iterator allocateBuffer(size_type n) {
+                return alloc_traits::allocate(this->alloc_, n);
+            }
+
+            /**
+             * @brief Уничтожает объекты в [first, last)
+             *
+             * @param first
+             * @param last
+             */
+            void destroyRange(iterator first, iterator last) noexcept {
+                if (!std::is_trivially_destructible<value_type>::value) {
+                    for (; first != last; ++first)
+                        alloc_traits::destroy(this->alloc_, first);
+                }
+            }
+
+            /**
+             * @brief Уничтожает элементы и возвращает буфер аллокатору,
+             * вектор остается пустым на встроенном буфере
+             *
+             */
+            void freeBuffer() noexcept {
+                this->destroyRange(this->begin(), this->end());
+                if (!this->isInline())
+                    alloc_traits::deallocate(this->alloc_, this->buffer_, this->capacity_);
+                this->buffer_ = this->inlineBuffer();
+                this->size_ = 0;
+                this->capacity_ = N;
+            }
+
+            /**
+             * @brief Копирует [first, last) в пустой вектор, место под них уже есть
+             * @details Если конструктор копирования бросит исключение,
+             * уже созданные элементы и буфер освобождаются
+             *
+             * @param first
+             * @param last
+             */
+            template<typename InputIt>
+            void copyConstruct(InputIt first, InputIt last) {
+                try {
+                    for (; first != last; ++first, this->size_++)
+                        alloc_traits::construct(this->alloc_, this->buffer_ + this->size_, *first);
+                } catch (...) {
+                    this->freeBuffer();
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Перемещает элементы v в пустой вектор, место под них уже есть, v очищается
+             * @details Тривиально копируемые типы переносятся одним memcpy
+             *
+             * @param v
+             */
+            void moveConstruct(small_vector& v) {
+                if (std::is_trivially_copyable<value_type>::value) {
+                    if (v.size_ > 0) {
+                        std::memcpy(static_cast<void*>(this->buffer_), static_cast<const void*>(v.buffer_),
+                                    v.size_ * sizeof(value_type));
+                    }
+                    this->size_ = v.size_;
+                } else {
+                    try {
+                        for (; this->size_ < v.size_; this->size_++)
+                            alloc_traits::construct(this->alloc_, this->buffer_ + this->size_,
+                                                    std::move(v.buffer_[this->size_]));
+                    } catch (...) {
+                        this->freeBuffer();
+                        throw;
+                    }
+                }
+                v.clear();
+            }
+
+            /**
+             * @brief Забирает буфер из аллокатора у v, v остается пустым на встроенном буфере
+             * @details this должен быть пуст и на встроенном буфере
+             *
+             * @param v
+             */
+            void stealBuffer(small_vector& v) noexcept {
+                this->buffer_ = v.buffer_;
+                this->size_ = v.size_;
+                this->capacity_ = v.capacity_;
+                v.buffer_ = v.inlineBuffer();
+                v.size_ = 0;
+                v.capacity_ = N;
+            }
+
+            /**
+             * @brief swap, когда буфер из аллокатора только у this
+             * @details Элементы other (их не больше N) переносятся в свободный
+             * встроенный буфер this, потом other получает буфер из аллокатора
+             *
+             * @param other
+             */
+            void swapWithHeap(small_vector& other) {
+                iterator own_inline = this->inlineBuffer();
+                other.relocate(own_inline);
+                other.destroyRange(other.begin(), other.end());
+                size_type other_size = other.size_;
+                other.buffer_ = this->buffer_;
+                other.size_ = this->size_;
+                other.capacity_ = this->capacity_;
+                this->buffer_ = own_inline;
+                this->size_ = other_size;
+                this->capacity_ = N;
+            }
+
+            /**
+             * @brief Переносит size_ элементов в сырой буфер dst
+             * @details Как у vector: тривиально копируемые типы переносятся одним memcpy,
+             * остальные - через std::move_if_noexcept, при ошибке созданные в dst элементы
+             * уничтожаются. Старые элементы не уничтожаются (см. replaceBuffer)
+             *
+             * @param dst
+             */
+            void relocate(iterator dst) {
+                if (this->size_ == 0)
+                    return;
+
+                if (std::is_trivially_copyable<value_type>::value) {
+                    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(this->buffer_),
+                                this->size_ * sizeof(value_type));
+                    return;
+                }
+                size_type i = 0;
+                try {
+                    for (; i < this->size_; i++)
+                        alloc_traits::construct(this->alloc_, dst + i, std::move_if_noexcept(this->buffer_[i]));
+                } catch (...) {
+                    this->destroyRange(dst, dst + i);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Уничтожает старые элементы, освобождает старый буфер
+             * и переходит на buffer, в который элементы уже перенесены (см. relocate)
+             *
+             * @param buffer
+             * @param new_capacity
+             */
+            void replaceBuffer(iterator buffer, size_type new_capacity) noexcept {
+                size_type size = this->size_;
+                this->freeBuffer();
+                this->buffer_ = buffer;
+                this->size_ = size;
+                this->capacity_ = new_capacity;
+            }
+
+            /**
+             * @brief Переносит элементы в буфер на new_capacity элементов
+             * @details Если new_capacity не больше N, элементы возвращаются во встроенный буфер
+             *
+             * @param new_capacity
+             */
+            void reallocVector(size_type new_capacity) {
+                if (new_capacity <= N) {
+                    iterator own_inline = this->inlineBuffer();
+                    this->relocate(own_inline);
+                    this->replaceBuffer(own_inline, N);
+                    return;
+                }
+                iterator tmp = this->allocateBuffer(new_capacity);
+                try {
+                    this->relocate(tmp);
+                } catch (...) {
+                    alloc_traits::deallocate(this->alloc_, tmp, new_capacity);
+                    throw;
+                }
+                this->replaceBuffer(tmp, new_capacity);
+            }
+    };
+}
+
+
+#endif // SRC_S21_SMALL_VECTOR_H_
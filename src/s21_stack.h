@@ -1,55 +1,88 @@
 #ifndef SRC_S21_STACK_H_
 #define SRC_S21_STACK_H_
-#include "s21_list.h"
+#include "s21_deque.h"
 #include <algorithm>
 #include <initializer_list>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 namespace s21 {
     /**
      * @brief Класс stack - последовательный контейнер
-     * @details Stack реализован через список list
+     * @details Stack - адаптер над последовательным контейнером Container, как std::stack.
+     * По умолчанию это блочная очередь s21::deque: push и pop не выделяют память на каждый элемент.
+     * Подойдет любой контейнер с back, push_back, emplace_back и pop_back (s21::list, s21::vector).
+     * Память контейнера настраивается через его аллокатор: s21::stack<T, s21::deque<T, MyAllocator<T>>>
      * 
+     * @tparam T
+     * @tparam Container - контейнер, в котором хранятся элементы
      */
-    template<typename T>
+    template<typename T, typename Container = s21::deque<T>>
     class stack {
         public:
-            using value_type = T;
-            using reference = T&;
-            using const_reference = const T&;
-            using size_type = std::size_t;
+            using container_type = Container;
+            using value_type = typename Container::value_type;
+            using reference = typename Container::reference;
+            using const_reference = typename Container::const_reference;
+            using size_type = typename Container::size_type;
 
             /*---------------------------constructors and operators stack-----------------------------------*/
 
             /**
-             * @brief Конструктор создает пустой список
+             * @brief Конструктор создает пустой стек
              * 
              */
-            stack() : list_() {}
+            stack() : container_() {}
             
             /**
-             * @brief Конструктор создает список инициализируя кaждый узел элементами
+             * @brief Конструктор создает стек из элементов items
              * 
              * @param items 
              */
-            explicit stack(std::initializer_list<value_type> const &items) : list_(items) {}
+            explicit stack(std::initializer_list<value_type> const &items) : container_(items) {}
 
             /**
-             * @brief Конструктор создает список путем копирования из s
+             * @brief Конструктор копирует готовый контейнер
+             *
+             * @param cont
+             */
+            explicit stack(const Container& cont) : container_(cont) {}
+
+            /**
+             * @brief Конструктор забирает готовый контейнер перемещением
+             *
+             * @param cont
+             */
+            explicit stack(Container&& cont) : container_(std::move(cont)) {}
+
+            /**
+             * @brief Конструктор создает пустой контейнер с заданным аллокатором
+             * @details Доступен только если контейнер умеет работать с таким аллокатором
+             *
+             * @param alloc
+             */
+            template<typename Alloc, typename = std::enable_if_t<std::uses_allocator<Container, Alloc>::value>>
+            explicit stack(const Alloc& alloc) : container_(alloc) {}
+
+            /**
+             * @brief Конструктор создает стек путем копирования из s
              * 
              * @param s 
              */
-            stack(const stack &s) : list_(s.list_) {}
+            stack(const stack &s) : container_(s.container_) {}
 
             /**
-             * @brief Конструктор создает список путем перемещения из s в this
+             * @brief Конструктор создает стек путем перемещения из s в this
              * 
              * @param s
              */
-            stack(stack &&s) : list_(std::move(s.list_)) {}
+            stack(stack &&s) : container_(std::move(s.container_)) {}
 
             /**
              * @brief Деструктор будет дефолдным
-             * @details list_ сам себя почистит, у него есть свой деструктор
+             * @details container_ сам себя почистит, у него есть свой деструктор
              * 
              */
             ~stack() = default;
@@ -59,7 +92,7 @@ namespace s21 {
              * 
              */
             stack& operator=(const stack& s) {
-                this->list_ = s.list_;
+                this->container_ = s.container_;
                 return *this;
             }
 
@@ -68,7 +101,7 @@ namespace s21 {
              * 
              */
             stack& operator=(stack&& s) {
-                this->list_ = std::move(s.list_);
+                this->container_ = std::move(s.container_);
                 return *this;
             }
 
@@ -79,11 +112,15 @@ namespace s21 {
 
             /**
              * @brief Обращается к верхнему элементу
+             * @details У пустого стека - значение по умолчанию (см. emptyValue)
              * 
              * @return reference 
              */
-            reference top() noexcept {
-                return this->list_.back();
+            reference top() {
+                if (this->container_.empty())
+                    return this->emptyValue();
+
+                return this->container_.back();
             }
 
             /**
@@ -92,8 +129,11 @@ namespace s21 {
              * 
              * @return const_reference 
              */
-            const_reference top() const noexcept {
-                return this->list_.back();
+            const_reference top() const {
+                if (this->container_.empty())
+                    return this->emptyValue();
+
+                return this->container_.back();
             }
 
             /**
@@ -103,7 +143,7 @@ namespace s21 {
              * @return false - если не пуст
              */
             bool empty() const noexcept {
-                return this->list_.empty();
+                return this->container_.empty();
             }
 
             /**
@@ -112,7 +152,7 @@ namespace s21 {
              * @return size_type 
              */
             size_type size() const noexcept {
-                return this->list_.size();
+                return this->container_.size();
             }
 
             /**
@@ -121,7 +161,7 @@ namespace s21 {
              * @param value 
              */
             void push(const_reference value) {
-                this->list_.push_back(value);
+                this->container_.push_back(value);
             }
 
             /**
@@ -129,7 +169,7 @@ namespace s21 {
              * 
              */
             void pop() {
-                this->list_.pop_back();
+                this->container_.pop_back();
             }
 
             /**
@@ -138,26 +178,57 @@ namespace s21 {
              * @param other 
              */
             void swap(stack& other) {
-                std::swap(this->list_, other.list_);
+                std::swap(this->container_, other.container_);
+            }
+
+            /**
+             * @brief Создает новый элемент из args прямо в верхней части контейнера
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             */
+            template<typename... Args>
+            void emplace(Args&&... args) {
+                this->container_.emplace_back(std::forward<Args>(args)...);
             }
 
             /**
              * @brief Добавляет новые элементы в верхнюю часть контейнера
+             * @details Каждый аргумент - отдельный элемент
              * 
              * @tparam Args 
              * @param args 
              */
             template<typename... Args>
-            void emplace_front(Args&&... args) {
-                this->list_.emplace_back(std::forward<Args>(args)...);
+            void insert_many_front(Args&&... args) {
+                (this->container_.emplace_back(std::forward<Args>(args)), ...);
             }
 
 
             /*---------------------------------------------------------------------------*/
 
         private:
-            // Поле контейнера s21::list
-            s21::list<T> list_;
+            /**
+             * @brief Что top() возвращает у пустого стека
+             * @details Так было, пока стек строился на s21::list со служебным узлом: значение
+             * по умолчанию, а не чтение свободной ячейки контейнера. Значение хранится в самом
+             * стеке и создается заново при каждом обращении, так что запись через ссылку
+             * ни на что не влияет. Если T нельзя создать по умолчанию - std::out_of_range
+             *
+             * @return reference
+             */
+            reference emptyValue() const {
+                if constexpr (std::is_default_constructible<value_type>::value) {
+                    return this->empty_value_.emplace();
+                } else {
+                    throw std::out_of_range("s21::stack::top: Using methods on a zero sized container");
+                }
+            }
+
+            // Контейнер с элементами (по умолчанию s21::deque)
+            Container container_;
+            // значение top() у пустого стека (см. emptyValue)
+            mutable std::optional<value_type> empty_value_;
     };
 }
 
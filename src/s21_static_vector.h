@@ -0,0 +1,542 @@
+#ifndef SRC_S21_STATIC_VECTOR_H_
+#define SRC_S21_STATIC_VECTOR_H_
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "s21_debug.h"
+#include "s21_inline_storage.h"
+
+namespace s21 {
+    /**
+     * @brief Основа static_vector: хранилище и размер
+     * @details Для тривиальных T копирование, перемещение и деструктор тривиальные
+     * (static_vector остается литеральным типом), для остальных элементы копируются,
+     * перемещаются и уничтожаются по одному (специализация ниже)
+     *
+     * @tparam T
+     * @tparam Cap
+     */
+    template<typename T, std::size_t Cap, bool = std::is_trivial<T>::value>
+    class StaticVectorBase {
+        protected:
+            InlineStorage<T, Cap> storage_;
+            std::size_t size_ = 0;
+    };
+
+    template<typename T, std::size_t Cap>
+    class StaticVectorBase<T, Cap, false> {
+        using size_type = std::size_t;
+        protected:
+            StaticVectorBase() noexcept : size_(0) {}
+
+            // Тело выполняется после делегирующего конструктора, так что если копирование
+            // элемента бросит исключение, деструктор уничтожит уже созданные элементы
+            StaticVectorBase(const StaticVectorBase& other) : StaticVectorBase() {
+                for (; this->size_ < other.size_; this->size_++)
+                    this->storage_.construct(this->size_, *other.storage_.slot(this->size_));
+            }
+
+            // Как у vector, other после перемещения пуст
+            StaticVectorBase(StaticVectorBase&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : StaticVectorBase() {
+                for (; this->size_ < other.size_; this->size_++)
+                    this->storage_.construct(this->size_, std::move(*other.storage_.slot(this->size_)));
+                other.destroyFrom(0);
+            }
+
+            ~StaticVectorBase() {
+                this->destroyFrom(0);
+            }
+
+            // Общая часть присваивается (элементы переиспользуют свои ресурсы),
+            // остаток создается или уничтожается
+            StaticVectorBase& operator=(const StaticVectorBase& other) {
+                if (this != &other) {
+                    size_type common = this->size_ < other.size_ ? this->size_ : other.size_;
+                    for (size_type i = 0; i < common; i++)
+                        *this->storage_.slot(i) = *other.storage_.slot(i);
+                    this->destroyFrom(common);
+                    for (; this->size_ < other.size_; this->size_++)
+                        this->storage_.construct(this->size_, *other.storage_.slot(this->size_));
+                }
+                return *this;
+            }
+
+            StaticVectorBase& operator=(StaticVectorBase&& other) {
+                if (this != &other) {
+                    size_type common = this->size_ < other.size_ ? this->size_ : other.size_;
+                    for (size_type i = 0; i < common; i++)
+                        *this->storage_.slot(i) = std::move(*other.storage_.slot(i));
+                    this->destroyFrom(common);
+                    for (; this->size_ < other.size_; this->size_++)
+                        this->storage_.construct(this->size_, std::move(*other.storage_.slot(this->size_)));
+                    other.destroyFrom(0);
+                }
+                return *this;
+            }
+
+            void destroyFrom(size_type first) noexcept {
+                while (this->size_ > first)
+                    this->storage_.destroy(--this->size_);
+            }
+
+            InlineStorage<T, Cap> storage_;
+            size_type size_;
+    };
+
+    /**
+     * @brief static_vector - вектор с вместимостью Cap, вся память которого внутри объекта
+     * @details Интерфейс как у s21::vector, но память никогда не выделяется: элементы живут
+     * в InlineStorage (ячейки как у s21::array, только создаются по мере вставки).
+     * Вставка сверх Cap бросает std::out_of_range, поэтому нет reserve и shrink_to_fit.
+     * Для тривиальных T все методы constexpr и контейнер можно заполнять
+     * в constexpr-вычислениях (C++17 не дает placement new в constexpr,
+     * поэтому для остальных T - только во время выполнения).
+     * Итераторы - указатели, действительны до вставки или удаления перед ними
+     *
+     * @tparam T - тип элемента
+     * @tparam Cap - максимальное количество элементов, Cap > 0
+     */
+    template<typename T, std::size_t Cap>
+    class static_vector : private StaticVectorBase<T, Cap> {
+        public:
+            using value_type = T;
+            using reference = T&;
+            using const_reference = const T&;
+            using iterator = T*;
+            using const_iterator = const T*;
+            using size_type = std::size_t;
+
+            /*---------------------------------constructors and operators static_vector-----------------------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустой вектор
+             *
+             */
+            static_vector() = default;
+
+            /**
+             * @brief Параметризованный конструктор, создает вектор из n элементов по умолчанию
+             *
+             * @param n
+             */
+            constexpr explicit static_vector(size_type n) : static_vector() {
+                if (n > Cap)
+                    throw std::out_of_range("s21::static_vector: Size can't be larger than capacity");
+
+                while (this->size_ < n)
+                    this->emplace_back();
+            }
+
+            /**
+             * @brief Конструктор списка инициализаторов, создает вектор
+             * инициализированный с помощью std::initializer_list
+             *
+             * @param items
+             */
+            constexpr static_vector(std::initializer_list<value_type> const &items) : static_vector() {
+                if (items.size() > Cap)
+                    throw std::out_of_range("s21::static_vector: Initializer_list is larger than capacity");
+
+                for (const_reference item : items)
+                    this->emplace_back(item);
+            }
+
+            // Копирование, перемещение и деструктор - у StaticVectorBase
+            static_vector(const static_vector&) = default;
+            static_vector(static_vector&&) = default;
+            static_vector& operator=(const static_vector&) = default;
+            static_vector& operator=(static_vector&&) = default;
+            ~static_vector() = default;
+
+            /*----------------------------------------------------------------------------------------*/
+
+            /*-----------------------------------------methods static_vector-----------------------------------------------*/
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             *
+             * @param pos
+             * @return reference
+             */
+            constexpr reference at(size_type pos) {
+                if (pos >= this->size_)
+                    throw std::out_of_range("s21::static_vector::at: The index is out of range");
+
+                return *this->storage_.slot(pos);
+            }
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой границ
+             * @details Для конст объекта
+             *
+             * @param pos
+             * @return const_reference
+             */
+            constexpr const_reference at(size_type pos) const {
+                if (pos >= this->size_)
+                    throw std::out_of_range("s21::static_vector::at: The index is out of range");
+
+                return *this->storage_.slot(pos);
+            }
+
+            /**
+             * @brief Доступ к указанному элементу без проверки границ
+             * @details Проверка только в сборке с S21_CONTAINERS_DEBUG (см. s21_debug.h)
+             *
+             * @param pos
+             * @return reference
+             */
+            constexpr reference operator[](size_type pos) {
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::static_vector::operator[]: The index is out of range");
+                return *this->storage_.slot(pos);
+            }
+
+            /**
+             * @brief Доступ к указанному элементу без проверки границ
+             * @details Для конст объекта
+             *
+             * @param pos
+             * @return const_reference
+             */
+            constexpr const_reference operator[](size_type pos) const {
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::static_vector::operator[]: The index is out of range");
+                return *this->storage_.slot(pos);
+            }
+
+            /**
+             * @brief Получить доступ к первому элементу
+             *
+             * @return reference
+             */
+            constexpr reference front() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::static_vector::front: Using methods on a zero sized container");
+
+                return *this->begin();
+            }
+
+            /**
+             * @brief Получить доступ к первому элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            constexpr const_reference front() const {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::static_vector::front: Using methods on a zero sized container");
+
+                return *this->begin();
+            }
+
+            /**
+             * @brief Получить доступ к последнему элементу
+             *
+             * @return reference
+             */
+            constexpr reference back() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::static_vector::back: Using methods on a zero sized container");
+
+                return *(this->end() - 1);
+            }
+
+            /**
+             * @brief Получить доступ к последнему элементу
+             * @details Для конст объекта
+             *
+             * @return const_reference
+             */
+            constexpr const_reference back() const {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::static_vector::back: Using methods on a zero sized container");
+
+                return *(this->end() - 1);
+            }
+
+            /**
+             * @brief Прямой доступ к базовому массиву
+             *
+             * @return iterator
+             */
+            constexpr iterator data() noexcept {
+                return this->storage_.slot(0);
+            }
+
+            /**
+             * @brief Прямой доступ к базовому массиву
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            constexpr const_iterator data() const noexcept {
+                return this->storage_.slot(0);
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             *
+             * @return iterator
+             */
+            constexpr iterator begin() noexcept {
+                return this->storage_.slot(0);
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            constexpr const_iterator begin() const noexcept {
+                return this->storage_.slot(0);
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             *
+             * @return iterator
+             */
+            constexpr iterator end() noexcept {
+                return this->storage_.slot(this->size_);
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            constexpr const_iterator end() const noexcept {
+                return this->storage_.slot(this->size_);
+            }
+
+            /**
+             * @brief Проверяет, пуст ли контейнер
+             *
+             * @return true - контейнер пуст
+             * @return false - контейнер не пуст
+             */
+            constexpr bool empty() const noexcept {
+                return this->size_ == 0;
+            }
+
+            /**
+             * @brief Проверяет, заполнен ли контейнер до Cap
+             *
+             * @return true - вставлять некуда
+             * @return false - место есть
+             */
+            constexpr bool full() const noexcept {
+                return this->size_ == Cap;
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            constexpr size_type size() const noexcept {
+                return this->size_;
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             *
+             * @return size_type - Cap
+             */
+            constexpr size_type max_size() const noexcept {
+                return Cap;
+            }
+
+            /**
+             * @brief Вместимость, всегда Cap
+             *
+             * @return size_type
+             */
+            static constexpr size_type capacity() noexcept {
+                return Cap;
+            }
+
+            /**
+             * @brief Очищает содержимое
+             *
+             */
+            constexpr void clear() noexcept {
+                while (this->size_ > 0)
+                    this->storage_.destroy(--this->size_);
+            }
+
+            /**
+             * @brief Вставляет элемент в конкретную позицию
+             * и возвращает итератор, указывающий на новый элемент
+             * @details См. emplace
+             *
+             * @param pos
+             * @param value
+             * @return iterator
+             */
+            constexpr iterator insert(const_iterator pos, const_reference value) {
+                return this->emplace(pos, value);
+            }
+
+            /**
+             * @brief Аналогично insert только вставка перемещением
+             *
+             * @param pos
+             * @param value
+             * @return iterator
+             */
+            constexpr iterator insert(const_iterator pos, value_type &&value) {
+                return this->emplace(pos, std::move(value));
+            }
+
+            /**
+             * @brief Стирает элемент в позиции
+             *
+             * @param pos
+             */
+            constexpr void erase(const_iterator pos) {
+                size_type index = pos - this->begin();
+                if (index >= this->size_)
+                    throw std::out_of_range("s21::static_vector::erase: Unable to erase a position out of range of begin to end");
+
+                for (; index + 1 < this->size_; index++)
+                    *this->storage_.slot(index) = std::move(*this->storage_.slot(index + 1));
+                this->storage_.destroy(--this->size_);
+            }
+
+            /**
+             * @brief Добавляет элемент в конец
+             *
+             * @param value
+             */
+            constexpr void push_back(const_reference value) {
+                this->emplace_back(value);
+            }
+
+            /**
+             * @brief Аналогично push_back только вставка перемещением
+             *
+             * @param value
+             */
+            constexpr void push_back(value_type &&value) {
+                this->emplace_back(std::move(value));
+            }
+
+            /**
+             * @brief Удаляет последний элемент
+             *
+             */
+            constexpr void pop_back() {
+                if (this->size_ == 0)
+                    throw std::out_of_range("s21::static_vector::pop_back: nothing to delete...");
+
+                this->storage_.destroy(--this->size_);
+            }
+
+            /**
+             * @brief Меняет содержимое
+             * @details Памяти не передать, поэтому элементы переносятся перемещением - O(size)
+             *
+             * @param other
+             */
+            constexpr void swap(static_vector& other) {
+                static_vector tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+            }
+
+            /**
+             * @brief Создает новый элемент из args непосредственно перед pos
+             * @details Как у vector: в середину элемент сначала создается во временном
+             * объекте (args могут ссылаться на элементы самого вектора), потом
+             * элементы сдвигаются перемещением
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param pos
+             * @param args
+             * @return iterator - указывает на новый элемент
+             */
+            template<typename... Args>
+            constexpr iterator emplace(const_iterator pos, Args&&... args) {
+                size_type index = pos - this->begin();
+                if (index > this->size_)
+                    throw std::out_of_range("s21::static_vector::insert Unable to insert into a position out of range of begin to end");
+
+                if (index == this->size_) {
+                    this->emplace_back(std::forward<Args>(args)...);
+                    return this->begin() + index;
+                }
+                if (this->size_ == Cap)
+                    throw std::out_of_range("s21::static_vector::insert: The container is full");
+
+                value_type value(std::forward<Args>(args)...);
+                this->storage_.construct(this->size_, std::move(*this->storage_.slot(this->size_ - 1)));
+                this->size_++;
+                for (size_type i = this->size_ - 2; i > index; i--)
+                    *this->storage_.slot(i) = std::move(*this->storage_.slot(i - 1));
+                *this->storage_.slot(index) = std::move(value);
+                return this->begin() + index;
+            }
+
+            /**
+             * @brief Создает новый элемент из args в конце контейнера
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            constexpr reference emplace_back(Args&&... args) {
+                if (this->size_ == Cap)
+                    throw std::out_of_range("s21::static_vector::push_back: The container is full");
+
+                reference item = this->storage_.construct(this->size_, std::forward<Args>(args)...);
+                this->size_++;
+                return item;
+            }
+
+            /**
+             * @brief Вставляет новые элементы в контейнер непосредственно перед pos
+             * @details Каждый аргумент - отдельный элемент, порядок сохраняется.
+             * Если все не поместятся, не вставляется ни один
+             *
+             * @tparam Args
+             * @param pos
+             * @param args
+             * @return iterator - указывает на последний вставленный элемент
+             */
+            template<typename... Args>
+            constexpr iterator insert_many(const_iterator pos, Args&&... args) {
+                size_type index = pos - this->begin();
+                if (index > this->size_)
+                    throw std::out_of_range("s21::static_vector::insert Unable to insert into a position out of range of begin to end");
+                if (sizeof...(args) > Cap - this->size_)
+                    throw std::out_of_range("s21::static_vector::insert_many: Not enough capacity");
+
+                iterator it_res = this->begin() + index;
+                ((it_res = this->emplace(this->begin() + index++, std::forward<Args>(args))), ...);
+                return it_res;
+            }
+
+            /**
+             * @brief Добавляет новые элементы в конец контейнера
+             * @details Если все не поместятся, не вставляется ни один
+             *
+             * @tparam Args
+             * @param args
+             */
+            template<typename... Args>
+            constexpr void insert_many_back(Args&&... args) {
+                if (sizeof...(args) > Cap - this->size_)
+                    throw std::out_of_range("s21::static_vector::insert_many_back: Not enough capacity");
+
+                (this->emplace_back(std::forward<Args>(args)), ...);
+            }
+    };
+}
+
+#endif // SRC_S21_STATIC_VECTOR_H_
@@ -1,11 +1,28 @@
 #ifndef SRC_S21_TREE_H_
 #define SRC_S21_TREE_H_
 #include <iostream>
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "s21_node_pool.h"
 
 namespace s21 {
+    // Значение служебного узла создается без исключений. std::pair не помечает свой
+    // конструктор по умолчанию noexcept, хотя он только создает first и second
+    template<typename T>
+    struct IsNothrowHeadKey : std::is_nothrow_default_constructible<T> {};
+
+    template<typename T1, typename T2>
+    struct IsNothrowHeadKey<std::pair<T1, T2>>
+        : std::bool_constant<std::is_nothrow_default_constructible<T1>::value &&
+                             std::is_nothrow_default_constructible<T2>::value> {};
+
     /**
      * @brief ВАЖНО!!!
      * Реализация красно-черного дерева, почти весь функционал я буду описывать
@@ -28,13 +45,37 @@ namespace s21 {
      * head_->left_ - самый маленкий элемент;
      * head_->right_ - самый большой элемент;
      * head_->parent_ - корень дерево (который всегда черный); 
+     *
+     * Узлы дерева (кроме head_) берутся из пула узлов (см. s21_node_pool.h), а не через new
+     * по одному: так вставка не ходит каждый раз в malloc, а узлы лежат в памяти плотно.
+     * Пул у каждого дерева свой, а куски памяти лежат в общем складе с подсчетом ссылок,
+     * так что разные деревья можно менять из разных потоков. Когда узлы переезжают из одного
+     * дерева в другое (merge, join, split), вместе с ними переезжает и право на память
+     * пула (см. absorbPool и sharePool) - узлы перевешиваются без копирования.
+     *
+     * Служебный узел head_ лежит в самом дереве, поэтому пустое дерево и перемещение дерева
+     * ничего не выделяют (end() при swap и перемещении остается у своего дерева, как в std::set).
+     * Куски пула берутся у аллокатора Allocator, перепривязанного через std::allocator_traits.
+     *
+     * Если OrderStatistics == true, каждый узел дополнительно хранит размер своего поддерева
+     * (subtree_size_). Тогда k-й по порядку элемент и позиция ключа находятся за O(log n)
+     * (nthElement, rank, countRange), но вставка по подсказке перестает быть O(1) - размеры
+     * нужно обновить на пути до корня. Без этого флага узел не растет ни на байт.
      */
-    template<typename Key, typename Comparator = std::less<Key>>
+    template<typename Key, typename Comparator = std::less<Key>, typename Allocator = std::allocator<Key>,
+             bool OrderStatistics = false>
     class BinaryTree {
         class BinaryTreeNode;
         class BinaryTreeIterator;
         class BinaryTreeConstIterator;
         using tree_node = BinaryTreeNode;
+        using node_pool = NodePool<tree_node, Allocator>;
+        using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<tree_node>;
+        using node_traits = std::allocator_traits<node_allocator>;
+        // Узлы можно не уничтожать по одному: у ключа нет деструктора, а стандартный
+        // аллокатор в destroy ничего кроме деструктора не делает
+        static constexpr bool kTrivialNodes = std::is_trivially_destructible<Key>::value &&
+            std::is_same<node_allocator, std::allocator<BinaryTreeNode>>::value;
         using reference = Key&;
         using const_reference = const Key&;
         using size_type = std::size_t;
@@ -48,60 +89,82 @@ namespace s21 {
             // итераторы переопределим в public как iterator и const_iterator
             using iterator = BinaryTreeIterator;
             using const_iterator = BinaryTreeConstIterator;
+            using allocator_type = Allocator;
+
+            // Операции над множествами для combineWith и assignCombined
+            // (с повторами работают как std::set_union и т.д.)
+            enum class SetOperation {
+                Union,
+                Intersection,
+                Difference,
+                SymmetricDifference
+            };
 
             /*----------------------------constructors and operators--------------------------------*/
 
-            // Конструктор инициализации дерева, создает служебный узел для головы дерева
-            BinaryTree() {
-                this->head_ = new tree_node;
-                this->size_ = 0;
-            }
+            // Конструктор инициализации дерева: пустое дерево ничего не выделяет,
+            // служебный узел лежит в самом дереве, а пул берет память при первой вставке
+            BinaryTree() : BinaryTree(Comparator(), Allocator()) {}
+
+            // Конструктор с аллокатором
+            explicit BinaryTree(const Allocator& alloc) : BinaryTree(Comparator(), alloc) {}
+
+            // Конструктор с компаратором и аллокатором
+            explicit BinaryTree(const Comparator& comparator, const Allocator& alloc = Allocator())
+                : size_(0), comparator_(comparator), alloc_(alloc), pool_(Allocator(alloc)) {}
 
             // Конструктор копирования дерева
-            BinaryTree(const BinaryTree& other) : BinaryTree() {
-                *this = other;
+            // Аллокатор для копии выбирает сам аллокатор (select_on_container_copy_construction)
+            BinaryTree(const BinaryTree& other)
+                : BinaryTree(other.comparator_, node_traits::select_on_container_copy_construction(other.alloc_)) {
+                this->copyTreeFrom(other);
             }
 
 
-            // Конструктор перемещения дерева
-            BinaryTree(BinaryTree&& other) : BinaryTree() {
-                *this = std::move(other);
+            // Конструктор перемещения дерева: узлы перевешиваются к своему служебному узлу,
+            // пул (вместе с памятью) переезжает целиком - ничего не выделяется
+            BinaryTree(BinaryTree&& other) noexcept(IsNothrowHeadKey<Key>::value &&
+                                                    std::is_nothrow_copy_constructible<Comparator>::value)
+                : size_(0), comparator_(other.comparator_), alloc_(other.alloc_), pool_(std::move(other.pool_)) {
+                this->swapHeads(other);
             }
 
             // Деструктор - удаления дерева
             ~BinaryTree() {
                 this->clear();
-                delete this->head_;
-                this->head_ = nullptr;
             }
 
             // Оператор присваивания копированием
+            // Копию собираем во временном дереве (со своим пулом), а потом забираем ее
+            // перемещением, так старые узлы this и их пул освобождаются целиком
             BinaryTree& operator=(const BinaryTree& other) {
                 if (this != &other) {
-                    if (other.size_ == 0) {
-                        this->clear();
-                    } else {
-                        tree_node* temp_root = this->copyFromNode(other.head_->parent_, nullptr);
-                        this->clear();
-                        this->head_->parent_ = temp_root;
-                        this->head_->parent_->parent_ = this->head_;
-                        this->head_->left_ = searchLeft(this->head_->parent_);
-                        this->head_->right_ = searchRight(this->head_->parent_);
-                        this->size_ = other.size_;
-                        this->comparator_ = other.comparator_;
-                    }
+                    BinaryTree temp(other.comparator_,
+                        node_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : this->alloc_);
+                    temp.copyTreeFrom(other);
+                    this->swapTree(temp);
                 }
                 return *this;
             }
 
 
             // Оператор присваивания перемещением
-            BinaryTree& operator=(BinaryTree&& other) {
+            // Если аллокаторы равны (или аллокатор переезжает вместе с деревом),
+            // просто меняемся узлами, иначе чужую память забрать нельзя и
+            // перемещаем элементы по одному в свои узлы
+            BinaryTree& operator=(BinaryTree&& other) noexcept(node_traits::propagate_on_container_move_assignment::value ||
+                                                    node_traits::is_always_equal::value) {
                 if (this != &other) {
                     this->clear();
-                    std::swap(this->head_, other.head_);
-                    std::swap(this->size_, other.size_);
-                    std::swap(this->comparator_, other.comparator_);
+                    if (node_traits::propagate_on_container_move_assignment::value || this->alloc_ == other.alloc_) {
+                        this->swapTree(other);
+                    } else {
+                        this->comparator_ = other.comparator_;
+                        for (iterator it = other.begin(); it != other.end(); ++it) {
+                            this->insert(this->head()->parent_, this->createNode(std::move(*it)), false);
+                        }
+                        other.clear();
+                    }
                 }
                 return *this;
             }
@@ -110,18 +173,39 @@ namespace s21 {
 
             /*---------------------------------methods----------------------------------*/
 
+            /**
+             * @brief Возвращает копию аллокатора дерева
+             *
+             */
+            allocator_type get_allocator() const noexcept {
+                return allocator_type(this->alloc_);
+            }
+
+            /**
+             * @brief Меняет содержимое деревьев вместе с компараторами, аллокаторами и пулами
+             * @details Ничего не выделяет: перевешиваются только корни
+             *
+             */
+            void swap(BinaryTree& other) noexcept {
+                this->swapTree(other);
+            }
+
             /**
              * @brief Функция удаления дерева, служебный узел head_ остается
+             * @details После удаления узлов пул отпускает свою память разом (куски, которые
+             * держит и другое дерево, освободит оно). А если узлам к тому же не нужны
+             * деструкторы (см. kTrivialNodes), их можно даже не обходить - дерево
+             * освобождается за время, не зависящее от количества элементов
              * 
              */
-            void clear() {
-                // Удаляем узлы
-                this->destroyNodes(this->head_->parent_);
+            void clear() noexcept {
+                if (!kTrivialNodes) {
+                    // Удаляем узлы
+                    this->destroyNodes(this->head()->parent_);
+                }
+                this->pool_.release();
                 // Приводим наше дерево к состоянию пустого дерева
-                this->head_->parent_ = nullptr;
-                this->head_->left_ = this->head_;
-                this->head_->right_ = this->head_;
-                this->size_ = 0;
+                this->resetHead();
             }
 
             /**
@@ -130,7 +214,7 @@ namespace s21 {
              * @return iterator - начало
              */
             iterator begin() noexcept {
-                return iterator(this->head_->left_);
+                return iterator(this->head()->left_);
             }
 
             /**
@@ -140,7 +224,7 @@ namespace s21 {
              * @return const_iterator - начало
              */
             const_iterator begin() const noexcept {
-                return const_iterator(this->head_->left_);
+                return const_iterator(this->head()->left_);
             }
 
             /**
@@ -150,7 +234,7 @@ namespace s21 {
              * @return iterator - конец
              */
             iterator end() noexcept {
-                return iterator(this->head_);
+                return iterator(this->head());
             }
 
             /**
@@ -161,7 +245,7 @@ namespace s21 {
              * @return iterator - конец
              */
             const_iterator end() const noexcept {
-                return const_iterator(this->head_);
+                return const_iterator(this->head());
             }
 
             /**
@@ -209,27 +293,144 @@ namespace s21 {
              * @return iterator - iterator указывает на вставленный элемент
              */
             iterator insert(const Key& key) {
-                tree_node* node = new tree_node(key);
-                return this->insert(this->head_->parent_, node, false).first;
+                tree_node* node = this->createNode(key);
+                return this->insert(this->head()->parent_, node, false).first;
             }
 
             /**
              * @brief Функция втсавляет значения в узел только уникальные элементы,
              * а затем в древо.
-             * @details если вставить не получилось, тогда созданный узел удаляем
+             * @details Сначала ищем место для ключа, и только если такого ключа еще нет,
+             * создаем узел (см. emplaceUniqueKey)
              * 
              * @return pair<iterator, bool> - если получилось вставить элемент iterator
              * будет указывать на элемент который вставили и bool = true,
-             * в противном случае iterator будет указывать на end() и bool = false
+             * в противном случае iterator будет указывать на элемент с таким же ключом и bool = false
              */
             std::pair<iterator, bool> insertUnique(const Key& key) {
-                tree_node* new_node = new tree_node(key);
-                std::pair<iterator, bool> result = insert(this->head_->parent_, new_node, true);
+                return this->emplaceUniqueKey(key, key);
+            }
+
+            /**
+             * @brief Вставляет элемент с ключом key, если такого ключа еще нет
+             * @details Место для key ищется за один спуск от корня. Если ключ нашелся,
+             * ничего не создаем. Иначе узел создается прямо из args (они передаются
+             * в конструктор Key как есть, например std::piecewise_construct для пары)
+             * и сразу подвешивается в найденное место - второго спуска нет.
+             * key - Key или любой тип, который компаратор умеет сравнивать с Key,
+             * а элемент, собранный из args, должен быть равен key
+             * 
+             * @return pair<iterator, bool> - как у insertUnique
+             */
+            template<typename K, typename... Args>
+            std::pair<iterator, bool> emplaceUniqueKey(const K& key, Args&&... args) {
+                bool left = false;
+                std::pair<tree_node*, bool> pos = this->searchUniquePos(key, left);
+                if (pos.second) {
+                    return {iterator(pos.first), false};
+                }
+                tree_node* new_node = this->createNode(std::in_place, std::forward<Args>(args)...);
+                return {this->linkNode(pos.first, left, new_node), true};
+            }
+
+            /**
+             * @brief Вставляет элемент, начиная поиск места с подсказки hint
+             * @details Подсказка - позиция, перед которой, по мнению вызывающего, должен
+             * встать элемент (например end() для возрастающих ключей). Если подсказка верна,
+             * узел подвешивается сразу, без спуска от корня (см. insertHint)
+             *
+             * @return iterator - указывает на вставленный элемент
+             */
+            iterator insert(const_iterator hint, const Key& key) {
+                tree_node* node = this->createNode(key);
+                return this->insertHint(hint, node, false).first;
+            }
+
+            /**
+             * @brief Аналогично insert(hint, key), но вставляет только уникальные элементы
+             *
+             * @return iterator - указывает на вставленный элемент или на уже
+             * имеющийся элемент с таким ключом
+             */
+            iterator insertUnique(const_iterator hint, const Key& key) {
+                tree_node* new_node = this->createNode(key);
+                std::pair<iterator, bool> result = this->insertHint(hint, new_node, true);
                 if (result.second == false) {
-                    //Если не смогли вставить эелемент, надо его удалить
-                    delete new_node;
+                    this->destroyNode(new_node);
                 }
-                return result;
+                return result.first;
+            }
+
+            /**
+             * @brief Создает элемент из args и вставляет его с подсказкой hint
+             *
+             * @return iterator - указывает на вставленный элемент
+             */
+            template<typename... Args>
+            iterator emplaceHint(const_iterator hint, Args&&... args) {
+                tree_node* node = this->createNode(std::in_place, std::forward<Args>(args)...);
+                return this->insertHint(hint, node, false).first;
+            }
+
+            /**
+             * @brief Аналогично emplaceHint, но вставляет только уникальные элементы
+             *
+             * @return iterator - указывает на вставленный элемент или на уже
+             * имеющийся элемент с таким ключом
+             */
+            template<typename... Args>
+            iterator emplaceHintUnique(const_iterator hint, Args&&... args) {
+                tree_node* new_node = this->createNode(std::in_place, std::forward<Args>(args)...);
+                std::pair<iterator, bool> result = this->insertHint(hint, new_node, true);
+                if (result.second == false) {
+                    this->destroyNode(new_node);
+                }
+                return result.first;
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева элементами из [first, last)
+             * @details Элементы должны идти по возрастанию (в смысле comparator_).
+             * Дерево строится сразу целиком снизу вверх за O(n), без поиска места
+             * и балансировки для каждого элемента (см. buildFromNodes)
+             *
+             */
+            template<typename InputIt>
+            void assignSorted(InputIt first, InputIt last) {
+                this->assignRange(first, last, false, true);
+            }
+
+            /**
+             * @brief Аналогично assignSorted, но из повторяющихся элементов
+             * остается только первый
+             *
+             */
+            template<typename InputIt>
+            void assignSortedUnique(InputIt first, InputIt last) {
+                this->assignRange(first, last, true, true);
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева элементами из [first, last) в любом порядке
+             * @details Если элементы не отсортированы, сначала сортируем их (устойчиво,
+             * чтобы равные элементы остались в порядке следования), потом строим дерево
+             * как в assignSorted. Итого O(n log n) сравнений без балансировки, а для уже
+             * отсортированного диапазона - O(n)
+             *
+             */
+            template<typename InputIt>
+            void assign(InputIt first, InputIt last) {
+                this->assignRange(first, last, false, false);
+            }
+
+            /**
+             * @brief Аналогично assign, но из повторяющихся элементов
+             * остается только первый
+             *
+             */
+            template<typename InputIt>
+            void assignUnique(InputIt first, InputIt last) {
+                this->assignRange(first, last, true, false);
             }
 
             /**
@@ -237,14 +438,14 @@ namespace s21 {
              * 
              */
             void erase(iterator pos) noexcept {
-                delete this->extractNode(pos);
+                this->destroyNode(this->extractNode(pos));
             }
 
             /**
              * @brief Находит элемент по ключу
              * @details В стандарте не регулируется какой именно элемент будет найден, если
              * их несколько, но в стандарте есть lower_bound,
-             * поэтому делаем через lower_bound как в стандарте.
+             * поэтому делаем через lower_bound как в стандарте (см. findNode).
              * Если элемент не найден или больше key, тогда
              * возвращаем iterator указывающий на конец
              * 
@@ -252,11 +453,7 @@ namespace s21 {
              * случае будет указывать на end()
              */
             iterator find(const_reference key) {
-                iterator result = lowerBound(key);
-                if (result == this->end() || this->comparator_(key, *result)) {
-                    return this->end();
-                }
-                return result;
+                return iterator(this->findNode(key));
             }
 
             /**
@@ -264,11 +461,29 @@ namespace s21 {
              * 
              */
             const_iterator find(const_reference key) const {
-                const_iterator result = lowerBound(key);
-                if (result == this->end() || this->comparator_(key, *result)) {
-                    return this->end();
-                }
-                return result;
+                return const_iterator(this->findNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции find, но ключ может быть любого типа,
+             * который компаратор умеет сравнивать с Key
+             * @details Доступно, только если у компаратора есть is_transparent (как у std::less<>).
+             * Так можно, например, искать std::string по std::string_view, не создавая
+             * временный std::string, а в map - искать пару только по ключу
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            iterator find(const K& key) {
+                return iterator(this->findNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции find(const K&) только для конст объекта
+             * 
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            const_iterator find(const K& key) const {
+                return const_iterator(this->findNode(key));
             }
 
             /**
@@ -281,6 +496,9 @@ namespace s21 {
             void merge(BinaryTree& other) {
                 //Проверяем указатели что они не равны
                 if (this != &other) {
+                    // Все узлы other переезжают в this, поэтому вместе с ними можно забрать
+                    // и память пула other (если аллокаторы равны)
+                    bool shared = this->absorbPool(other);
                     iterator it_other = other.begin();
                     while (other.size_ > 0) {
                         // Сохраним во временную переменную чтоб отцепить его
@@ -304,203 +522,1116 @@ namespace s21 {
                             temp->left_->parent_ = temp->parent_;
                         }
 
-                        // Обнуляем указатели узла
-                        temp->left_ = nullptr;
-                        temp->right_ = nullptr;
-                        temp->parent_ = nullptr;
+                        // Обнуляем указатели узла
+                        temp->left_ = nullptr;
+                        temp->right_ = nullptr;
+                        temp->parent_ = nullptr;
+
+                        // Узел нужно перекрасить в красный если он был черный,
+                        // даже если он красный ничего страшного не будет
+                        temp->color_ = Red;
+
+                        // Теперь этот узел который отцепили вставляем в this
+                        this->insert(this->head()->parent_, this->adoptNode(other, temp, shared), false);
+
+                        // Уменьшаем количество элементов(size_) в other
+                        other.size_--;
+                    }
+
+                    // Приводим дерево other по умолчанию как при создании
+                    other.head()->parent_ = nullptr;
+                    other.head()->left_ = other.head();
+                    other.head()->right_ = other.head();
+                }
+
+            }
+
+            /**
+             * @brief Функция вытаскивает только уникальные эелементы из other.
+             * @details Все эелементы которые не вставились в this остаются в other, поэтому тут
+             * придется потратить не много времени на изьятия узла использовав каждый раз
+             * болансировку после изъятия. Сами узлы перевешиваются без копирования: this
+             * начинает держать память пула other (см. sharePool). Только если аллокаторы
+             * не равны, ключ перемещается в новый узел из пула this
+             */
+            void mergeUnique(BinaryTree& other) {
+                if (this != &other) {
+                    // Узлы other перевешиваются как есть, если this может держать память other
+                    bool shared = this->sharePool(other);
+                    iterator it_other = other.begin();
+                    while (it_other != other.end()) {
+                        // Проверяем есть ли такой элемент в this
+                        if (this->find(it_other.currentNode_->key_) == this->end()) {
+                            // Если он не нашел такого элемента, iterator будет указывать в конец
+                            iterator temp = it_other;
+                            ++it_other;
+                            // Забираем узел из other и вставляем в this. Ключ перемещается
+                            // в новый узел, только если аллокаторы не равны (см. adoptNode)
+                            tree_node* pick_up_node = other.extractNode(temp);
+                            this->insert(this->head()->parent_, this->adoptNode(other, pick_up_node, shared), false);
+                        } else {
+                            // Если нашли такой же узел, значит не трогаем его
+                            // (оставляем его в other и переходим на следующий узел)
+                            ++it_other;
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева результатом операции op над this и other
+             * @details Оба дерева обходятся по возрастанию один раз, как в std::set_union.
+             * Свои узлы, попавшие в результат, не копируются, для элементов other
+             * создаются новые узлы, лишние свои узлы удаляются. Затем дерево заново
+             * собирается снизу вверх (см. buildFromNodes) - итого O(n + m) без поиска
+             * и балансировки для каждого элемента.
+             * Если создание узла бросит исключение, дерево остается как было
+             *
+             */
+            void combineWith(const BinaryTree& other, SetOperation op) {
+                std::vector<tree_node*> nodes;
+                std::vector<tree_node*> dropped;
+                // Памяти хватит на любой результат, push_back дальше не бросает
+                nodes.reserve(this->size_ + other.size_);
+                dropped.reserve(this->size_);
+                try {
+                    this->walkCombined(this->head(), other.head(), op,
+                        [&nodes](tree_node* node) { nodes.push_back(node); },
+                        [&dropped](tree_node* node) { dropped.push_back(node); },
+                        [this, &nodes](tree_node* node) { nodes.push_back(this->createNode(node->key_)); });
+                } catch (...) {
+                    // Новые узлы еще ни к чему не подвешены, в отличие от своих (у корня родитель - head_)
+                    for (tree_node* node : nodes) {
+                        if (node->parent_ == nullptr) {
+                            this->destroyNode(node);
+                        }
+                    }
+                    throw;
+                }
+                this->head()->parent_ = nullptr;
+                this->head()->left_ = this->head();
+                this->head()->right_ = this->head();
+                this->size_ = 0;
+                this->buildFromNodes(nodes);
+                for (tree_node* node : dropped) {
+                    this->destroyNode(node);
+                }
+            }
+
+            /**
+             * @brief Заменяет содержимое дерева результатом операции op над a и b
+             * @details Как combineWith, только все узлы результата новые: O(n + m).
+             * Компаратор берется у a
+             *
+             */
+            void assignCombined(const BinaryTree& a, const BinaryTree& b, SetOperation op) {
+                this->clear();
+                this->comparator_ = a.comparator_;
+                std::vector<tree_node*> nodes;
+                nodes.reserve(a.size_ + b.size_);
+                auto copy = [this, &nodes](tree_node* node) { nodes.push_back(this->createNode(node->key_)); };
+                try {
+                    this->walkCombined(a.head(), b.head(), op, copy, [](tree_node*) {}, copy);
+                } catch (...) {
+                    for (tree_node* node : nodes) {
+                        this->destroyNode(node);
+                    }
+                    throw;
+                }
+                this->buildFromNodes(nodes);
+            }
+
+            /**
+             * @brief Переносит все элементы, которые >= key, в дерево upper
+             * @details В this остаются элементы меньше key, прежнее содержимое upper удаляется.
+             * Узлы не копируются и не создаются: дерево разрезается по пути поиска key,
+             * а куски склеиваются обратно через joinParts с учетом черной высоты,
+             * поэтому сама перестановка узлов - O(log n).
+             * size() обоих деревьев при OrderStatistics == true тоже считается за O(log n),
+             * иначе перенесенные элементы приходится пересчитать: O(min(k, n - k)).
+             * Если аллокаторы равны, upper забирает отрезанные узлы вместе с правом держать
+             * память пула this и ничего не выделяет (см. splitTo). Иначе элементы >= key
+             * переносятся в новые узлы upper - O(k), а при исключении остаются в this
+             *
+             */
+            void split(const_reference key, BinaryTree& upper) {
+                this->splitTo(key, upper);
+            }
+
+            /**
+             * @brief Аналогично функции split для ключа другого типа (см. find(const K&))
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            void split(const K& key, BinaryTree& upper) {
+                this->splitTo(key, upper);
+            }
+
+            /**
+             * @brief Переносит все элементы other в this, если диапазоны ключей не пересекаются
+             * @details Все ключи other должны быть не меньше всех ключей this или не больше
+             * (при unique - строго). Крайний узел other становится разделителем, и деревья
+             * склеиваются через joinParts за O(log n) без копирования. other становится пустым.
+             * Если аллокаторы не равны, элементы other сначала перемещаются в свои узлы - O(m)
+             *
+             * @param unique - в дереве не может быть равных ключей (set, map)
+             * @throw std::invalid_argument - диапазоны ключей пересекаются
+             */
+            void join(BinaryTree& other, bool unique) {
+                if (this == &other || other.size_ == 0) {
+                    return;
+                }
+                bool other_after = true;
+                if (this->size_ > 0) {
+                    other_after = this->notAfter(this->head()->right_->key_, other.head()->left_->key_, unique);
+                    if (!other_after && !this->notAfter(other.head()->right_->key_, this->head()->left_->key_, unique)) {
+                        throw std::invalid_argument("s21::BinaryTree::join: key ranges overlap");
+                    }
+                }
+                if (!this->absorbPool(other)) {
+                    // Чужую память забрать нельзя: перемещаем элементы other в узлы из своего пула
+                    BinaryTree moved(this->comparator_, this->alloc_);
+                    moved.assignSorted(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    other.clear();
+                    this->join(moved, unique);
+                    return;
+                }
+                if (this->size_ == 0) {
+                    this->installRoot(other.head()->parent_, other.head()->left_, other.head()->right_, other.size_);
+                    other.resetHead();
+                    return;
+                }
+
+                size_type total = this->size_ + other.size_;
+                tree_node* this_min = this->head()->left_;
+                tree_node* this_max = this->head()->right_;
+                tree_node* other_min = other.head()->left_;
+                tree_node* other_max = other.head()->right_;
+                // Разделитель - крайний узел other со стороны this
+                tree_node* pivot = other.extractNode(other_after ? other.begin() : iterator(other_max));
+                SubtreePart mine = this->detachRoot(this->head()->parent_);
+                SubtreePart theirs = this->detachRoot(other.head()->parent_);
+                other.resetHead();
+                this->head()->parent_ = nullptr;
+
+                SubtreePart joined = other_after ? this->joinParts(mine, pivot, theirs)
+                                                 : this->joinParts(theirs, pivot, mine);
+                this->installRoot(joined.root_, other_after ? this_min : other_min,
+                                  other_after ? other_max : this_max, total);
+            }
+
+            /**
+             * @brief Функция находит элемент который >= key и возвращает iterator
+             * указывающий на найденный элемент
+             * 
+             * @return iterator - указывает на найденный узел, в противном случае
+             * указывает на end()
+             */
+            iterator lowerBound(const_reference key) noexcept {
+                return iterator(this->lowerBoundNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции lowerBound только для конст объекта
+             * 
+             */
+            const_iterator lowerBound(const_reference key) const noexcept {
+                return const_iterator(this->lowerBoundNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции lowerBound для ключа другого типа (см. find(const K&))
+             * 
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            iterator lowerBound(const K& key) noexcept {
+                return iterator(this->lowerBoundNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции lowerBound(const K&) только для конст объекта
+             * 
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            const_iterator lowerBound(const K& key) const noexcept {
+                return const_iterator(this->lowerBoundNode(key));
+            }
+
+            /**
+             * @brief Функция находит элемент который больше key
+             * 
+             * @param key 
+             * @return iterator 
+             */
+            iterator upperBound(const_reference key) noexcept {
+                return iterator(this->upperBoundNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции upperBound только для конст объекта
+             * 
+             */
+            const_iterator upperBound(const_reference key) const noexcept {
+                return const_iterator(this->upperBoundNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции upperBound для ключа другого типа (см. find(const K&))
+             * 
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            iterator upperBound(const K& key) noexcept {
+                return iterator(this->upperBoundNode(key));
+            }
+
+            /**
+             * @brief Аналогично функции upperBound(const K&) только для конст объекта
+             * 
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            const_iterator upperBound(const K& key) const noexcept {
+                return const_iterator(this->upperBoundNode(key));
+            }
+
+            /**
+             * @brief Возвращает диапазон [lowerBound(key), upperBound(key)) элементов, равных key
+             * @details Спуск от корня общий, пока не встретим равный узел, дальше нижняя
+             * граница ищется в его левом поддереве, а верхняя - в правом. Итого O(log n)
+             * независимо от количества равных элементов, end() не разыменовывается
+             *
+             */
+            std::pair<iterator, iterator> equalRange(const_reference key) noexcept {
+                std::pair<tree_node*, tree_node*> range = this->equalRangeNodes(key);
+                return {iterator(range.first), iterator(range.second)};
+            }
+
+            /**
+             * @brief Аналогично функции equalRange только для конст объекта
+             *
+             */
+            std::pair<const_iterator, const_iterator> equalRange(const_reference key) const noexcept {
+                std::pair<tree_node*, tree_node*> range = this->equalRangeNodes(key);
+                return {const_iterator(range.first), const_iterator(range.second)};
+            }
+
+            /**
+             * @brief Количество элементов, равных key
+             * @details При OrderStatistics == true это разность двух рангов - O(log n)
+             * при любом количестве повторов. Иначе равные элементы приходится
+             * пересчитать итератором: O(log n + k)
+             *
+             */
+            size_type count(const_reference key) const noexcept {
+                if constexpr (OrderStatistics) {
+                    return this->upperRank(key) - this->lowerRank(key);
+                } else {
+                    std::pair<tree_node*, tree_node*> range = this->equalRangeNodes(key);
+                    size_type result = 0;
+                    for (const_iterator it(range.first), last(range.second); it != last; ++it) {
+                        ++result;
+                    }
+                    return result;
+                }
+            }
+
+            /**
+             * @brief Создает один элемент прямо в узле из args и вставляет его,
+             * если в дереве еще нет такого ключа
+             * @details Чтобы сравнить элемент с другими, его нужно сначала создать,
+             * поэтому при повторе созданный узел удаляется
+             * 
+             * @tparam Args - аргументы конструктора Key
+             * @param args 
+             * @return pair<iterator, bool> - как у insertUnique
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplaceUnique(Args&&... args) {
+                tree_node* new_node = this->createNode(std::in_place, std::forward<Args>(args)...);
+                std::pair<iterator, bool> result = this->insert(this->head()->parent_, new_node, true);
+                if (result.second == false) {
+                    //Если элемент не вставился - надо его удалить
+                    this->destroyNode(new_node);
+                }
+                return result;
+            }
+
+            /**
+             * @brief Аналогично emplaceUnique только вставляет элемент всегда
+             * 
+             * @tparam Args - аргументы конструктора Key
+             * @param args 
+             * @return iterator - указывает на вставленный элемент
+             */
+            template<typename... Args>
+            iterator emplace(Args&&... args) {
+                tree_node* new_node = this->createNode(std::in_place, std::forward<Args>(args)...);
+                return this->insert(this->head()->parent_, new_node, false).first;
+            }
+
+            /**
+             * @brief Вставляет новые элеметы в контейнер, если контейнер
+             * не содержит таких ключей
+             * @details Каждый аргумент - отдельный элемент, он передается в emplaceUnique
+             * как есть (перемещается, если это rvalue), без промежуточных копий
+             * 
+             * @tparam Args 
+             * @param args 
+             * @return vector<std::pair<iterator,bool>> 
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insertManyUnique(Args&&... args) {
+                //Создаем вектор, что бы записать результат вставки всех элементов
+                std::vector<std::pair<iterator, bool>> v;
+                //Считаем количество аргументов и создаем память под вектор.
+                //Это делается для того, чтоб каждый раз при вставке элемента
+                //память не перевыделялась
+                v.reserve(sizeof...(args));
+                (v.push_back(this->emplaceUnique(std::forward<Args>(args))), ...);
+                return v;
+            }
+
+            /**
+             * @brief Аналогично insertManyUnique только вставляет все элементы
+             * 
+             * @tparam Args 
+             * @param args 
+             * @return vector<std::pair<iterator,bool>> 
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insertMany(Args&&... args) {
+                std::vector<std::pair<iterator, bool>> v;
+                v.reserve(sizeof...(args));
+                (v.push_back({this->emplace(std::forward<Args>(args)), true}), ...);
+                return v;
+            }
+
+            /**
+             * @brief Возвращает iterator на k-й по порядку элемент (считая с 0)
+             * @details Спускаемся от корня, сравнивая k с размером левого поддерева,
+             * поэтому O(log n). Доступно только при OrderStatistics == true
+             *
+             * @return iterator - k-й элемент или end(), если k >= size()
+             */
+            iterator nthElement(size_type k) noexcept {
+                return iterator(this->nthNode(k));
+            }
+
+            /**
+             * @brief Аналогично функции nthElement только для конст объекта
+             *
+             */
+            const_iterator nthElement(size_type k) const noexcept {
+                return const_iterator(this->nthNode(k));
+            }
+
+            /**
+             * @brief Количество элементов, меньших key, то есть номер lowerBound(key)
+             * @details O(log n). Доступно только при OrderStatistics == true
+             *
+             */
+            size_type rank(const_reference key) const noexcept {
+                return this->lowerRank(key);
+            }
+
+            /**
+             * @brief Аналогично функции rank для ключа другого типа (см. find(const K&))
+             *
+             */
+            template<typename K, typename C = Comparator, typename = typename C::is_transparent>
+            size_type rank(const K& key) const noexcept {
+                return this->lowerRank(key);
+            }
+
+            /**
+             * @brief Количество элементов из полуинтервала [lo, hi)
+             * @details Разность двух rank, поэтому O(log n) при любом количестве
+             * элементов внутри. Доступно только при OrderStatistics == true
+             *
+             */
+            size_type countRange(const_reference lo, const_reference hi) const noexcept {
+                if (!this->comparator_(lo, hi)) {
+                    return 0;
+                }
+                return this->lowerRank(hi) - this->lowerRank(lo);
+            }
+
+
+            /*----------------------------------------------------------------------------------*/
+
+        private:
+
+            // Размер поддерева node, для пустой ветки - 0
+            static size_type subtreeSize(const tree_node* node) noexcept {
+                return node == nullptr ? 0 : node->subtree_size_;
+            }
+
+            // Пересчитывает размер поддерева node по его детям
+            static void updateSubtreeSize(tree_node* node) noexcept {
+                if constexpr (OrderStatistics) {
+                    node->subtree_size_ = 1 + subtreeSize(node->left_) + subtreeSize(node->right_);
+                }
+            }
+
+            // Прибавляет delta (по модулю size_type) к размерам поддеревьев от node до корня
+            void addSubtreeSizeUp(tree_node* node, size_type delta) noexcept {
+                if constexpr (OrderStatistics) {
+                    for (; node != this->head(); node = node->parent_) {
+                        node->subtree_size_ += delta;
+                    }
+                }
+            }
+
+            /**
+             * @brief Находит k-й по порядку узел или возвращает head_
+             *
+             */
+            tree_node* nthNode(size_type k) const noexcept {
+                static_assert(OrderStatistics, "s21::BinaryTree: nthElement requires OrderStatistics");
+                tree_node* node = this->head()->parent_;
+                if (k >= this->size_) {
+                    return this->head();
+                }
+                while (true) {
+                    size_type left = subtreeSize(node->left_);
+                    if (k < left) {
+                        node = node->left_;
+                    } else if (k == left) {
+                        return node;
+                    } else {
+                        k -= left + 1;
+                        node = node->right_;
+                    }
+                }
+            }
+
+            /**
+             * @brief Количество узлов, меньших key
+             *
+             */
+            template<typename K>
+            size_type lowerRank(const K& key) const noexcept {
+                static_assert(OrderStatistics, "s21::BinaryTree: rank requires OrderStatistics");
+                size_type result = 0;
+                tree_node* node = this->head()->parent_;
+                while (node != nullptr) {
+                    if (this->comparator_(node->key_, key)) {
+                        // Узел и все его левое поддерево меньше key
+                        result += subtreeSize(node->left_) + 1;
+                        node = node->right_;
+                    } else {
+                        node = node->left_;
+                    }
+                }
+                return result;
+            }
+
+            /**
+             * @brief Количество узлов, не больших key
+             *
+             */
+            template<typename K>
+            size_type upperRank(const K& key) const noexcept {
+                static_assert(OrderStatistics, "s21::BinaryTree: rank requires OrderStatistics");
+                size_type result = 0;
+                tree_node* node = this->head()->parent_;
+                while (node != nullptr) {
+                    if (!this->comparator_(key, node->key_)) {
+                        result += subtreeSize(node->left_) + 1;
+                        node = node->right_;
+                    } else {
+                        node = node->left_;
+                    }
+                }
+                return result;
+            }
+
+            /**
+             * @brief Находит первый узел, который >= key, и первый узел, который больше key
+             * (head_, если такого нет) за один спуск
+             *
+             */
+            template<typename K>
+            std::pair<tree_node*, tree_node*> equalRangeNodes(const K& key) const noexcept {
+                tree_node* upper = this->head();
+                tree_node* node = this->head()->parent_;
+                while (node != nullptr) {
+                    if (this->comparator_(node->key_, key)) {
+                        node = node->right_;
+                    } else if (this->comparator_(key, node->key_)) {
+                        upper = node;
+                        node = node->left_;
+                    } else {
+                        // Узел равен key: все меньшие ключи слева от него, все большие - справа
+                        tree_node* lower = node;
+                        for (tree_node* left = node->left_; left != nullptr;) {
+                            if (this->comparator_(left->key_, key)) {
+                                left = left->right_;
+                            } else {
+                                lower = left;
+                                left = left->left_;
+                            }
+                        }
+                        for (tree_node* right = node->right_; right != nullptr;) {
+                            if (this->comparator_(key, right->key_)) {
+                                upper = right;
+                                right = right->left_;
+                            } else {
+                                right = right->right_;
+                            }
+                        }
+                        return {lower, upper};
+                    }
+                }
+                return {upper, upper};
+            }
+
+            /**
+             * @brief Находит узел с ключом, равным key, или возвращает head_
+             * @details K - Key или любой тип, который компаратор умеет сравнивать с Key
+             *
+             */
+            template<typename K>
+            tree_node* findNode(const K& key) const {
+                tree_node* result = this->lowerBoundNode(key);
+                if (result == this->head() || this->comparator_(key, result->key_)) {
+                    return this->head();
+                }
+                return result;
+            }
+
+            /**
+             * @brief Находит первый узел, который >= key, или возвращает head_
+             *
+             */
+            template<typename K>
+            tree_node* lowerBoundNode(const K& key) const noexcept {
+                tree_node* result = this->head();
+                tree_node* begin = this->head()->parent_;
+
+                while (begin != nullptr) {
+                    if (this->comparator_(begin->key_, key)) {
+                        // Если элемент меньше key значит идем в право,
+                        // т.к. справа элементы больше
+                        begin = begin->right_;
+                    } else {
+                        // Если элемент больше или равен key запоминаем его
+                        result = begin;
+                        // Так как элемент был больше или равен, идем влево
+                        // т.к. слева распологаются элементы меньше текущего
+                        begin = begin->left_;
+                    }
+                }
+                
+                return result;
+            }
+
+            /**
+             * @brief Находит первый узел, который больше key, или возвращает head_
+             *
+             */
+            template<typename K>
+            tree_node* upperBoundNode(const K& key) const noexcept {
+                tree_node* result = this->head();
+                tree_node* begin = this->head()->parent_;
+                while (begin != nullptr) {
+                    if (this->comparator_(key, begin->key_)) {
+                        // Если значение которое мы ищем меньше значения узла,
+                        // то мы сохраняем этот узел
+                        result = begin;
+                        // Идем влево так как узел был больше искомого
+                        begin = begin->left_;
+                    } else {
+                        // В другом случае идем в право
+                        begin = begin->right_;
+                    }
+                }
+                return result;
+            }
+
+            /**
+             * @brief Обходит по возрастанию деревья с головами a_head и b_head так же,
+             * как std::set_union и другие алгоритмы над отсортированными диапазонами
+             * @details Для каждого элемента результата вызывается take_a (узел из a) или
+             * take_b (узел из b), для элементов a, не попавших в результат, - skip_a.
+             * Из пары равных элементов в результат идет элемент из a.
+             * Функции только запоминают узлы и не должны менять сами деревья
+             *
+             */
+            template<typename TakeA, typename SkipA, typename TakeB>
+            void walkCombined(tree_node* a_head, tree_node* b_head, SetOperation op,
+                              TakeA take_a, SkipA skip_a, TakeB take_b) const {
+                const bool keep_a = op != SetOperation::Intersection;
+                const bool keep_b = op == SetOperation::Union || op == SetOperation::SymmetricDifference;
+                const bool keep_equal = op == SetOperation::Union || op == SetOperation::Intersection;
+                tree_node* a = a_head->left_;
+                tree_node* b = b_head->left_;
+                auto visit_a = [&](tree_node* node, bool keep) {
+                    if (keep) {
+                        take_a(node);
+                    } else {
+                        skip_a(node);
+                    }
+                };
+                while (a != a_head && b != b_head) {
+                    if (this->comparator_(a->key_, b->key_)) {
+                        visit_a(a, keep_a);
+                        a = a->next();
+                    } else if (this->comparator_(b->key_, a->key_)) {
+                        if (keep_b) {
+                            take_b(b);
+                        }
+                        b = b->next();
+                    } else {
+                        visit_a(a, keep_equal);
+                        a = a->next();
+                        b = b->next();
+                    }
+                }
+                for (; a != a_head; a = a->next()) {
+                    visit_a(a, keep_a);
+                }
+                for (; keep_b && b != b_head; b = b->next()) {
+                    take_b(b);
+                }
+            }
+
+            // Корень поддерева и его черная высота (число черных узлов на пути
+            // от корня до пустой ветки, включая сам корень)
+            struct SubtreePart {
+                tree_node* root_;
+                size_type black_height_;
+            };
+
+            // Черная высота поддерева: на любом пути одинаковая, считаем по левому краю
+            static size_type blackHeight(const tree_node* node) noexcept {
+                size_type result = 0;
+                for (; node != nullptr; node = node->left_) {
+                    if (node->color_ == Black) {
+                        ++result;
+                    }
+                }
+                return result;
+            }
+
+            // Отцепляет поддерево от родителя и красит корень в черный - это не ломает
+            // правила дерева, черная высота просто вырастает на 1
+            static SubtreePart detachRoot(tree_node* root, size_type black_height) noexcept {
+                if (root == nullptr) {
+                    return {nullptr, 0};
+                }
+                root->parent_ = nullptr;
+                if (root->color_ == Red) {
+                    root->color_ = Black;
+                    ++black_height;
+                }
+                return {root, black_height};
+            }
+
+            static SubtreePart detachRoot(tree_node* root) noexcept {
+                return detachRoot(root, blackHeight(root));
+            }
+
+            // left_key <= right_key (при strict - строго меньше)
+            bool notAfter(const Key& left_key, const Key& right_key, bool strict) const {
+                return strict ? this->comparator_(left_key, right_key) : !this->comparator_(right_key, left_key);
+            }
+
+            // Приводит служебный узел к состоянию пустого дерева
+            void resetHead() noexcept {
+                this->head()->parent_ = nullptr;
+                this->head()->left_ = this->head();
+                this->head()->right_ = this->head();
+                this->size_ = 0;
+            }
 
-                        // Узел нужно перекрасить в красный если он был черный,
-                        // даже если он красный ничего страшного не будет
-                        temp->color_ = Red;
+            // Подвешивает к head_ готовое дерево с корнем root
+            void installRoot(tree_node* root, tree_node* min, tree_node* max, size_type size) noexcept {
+                if (root == nullptr) {
+                    this->resetHead();
+                    return;
+                }
+                root->parent_ = this->head();
+                this->head()->parent_ = root;
+                this->head()->left_ = min;
+                this->head()->right_ = max;
+                this->size_ = size;
+            }
 
-                        // Теперь этот узел который отцепили вставляем в this
-                        this->insert(this->head_->parent_, temp, false);
+            /**
+             * @brief Склеивает поддеревья left и right через узел pivot: left < pivot < right
+             * @details Если черные высоты равны, pivot просто становится черным корнем.
+             * Иначе спускаемся по правому краю более высокого левого дерева (или по левому
+             * краю правого) до черного узла с той же черной высотой, что у низкого дерева,
+             * ставим на его место красный pivot, а сам узел и низкое дерево делаем детьми
+             * pivot. Черные высоты при этом не меняются, может появиться только красный
+             * узел под красным - это исправляет обычная балансировка после вставки.
+             * Время O(|bh(left) - bh(right)| + 1). Для балансировки высокое дерево
+             * временно подвешивается к head_, поэтому head_ не должен держать дерево
+             *
+             * @return SubtreePart - корень (черный, без родителя) и черная высота результата
+             */
+            SubtreePart joinParts(SubtreePart left, tree_node* pivot, SubtreePart right) noexcept {
+                pivot->left_ = nullptr;
+                pivot->right_ = nullptr;
+                if (left.black_height_ == right.black_height_) {
+                    pivot->left_ = left.root_;
+                    pivot->right_ = right.root_;
+                    pivot->color_ = Black;
+                    pivot->parent_ = nullptr;
+                    if (left.root_ != nullptr) {
+                        left.root_->parent_ = pivot;
+                    }
+                    if (right.root_ != nullptr) {
+                        right.root_->parent_ = pivot;
+                    }
+                    updateSubtreeSize(pivot);
+                    return {pivot, left.black_height_ + 1};
+                }
 
-                        // Уменьшаем количество элементов(size_) в other
-                        other.size_--;
+                bool left_taller = left.black_height_ > right.black_height_;
+                SubtreePart tall = left_taller ? left : right;
+                SubtreePart low = left_taller ? right : left;
+                this->head()->parent_ = tall.root_;
+                tall.root_->parent_ = this->head();
+
+                // Пропускаем столько черных узлов, на сколько высокое дерево выше низкого
+                size_type skip = tall.black_height_ - low.black_height_;
+                tree_node* parent = this->head();
+                tree_node* node = tall.root_;
+                while (node != nullptr && (node->color_ == Red || skip > 0)) {
+                    if (node->color_ == Black) {
+                        --skip;
                     }
+                    parent = node;
+                    node = left_taller ? node->right_ : node->left_;
+                }
 
-                    // Приводим дерево other по умолчанию как при создании
-                    other.head_->parent_ = nullptr;
-                    other.head_->left_ = other.head_;
-                    other.head_->right_ = other.head_;
+                pivot->color_ = Red;
+                pivot->parent_ = parent;
+                if (left_taller) {
+                    parent->right_ = pivot;
+                    pivot->left_ = node;
+                    pivot->right_ = low.root_;
+                } else {
+                    parent->left_ = pivot;
+                    pivot->right_ = node;
+                    pivot->left_ = low.root_;
+                }
+                if (node != nullptr) {
+                    node->parent_ = pivot;
+                }
+                if (low.root_ != nullptr) {
+                    low.root_->parent_ = pivot;
+                }
+                updateSubtreeSize(pivot);
+                if constexpr (OrderStatistics) {
+                    this->addSubtreeSizeUp(parent, subtreeSize(low.root_) + 1);
                 }
 
+                bool grew = this->balancingAfterInsertion(pivot);
+                tree_node* root = this->head()->parent_;
+                root->parent_ = nullptr;
+                this->head()->parent_ = nullptr;
+                return {root, tall.black_height_ + (grew ? 1 : 0)};
             }
 
             /**
-             * @brief Функция вытаскивает только уникальные эелементы из other.
-             * @details Все эелементы которые не вставились в this остаются в other, поэтому тут
-             * придется потратить не много времени на изьятия узла использовав каждый раз
-             * болансировку после изъятия
+             * @brief Разрезает поддерево node с черной высотой black_height на узлы < key (less)
+             * и >= key (rest)
+             * @details Идем по пути поиска key. Узел пути и его поддерево по другую сторону
+             * от key целиком уходят в одну часть и приклеиваются к тому, что вернул спуск
+             * ниже (joinParts). Высоты склеиваемых кусков растут вдоль пути, поэтому
+             * стоимости склеек складываются в O(log n)
+             *
              */
-            void mergeUnique(BinaryTree& other) {
-                if (this != &other) {
-                    iterator it_other = other.begin();
-                    while (it_other != other.end()) {
-                        // Проверяем есть ли такой элемент в this
-                        if (this->find(it_other.currentNode_->key_) == this->end()) {
-                            // Если он не нашел такого элемента, iterator будет указывать в конец
-                            iterator temp = it_other;
-                            ++it_other;
-                            // Забираем узел из other и
-                            // вставляем в this
-                            tree_node* pick_up_node = other.extractNode(temp);
-                            this->insert(this->head_->parent_, pick_up_node, false);
-                        } else {
-                            // Если нашли такой же узел, значит не трогаем его
-                            // (оставляем его в other и переходим на следующий узел)
-                            ++it_other;
-                        }
-                    }
+            template<typename K>
+            void splitNode(tree_node* node, size_type black_height, const K& key,
+                           SubtreePart& less, SubtreePart& rest) noexcept {
+                if (node == nullptr) {
+                    less = {nullptr, 0};
+                    rest = {nullptr, 0};
+                    return;
+                }
+                size_type child_height = black_height - (node->color_ == Black ? 1 : 0);
+                tree_node* left = node->left_;
+                tree_node* right = node->right_;
+                if (this->comparator_(node->key_, key)) {
+                    SubtreePart right_less;
+                    this->splitNode(right, child_height, key, right_less, rest);
+                    less = this->joinParts(detachRoot(left, child_height), node, right_less);
+                } else {
+                    SubtreePart left_rest;
+                    this->splitNode(left, child_height, key, less, left_rest);
+                    rest = this->joinParts(left_rest, node, detachRoot(right, child_height));
                 }
             }
 
             /**
-             * @brief Функция находит элемент который >= key и возвращает iterator
-             * указывающий на найденный элемент
-             * 
-             * @return iterator - указывает на найденный узел, в противном случае
-             * указывает на end()
+             * @brief Реализация split: элементы >= key переезжают в upper
+             * @details Если аллокаторы равны, upper начинает держать память this (см. sharePool),
+             * и отрезанные узлы перевешиваются прямо в него (см. cutTo). Иначе узлы отрезаются
+             * во временное дерево rest с пулом this, а элементы переносятся в узлы upper; если
+             * перенос бросит исключение, rest приклеивается обратно к this
+             *
              */
-            iterator lowerBound(const_reference key) noexcept {
-                tree_node* result = this->head_;
-                tree_node* begin = this->head_->parent_;
-
-                while (begin != nullptr) {
-                    if (this->comparator_(begin->key_, key)) {
-                        // Если элемент меньше key значит идем в право,
-                        // т.к. справа элементы больше
-                        begin = begin->right_;
+            template<typename K>
+            void splitTo(const K& key, BinaryTree& upper) {
+                if (this == &upper) {
+                    return;
+                }
+                upper.clear();
+                upper.comparator_ = this->comparator_;
+                if (upper.sharePool(*this)) {
+                    this->cutTo(key, upper);
+                    return;
+                }
+                BinaryTree rest(this->comparator_, this->alloc_);
+                rest.sharePool(*this);
+                this->cutTo(key, rest);
+                try {
+                    // Перемещаем, только если перемещение не бросает (или копировать нельзя),
+                    // иначе копируем, чтобы при исключении элементы в rest остались целыми
+                    if constexpr (std::is_nothrow_move_constructible<Key>::value ||
+                                  !std::is_copy_constructible<Key>::value) {
+                        upper.assignSorted(std::make_move_iterator(rest.begin()), std::make_move_iterator(rest.end()));
                     } else {
-                        // Если элемент больше или равен key запоминаем его
-                        result = begin;
-                        // Так как элемент был больше или равен, идем влево
-                        // т.к. слева распологаются элементы меньше текущего
-                        begin = begin->left_;
+                        upper.assignSorted(rest.begin(), rest.end());
                     }
+                } catch (...) {
+                    this->join(rest, false);
+                    throw;
                 }
-                
-                return iterator(result);
             }
 
             /**
-             * @brief Аналогично функции lowerBound только для конст объекта
-             * 
+             * @brief Перевешивает узлы >= key в пустое дерево rest с тем же пулом
+             *
              */
-            const_iterator lowerBound(const_reference key) const noexcept {
-                return const_cast<BinaryTree<Key, Comparator> *>(this)->lowerBound(key);
-            }
+            template<typename K>
+            void cutTo(const K& key, BinaryTree& rest) noexcept {
+                if (this->size_ == 0) {
+                    return;
+                }
 
-            /**
-             * @brief Функция находит элемент который больше key
-             * 
-             * @param key 
-             * @return iterator 
-             */
-            iterator upperBound(const_reference key) noexcept {
-                tree_node* result = this->head_;
-                tree_node* begin = this->head_->parent_;
-                while (begin != nullptr) {
-                    if (this->comparator_(key, begin->key_)) {
-                        // Если значение которое мы ищем меньше значения узла,
-                        // то мы сохраняем этот узел
-                        result = begin;
-                        // Идем влево так как узел был больше искомого
-                        begin = begin->left_;
-                    } else {
-                        // В другом случае идем в право
-                        begin = begin->right_;
+                size_type total = this->size_;
+                tree_node* min = this->head()->left_;
+                tree_node* max = this->head()->right_;
+                SubtreePart whole = detachRoot(this->head()->parent_);
+                this->head()->parent_ = nullptr;
+                SubtreePart less;
+                SubtreePart right;
+                this->splitNode(whole.root_, whole.black_height_, key, less, right);
+
+                this->installRoot(less.root_, min, less.root_ == nullptr ? nullptr : searchRight(less.root_), 0);
+                rest.installRoot(right.root_, right.root_ == nullptr ? nullptr : searchLeft(right.root_), max, 0);
+                size_type less_size = 0;
+                if constexpr (OrderStatistics) {
+                    less_size = subtreeSize(less.root_);
+                } else {
+                    // Идем по обеим частям одновременно, пока меньшая не кончится
+                    tree_node* a = this->head()->left_;
+                    tree_node* b = rest.head()->left_;
+                    size_type steps = 0;
+                    for (; a != this->head() && b != rest.head(); a = a->next(), b = b->next()) {
+                        ++steps;
                     }
+                    less_size = a == this->head() ? steps : total - steps;
+                }
+                if (less.root_ != nullptr) {
+                    this->size_ = less_size;
+                }
+                if (right.root_ != nullptr) {
+                    rest.size_ = total - less_size;
                 }
-                return iterator(result);
             }
 
             /**
-             * @brief Аналогично функции upperBound только для конст объекта
-             * 
+             * @brief Копирует все узлы other в пустое дерево this
+             *
              */
-            const_iterator upperBound(const_reference key) const noexcept {
-                return const_cast<BinaryTree<Key, Comparator> *>(this)->upperBound(key);
+            void copyTreeFrom(const BinaryTree& other) {
+                if (other.size_ > 0) {
+                    // Все узлы копии берутся из одного куска памяти
+                    this->pool().reserve(other.size_);
+                    this->head()->parent_ = this->copyFromNode(other.head()->parent_, this->head());
+                    this->head()->left_ = searchLeft(this->head()->parent_);
+                    this->head()->right_ = searchRight(this->head()->parent_);
+                    this->size_ = other.size_;
+                }
+                this->comparator_ = other.comparator_;
             }
 
             /**
-             * @brief Вставляет новые элеметы в контейнер, если контейнер
-             * не содержит таких ключей
-             * 
-             * @tparam Args 
-             * @param args 
-             * @return vector<std::pair<iterator,bool>> 
+             * @brief Заменяет содержимое дерева элементами из [first, last)
+             * @details Сначала создаем узлы для всех элементов (в порядке следования),
+             * при необходимости сортируем указатели на узлы - так сами элементы не нужно
+             * перемещать (у map ключ константный) - и убираем повторы, потом собираем
+             * дерево через buildFromNodes
+             *
+             * @param unique - оставить только первый из равных элементов
+             * @param sorted - вызывающий гарантирует, что [first, last) уже отсортирован
              */
-            template<typename... Args>
-            std::vector<std::pair<iterator,bool>> emplaceUnique(Args&&... args) {
-                //Создаем вектор, что бы записать результат вставки всех элементов
-                std::vector<std::pair<iterator, bool>> v;
-                //Считаем количество аргументов и создаем память под вектор.
-                //Это делается для того, чтоб каждый раз при вставке элемента
-                //память не перевыделялась
-                v.reserve(sizeof...(args));
-                //Начинаем вставлять элементы
-                for (auto element : {std::forward<Args>(args)...}) {
-                    //Создаем объект который будем вставлять
-                    tree_node* new_node = new tree_node(std::move(element));
-                    //Вставляем элемент и записываем результат
-                    std::pair<iterator, bool> result = this->insert(this->head_->parent_, new_node, true);
-                    //Проверяем вставился элемент или нет
-                    if (result.second == false) {
-                        //Если элемент не вставился - надо его удалить
-                        delete new_node;
-                    }
-                    v.push_back(result);
+            template<typename InputIt>
+            void assignRange(InputIt first, InputIt last, bool unique, bool sorted) {
+                this->clear();
+                std::vector<tree_node*> nodes;
+                if (std::is_base_of<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>::value) {
+                    nodes.reserve(static_cast<size_type>(std::distance(first, last)));
+                    this->pool().reserve(nodes.capacity());
                 }
-                return v;
+                try {
+                    for (; first != last; ++first) {
+                        nodes.push_back(nullptr);
+                        nodes.back() = this->createNode(*first);
+                    }
+                } catch (...) {
+                    for (tree_node* node : nodes) {
+                        this->destroyNode(node);
+                    }
+                    throw;
+                }
+
+                auto less = [this](const tree_node* a, const tree_node* b) {
+                    return this->comparator_(a->key_, b->key_);
+                };
+                if (!sorted && !std::is_sorted(nodes.begin(), nodes.end(), less)) {
+                    std::stable_sort(nodes.begin(), nodes.end(), less);
+                }
+
+                if (unique && !nodes.empty()) {
+                    // Узлы уже по возрастанию: повтор может быть только равен последнему оставленному
+                    size_type kept = 1;
+                    for (size_type i = 1; i < nodes.size(); ++i) {
+                        if (this->comparator_(nodes[kept - 1]->key_, nodes[i]->key_)) {
+                            nodes[kept++] = nodes[i];
+                        } else {
+                            this->destroyNode(nodes[i]);
+                        }
+                    }
+                    nodes.resize(kept);
+                }
+                this->buildFromNodes(nodes);
             }
 
             /**
-             * @brief Аналогично emplaceUnique только вставляет все элементы
-             * 
-             * @tparam Args 
-             * @param args 
-             * @return vector<std::pair<iterator,bool>> 
+             * @brief Собирает пустое дерево из узлов, уже идущих по возрастанию
+             * @details Корнем поддерева становится средний узел, левая и правая половины
+             * собираются так же рекурсивно. Размеры половин отличаются не больше чем на 1,
+             * поэтому все пустые ветки (NIL) лежат на глубине h или h + 1, где
+             * h = floor(log2(n + 1)). Красим в красный только узлы на глубине h
+             * (если нижний уровень не заполнен целиком), остальные черные - тогда
+             * черная высота у всех путей одинаковая, а у красных узлов нет детей.
+             * Время O(n), ни одного сравнения и поворота
+             *
              */
-            template<typename... Args>
-            std::vector<std::pair<iterator,bool>> emplace(Args&&... args) {
-                //Создаем вектор, что бы записать результат вставки всех элементов
-                std::vector<std::pair<iterator, bool>> v;
-                //Считаем количество аргументов и создаем память под вектор.
-                //Это делается для того, чтоб каждый раз при вставке элемента
-                //память не перевыделялась
-                v.reserve(sizeof...(args));
-                //Начинаем вставлять элементы
-                for (auto element : {std::forward<Args>(args)...}) {
-                    //Создаем объект который будем вставлять
-                    tree_node* new_node = new tree_node(std::move(element));
-                    //Вставляем элемент и записываем результат
-                    v.push_back(this->insert(this->head_->parent_, new_node, false));
+            void buildFromNodes(const std::vector<tree_node*>& nodes) noexcept {
+                if (nodes.empty()) {
+                    return;
                 }
-                return v;
+                size_type red_depth = 0;
+                for (size_type n = nodes.size() + 1; n > 1; n /= 2) {
+                    ++red_depth;
+                }
+                tree_node* root = this->buildSubtree(nodes, 0, nodes.size(), 0, red_depth);
+                root->parent_ = this->head();
+                this->head()->parent_ = root;
+                this->head()->left_ = nodes.front();
+                this->head()->right_ = nodes.back();
+                this->size_ = nodes.size();
             }
 
+            // Собирает поддерево из nodes[begin, end), depth - глубина его корня
+            tree_node* buildSubtree(const std::vector<tree_node*>& nodes, size_type begin, size_type end,
+                                    size_type depth, size_type red_depth) noexcept {
+                if (begin == end) {
+                    return nullptr;
+                }
+                size_type middle = begin + (end - begin) / 2;
+                tree_node* node = nodes[middle];
+                node->color_ = depth == red_depth ? Red : Black;
+                node->left_ = this->buildSubtree(nodes, begin, middle, depth + 1, red_depth);
+                node->right_ = this->buildSubtree(nodes, middle + 1, end, depth + 1, red_depth);
+                if (node->left_ != nullptr) {
+                    node->left_->parent_ = node;
+                }
+                if (node->right_ != nullptr) {
+                    node->right_->parent_ = node;
+                }
+                if constexpr (OrderStatistics) {
+                    node->subtree_size_ = end - begin;
+                }
+                return node;
+            }
 
-            /*----------------------------------------------------------------------------------*/
+            /**
+             * @brief Меняет местами содержимое деревьев вместе с пулами и аллокаторами
+             *
+             */
+            void swapTree(BinaryTree& other) noexcept {
+                this->swapHeads(other);
+                std::swap(this->comparator_, other.comparator_);
+                std::swap(this->alloc_, other.alloc_);
+                this->pool_.swap(other.pool_);
+            }
 
-        private:
+            // Меняет местами узлы, подвешенные к служебным узлам this и other
+            void swapHeads(BinaryTree& other) noexcept {
+                tree_node* root = this->head()->parent_;
+                tree_node* min = this->head()->left_;
+                tree_node* max = this->head()->right_;
+                size_type size = this->size_;
+                this->installRoot(other.head()->parent_, other.head()->left_, other.head()->right_, other.size_);
+                other.installRoot(root, min, max, size);
+            }
 
             /**
-             * @brief Метод для копирования узлов начиная от copiedNode рекурсивно
+             * @brief Метод для копирования узлов начиная от copiedNode
+             * @details Без рекурсии: идем по исходному дереву и копии одновременно.
+             * Из узла спускаемся в еще не скопированного ребенка (у копии на его месте
+             * пока nullptr), а когда оба ребенка готовы - поднимаемся по parent_.
+             * Дополнительной памяти не нужно, глубина дерева не ограничена стеком.
+             * Если копирование ключа бросит исключение, уже созданные узлы удаляются
              * 
              * @return tree_node* - возвращает новый копированный узел
              */
             tree_node* copyFromNode(tree_node* copiedNode, tree_node* parent) {
-                tree_node* copy = new tree_node(copiedNode->key_, copiedNode->color_);
-                if (copiedNode->left_ != nullptr) {
-                    copy->left_ = copyFromNode(copiedNode->left_, copy);
+                tree_node* root = this->copyNodeData(copiedNode);
+                root->parent_ = parent;
+                tree_node* source = copiedNode;
+                tree_node* copy = root;
+                try {
+                    while (true) {
+                        if (source->left_ != nullptr && copy->left_ == nullptr) {
+                            copy->left_ = this->copyNodeData(source->left_);
+                            copy->left_->parent_ = copy;
+                            source = source->left_;
+                            copy = copy->left_;
+                        } else if (source->right_ != nullptr && copy->right_ == nullptr) {
+                            copy->right_ = this->copyNodeData(source->right_);
+                            copy->right_->parent_ = copy;
+                            source = source->right_;
+                            copy = copy->right_;
+                        } else if (source == copiedNode) {
+                            break;
+                        } else {
+                            source = source->parent_;
+                            copy = copy->parent_;
+                        }
+                    }
+                } catch (...) {
+                    this->destroyNodes(root);
+                    throw;
                 }
+                return root;
+            }
 
-                if (copiedNode->right_ != nullptr) {
-                    copy->right_ = copyFromNode(copiedNode->right_, copy);
+            // Создает узел с копией ключа, цвета и размера поддерева node, без связей
+            tree_node* copyNodeData(const tree_node* node) {
+                tree_node* copy = this->createNode(node->key_, node->color_);
+                if constexpr (OrderStatistics) {
+                    copy->subtree_size_ = node->subtree_size_;
                 }
-                copy->parent_ = parent;
                 return copy;
             }
 
@@ -555,14 +1686,18 @@ namespace s21 {
                     // Когда удаляемый узел красный без детей, мы просто его удаляем
                     // никаких действий не требуется
 
+                    // Теперь deleteNode - лист, все повороты позади: его больше нет
+                    // в поддеревьях всех предков
+                    this->addSubtreeSizeUp(deleteNode->parent_, static_cast<size_type>(-1));
+
                     // Извлекаем узел из дерева
-                    if (this->head_->parent_ == deleteNode) {
+                    if (this->head()->parent_ == deleteNode) {
                         // Если узел deleteNode является корнем, значит он единственный
                         // элемент дерева, нам нужно служебный узел привести к изначальному
                         // состоянию
-                        this->head_->left_ = this->head_;
-                        this->head_->right_ = this->head_;
-                        this->head_->parent_ = nullptr;
+                        this->head()->left_ = this->head();
+                        this->head()->right_ = this->head();
+                        this->head()->parent_ = nullptr;
                     } else {
                         // Во всех других случаях отцепляем ссылки родителя
                         if (deleteNode->parent_->left_ == deleteNode) {
@@ -573,14 +1708,14 @@ namespace s21 {
 
                         // Если удаляемый эелемент был самым большим
                         // ищем новый
-                        if (this->head_->right_ == deleteNode) {
-                            this->head_->right_ = searchRight(this->head_->parent_);
+                        if (this->head()->right_ == deleteNode) {
+                            this->head()->right_ = searchRight(this->head()->parent_);
                         }
 
                         // Если удаляемый элемент был самым маленьким
                         // ищем новый
-                        if (this->head_->left_ == deleteNode) {
-                            this->head_->left_ = searchLeft(this->head_->parent_);
+                        if (this->head()->left_ == deleteNode) {
+                            this->head()->left_ = searchLeft(this->head()->parent_);
                         }
                     }
 
@@ -613,7 +1748,7 @@ namespace s21 {
                 // Проверка будет в цикле, так как из ситуации может возникнуть
                 // потребность перейти на следующую итерации цикла для перехода к другой ситуации,
                 // ну или пока дерево не кончится
-                while (checkNode != this->head_->parent_ && checkNode->color_ == Black) {
+                while (checkNode != this->head()->parent_ && checkNode->color_ == Black) {
                     if (checkNode == parent->left_) {
                         // Элемент checkNode находится слева от родителя
                         // sibling - второй ребенок parent
@@ -733,8 +1868,8 @@ namespace s21 {
                 }
 
                 // Проверим, deleteNode является корнем дерева
-                if (deleteNode == this->head_->parent_) {
-                    this->head_->parent_ = node;
+                if (deleteNode == this->head()->parent_) {
+                    this->head()->parent_ = node;
                 } else {
                     // Меняем указатель на узел deleteNode у родтеля deleteNode
                     if (deleteNode->parent_->left_ == deleteNode) {
@@ -749,6 +1884,10 @@ namespace s21 {
                 std::swap(deleteNode->right_, node->right_);
                 std::swap(deleteNode->color_, node->color_);
                 std::swap(deleteNode->parent_, node->parent_);
+                if constexpr (OrderStatistics) {
+                    // Размер поддерева - свойство места в дереве, а не узла
+                    std::swap(deleteNode->subtree_size_, node->subtree_size_);
+                }
 
                 // Mеняем родителей у потомков
                 if (node->left_ != nullptr) {
@@ -800,11 +1939,14 @@ namespace s21 {
             std::pair<iterator, bool> insert(tree_node* root, tree_node* new_node, bool unique) {
                 tree_node* node = root;
                 tree_node* parent = nullptr;
+                // в какую сторону от parent мы спустились последний раз
+                bool left = false;
 
                 // Ищем место для вставки. Нам нужно дойти до пустого узла...
                 while (node != nullptr) {
                     parent = node;
-                    if (this->comparator_(new_node->key_, node->key_)) {
+                    left = this->comparator_(new_node->key_, node->key_);
+                    if (left) {
                         node = node->left_;
                     } else {
                         // Проверка выключен ли флаг unique
@@ -825,34 +1967,133 @@ namespace s21 {
 
                 // Вставляем узел, parent уже будет указывать на узел, new_node будет потомком для узла parent.
                 // Parent так же может указывать и на nullptr, значит дерево пустое и new_node становится корнем дерева
-                if (parent != nullptr) {
-                    new_node->parent_ = parent;
-                    // Проверяем в какую сторону кладем new_node
-                    if (this->comparator_(new_node->key_, parent->key_)) {
-                        parent->left_ = new_node;
+                return {this->linkNode(parent, left, new_node), true};
+            }
+
+            /**
+             * @brief Ищет место для уникального ключа key за один спуск
+             * 
+             * @param left - сюда пишем, с какой стороны от родителя встанет ключ
+             * @return pair<tree_node*, bool> - {узел с таким же ключом, true}, если ключ уже есть,
+             * иначе {будущий родитель, false} (nullptr - дерево пустое)
+             */
+            template<typename K>
+            std::pair<tree_node*, bool> searchUniquePos(const K& key, bool& left) const {
+                tree_node* node = this->head()->parent_;
+                tree_node* parent = nullptr;
+                while (node != nullptr) {
+                    parent = node;
+                    if (this->comparator_(key, node->key_)) {
+                        left = true;
+                        node = node->left_;
+                    } else if (this->comparator_(node->key_, key)) {
+                        left = false;
+                        node = node->right_;
                     } else {
-                        parent->right_ = new_node;
+                        return {node, true};
+                    }
+                }
+                return {parent, false};
+            }
+
+            /**
+             * @brief Встраивает узел new_node рядом с подсказкой hint
+             * @details Элемент должен встать между предыдущим элементом и hint (или между hint
+             * и следующим элементом). Проверяем это двумя сравнениями с соседями, и если
+             * все так - подвешиваем узел в пустую ветку одного из соседей: у двух соседних
+             * в порядке обхода узлов одна из этих веток всегда пустая (если у prev есть правое
+             * поддерево, то hint - его самый левый узел, и у hint нет левого ребенка).
+             * Если подсказка неверна - обычная вставка со спуском от корня.
+             * Для unique == true при равенстве с hint вставки не будет.
+             *
+             * @return pair<iterator, bool> - как у insert(root, new_node, unique)
+             */
+            std::pair<iterator, bool> insertHint(const_iterator hint, tree_node* new_node, bool unique) {
+                tree_node* pos = const_cast<tree_node*>(hint.currentNode_);
+                const Key& key = new_node->key_;
+
+                if (pos == this->head()) {
+                    // Подсказка end(): элемент должен быть больше (для multi - не меньше) максимального
+                    tree_node* last = this->head()->right_;
+                    if (this->size_ > 0 &&
+                        (unique ? this->comparator_(last->key_, key) : !this->comparator_(key, last->key_))) {
+                        return {this->linkNode(last, false, new_node), true};
+                    }
+                } else if (this->comparator_(key, pos->key_) || (!unique && !this->comparator_(pos->key_, key))) {
+                    // Элемент встает перед pos
+                    if (pos == this->head()->left_) {
+                        return {this->linkNode(pos, true, new_node), true};
+                    }
+                    tree_node* before = pos->prev();
+                    if (unique ? this->comparator_(before->key_, key) : !this->comparator_(key, before->key_)) {
+                        if (before->right_ == nullptr) {
+                            return {this->linkNode(before, false, new_node), true};
+                        }
+                        return {this->linkNode(pos, true, new_node), true};
+                    }
+                } else if (this->comparator_(pos->key_, key)) {
+                    // Элемент встает после pos
+                    if (pos == this->head()->right_) {
+                        return {this->linkNode(pos, false, new_node), true};
+                    }
+                    tree_node* after = pos->next();
+                    if (unique ? this->comparator_(key, after->key_) : !this->comparator_(after->key_, key)) {
+                        if (pos->right_ == nullptr) {
+                            return {this->linkNode(pos, false, new_node), true};
+                        }
+                        return {this->linkNode(after, true, new_node), true};
                     }
                 } else {
-                    // Дерево пустое, значит new_node корень
-                    new_node->color_ = Black;
-                    new_node->parent_ = this->head_;
-                    this->head_->parent_ = new_node;
+                    // Такой ключ уже есть - это и есть hint
+                    return {iterator(pos), false};
                 }
-                this->size_++;
 
-                // Надо обновить указатель на самый маленький и самый большой элемент
-                if (this->head_->left_ == this->head_ || this->head_->left_->left_ != nullptr) {
-                    this->head_->left_ = new_node;
+                // Подсказка не подошла
+                return this->insert(this->head()->parent_, new_node, unique);
+            }
+
+            /**
+             * @brief Подвешивает new_node ребенком к parent (слева, если left == true)
+             * @details Соответствующая ветка parent должна быть пустой. Обновляет
+             * указатели на самый маленький и самый большой элементы и балансирует дерево.
+             * parent == nullptr - дерево пустое, new_node становится корнем
+             *
+             * @return iterator - указывает на new_node
+             */
+            iterator linkNode(tree_node* parent, bool left, tree_node* new_node) {
+                if constexpr (OrderStatistics) {
+                    // Узел мог прийти из другого дерева (merge) со старым размером
+                    new_node->subtree_size_ = 1;
+                }
+                if (parent == nullptr) {
+                    new_node->color_ = Black;
+                    new_node->parent_ = this->head();
+                    this->head()->parent_ = new_node;
+                    this->head()->left_ = new_node;
+                    this->head()->right_ = new_node;
+                    this->size_++;
+                    return iterator(new_node);
                 }
-                if (this->head_->right_ == this->head_ || this->head_->right_->right_ != nullptr) {
-                    this->head_->right_ = new_node;
+                new_node->parent_ = parent;
+                if (left) {
+                    parent->left_ = new_node;
+                    if (this->head()->left_ == parent) {
+                        this->head()->left_ = new_node;
+                    }
+                } else {
+                    parent->right_ = new_node;
+                    if (this->head()->right_ == parent) {
+                        this->head()->right_ = new_node;
+                    }
                 }
+                this->size_++;
+                // Новый узел теперь есть в поддеревьях всех своих предков
+                this->addSubtreeSizeUp(parent, 1);
 
                 // После того как мы вставили узел, нам нужно выполнить балансировку дерева
                 balancingAfterInsertion(new_node);
 
-                return {iterator(new_node), true};
+                return iterator(new_node);
             }
 
 
@@ -870,11 +2111,13 @@ namespace s21 {
              * 1. 3 случая, когда дядя справа у деда
              * 2. 3 случая, когда дядя слева у деда
              * На самомом деле случая всего 3, остальные просто отражают первые 3 случая
+             *
+             * @return true - перекраска дошла до корня и черная высота дерева выросла на 1
              */
-            void balancingAfterInsertion(tree_node* node) {
+            bool balancingAfterInsertion(tree_node* node) {
                 tree_node* parent = node->parent_;
                 // можно сделать рекурсией, но мы знаем что любую рекурсиию можно заменить цклом :)
-                while (node != this->head_->parent_ && parent->color_ == Red) {
+                while (node != this->head()->parent_ && parent->color_ == Red) {
                     tree_node* g_parent = parent->parent_;
                     // Дядя справа у деда
                     if (g_parent->left_ == parent) {
@@ -941,7 +2184,9 @@ namespace s21 {
                 }
                 
                 // Корень всегда останется черным после наших манипуляций
-                this->head_->parent_->color_ = Black;
+                bool grew = this->head()->parent_->color_ == Red;
+                this->head()->parent_->color_ = Black;
+                return grew;
             }
 
 
@@ -954,8 +2199,8 @@ namespace s21 {
                 tree_node *pivotNode = node->right_;
                 pivotNode->parent_ = node->parent_;
 
-                if (this->head_->parent_ == node) {
-                    this->head_->parent_ = pivotNode;
+                if (this->head()->parent_ == node) {
+                    this->head()->parent_ = pivotNode;
                 } else if (node->parent_->left_ == node) {
                     node->parent_->left_ = pivotNode;
                 } else {
@@ -970,6 +2215,12 @@ namespace s21 {
 
                 node->parent_ = pivotNode;
                 pivotNode->left_ = node;
+
+                // Опорный элемент занимает место node вместе с размером его поддерева
+                if constexpr (OrderStatistics) {
+                    pivotNode->subtree_size_ = node->subtree_size_;
+                }
+                updateSubtreeSize(node);
             }
 
             /**
@@ -982,8 +2233,8 @@ namespace s21 {
 
                 pivotNode->parent_ = node->parent_;
 
-                if (this->head_->parent_ == node) {
-                    this->head_->parent_ = pivotNode;
+                if (this->head()->parent_ == node) {
+                    this->head()->parent_ = pivotNode;
                 } else if (node->parent_->left_ == node) {
                     node->parent_->left_ = pivotNode;
                 } else {
@@ -997,25 +2248,127 @@ namespace s21 {
 
                 node->parent_ = pivotNode;
                 pivotNode->right_ = node;
+
+                if constexpr (OrderStatistics) {
+                    pivotNode->subtree_size_ = node->subtree_size_;
+                }
+                updateSubtreeSize(node);
             }
 
-            // Удаляет узлы начиная от node рекурсивно
+            // Удаляет узлы поддерева node без рекурсии: спускаемся в ребенка, сразу
+            // отцепляя его от родителя, а лист удаляем и поднимаемся к родителю
             void destroyNodes(tree_node* node) noexcept {
-                // условие выхода из рекурсии
                 if (node == nullptr) { return; }
-                destroyNodes(node->left_);
-                destroyNodes(node->right_);
-                delete node;
+                tree_node* stop = node->parent_;
+                while (node != stop) {
+                    tree_node* next;
+                    if (node->left_ != nullptr) {
+                        next = node->left_;
+                        node->left_ = nullptr;
+                    } else if (node->right_ != nullptr) {
+                        next = node->right_;
+                        node->right_ = nullptr;
+                    } else {
+                        next = node->parent_;
+                        this->destroyNode(node);
+                    }
+                    node = next;
+                }
+            }
+
+            // Возвращает пул узлов дерева
+            node_pool& pool() noexcept {
+                return this->pool_;
+            }
+
+            // Служебный узел дерева
+            tree_node* head() const noexcept {
+                return &this->head_;
+            }
+
+            /**
+             * @brief Забирает память пула other, когда все узлы other переезжают в this
+             * @details Вызывать, только если other после операции останется пустым (merge, join):
+             * пул this начинает держать склады кусков other и забирает его свободные ячейки
+             * (см. NodePool::absorb). Если аллокаторы деревьев не равны, забрать память нельзя.
+             * Бросить может только резерв места под ссылки на склады - до любых изменений
+             *
+             * @return true - память забрана, узлы other можно перевешивать в this как есть
+             * @return false - узлы other надо перемещать в новые узлы из пула this
+             */
+            bool absorbPool(BinaryTree& other) {
+                return this->pool().absorb(other.pool());
+            }
+
+            /**
+             * @brief Дает this право держать узлы из памяти other, other остается со своими узлами
+             * @details Для операций, после которых в other что-то остается (mergeUnique, split):
+             * пул this тоже держит склады кусков other (см. NodePool::share), а свободные
+             * ячейки у каждого пула свои
+             *
+             * @return true - узлы other можно перевешивать в this как есть
+             * @return false - аллокаторы не равны, узлы надо перемещать в новые узлы
+             */
+            bool sharePool(const BinaryTree& other) {
+                return this->pool_.share(other.pool_);
+            }
+
+            /**
+             * @brief Готовит узел node, вынутый из other, к вставке в this
+             * @details Если память пула other уже у this, узел переезжает как есть. Иначе перемещаем
+             * ключ в новый узел из своего пула, а старый узел уничтожаем в other
+             *
+             */
+            tree_node* adoptNode(BinaryTree& other, tree_node* node, bool shared) {
+                if (shared) {
+                    return node;
+                }
+                tree_node* new_node = this->createNode(std::move(node->key_));
+                other.destroyNode(node);
+                return new_node;
+            }
+
+            /**
+             * @brief Создает узел в памяти из пула
+             * @details Если конструктор ключа бросит исключение, ячейку возвращаем в пул
+             *
+             */
+            template<typename... Args>
+            tree_node* createNode(Args&&... args) {
+                tree_node* node = this->pool().allocate();
+                try {
+                    node_traits::construct(this->alloc_, node, std::forward<Args>(args)...);
+                } catch (...) {
+                    this->pool().deallocate(node);
+                    throw;
+                }
+                return node;
             }
 
+            // Уничтожает узел и возвращает его память в пул
+            void destroyNode(tree_node* node) noexcept {
+                if (node != nullptr) {
+                    node_traits::destroy(this->alloc_, node);
+                    this->pool().deallocate(node);
+                }
+            }
+
+            // Размер поддерева узла, хранится только при OrderStatistics == true
+            struct NodeSubtreeSize {
+                size_type subtree_size_ = 1;
+            };
+
+            // Пустая база: без OrderStatistics узел не растет
+            struct NodeNoSubtreeSize {};
+
             /**
              * @brief Класс узла, который будет хранится в дереве
              * 
              */
-            class BinaryTreeNode {
+            class BinaryTreeNode : public std::conditional_t<OrderStatistics, NodeSubtreeSize, NodeNoSubtreeSize> {
                 public:
                     // Конструктор для создания головы дерева (head_)
-                    BinaryTreeNode() : key_(Key{}) {
+                    BinaryTreeNode() noexcept(IsNothrowHeadKey<Key>::value) : key_() {
                         this->left_ = this;
                         this->right_ = this;
                         this->parent_ = nullptr;
@@ -1032,7 +2385,7 @@ namespace s21 {
 
                     // Конструктор для создания узла с значением и цветом
                     // В основном использую для копирования узлов
-                    BinaryTreeNode(Key key, colorRB color) : key_(key) {
+                    BinaryTreeNode(const Key& key, colorRB color) : key_(key) {
                         this->left_ = nullptr;
                         this->right_ = nullptr;
                         this->parent_ = nullptr;
@@ -1048,6 +2401,16 @@ namespace s21 {
                         this->color_ = Red;
                     }
 
+                    // Конструктор, который создает значение прямо в узле из аргументов
+                    // конструктора Key, без временного объекта
+                    template<typename... Args>
+                    explicit BinaryTreeNode(std::in_place_t, Args&&... args) : key_(std::forward<Args>(args)...) {
+                        this->left_ = nullptr;
+                        this->right_ = nullptr;
+                        this->parent_ = nullptr;
+                        this->color_ = Red;
+                    }
+
                     /**
                      * @brief функция возвращает iterator на следующий узел относитльно this
                      * @details у функции стоит const это делается для const_iterator, иначе компилятор будет ругаться,
@@ -1131,10 +2494,17 @@ namespace s21 {
             class BinaryTreeIterator {
                 friend BinaryTree;
                 public:
+                    // Типы для std::iterator_traits, чтобы итератор работал со стандартными алгоритмами
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = Key;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = Key*;
+                    using reference = Key&;
+
                     // Пустой итератор нам не нужен - удаляем конструктор по умолчанию
                     BinaryTreeIterator() = delete;
 
-                    reference operator*() {
+                    reference operator*() const {
                         return this->currentNode_->key_;
                     }
 
@@ -1197,6 +2567,12 @@ namespace s21 {
                     return it1.currentNode_ != it2.currentNode_;
                 }
                 public:
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using value_type = Key;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const Key*;
+                    using reference = const Key&;
+
                     // Пустой итератор нам не нужен - удаляем конструктор по умолчанию
                     BinaryTreeConstIterator() = delete;
 
@@ -1231,19 +2607,39 @@ namespace s21 {
                     }
 
                 private:
+                    BinaryTreeConstIterator(const tree_node* node) {
+                        this->currentNode_ = node;
+                    }
+
                     const tree_node* currentNode_;
             };
 
             /*---------------------------------------------------------------*/
-            // указатель на голову (служебный узел)
-            tree_node* head_;
+            // голова (служебный узел) лежит в самом дереве, поэтому пустое дерево ничего
+            // не выделяет; mutable - end() const-дерева тоже указывает на нее
+            mutable tree_node head_;
             // количество элементов в дереве
             size_type size_;
             // компоратор для сравнивания элементов
             // используем чтоб можно было в s21_map переопределить на наш компаратор
             // для сравнения ключей
             Comparator comparator_;
+            // аллокатор, перепривязанный на тип узла
+            node_allocator alloc_;
+            // пул, из которого берутся узлы (память пула может быть общей с другими деревьями)
+            node_pool pool_;
     }; // BinaryTree;
+
+    /**
+     * @brief Политика дерева для map, set и multiset: красно-черное BinaryTree
+     * @details Контейнеры берут тип дерева как TreePolicy::tree<...>, поэтому движок
+     * выбирается параметром шаблона. Другой движок - BTreePolicy из s21_btree.h
+     *
+     */
+    struct RedBlackTreePolicy {
+        template<typename Key, typename Comparator, typename Allocator, bool OrderStatistics>
+        using tree = BinaryTree<Key, Comparator, Allocator, OrderStatistics>;
+    };
 } // s21
 
 
@@ -0,0 +1,604 @@
+#ifndef SRC_S21_UNORDERED_MAP_H_
+#define SRC_S21_UNORDERED_MAP_H_
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "s21_hash_table.h"
+
+namespace s21 {
+    /**
+     * @brief unordered_map - словарь без порядка ключей: хеш-таблица вместо дерева
+     * @details Интерфейс как у s21::map (at, operator[], try_emplace, insert_or_assign,
+     * contains, merge, ...), но поиск, вставка и удаление в среднем O(1), а обход идет
+     * в порядке ячеек таблицы, не по возрастанию ключей. Реализована через HashTable
+     * (открытая адресация, группы по 16 ячеек), ее устройство смотрите в s21_hash_table.h.
+     *
+     * Пары лежат прямо в массиве таблицы. Когда таблица растет, а при удалении -
+     * соседние элементы, пары переезжают: итераторы и ссылки на них становятся
+     * недействительными (у s21::map ссылки живут до удаления элемента)
+     *
+     * @tparam Key - тип ключа
+     * @tparam T - тип значения
+     * @tparam Hash - хеш ключей
+     * @tparam KeyEqual - сравнение ключей на равенство
+     * @tparam Allocator - аллокатор пар ключ-значение
+     */
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<std::pair<const Key, T>>>
+    class unordered_map {
+        class MapHasherMy;
+        class MapKeyEqualMy;
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using table = HashTable<value_type, MapHasherMy, MapKeyEqualMy, Allocator>;
+        using size_type = std::size_t;
+        // Таблица хеширует и сравнивает пары только по ключу - как MapComparatorMy у map
+        class MapHasherMy {
+            public:
+                MapHasherMy() = default;
+                explicit MapHasherMy(const Hash& hash) : hash_(hash) {}
+
+                std::size_t operator()(const_reference v) const {
+                    return this->hash_(v.first);
+                }
+
+                // Хеш ключа (K - Key или тип, который понимает прозрачный Hash)
+                template<typename K>
+                std::size_t operator()(const K& key) const {
+                    return this->hash_(key);
+                }
+
+                // хеш ключей пользователя
+                Hash hash_;
+        };
+
+        class MapKeyEqualMy {
+            public:
+                MapKeyEqualMy() = default;
+                explicit MapKeyEqualMy(const KeyEqual& equal) : equal_(equal) {}
+
+                bool operator()(const_reference v1, const_reference v2) const {
+                    return this->equal_(v1.first, v2.first);
+                }
+
+                template<typename K>
+                bool operator()(const_reference v, const K& key) const {
+                    return this->equal_(v.first, key);
+                }
+
+                // сравнение ключей пользователя
+                KeyEqual equal_;
+        };
+
+        public:
+            using iterator = typename table::iterator;
+            using const_iterator = typename table::const_iterator;
+            using hasher = Hash;
+            using key_equal = KeyEqual;
+            using allocator_type = Allocator;
+
+            /*------------------constructors and operators unordered_map----------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустой словарь без памяти
+             *
+             */
+            unordered_map() : table_() {}
+
+            /**
+             * @brief Создает пустой словарь, рассчитанный на bucket_count элементов
+             *
+             * @param bucket_count
+             * @param hash
+             * @param equal
+             * @param alloc
+             */
+            explicit unordered_map(size_type bucket_count, const Hash& hash = Hash(),
+                                   const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+                : table_(MapHasherMy(hash), MapKeyEqualMy(equal), alloc) {
+                this->table_.reserve(bucket_count);
+            }
+
+            /**
+             * @brief Создает пустой словарь с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit unordered_map(const Allocator& alloc) : table_(alloc) {}
+
+            /**
+             * @brief Конструктор списка инициализаторов, создает словарь
+             * @details Из равных ключей остается первый
+             *
+             * @param items
+             */
+            unordered_map(std::initializer_list<value_type> const &items, const Hash& hash = Hash(),
+                          const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+                : unordered_map(items.begin(), items.end(), hash, equal, alloc) {}
+
+            /**
+             * @brief Конструктор из диапазона [first, last)
+             * @details Для итераторов с несколькими проходами место резервируется сразу,
+             * таблица не растет по ходу. Из равных ключей остается первый
+             *
+             * @tparam InputIt - итератор
+             * @param first
+             * @param last
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            unordered_map(InputIt first, InputIt last, const Hash& hash = Hash(),
+                          const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+                : table_(MapHasherMy(hash), MapKeyEqualMy(equal), alloc) {
+                if (std::is_base_of<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>::value) {
+                    this->table_.reserve(static_cast<size_type>(std::distance(first, last)));
+                }
+                for (; first != last; ++first) {
+                    this->insert(*first);
+                }
+            }
+
+            /**
+             * @brief Конструктор копирования
+             *
+             * @param m
+             */
+            unordered_map(const unordered_map &m) : table_(m.table_) {}
+
+            /**
+             * @brief Конструктор перемещения
+             *
+             * @param m
+             */
+            unordered_map(unordered_map &&m) noexcept(std::is_nothrow_move_constructible<table>::value) : table_(std::move(m.table_)) {}
+
+            /**
+             * @brief Деструктор будет дефолдным
+             * @details table_ сама себя почистит
+             *
+             */
+            ~unordered_map() = default;
+
+            /**
+             * @brief Перегрузка оператора присваивания копированием
+             *
+             * @param m
+             * @return unordered_map&
+             */
+            unordered_map& operator=(const unordered_map &m) {
+                this->table_ = m.table_;
+                return *this;
+            }
+
+            /**
+             * @brief Перегрузка оператора присваивания перемещением
+             *
+             * @param m
+             * @return unordered_map&
+             */
+            unordered_map& operator=(unordered_map &&m) {
+                this->table_ = std::move(m.table_);
+                return *this;
+            }
+
+            /*------------------------------------------------------------------------------*/
+
+            /*------------------------methods unordered_map-------------------------*/
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой
+             * @details Если такого элемента нет, значит будет исключение
+             *
+             * @param key
+             * @return T&
+             */
+            mapped_type& at(const Key& key) {
+                iterator it = this->table_.find(key);
+                if (it == this->table_.end())
+                    throw std::out_of_range("s21::unordered_map::at: no such element exists");
+
+                return (*it).second;
+            }
+
+            /**
+             * @brief Доступ к указанному элементу с проверкой
+             * @details Для конст объекта
+             *
+             * @param key
+             * @return T&
+             */
+            const mapped_type& at(const Key& key) const {
+                return const_cast<unordered_map*>(this)->at(key);
+            }
+
+            /**
+             * @brief Аналогично at, но ключ может быть любого типа, который понимают Hash и KeyEqual
+             * @details Доступно, только если у Hash и KeyEqual есть is_transparent -
+             * так можно искать std::string по std::string_view без временных объектов
+             *
+             * @param key
+             * @return T&
+             */
+            template<typename K, typename H = Hash, typename E = KeyEqual,
+                     typename = typename H::is_transparent, typename = typename E::is_transparent>
+            mapped_type& at(const K& key) {
+                iterator it = this->table_.find(key);
+                if (it == this->table_.end())
+                    throw std::out_of_range("s21::unordered_map::at: no such element exists");
+
+                return (*it).second;
+            }
+
+            /**
+             * @brief Аналогично at(const K&) для конст объекта
+             *
+             * @param key
+             * @return T&
+             */
+            template<typename K, typename H = Hash, typename E = KeyEqual,
+                     typename = typename H::is_transparent, typename = typename E::is_transparent>
+            const mapped_type& at(const K& key) const {
+                return const_cast<unordered_map*>(this)->at(key);
+            }
+
+            /**
+             * @brief Получить доступ или вставить указанный элемент
+             * @details Если такого ключа нет, он вставляется с дефолдным значением,
+             * ключ ищется один раз
+             *
+             * @param key
+             * @return mapped_type&
+             */
+            mapped_type& operator[](const Key& key) {
+                return (*this->try_emplace(key).first).second;
+            }
+
+            /**
+             * @brief Аналогично operator[](const Key&), но ключ перемещается в новый элемент
+             *
+             * @param key
+             * @return mapped_type&
+             */
+            mapped_type& operator[](Key&& key) {
+                return (*this->try_emplace(std::move(key)).first).second;
+            }
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->table_.get_allocator();
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             *
+             * @return iterator
+             */
+            iterator begin() noexcept {
+                return this->table_.begin();
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator begin() const noexcept {
+                return this->table_.begin();
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             *
+             * @return iterator
+             */
+            iterator end() noexcept {
+                return this->table_.end();
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             * @details Для конст объекта
+             *
+             * @return const_iterator
+             */
+            const_iterator end() const noexcept {
+                return this->table_.end();
+            }
+
+            /**
+             * @brief Проверяет, пуст ли контейнер
+             *
+             * @return true - контейнер пуст
+             * @return false - контейнер не пуст
+             */
+            bool empty() const noexcept {
+                return this->table_.empty();
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                return this->table_.size();
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             *
+             * @return size_type
+             */
+            size_type max_size() const noexcept {
+                return this->table_.max_size();
+            }
+
+            /**
+             * @brief Очищает содержимое контейнера
+             * @details Память таблицы остается за контейнером
+             *
+             */
+            void clear() noexcept {
+                this->table_.clear();
+            }
+
+            /**
+             * @brief Готовит таблицу к count элементам, чтобы вставки до этого размера
+             * не перестраивали ее
+             *
+             * @param count
+             */
+            void reserve(size_type count) {
+                this->table_.reserve(count);
+            }
+
+            /**
+             * @brief Перестраивает таблицу под не меньше count ячеек
+             * @details rehash(0) сжимает таблицу до минимально нужной
+             *
+             * @param count
+             */
+            void rehash(size_type count) {
+                this->table_.rehash(count);
+            }
+
+            /**
+             * @brief Возвращает количество ячеек таблицы
+             *
+             * @return size_type
+             */
+            size_type bucket_count() const noexcept {
+                return this->table_.bucketCount();
+            }
+
+            /**
+             * @brief Возвращает долю занятых ячеек
+             *
+             * @return float
+             */
+            float load_factor() const noexcept {
+                return this->table_.loadFactor();
+            }
+
+            /**
+             * @brief вставляет элемент и возвращает итератор туда, где элемент находится
+             * в контейнере, и логическое значение, обозначающее, имела ли место вставка
+             *
+             * @param value
+             * @return std::pair<iterator, bool>
+             */
+            std::pair<iterator, bool> insert(const value_type& value) {
+                return this->table_.emplaceUniqueKey(value.first, value);
+            }
+
+            /**
+             * @brief вставляет значение по ключу и возвращает итератор туда, где элемент находится в контейнере,
+             * и логическое значение, обозначающее, имела ли место вставка
+             *
+             * @param key
+             * @param obj
+             * @return std::pair<iterator, bool>
+             */
+            std::pair<iterator, bool> insert(const Key& key, const mapped_type& obj) {
+                return this->table_.emplaceUniqueKey(key, key, obj);
+            }
+
+            /**
+             * @brief Вставляет элемент с ключом key, если такого ключа еще нет
+             * @details Ключ ищется один раз. Значение создается прямо в ячейке из args
+             * и только если вставка действительно будет, иначе args не трогаются
+             *
+             * @tparam Args
+             * @param key
+             * @param args - аргументы конструктора mapped_type
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с ключом key,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+                return this->table_.emplaceUniqueKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                                     std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            /**
+             * @brief Аналогично try_emplace(const Key&, Args&&...), но ключ перемещается в новый элемент
+             *
+             * @tparam Args
+             * @param key
+             * @param args
+             * @return std::pair<iterator, bool>
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+                // Ключ хешируется и сравнивается до того, как его переместят в ячейку
+                return this->table_.emplaceUniqueKey(key, std::piecewise_construct,
+                                                     std::forward_as_tuple(std::move(key)),
+                                                     std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            /**
+             * @brief Вставляет элемент или присваивает значение текущему элементу, если ключ уже существует
+             *
+             * @param key
+             * @param obj
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с ключом key,
+             * bool - была ли вставка
+             */
+            std::pair<iterator, bool> insert_or_assign(const Key& key, const mapped_type& obj) {
+                std::pair<iterator, bool> result = this->table_.emplaceUniqueKey(key, key, obj);
+                if (!result.second)
+                    (*result.first).second = obj;
+                return result;
+            }
+
+            /**
+             * @brief Стирает элемент в позиции
+             * @details Итераторы на другие элементы могут стать недействительными
+             * (см. HashTable::erase)
+             *
+             * @param pos
+             */
+            void erase(iterator pos) {
+                this->table_.erase(pos);
+            }
+
+            /**
+             * @brief Меняет содержимое
+             *
+             * @param other
+             */
+            void swap(unordered_map& other) noexcept {
+                this->table_.swap(other.table_);
+            }
+
+            /**
+             * @brief Переносит из other элементы с ключами, которых нет в this
+             * @details Элементы с ключами, которые уже есть в this, остаются в other
+             *
+             * @param other
+             */
+            void merge(unordered_map& other) {
+                this->table_.mergeUnique(other.table_);
+            }
+
+            /**
+             * @brief Проверяет, есть ли элемент с ключом, эквивалентным ключу в контейнере
+             *
+             * @param key
+             * @return true - есть элемент в контенере
+             * @return false - нет эдемента в контейнере
+             */
+            bool contains(const Key& key) const {
+                return this->table_.find(key) != this->table_.end();
+            }
+
+            /**
+             * @brief Аналогично contains для ключа любого типа, который понимают Hash и KeyEqual
+             * @details Доступно, только если у Hash и KeyEqual есть is_transparent
+             *
+             * @param key
+             * @return true - есть элемент в контенере
+             * @return false - нет эдемента в контейнере
+             */
+            template<typename K, typename H = Hash, typename E = KeyEqual,
+                     typename = typename H::is_transparent, typename = typename E::is_transparent>
+            bool contains(const K& key) const {
+                return this->table_.find(key) != this->table_.end();
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             *
+             * @param key
+             * @return iterator - указывает на найденный элемент или на end()
+             */
+            iterator find(const Key& key) {
+                return this->table_.find(key);
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             * @details Для конст объекта
+             *
+             * @param key
+             * @return const_iterator
+             */
+            const_iterator find(const Key& key) const {
+                return this->table_.find(key);
+            }
+
+            /**
+             * @brief Аналогично find для ключа любого типа, который понимают Hash и KeyEqual
+             * @details Доступно, только если у Hash и KeyEqual есть is_transparent
+             *
+             * @param key
+             * @return iterator
+             */
+            template<typename K, typename H = Hash, typename E = KeyEqual,
+                     typename = typename H::is_transparent, typename = typename E::is_transparent>
+            iterator find(const K& key) {
+                return this->table_.find(key);
+            }
+
+            /**
+             * @brief Аналогично find(const K&) для конст объекта
+             *
+             * @param key
+             * @return const_iterator
+             */
+            template<typename K, typename H = Hash, typename E = KeyEqual,
+                     typename = typename H::is_transparent, typename = typename E::is_transparent>
+            const_iterator find(const K& key) const {
+                return this->table_.find(key);
+            }
+
+            /**
+             * @brief Создает элемент из аргументов его конструктора
+             * и вставляет его, если в контейнере нет такого ключа
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return std::pair<iterator, bool> - iterator указывает на элемент с таким ключом,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                return this->table_.emplaceUnique(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Вставляет новые элеметы в контейнер, если контейнер
+             * не содержит таких ключей
+             * @details Каждый аргумент - отдельный элемент. Место резервируется
+             * заранее, поэтому все итераторы результата действительны
+             *
+             * @tparam Args
+             * @param args
+             * @return std::vector<std::pair<iterator,bool>>
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insert_many(Args&&... args) {
+                return this->table_.insertManyUnique(std::forward<Args>(args)...);
+            }
+
+        private:
+            table table_;
+
+    }; // unordered_map
+} // s21
+
+#endif //SRC_S21_UNORDERED_MAP_H_
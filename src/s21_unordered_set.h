@@ -0,0 +1,382 @@
+#ifndef SRC_S21_UNORDERED_SET_H_
+#define SRC_S21_UNORDERED_SET_H_
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "s21_hash_table.h"
+
+namespace s21 {
+    /**
+     * @brief unordered_set - множество уникальных элементов без порядка: хеш-таблица вместо дерева
+     * @details Интерфейс как у s21::set (без операций, которым нужен порядок), поиск,
+     * вставка и удаление в среднем O(1). Реализовано через HashTable, ее устройство
+     * смотрите в s21_hash_table.h. Итераторы становятся недействительными при росте
+     * таблицы и при удалении элементов
+     *
+     * @tparam Key - тип элемента
+     * @tparam Hash - хеш элементов
+     * @tparam KeyEqual - сравнение элементов на равенство
+     * @tparam Allocator - аллокатор элементов
+     */
+    template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<Key>>
+    class unordered_set {
+        using key_type = Key;
+        using value_type = Key;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using table = HashTable<Key, Hash, KeyEqual, Allocator>;
+        using size_type = std::size_t;
+        public:
+            // Элементы менять нельзя - изменится хеш, поэтому оба итератора константные
+            using iterator = typename table::const_iterator;
+            using const_iterator = typename table::const_iterator;
+            using hasher = Hash;
+            using key_equal = KeyEqual;
+            using allocator_type = Allocator;
+
+            /*------------------constructors and operators unordered_set----------------------*/
+
+            /**
+             * @brief Конструктор по умолчанию, создает пустой набор без памяти
+             *
+             */
+            unordered_set() : table_() {}
+
+            /**
+             * @brief Создает пустой набор, рассчитанный на bucket_count элементов
+             *
+             * @param bucket_count
+             * @param hash
+             * @param equal
+             * @param alloc
+             */
+            explicit unordered_set(size_type bucket_count, const Hash& hash = Hash(),
+                                   const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+                : table_(hash, equal, alloc) {
+                this->table_.reserve(bucket_count);
+            }
+
+            /**
+             * @brief Создает пустой набор с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit unordered_set(const Allocator& alloc) : table_(alloc) {}
+
+            /**
+             * @brief Конструктор списка инициализаторов, создает набор
+             *
+             * @param items
+             */
+            unordered_set(std::initializer_list<value_type> const &items, const Hash& hash = Hash(),
+                          const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+                : unordered_set(items.begin(), items.end(), hash, equal, alloc) {}
+
+            /**
+             * @brief Конструктор из диапазона [first, last)
+             * @details Для итераторов с несколькими проходами место резервируется сразу
+             *
+             * @tparam InputIt - итератор
+             * @param first
+             * @param last
+             */
+            template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+            unordered_set(InputIt first, InputIt last, const Hash& hash = Hash(),
+                          const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+                : table_(hash, equal, alloc) {
+                if (std::is_base_of<std::forward_iterator_tag,
+                                    typename std::iterator_traits<InputIt>::iterator_category>::value) {
+                    this->table_.reserve(static_cast<size_type>(std::distance(first, last)));
+                }
+                for (; first != last; ++first) {
+                    this->insert(*first);
+                }
+            }
+
+            /**
+             * @brief Конструктор копирования
+             *
+             * @param s
+             */
+            unordered_set(const unordered_set &s) : table_(s.table_) {}
+
+            /**
+             * @brief Конструктор перемещения
+             *
+             * @param s
+             */
+            unordered_set(unordered_set &&s) noexcept(std::is_nothrow_move_constructible<table>::value) : table_(std::move(s.table_)) {}
+
+            /**
+             * @brief Деструктор будет дефолдным
+             * @details table_ сама себя почистит
+             *
+             */
+            ~unordered_set() = default;
+
+            /**
+             * @brief Перегрузка оператора присваивания копированием
+             *
+             * @param s
+             * @return unordered_set&
+             */
+            unordered_set& operator=(const unordered_set &s) {
+                this->table_ = s.table_;
+                return *this;
+            }
+
+            /**
+             * @brief Перегрузка оператора присваивания перемещением
+             *
+             * @param s
+             * @return unordered_set&
+             */
+            unordered_set& operator=(unordered_set &&s) {
+                this->table_ = std::move(s.table_);
+                return *this;
+            }
+
+            /*------------------------------------------------------------------------*/
+
+            /*------------------------methods unordered_set-------------------------*/
+
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->table_.get_allocator();
+            }
+
+            /**
+             * @brief Возвращает итератор в начало
+             *
+             * @return iterator
+             */
+            iterator begin() const noexcept {
+                return this->table_.begin();
+            }
+
+            /**
+             * @brief Возвращает итератор в конец
+             *
+             * @return iterator
+             */
+            iterator end() const noexcept {
+                return this->table_.end();
+            }
+
+            /**
+             * @brief Проверяет, пуст ли контейнер
+             *
+             * @return true - контейнер пуст
+             * @return false - контейнер не пуст
+             */
+            bool empty() const noexcept {
+                return this->table_.empty();
+            }
+
+            /**
+             * @brief Возвращает количество элементов
+             *
+             * @return size_type
+             */
+            size_type size() const noexcept {
+                return this->table_.size();
+            }
+
+            /**
+             * @brief Возвращает максимально возможное количество элементов
+             *
+             * @return size_type
+             */
+            size_type max_size() const noexcept {
+                return this->table_.max_size();
+            }
+
+            /**
+             * @brief Очищает содержимое контейнера
+             * @details Память таблицы остается за контейнером
+             *
+             */
+            void clear() noexcept {
+                this->table_.clear();
+            }
+
+            /**
+             * @brief Готовит таблицу к count элементам
+             *
+             * @param count
+             */
+            void reserve(size_type count) {
+                this->table_.reserve(count);
+            }
+
+            /**
+             * @brief Перестраивает таблицу под не меньше count ячеек
+             * @details rehash(0) сжимает таблицу до минимально нужной
+             *
+             * @param count
+             */
+            void rehash(size_type count) {
+                this->table_.rehash(count);
+            }
+
+            /**
+             * @brief Возвращает количество ячеек таблицы
+             *
+             * @return size_type
+             */
+            size_type bucket_count() const noexcept {
+                return this->table_.bucketCount();
+            }
+
+            /**
+             * @brief Возвращает долю занятых ячеек
+             *
+             * @return float
+             */
+            float load_factor() const noexcept {
+                return this->table_.loadFactor();
+            }
+
+            /**
+             * @brief Вставляет элемент, если такого еще нет
+             *
+             * @param value
+             * @return std::pair<iterator, bool> - iterator указывает на элемент, равный value,
+             * bool - была ли вставка
+             */
+            std::pair<iterator, bool> insert(const value_type& value) {
+                return this->table_.emplaceUniqueKey(value, value);
+            }
+
+            /**
+             * @brief Аналогично insert(const value_type&), но элемент перемещается
+             *
+             * @param value
+             * @return std::pair<iterator, bool>
+             */
+            std::pair<iterator, bool> insert(value_type&& value) {
+                return this->table_.emplaceUniqueKey(value, std::move(value));
+            }
+
+            /**
+             * @brief Стирает элемент в позиции
+             * @details Итераторы на другие элементы могут стать недействительными
+             *
+             * @param pos
+             */
+            void erase(iterator pos) {
+                this->table_.erase(pos);
+            }
+
+            /**
+             * @brief Меняет содержимое
+             *
+             * @param other
+             */
+            void swap(unordered_set& other) noexcept {
+                this->table_.swap(other.table_);
+            }
+
+            /**
+             * @brief Переносит из other элементы, которых нет в this
+             *
+             * @param other
+             */
+            void merge(unordered_set& other) {
+                this->table_.mergeUnique(other.table_);
+            }
+
+            /**
+             * @brief Находит элемент с определенным ключом
+             *
+             * @param key
+             * @return iterator - если элемента нет в контейнере - итератор
+             * будет указывать на end()
+             */
+            iterator find(const Key& key) const {
+                return this->table_.find(key);
+            }
+
+            /**
+             * @brief Аналогично find для ключа любого типа, который понимают Hash и KeyEqual
+             * @details Доступно, только если у Hash и KeyEqual есть is_transparent
+             *
+             * @param key
+             * @return iterator
+             */
+            template<typename K, typename H = Hash, typename E = KeyEqual,
+                     typename = typename H::is_transparent, typename = typename E::is_transparent>
+            iterator find(const K& key) const {
+                return this->table_.find(key);
+            }
+
+            /**
+             * @brief Проверяет, содержит ли контейнер элемент с определенным ключом
+             *
+             * @param key
+             * @return true - в контейнере есть этот элемент
+             * @return false - в контенер нет этого элемента
+             */
+            bool contains(const Key& key) const {
+                return this->table_.find(key) != this->table_.end();
+            }
+
+            /**
+             * @brief Аналогично contains для ключа любого типа, который понимают Hash и KeyEqual
+             * @details Доступно, только если у Hash и KeyEqual есть is_transparent
+             *
+             * @param key
+             * @return true - есть такой элемент
+             * @return false - нет такого элемента
+             */
+            template<typename K, typename H = Hash, typename E = KeyEqual,
+                     typename = typename H::is_transparent, typename = typename E::is_transparent>
+            bool contains(const K& key) const {
+                return this->table_.find(key) != this->table_.end();
+            }
+
+            /**
+             * @brief Создает элемент из аргументов его конструктора
+             * и вставляет его, если в контейнере нет такого же
+             *
+             * @tparam Args - аргументы конструктора элемента
+             * @param args
+             * @return std::pair<iterator, bool> - iterator указывает на элемент, равный новому,
+             * bool - была ли вставка
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                return this->table_.emplaceUnique(std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief Вставляет новые элеметы в контейнер, если контейнер
+             * не содержит таких же
+             * @details Каждый аргумент - отдельный элемент, итераторы результата действительны
+             *
+             * @tparam Args
+             * @param args
+             * @return std::vector<std::pair<iterator,bool>>
+             */
+            template<typename... Args>
+            std::vector<std::pair<iterator,bool>> insert_many(Args&&... args) {
+                auto inserted = this->table_.insertManyUnique(std::forward<Args>(args)...);
+                return std::vector<std::pair<iterator, bool>>(inserted.begin(), inserted.end());
+            }
+
+        private:
+            table table_;
+
+    }; // unordered_set
+} // s21
+
+#endif //SRC_S21_UNORDERED_SET_H_
@@ -1,8 +1,14 @@
 #ifndef SRC_S21_VECTOR_H_
 #define SRC_S21_VECTOR_H_
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <initializer_list>
 #include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "s21_debug.h"
 
 
 namespace s21 {
@@ -11,14 +17,20 @@ namespace s21 {
      * @brief Вектор - это последовательный контейнер, не требующий ручного
      * контроля памяти.
      * @details  Динамическое изменение размера массива происходит не при каждом добавлении или
-     * удалении элемента, а только в случае превышения размера заданного размера буфера
+     * удалении элемента, а только в случае превышения размера заданного размера буфера.
+     * Память под буфер берется у аллокатора Allocator через std::allocator_traits.
+     * Буфер - сырая память: объекты живут только в первых size_ ячейках,
+     * остальные capacity_ - size_ ячеек не создаются до вставки.
      * 
      * @tparam T 
+     * @tparam Allocator - аллокатор элементов
      */
-    template<typename T>
+    template<typename T, typename Allocator = std::allocator<T>>
     class vector {
+        using alloc_traits = std::allocator_traits<Allocator>;
         public:
             using value_type = T;
+            using allocator_type = Allocator;
             using reference = T&;
             using const_reference = const T&;
             using iterator = T*;
@@ -30,7 +42,14 @@ namespace s21 {
              * @brief Конструктор по умолчанию, создает пустой вектор
              * 
              */
-            vector() {
+            vector() : vector(Allocator()) {}
+
+            /**
+             * @brief Создает пустой вектор с заданным аллокатором
+             *
+             * @param alloc
+             */
+            explicit vector(const Allocator& alloc) : alloc_(alloc) {
                 this->size_ = 0;
                 this->capacity_ = 0;
                 this->buffer_ = nullptr;
@@ -41,10 +60,16 @@ namespace s21 {
              * 
              * @param n 
              */
-            explicit vector(size_type n) {
-                this->size_ = n;
+            explicit vector(size_type n, const Allocator& alloc = Allocator()) : vector(alloc) {
+                this->buffer_ = this->allocateBuffer(n);
                 this->capacity_ = n;
-                this->buffer_ = new value_type[this->capacity_];
+                try {
+                    for (; this->size_ < n; this->size_++)
+                        alloc_traits::construct(this->alloc_, this->buffer_ + this->size_);
+                } catch (...) {
+                    this->freeBuffer();
+                    throw;
+                }
             }
 
             /**
@@ -53,29 +78,32 @@ namespace s21 {
              * 
              * @param items 
              */
-            vector(std::initializer_list<value_type> const &items) {
-                this->size_ = items.size();
+            vector(std::initializer_list<value_type> const &items, const Allocator& alloc = Allocator())
+                : vector(alloc) {
+                this->buffer_ = this->allocateBuffer(items.size());
                 this->capacity_ = items.size();
-                this->buffer_ = new value_type[this->capacity_];
-                std::copy(items.begin(), items.end(), this->buffer_);
+                this->copyConstruct(items.begin(), items.end());
             }
 
             /**
              * @brief Конструктор копирования
+             * @details Аллокатор для копии выбирает сам аллокатор (select_on_container_copy_construction)
              * 
              * @param v 
              */
-            vector(const vector& v) : vector() {
+            vector(const vector& v) : vector(alloc_traits::select_on_container_copy_construction(v.alloc_)) {
                 *this = v;
             }
 
             /**
              * @brief Конструктор перемещения
+             * @details Не бросает исключений: вектор векторов при росте перемещает
+             * элементы, а не копирует (см. std::move_if_noexcept в relocate)
              * 
              * @param v 
              */
-            vector(vector&& v) : vector() {
-                *this = std::move(v);
+            vector(vector&& v) noexcept : vector(v.alloc_) {
+                this->swap(v);
             }
 
             /**
@@ -83,7 +111,7 @@ namespace s21 {
              * 
              */
             ~vector() {
-                delete[] this->buffer_;
+                this->freeBuffer();
             }
 
             /**
@@ -94,33 +122,48 @@ namespace s21 {
              */
             vector& operator=(const vector& v) {
                 if (this != &v) {
-                    delete[] this->buffer_;
-                    this->size_ = v.size_;
-                    this->capacity_ = v.capacity_;
-                    if (this->size_ > 0) {
-                        this->buffer_ = new value_type[v.capacity_];
-                        std::copy(v.begin(), v.end(), this->buffer_);
+                    this->freeBuffer();
+                    if (alloc_traits::propagate_on_container_copy_assignment::value) {
+                        this->alloc_ = v.alloc_;
+                    }
+                    if (v.size_ > 0) {
+                        this->buffer_ = this->allocateBuffer(v.capacity_);
+                        this->capacity_ = v.capacity_;
+                        this->copyConstruct(v.begin(), v.end());
                     }
-
                 }
                 return *this;
             }
 
             /**
              * @brief Перегрузка оператора присваивания перемещением
+             * @details Если аллокаторы не равны и аллокатор не переезжает вместе
+             * с содержимым, забрать чужой буфер нельзя - перемещаем элементы по одному
              * 
              * @param v 
              * @return vector& 
              */
             vector& operator=(vector&& v) {
                 if (this != &v) {
-                    delete[] this->buffer_;
-                    this->size_ = v.size_;
-                    this->capacity_ = v.capacity_;
-                    this->buffer_ = v.buffer_;
-                    v.buffer_ = nullptr;
-                    v.capacity_ = 0;
-                    v.size_ = 0;
+                    if (alloc_traits::propagate_on_container_move_assignment::value || this->alloc_ == v.alloc_) {
+                        this->freeBuffer();
+                        if (alloc_traits::propagate_on_container_move_assignment::value) {
+                            this->alloc_ = std::move(v.alloc_);
+                        }
+                        this->size_ = v.size_;
+                        this->capacity_ = v.capacity_;
+                        this->buffer_ = v.buffer_;
+                        v.buffer_ = nullptr;
+                        v.capacity_ = 0;
+                        v.size_ = 0;
+                    } else {
+                        this->clear();
+                        this->reserve(v.size_);
+                        for (size_type i = 0; i < v.size_; i++) {
+                            this->emplace_back(std::move(v.buffer_[i]));
+                        }
+                        v.clear();
+                    }
                 }
                 return *this;
             }
@@ -129,6 +172,15 @@ namespace s21 {
 
             /*-----------------------------------------methods vector-----------------------------------------------*/
             
+            /**
+             * @brief Возвращает копию аллокатора
+             *
+             * @return allocator_type
+             */
+            allocator_type get_allocator() const noexcept {
+                return this->alloc_;
+            }
+
             /**
              * @brief Доступ к указанному элементу с проверкой границ
              * 
@@ -157,24 +209,27 @@ namespace s21 {
             }
 
             /**
-             * @brief Доступ к указанному элементу
+             * @brief Доступ к указанному элементу без проверки границ
+             * @details Проверка только в сборке с S21_CONTAINERS_DEBUG (см. s21_debug.h)
              * 
              * @param pos 
              * @return reference 
              */
             reference operator[](size_type pos) {
-                return this->at(pos);
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::vector::operator[]: The index is out of range");
+                return this->buffer_[pos];
             }
 
             /**
-             * @brief Доступ к указанному элементу
+             * @brief Доступ к указанному элементу без проверки границ
              * @details Для конст объекта
              * 
              * @param pos 
              * @return const_reference 
              */
             const_reference operator[](size_type pos) const {
-                return this->at(pos);
+                S21_DEBUG_ASSERT(pos < this->size_, "s21::vector::operator[]: The index is out of range");
+                return this->buffer_[pos];
             }
 
             /**
@@ -352,10 +407,11 @@ namespace s21 {
 
             /**
              * @brief Очищает содержимое
-             * @details 
+             * @details Элементы уничтожаются, память остается за вектором
              * 
              */
             void clear() noexcept {
+                this->destroyRange(this->begin(), this->end());
                 this->size_ = 0;
             }
 
@@ -364,21 +420,11 @@ namespace s21 {
              * и возвращает итератор, указывающий на новый элемент
              * @details если capacity_ == size_ то делаем реалок на 
              * size_ * 2, если контейнер пуст - выделяем память на 1 элемент
+             * (см. emplace)
              * 
              */
             iterator insert(const_iterator pos, const_reference value) {
-                size_type index = pos - this->begin();
-                if (index > this->size_)
-                    throw std::out_of_range("s21::vector::insert Unable to insert into a position out of range of begin to end");
-                
-                if (this->size_ == this->capacity_)
-                    this->reallocVector(this->size_ ? this->size_ * 2 : 1);
-                
-                iterator it_begin = this->begin();
-                std::copy(it_begin + index, this->end(), it_begin + index + 1);
-                *(this->buffer_ + index) = value;
-                this->size_++;
-                return it_begin + index;
+                return this->emplace(pos, value);
             }
 
             /**
@@ -389,18 +435,7 @@ namespace s21 {
              * @return iterator 
              */
             iterator insert(const_iterator pos, value_type &&value) {
-                size_type index = pos - this->begin();
-                if (index > this->size_)
-                    throw std::out_of_range("s21::vector::insert Unable to insert into a position out of range of begin to end");
-                
-                if (this->size_ == this->capacity_)
-                    this->reallocVector(this->size_ ? this->size_ * 2 : 1);
-                
-                iterator it_begin = this->begin();
-                std::copy(it_begin + index, this->end(), it_begin + index + 1);
-                *(this->buffer_ + index) = std::move(value);
-                this->size_++;
-                return it_begin + index;
+                return this->emplace(pos, std::move(value));
             }
 
             /**
@@ -413,7 +448,8 @@ namespace s21 {
                 if (index > this->size_)
                     throw std::out_of_range("s21::vector::insert Unable to insert into a position out of range of begin to end");
 
-                std::copy(const_cast<iterator>(pos) + 1, this->end(), this->buffer_ + index);
+                std::move(const_cast<iterator>(pos) + 1, this->end(), this->buffer_ + index);
+                alloc_traits::destroy(this->alloc_, this->end() - 1);
                 this->size_--;
             }
 
@@ -423,7 +459,7 @@ namespace s21 {
              * @param value 
              */
             void push_back(const_reference value) {
-                this->insert(this->end(), value);
+                this->emplace_back(value);
             }
 
             /**
@@ -432,7 +468,7 @@ namespace s21 {
              * @param value 
              */
             void push_back(value_type &&value) {
-                this->insert(this->end(), std::move(value));
+                this->emplace_back(std::move(value));
             }
 
             /**
@@ -443,6 +479,7 @@ namespace s21 {
                 if (this->size_ == 0)
                     throw std::out_of_range("s21::vector::pop_back: nothing to delete...");
                 
+                alloc_traits::destroy(this->alloc_, this->end() - 1);
                 this->size_--;
             }
 
@@ -451,30 +488,106 @@ namespace s21 {
              * 
              * @param other 
              */
-            void swap(vector& other) {
+            void swap(vector& other) noexcept {
+                if (alloc_traits::propagate_on_container_swap::value) {
+                    std::swap(this->alloc_, other.alloc_);
+                }
                 std::swap(this->buffer_, other.buffer_);
                 std::swap(this->size_, other.size_);
                 std::swap(this->capacity_, other.capacity_);
             }
 
             /**
-             * @brief Вставляет новые элементы в контейнер непосредственно перед pos
+             * @brief Создает новый элемент из args непосредственно перед pos
+             * @details В конец элемент создается прямо в памяти вектора (см. emplace_back).
+             * В середину - сначала во временном объекте (args могут ссылаться на элементы
+             * самого вектора, которые сейчас сдвинутся), потом последний элемент
+             * перемещается в свободную ячейку, остальные сдвигаются перемещением
+             * и новый элемент перемещается на свое место
              * 
-             * @tparam Args 
+             * @tparam Args - аргументы конструктора элемента
              * @param pos 
              * @param args 
-             * @return iterator 
+             * @return iterator - указывает на новый элемент
              */
             template<typename... Args>
             iterator emplace(const_iterator pos, Args&&... args) {
-                auto index_pos = pos - this->begin();
-                iterator it_res;
-                // Чтоб insert постоянно не вызывал realloc, мы сразу
-                // выделим то количество, которое нужно
-                this->reserve(this->capacity_ + sizeof...(args));
-                for (auto element : {std::forward<Args>(args)...}) {
-                    it_res = this->insert(this->begin() + index_pos++, std::move(element));
+                size_type index = pos - this->begin();
+                if (index > this->size_)
+                    throw std::out_of_range("s21::vector::insert Unable to insert into a position out of range of begin to end");
+
+                if (index == this->size_) {
+                    this->emplace_back(std::forward<Args>(args)...);
+                    return this->begin() + index;
+                }
+
+                value_type value(std::forward<Args>(args)...);
+                if (this->size_ == this->capacity_)
+                    this->reallocVector(this->size_ * 2);
+
+                iterator it_begin = this->begin();
+                iterator it_end = this->end();
+                alloc_traits::construct(this->alloc_, it_end, std::move(*(it_end - 1)));
+                this->size_++;
+                std::move_backward(it_begin + index, it_end - 1, it_end);
+                *(it_begin + index) = std::move(value);
+                return it_begin + index;
+            }
+
+            /**
+             * @brief Создает новый элемент из args в конце контейнера
+             * @details Элемент создается сразу в памяти вектора. Если памяти не хватает,
+             * новый элемент создается в новом буфере до переноса старых элементов,
+             * так что args могут ссылаться на элементы самого вектора
+             * 
+             * @tparam Args - аргументы конструктора элемента
+             * @param args 
+             * @return reference - новый элемент
+             */
+            template<typename... Args>
+            reference emplace_back(Args&&... args) {
+                if (this->size_ == this->capacity_) {
+                    size_type new_capacity = this->size_ ? this->size_ * 2 : 1;
+                    iterator tmp = this->allocateBuffer(new_capacity);
+                    try {
+                        alloc_traits::construct(this->alloc_, tmp + this->size_, std::forward<Args>(args)...);
+                    } catch (...) {
+                        alloc_traits::deallocate(this->alloc_, tmp, new_capacity);
+                        throw;
+                    }
+                    try {
+                        this->relocate(tmp);
+                    } catch (...) {
+                        alloc_traits::destroy(this->alloc_, tmp + this->size_);
+                        alloc_traits::deallocate(this->alloc_, tmp, new_capacity);
+                        throw;
+                    }
+                    this->replaceBuffer(tmp, new_capacity);
+                } else {
+                    alloc_traits::construct(this->alloc_, this->buffer_ + this->size_, std::forward<Args>(args)...);
                 }
+                return this->buffer_[this->size_++];
+            }
+
+            /**
+             * @brief Вставляет новые элементы в контейнер непосредственно перед pos
+             * @details Каждый аргумент - отдельный элемент, порядок сохраняется.
+             * Память под все элементы выделяем сразу
+             * 
+             * @tparam Args 
+             * @param pos 
+             * @param args 
+             * @return iterator - указывает на последний вставленный элемент
+             */
+            template<typename... Args>
+            iterator insert_many(const_iterator pos, Args&&... args) {
+                size_type index = pos - this->begin();
+                if (index > this->size_)
+                    throw std::out_of_range("s21::vector::insert Unable to insert into a position out of range of begin to end");
+
+                this->reserve(this->size_ + sizeof...(args));
+                iterator it_res = this->begin() + index;
+                ((it_res = this->emplace(this->begin() + index++, std::forward<Args>(args))), ...);
                 return it_res;
             }
 
@@ -485,32 +598,139 @@ namespace s21 {
              * @param args 
              */
             template<typename... Args>
-            void emplace_back(Args&&... args) {
-                for (auto element : {std::forward<Args>(args)...}) {
-                    this->push_back(std::move(element));
-                }
+            void insert_many_back(Args&&... args) {
+                this->reserve(this->size_ + sizeof...(args));
+                (this->emplace_back(std::forward<Args>(args)), ...);
             }
 
 
         private:
+            Allocator alloc_;
             size_type size_;
             size_type capacity_;
             iterator buffer_;
 
             /**
-             * @brief Приватная функция для переопределения памяти, копирования
-             * в нову память и удаление старой памяти
+             * @brief Выделяет у аллокатора сырой буфер на n элементов
+             * @details Объекты в буфере не создаются
+             *
+             * @param n
+             * @return iterator - новый буфер (nullptr если n == 0)
+             */
+            iterator allocateBuffer(size_type n) {
+                if (n == 0)
+                    return nullptr;
+
+                return alloc_traits::allocate(this->alloc_, n);
+            }
+
+            /**
+             * @brief Уничтожает объекты в [first, last)
+             *
+             * @param first
+             * @param last
+             */
+            void destroyRange(iterator first, iterator last) noexcept {
+                if (!std::is_trivially_destructible<value_type>::value) {
+                    for (; first != last; ++first)
+                        alloc_traits::destroy(this->alloc_, first);
+                }
+            }
+
+            /**
+             * @brief Уничтожает элементы и возвращает буфер аллокатору,
+             * вектор остается пустым
+             *
+             */
+            void freeBuffer() noexcept {
+                if (this->buffer_ == nullptr)
+                    return;
+
+                this->destroyRange(this->begin(), this->end());
+                alloc_traits::deallocate(this->alloc_, this->buffer_, this->capacity_);
+                this->buffer_ = nullptr;
+                this->size_ = 0;
+                this->capacity_ = 0;
+            }
+
+            /**
+             * @brief Копирует [first, last) в сырой буфер пустого вектора
+             * @details Если конструктор копирования бросит исключение,
+             * уже созданные элементы и буфер освобождаются
+             *
+             * @param first
+             * @param last
+             */
+            template<typename InputIt>
+            void copyConstruct(InputIt first, InputIt last) {
+                try {
+                    for (; first != last; ++first, this->size_++)
+                        alloc_traits::construct(this->alloc_, this->buffer_ + this->size_, *first);
+                } catch (...) {
+                    this->freeBuffer();
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Переносит size_ элементов в сырой буфер dst
+             * @details Тривиально копируемые типы переносятся одним memcpy.
+             * Остальные перемещаются, только если перемещение не бросает исключений,
+             * иначе копируются (std::move_if_noexcept) - при ошибке старый буфер
+             * остается нетронутым, созданные в dst элементы уничтожаются.
+             * Старые элементы не уничтожаются (см. replaceBuffer)
+             *
+             * @param dst
+             */
+            void relocate(iterator dst) {
+                if (this->size_ == 0)
+                    return;
+
+                if (std::is_trivially_copyable<value_type>::value) {
+                    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(this->buffer_),
+                                this->size_ * sizeof(value_type));
+                    return;
+                }
+                size_type i = 0;
+                try {
+                    for (; i < this->size_; i++)
+                        alloc_traits::construct(this->alloc_, dst + i, std::move_if_noexcept(this->buffer_[i]));
+                } catch (...) {
+                    this->destroyRange(dst, dst + i);
+                    throw;
+                }
+            }
+
+            /**
+             * @brief Уничтожает старые элементы, освобождает старый буфер
+             * и переходит на buffer, в который элементы уже перенесены (см. relocate)
+             *
+             * @param buffer
+             * @param new_capacity
+             */
+            void replaceBuffer(iterator buffer, size_type new_capacity) noexcept {
+                size_type size = this->size_;
+                this->freeBuffer();
+                this->buffer_ = buffer;
+                this->size_ = size;
+                this->capacity_ = new_capacity;
+            }
+
+            /**
+             * @brief Приватная функция для переопределения памяти, переноса
+             * элементов в новую память и удаления старой памяти
              * 
              * @param new_capacity 
              */
             void reallocVector(size_type new_capacity) {
-                iterator tmp = new value_type[new_capacity];
-                for (size_type i = 0; i < this->size_; i++)
-                    tmp[i] = std::move(this->buffer_[i]);
-
-                delete[] this->buffer_;
-                this->buffer_ = tmp;
-                this->capacity_ = new_capacity;
+                iterator tmp = this->allocateBuffer(new_capacity);
+                try {
+                    this->relocate(tmp);
+                } catch (...) {
+                    alloc_traits::deallocate(this->alloc_, tmp, new_capacity);
+                    throw;
+                }
+                this->replaceBuffer(tmp, new_capacity);
             }
     };
 }
@@ -231,3 +231,11 @@ TEST(array_test, end_const) {
         EXPECT_EQ(el, el);
     }
 }
+
+#ifdef S21_CONTAINERS_DEBUG
+TEST(array_test, subscript_debug_check) {
+    s21::array<int, 3> a = {1, 2, 3};
+    EXPECT_EQ(a[2], 3);
+    EXPECT_DEATH(a[3], "out of range");
+}
+#endif
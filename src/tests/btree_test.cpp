@@ -0,0 +1,483 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "counting_allocator.h"
+
+namespace {
+
+template<typename K, typename V, typename C = std::less<K>>
+using BMap = s21::map<K, V, C, std::allocator<std::pair<const K, V>>, s21::BTreePolicy>;
+
+template<typename K, bool OrderStatistics = false, typename C = std::less<K>>
+using BSet = s21::set<K, C, std::allocator<K>, OrderStatistics, s21::BTreePolicy>;
+
+template<typename K, bool OrderStatistics = false, typename C = std::less<K>>
+using BMultiset = s21::multiset<K, C, std::allocator<K>, OrderStatistics, s21::BTreePolicy>;
+
+// Большой элемент: в узел помещается всего три, так дерево быстро растет в высоту
+struct Wide {
+  int key;
+  int id;
+  char payload[120];
+};
+
+struct WideLess {
+  bool operator()(const Wide& a, const Wide& b) const { return a.key < b.key; }
+};
+
+Wide MakeWide(int key, int id) {
+  Wide w{};
+  w.key = key;
+  w.id = id;
+  return w;
+}
+
+// Проверяет, что контейнер совпадает с эталоном при обходе в обе стороны
+template<typename Container, typename Expected>
+void ExpectSameKeys(const Container& c, const Expected& expected) {
+  ASSERT_EQ(c.size(), expected.size());
+  auto it = c.begin();
+  for (const auto& item : expected) {
+    ASSERT_TRUE(*it == item);
+    ++it;
+  }
+  EXPECT_TRUE(it == c.end());
+  for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit) {
+    --it;
+    ASSERT_TRUE(*it == *rit);
+  }
+  EXPECT_TRUE(it == c.begin());
+}
+
+// Ключ, который считает свои копии: переносы между узлами и деревьями должны его перемещать
+struct CopyCountedKey {
+  static int copies;
+  int value;
+  explicit CopyCountedKey(int v) : value(v) {}
+  CopyCountedKey(const CopyCountedKey& other) : value(other.value) { ++copies; }
+  CopyCountedKey(CopyCountedKey&& other) noexcept : value(other.value) {}
+  CopyCountedKey& operator=(const CopyCountedKey&) = default;
+  CopyCountedKey& operator=(CopyCountedKey&&) = default;
+  bool operator<(const CopyCountedKey& other) const { return value < other.value; }
+};
+int CopyCountedKey::copies = 0;
+
+// Аллокатор, который бросает std::bad_alloc, когда кончается запас выделений
+// (отрицательный запас - без ограничений). Равны, если делят один запас
+template<typename T>
+struct FailingAllocator {
+  using value_type = T;
+
+  explicit FailingAllocator(int* budget) : budget_(budget) {}
+
+  template<typename U>
+  FailingAllocator(const FailingAllocator<U>& other) noexcept : budget_(other.budget_) {}
+
+  T* allocate(std::size_t n) {
+    if (*budget_ == 0) throw std::bad_alloc();
+    if (*budget_ > 0) --*budget_;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+
+  template<typename U>
+  bool operator==(const FailingAllocator<U>& other) const noexcept { return budget_ == other.budget_; }
+
+  template<typename U>
+  bool operator!=(const FailingAllocator<U>& other) const noexcept { return budget_ != other.budget_; }
+
+  int* budget_;
+};
+
+using FailingSet = s21::set<std::string, std::less<std::string>, FailingAllocator<std::string>, false,
+                            s21::BTreePolicy>;
+using FailingMultiset = s21::multiset<std::string, std::less<std::string>, FailingAllocator<std::string>,
+                                      false, s21::BTreePolicy>;
+
+// Длинная строка в куче: потерянный или перемещенный элемент видно по значению
+std::string LongKey(int i) {
+  std::string number = std::to_string(i);
+  return std::string(5 - number.size(), '0') + number + std::string(32, '#');
+}
+
+// Все элементы обоих деревьев по возрастанию, заодно проверяет порядок и size()
+template<typename Tree>
+std::multiset<std::string> ElementsOf(const Tree& a, const Tree& b) {
+  std::multiset<std::string> result;
+  for (const Tree* tree : {&a, &b}) {
+    std::size_t count = 0;
+    const std::string* previous = nullptr;
+    for (const auto& item : *tree) {
+      if (previous != nullptr) {
+        EXPECT_FALSE(item < *previous);
+      }
+      previous = &item;
+      result.insert(item);
+      ++count;
+    }
+    EXPECT_EQ(count, tree->size());
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(btree_test, map_matches_std_map) {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> dist(0, 3000);
+  BMap<int, int> m;
+  std::map<int, int> expected;
+  for (int i = 0; i < 30000; ++i) {
+    int key = dist(gen);
+    if (i % 3 == 0) {
+      auto it = m.find(key);
+      ASSERT_EQ(it != m.end(), expected.count(key) != 0);
+      if (it != m.end()) {
+        EXPECT_EQ(it->second, expected[key]);
+        m.erase(it);
+      }
+      expected.erase(key);
+    } else {
+      EXPECT_EQ(m.insert({key, i}).second, expected.insert({key, i}).second);
+    }
+  }
+  ExpectSameKeys(m, std::vector<std::pair<const int, int>>(expected.begin(), expected.end()));
+  m[5000] = 1;
+  EXPECT_EQ(m.at(5000), 1);
+  EXPECT_THROW(m.at(-1), std::out_of_range);
+  for (auto it = m.begin(); it != m.end(); it = m.begin()) {
+    m.erase(it);
+  }
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_TRUE(m.insert({1, 1}).second);
+}
+
+TEST(btree_test, string_set_small_nodes) {
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int> dist(0, 800);
+  BSet<std::string> s;
+  std::set<std::string> expected;
+  for (int i = 0; i < 6000; ++i) {
+    std::string key = "key" + std::to_string(dist(gen));
+    if (i % 2 == 0) {
+      auto it = s.find(key);
+      if (it != s.end()) s.erase(it);
+      expected.erase(key);
+    } else {
+      EXPECT_EQ(s.emplace(key).second, expected.insert(key).second);
+    }
+  }
+  ExpectSameKeys(s, expected);
+  // Удаление с конца, как у split
+  while (!s.empty()) {
+    auto last = s.end();
+    --last;
+    EXPECT_EQ(*last, *expected.rbegin());
+    s.erase(last);
+    expected.erase(std::prev(expected.end()));
+  }
+}
+
+TEST(btree_test, multiset_keeps_insertion_order_of_equal) {
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> dist(0, 60);
+  BMultiset<Wide, false, WideLess> ms;
+  std::multiset<Wide, WideLess> expected;
+  for (int i = 0; i < 4000; ++i) {
+    Wide w = MakeWide(dist(gen), i);
+    if (i % 4 == 3) {
+      auto it = ms.find(w);
+      auto eit = expected.find(w);
+      ASSERT_EQ(it != ms.end(), eit != expected.end());
+      if (it != ms.end()) {
+        EXPECT_EQ(it->id, eit->id);
+        ms.erase(it);
+        expected.erase(eit);
+      }
+    } else {
+      ms.insert(w);
+      expected.insert(w);
+    }
+  }
+  ASSERT_EQ(ms.size(), expected.size());
+  auto it = ms.begin();
+  for (const Wide& w : expected) {
+    EXPECT_EQ(it->key, w.key);
+    EXPECT_EQ(it->id, w.id);
+    ++it;
+  }
+  Wide probe = MakeWide(30, 0);
+  EXPECT_EQ(ms.count(probe), expected.count(probe));
+  auto range = ms.equal_range(probe);
+  EXPECT_EQ(static_cast<size_t>(std::distance(range.first, range.second)), expected.count(probe));
+  EXPECT_EQ(ms.lower_bound(probe)->id, expected.lower_bound(probe)->id);
+  EXPECT_TRUE(ms.upper_bound(MakeWide(100, 0)) == ms.end());
+}
+
+TEST(btree_test, order_statistics) {
+  std::mt19937 gen(9);
+  std::uniform_int_distribution<int> dist(0, 5000);
+  BSet<int, true> s;
+  BMultiset<int, true> ms;
+  std::set<int> expected;
+  std::multiset<int> expected_multi;
+  for (int i = 0; i < 8000; ++i) {
+    int key = dist(gen);
+    if (i % 5 == 4) {
+      auto it = s.find(key);
+      if (it != s.end()) s.erase(it);
+      expected.erase(key);
+    } else {
+      s.insert(key);
+      expected.insert(key);
+    }
+    ms.insert(key % 500);
+    expected_multi.insert(key % 500);
+  }
+  std::vector<int> sorted(expected.begin(), expected.end());
+  ASSERT_EQ(s.size(), sorted.size());
+  for (size_t k = 0; k < sorted.size(); k += 7) {
+    EXPECT_EQ(*s.nth_element(k), sorted[k]);
+  }
+  EXPECT_TRUE(s.nth_element(sorted.size()) == s.end());
+  for (int key = -1; key <= 5001; key += 13) {
+    size_t rank = static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+    EXPECT_EQ(s.rank(key), rank);
+  }
+  EXPECT_EQ(s.count_range(100, 4000), static_cast<size_t>(std::distance(expected.lower_bound(100),
+                                                                        expected.lower_bound(4000))));
+  for (int key = 0; key < 500; key += 17) {
+    EXPECT_EQ(ms.count(key), expected_multi.count(key));
+  }
+  EXPECT_EQ(*ms.nth_element(ms.size() - 1), *expected_multi.rbegin());
+}
+
+TEST(btree_test, hints_and_sorted_build) {
+  BSet<int> ascending;
+  for (int i = 0; i < 5000; ++i) {
+    ascending.insert(ascending.end(), i);
+  }
+  BSet<int> descending;
+  for (int i = 4999; i >= 0; --i) {
+    descending.insert(descending.begin(), i);
+  }
+  std::vector<int> keys(5000);
+  for (int i = 0; i < 5000; ++i) keys[i] = i;
+  ExpectSameKeys(ascending, keys);
+  ExpectSameKeys(descending, keys);
+  // Неверная подсказка - обычная вставка, повтор не вставляется
+  EXPECT_EQ(*ascending.insert(ascending.begin(), 7000), 7000);
+  EXPECT_EQ(*ascending.insert(ascending.end(), 10), 10);
+  EXPECT_EQ(ascending.size(), 5001U);
+
+  std::vector<std::pair<int, std::string>> items;
+  for (int i = 0; i < 3000; ++i) items.emplace_back(i / 2, std::to_string(i));
+  BMap<int, std::string> m(items.begin(), items.end());
+  EXPECT_EQ(m.size(), 1500U);
+  EXPECT_EQ(m.at(10), "20");
+  BMultiset<int> ms;
+  ms.assign_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(ms.size(), 5000U);
+  EXPECT_EQ(*ms.emplace_hint(ms.end(), 4999), 4999);
+  EXPECT_EQ(ms.count(4999), 2U);
+}
+
+TEST(btree_test, insert_many_iterators_stay_valid) {
+  BSet<int> s;
+  for (int i = 0; i < 200; i += 2) {
+    s.insert(i);
+  }
+  // Все вставки в один и тот же лист, он несколько раз делится
+  auto result = s.insert_many(51, 53, 55, 57, 59, 61, 63, 65, 67, 69, 71, 73, 75, 77, 79, 81, 83, 85, 87, 89,
+                              91, 93, 95, 97, 99, 101, 103, 105, 107, 109, 111, 113, 115, 117, 119, 121, 123,
+                              125, 127, 129, 131, 133, 135, 137, 139, 141, 143, 145, 147, 149, 151, 153, 155,
+                              157, 159, 161, 163, 165, 167, 169, 171, 50);
+  ASSERT_EQ(result.size(), 62U);
+  for (size_t i = 0; i + 1 < result.size(); ++i) {
+    EXPECT_TRUE(result[i].second);
+    EXPECT_EQ(*result[i].first, static_cast<int>(51 + 2 * i));
+  }
+  EXPECT_FALSE(result.back().second);
+  EXPECT_EQ(*result.back().first, 50);
+
+  BMap<std::string, int> m = {{"a", 1}};
+  auto map_result = m.insert_many(std::make_pair(std::string("c"), 3), std::make_pair(std::string("a"), 0),
+                                  std::make_pair(std::string("b"), 2));
+  EXPECT_EQ(map_result[0].first->second, 3);
+  EXPECT_EQ(map_result[1].first->second, 1);
+  EXPECT_FALSE(map_result[1].second);
+  EXPECT_EQ(map_result[2].first->first, "b");
+
+  BMultiset<int> ms = {5, 5};
+  auto multi_result = ms.insert_many(5, 4, 6, 5);
+  EXPECT_EQ(*multi_result[0].first, 5);
+  EXPECT_EQ(*multi_result[1].first, 4);
+  EXPECT_EQ(*multi_result[2].first, 6);
+  EXPECT_EQ(ms.count(5), 4U);
+}
+
+TEST(btree_test, merge_split_join_and_algebra) {
+  BSet<int> a;
+  BSet<int> b;
+  std::set<int> ea;
+  std::set<int> eb;
+  for (int i = 0; i < 3000; ++i) {
+    a.insert(i * 3);
+    ea.insert(i * 3);
+    b.insert(i * 2);
+    eb.insert(i * 2);
+  }
+  std::vector<int> expected;
+  std::set_union(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(expected));
+  ExpectSameKeys(a | b, expected);
+  expected.clear();
+  std::set_intersection(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(expected));
+  ExpectSameKeys(a & b, expected);
+  expected.clear();
+  std::set_symmetric_difference(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(expected));
+  BSet<int> c = a;
+  c.symmetric_difference_with(b);
+  ExpectSameKeys(c, expected);
+
+  BSet<int> rest = b;
+  a.merge(rest);
+  std::vector<int> left;
+  std::set_intersection(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(left));
+  ExpectSameKeys(rest, left);
+  expected.clear();
+  std::set_union(ea.begin(), ea.end(), eb.begin(), eb.end(), std::back_inserter(expected));
+  ExpectSameKeys(a, expected);
+
+  BSet<int> upper = a.split(4000);
+  EXPECT_EQ(*upper.begin(), 4000);
+  EXPECT_LT(*std::prev(a.end()), 4000);
+  EXPECT_EQ(a.size() + upper.size(), expected.size());
+  EXPECT_THROW(upper.join(rest), std::invalid_argument);
+  BSet<int> lower = a;
+  upper.join(lower);
+  EXPECT_TRUE(lower.empty());
+  ExpectSameKeys(upper, expected);
+  BSet<int> empty;
+  empty.join(upper);
+  EXPECT_TRUE(upper.empty());
+  ExpectSameKeys(empty, expected);
+
+  BMultiset<int> ma = {1, 2, 2, 3};
+  BMultiset<int> mb = {2, 3, 3};
+  ma.merge(mb);
+  EXPECT_TRUE(mb.empty());
+  ExpectSameKeys(ma, std::vector<int>{1, 2, 2, 2, 3, 3, 3});
+}
+
+TEST(btree_test, copy_move_and_allocator) {
+  std::ptrdiff_t bytes = 0;
+  std::ptrdiff_t other_bytes = 0;
+  {
+    using alloc = CountingAllocator<std::pair<const int, std::string>>;
+    using counted_map = s21::map<int, std::string, std::less<int>, alloc, s21::BTreePolicy>;
+    counted_map m{std::less<int>(), alloc(&bytes)};
+    for (int i = 0; i < 2000; ++i) {
+      m[i] = std::to_string(i);
+    }
+    EXPECT_GT(bytes, 0);
+    counted_map copy = m;
+    EXPECT_EQ(copy.at(1999), "1999");
+    counted_map moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 2000U);
+    counted_map other{std::less<int>(), alloc(&other_bytes)};
+    other = std::move(moved);
+    EXPECT_EQ(other.size(), 2000U);
+    EXPECT_GT(other_bytes, 0);
+    other = m;
+    EXPECT_EQ(other.at(0), "0");
+    m.clear();
+    EXPECT_EQ(other.size(), 2000U);
+  }
+  EXPECT_EQ(bytes, 0);
+  EXPECT_EQ(other_bytes, 0);
+}
+
+TEST(btree_test, heterogeneous_lookup) {
+  BMap<std::string, int, std::less<>> m = {{"apple", 1}, {"pear", 2}};
+  std::string_view key = "pear";
+  EXPECT_TRUE(m.contains(key));
+  EXPECT_EQ(m.at(key), 2);
+  EXPECT_TRUE(m.find(std::string_view("plum")) == m.end());
+  const auto& cm = m;
+  EXPECT_EQ(cm.find(std::string_view("apple"))->second, 1);
+}
+
+TEST(btree_test, relocation_moves_map_keys) {
+  BMap<CopyCountedKey, std::string> m;
+  CopyCountedKey::copies = 0;
+  for (int i = 0; i < 2000; ++i) m.try_emplace(CopyCountedKey(i), std::to_string(i));
+  for (int i = 0; i < 2000; i += 2) m.erase(m.find(CopyCountedKey(i)));
+  BMap<CopyCountedKey, std::string> upper = m.split(CopyCountedKey(1000));
+  BMap<CopyCountedKey, std::string> other;
+  other.try_emplace(CopyCountedKey(-1), "-1");
+  other.merge(m);
+  other.join(upper);
+  EXPECT_EQ(CopyCountedKey::copies, 0);
+  ASSERT_EQ(other.size(), 1001U);
+  int expected = -1;
+  for (const auto& item : other) {
+    EXPECT_EQ(item.first.value, expected);
+    EXPECT_EQ(item.second, std::to_string(expected));
+    expected += 2;
+  }
+}
+
+TEST(btree_test, failed_allocation_in_merge_and_join_loses_nothing) {
+  for (int fail_after = 0; fail_after < 60; fail_after += 3) {
+    int budget = -1;
+    // Запас может и не кончиться: тогда операция просто выполняется целиком
+    auto with_budget = [&budget, fail_after](auto operation) {
+      budget = fail_after;
+      try {
+        operation();
+      } catch (const std::bad_alloc&) {
+      }
+      budget = -1;
+    };
+    FailingAllocator<std::string> alloc(&budget);
+    FailingSet a(alloc);
+    FailingSet b(alloc);
+    FailingMultiset ma(alloc);
+    FailingMultiset mb(alloc);
+    FailingSet low(alloc);
+    FailingSet high(alloc);
+    std::multiset<std::string> expected;
+    for (int i = 0; i < 600; ++i) {
+      if (i % 2 == 0) a.insert(LongKey(i));
+      if (i % 3 == 0) b.insert(LongKey(i));
+      ma.insert(LongKey(i % 50));
+      mb.insert(LongKey(i % 70));
+      (i < 300 ? low : high).insert(LongKey(i));
+      expected.insert(LongKey(i));
+    }
+    std::multiset<std::string> set_expected = ElementsOf(a, b);
+    std::multiset<std::string> multiset_expected = ElementsOf(ma, mb);
+
+    with_budget([&] { a.merge(b); });
+    with_budget([&] { ma.merge(mb); });
+    with_budget([&] { high.join(low); });
+    EXPECT_TRUE(ElementsOf(a, b) == set_expected);
+    EXPECT_TRUE(ElementsOf(ma, mb) == multiset_expected);
+    EXPECT_TRUE(ElementsOf(low, high) == expected);
+
+    with_budget([&] { low.join(high); });
+    EXPECT_TRUE(ElementsOf(low, high) == expected);
+  }
+}
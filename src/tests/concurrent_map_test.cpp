@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../s21_containersplus.h"
+
+TEST(concurrent_map_test, basic_operations) {
+  s21::concurrent_map<int, std::string, 4> m = {{1, "one"}, {2, "two"}};
+  EXPECT_EQ(m.shard_count(), 4U);
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_TRUE(m.insert(3, "three"));
+  EXPECT_FALSE(m.insert({3, "drei"}));
+  EXPECT_EQ(m.find(3).value(), "three");
+  EXPECT_FALSE(m.find(4).has_value());
+  EXPECT_FALSE(m.insert_or_assign(3, "drei"));
+  EXPECT_TRUE(m.insert_or_assign(4, "four"));
+  EXPECT_EQ(m.find(3).value(), "drei");
+  EXPECT_TRUE(m.update(1, [](std::string& s) { s += "!"; }));
+  EXPECT_FALSE(m.update(5, [](std::string& s) { s += "!"; }));
+  EXPECT_EQ(m.find(1).value(), "one!");
+  EXPECT_EQ(m.erase(2), 1U);
+  EXPECT_EQ(m.erase(2), 0U);
+  EXPECT_FALSE(m.contains(2));
+  EXPECT_TRUE(m.contains(4));
+  EXPECT_EQ(m.size(), 3U);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(concurrent_map_test, shards_are_sorted_maps) {
+  s21::concurrent_map<int, int, 8> m;
+  for (int i = 0; i < 1000; ++i) {
+    m.insert(i, i * i);
+  }
+  std::vector<size_t> sizes(m.shard_count(), 0);
+  m.for_each_shard([&sizes, &m](size_t index, const auto& shard) {
+    int prev = -1;
+    for (const auto& item : shard) {
+      EXPECT_LT(prev, item.first);
+      EXPECT_EQ(m.shard_of(item.first), index);
+      prev = item.first;
+    }
+    sizes[index] = shard.size();
+  });
+  size_t total = 0;
+  for (size_t size : sizes) {
+    EXPECT_GT(size, 0U);
+    total += size;
+  }
+  EXPECT_EQ(total, 1000U);
+}
+
+TEST(concurrent_map_test, parallel_for_each_shard) {
+  s21::concurrent_map<int, int> m;
+  for (int i = 0; i < 5000; ++i) {
+    m.insert(i, 1);
+  }
+  std::atomic<long long> sum{0};
+  std::atomic<int> visited{0};
+  m.for_each_shard([&](size_t, const auto& shard) {
+    for (const auto& item : shard) sum += item.second;
+    ++visited;
+  }, 4);
+  EXPECT_EQ(sum.load(), 5000);
+  EXPECT_EQ(visited.load(), 16);
+  EXPECT_THROW(m.for_each_shard([](size_t index, const auto&) {
+    if (index == 3) throw std::runtime_error("shard");
+  }, 3), std::runtime_error);
+}
+
+TEST(concurrent_map_test, many_threads) {
+  constexpr int kThreads = 4;
+  constexpr int kKeys = 200;
+  constexpr int kRounds = 50;
+  s21::concurrent_map<int, long long> m;
+  for (int k = 0; k < kKeys; ++k) {
+    m.insert(k, 0);
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&m, t] {
+      for (int r = 0; r < kRounds; ++r) {
+        for (int k = 0; k < kKeys; ++k) {
+          m.update(k, [](long long& v) { ++v; });
+          m.insert_or_assign(kKeys + t * kKeys + k, r);
+          EXPECT_TRUE(m.find(k).has_value());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int k = 0; k < kKeys; ++k) {
+    EXPECT_EQ(m.find(k).value(), kThreads * kRounds);
+  }
+  EXPECT_EQ(m.size(), static_cast<size_t>(kKeys * (kThreads + 1)));
+  EXPECT_EQ(m.find(kKeys).value(), kRounds - 1);
+}
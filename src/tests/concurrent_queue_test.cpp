@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../s21_containersplus.h"
+#include "counting_allocator.h"
+
+TEST(spsc_queue_test, try_push_try_pop) {
+  s21::spsc_queue<std::string, 4> q;
+  EXPECT_EQ(q.capacity(), 4U);
+  EXPECT_TRUE(q.empty());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(q.try_push(std::to_string(i)));
+  }
+  EXPECT_FALSE(q.try_push("full"));
+  EXPECT_EQ(q.size(), 4U);
+  std::string value;
+  EXPECT_TRUE(q.try_pop(value));
+  EXPECT_EQ(value, "0");
+  EXPECT_TRUE(q.try_emplace(3, 'x'));
+  for (const char* expected : {"1", "2", "3", "xxx"}) {
+    EXPECT_TRUE(q.try_pop(value));
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_FALSE(q.try_pop(value));
+  EXPECT_TRUE(q.try_push("left in queue"));
+}
+
+TEST(spsc_queue_test, push_n_pop_n) {
+  s21::spsc_queue<int, 8> q;
+  std::vector<int> src = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  EXPECT_EQ(q.push_n(src.begin(), src.size()), 8U);
+  std::vector<int> dst(10, 0);
+  EXPECT_EQ(q.pop_n(dst.begin(), 5), 5U);
+  EXPECT_EQ(q.push_n(src.begin() + 8, 2), 2U);
+  EXPECT_EQ(q.pop_n(dst.begin() + 5, 10), 5U);
+  EXPECT_EQ(dst, src);
+  EXPECT_EQ(q.pop_n(dst.begin(), 1), 0U);
+}
+
+TEST(spsc_queue_test, two_threads) {
+  constexpr int kCount = 100000;
+  s21::spsc_queue<int, 64> q;
+  std::thread producer([&q] {
+    int batch[3];
+    for (int i = 0; i < kCount;) {
+      if (i % 7 == 0 && i + 3 <= kCount) {
+        batch[0] = i, batch[1] = i + 1, batch[2] = i + 2;
+        i += static_cast<int>(q.push_n(batch, 3));
+      } else if (q.try_push(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  long long sum = 0;
+  int expected = 0;
+  bool ordered = true;
+  int value = 0;
+  while (expected < kCount) {
+    if (q.try_pop(value)) {
+      ordered = ordered && value == expected;
+      sum += value;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(sum, static_cast<long long>(kCount) * (kCount - 1) / 2);
+  EXPECT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue_test, capacity_and_order) {
+  std::ptrdiff_t bytes = 0;
+  {
+    s21::mpmc_queue<std::unique_ptr<int>, CountingAllocator<int>> q(5, CountingAllocator<int>(&bytes));
+    EXPECT_GT(bytes, 0);
+    EXPECT_EQ(q.capacity(), 8U);
+    for (int i = 0; i < 8; ++i) {
+      EXPECT_TRUE(q.try_push(std::make_unique<int>(i)));
+    }
+    EXPECT_FALSE(q.try_emplace(std::make_unique<int>(8)));
+    std::unique_ptr<int> value;
+    EXPECT_TRUE(q.try_pop(value));
+    EXPECT_EQ(*value, 0);
+    EXPECT_EQ(q.size(), 7U);
+    std::vector<std::unique_ptr<int>> out(3);
+    EXPECT_EQ(q.pop_n(out.begin(), 3), 3U);
+    EXPECT_EQ(*out[2], 3);
+  }
+  EXPECT_EQ(bytes, 0);
+}
+
+TEST(mpmc_queue_test, push_n_pop_n) {
+  s21::mpmc_queue<int> q(4);
+  std::vector<int> src = {1, 2, 3, 4, 5};
+  EXPECT_EQ(q.push_n(src.begin(), src.size()), 4U);
+  std::vector<int> dst(5, 0);
+  EXPECT_EQ(q.pop_n(dst.begin(), 5), 4U);
+  EXPECT_EQ(dst[3], 4);
+  EXPECT_TRUE(q.empty());
+}
+
+namespace {
+
+// Копия бросает, перемещение - нет: исключение должно вылететь до того, как занята ячейка
+struct ThrowingCopy {
+  static bool fail;
+  int value;
+  explicit ThrowingCopy(int v) : value(v) {}
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (fail) throw std::runtime_error("copy");
+  }
+  ThrowingCopy(ThrowingCopy&&) noexcept = default;
+  ThrowingCopy& operator=(const ThrowingCopy&) = default;
+  ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+};
+bool ThrowingCopy::fail = false;
+
+// Выходной итератор, запись в который бросает на втором элементе
+struct FailingOutput {
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
+  std::vector<int>* out;
+  FailingOutput& operator*() { return *this; }
+  FailingOutput& operator++() { return *this; }
+  FailingOutput& operator=(int value) {
+    if (out->size() == 1) throw std::runtime_error("write");
+    out->push_back(value);
+    return *this;
+  }
+};
+
+}  // namespace
+
+TEST(mpmc_queue_test, exceptions_do_not_block_cells) {
+  s21::mpmc_queue<ThrowingCopy> q(2);
+  ThrowingCopy item(1);
+  ThrowingCopy::fail = true;
+  EXPECT_THROW(q.try_push(item), std::runtime_error);
+  ThrowingCopy::fail = false;
+  EXPECT_TRUE(q.empty());
+  EXPECT_TRUE(q.try_push(item));
+  EXPECT_TRUE(q.try_emplace(2));
+  ThrowingCopy out(0);
+  EXPECT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out.value, 1);
+  EXPECT_TRUE(q.try_pop(out));
+  EXPECT_EQ(out.value, 2);
+
+  s21::mpmc_queue<int> ints(4);
+  std::vector<int> src = {1, 2, 3, 4};
+  ints.push_n(src.begin(), src.size());
+  std::vector<int> dst;
+  EXPECT_THROW(ints.pop_n(FailingOutput{&dst}, 4), std::runtime_error);
+  EXPECT_EQ(dst, std::vector<int>{1});
+  int value = 0;
+  EXPECT_TRUE(ints.try_pop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_TRUE(ints.try_push(5));
+  EXPECT_EQ(ints.size(), 2U);
+}
+
+TEST(mpmc_queue_test, many_threads) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 50000;
+  s21::mpmc_queue<int> q(128);
+  std::atomic<long long> sum{0};
+  std::atomic<int> popped{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&q, t] {
+      for (int i = 0; i < kPerThread;) {
+        if (q.try_push(t * kPerThread + i)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&q, &sum, &popped] {
+      int value = 0;
+      while (popped.load() < kThreads * kPerThread) {
+        if (q.try_pop(value)) {
+          sum += value;
+          ++popped;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  const long long n = static_cast<long long>(kThreads) * kPerThread;
+  EXPECT_EQ(popped.load(), n);
+  EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+  EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,40 @@
+#ifndef SRC_TESTS_COUNTING_ALLOCATOR_H_
+#define SRC_TESTS_COUNTING_ALLOCATOR_H_
+#include <cstddef>
+#include <memory>
+
+// Аллокатор для тестов: считает, сколько байт сейчас выделено через него.
+// Два аллокатора равны, только если пишут в один и тот же счетчик
+template<typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  explicit CountingAllocator(std::ptrdiff_t* counter) : counter_(counter) {}
+
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U>& other) noexcept : counter_(other.counter_) {}
+
+  T* allocate(std::size_t n) {
+    *counter_ += static_cast<std::ptrdiff_t>(n * sizeof(T));
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    *counter_ -= static_cast<std::ptrdiff_t>(n * sizeof(T));
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template<typename U>
+  bool operator==(const CountingAllocator<U>& other) const noexcept {
+    return counter_ == other.counter_;
+  }
+
+  template<typename U>
+  bool operator!=(const CountingAllocator<U>& other) const noexcept {
+    return counter_ != other.counter_;
+  }
+
+  std::ptrdiff_t* counter_;
+};
+
+#endif  // SRC_TESTS_COUNTING_ALLOCATOR_H_
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "counting_allocator.h"
+
+TEST(deque_test, push_pop_both_ends) {
+  s21::deque<int> a;
+  std::deque<int> b;
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 3 == 0) {
+      a.push_front(i);
+      b.push_front(i);
+    } else {
+      a.push_back(i);
+      b.push_back(i);
+    }
+  }
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < b.size(); ++i) {
+    EXPECT_EQ(a[i], b[i]);
+  }
+  while (!b.empty()) {
+    EXPECT_EQ(a.front(), b.front());
+    EXPECT_EQ(a.back(), b.back());
+    a.pop_front();
+    b.pop_front();
+    if (!b.empty()) {
+      a.pop_back();
+      b.pop_back();
+    }
+  }
+  EXPECT_TRUE(a.empty());
+}
+
+TEST(deque_test, ring_reuses_blocks) {
+  std::ptrdiff_t bytes = 0;
+  s21::deque<int, CountingAllocator<int>> a{CountingAllocator<int>(&bytes)};
+  for (int i = 0; i < 1000; ++i) {
+    a.push_back(i);
+  }
+  std::ptrdiff_t warm = 0;
+  for (int i = 1000; i < 100000; ++i) {
+    // Один проход по кольцу выделяет все его блоки, дальше память только переиспользуется
+    if (i == 50000) warm = bytes;
+    a.push_back(i);
+    EXPECT_EQ(a.front(), i - 1000);
+    a.pop_front();
+  }
+  EXPECT_EQ(bytes, warm);
+  EXPECT_EQ(a.size(), 1000U);
+  EXPECT_EQ(a.back(), 99999);
+  a.clear();
+  a.shrink_to_fit();
+  EXPECT_EQ(bytes, 0);
+}
+
+TEST(deque_test, shrink_to_fit_keeps_elements) {
+  s21::deque<std::string> a;
+  for (int i = 0; i < 500; ++i) {
+    a.push_back(std::to_string(i));
+  }
+  for (int i = 0; i < 450; ++i) {
+    a.pop_front();
+  }
+  a.shrink_to_fit();
+  EXPECT_EQ(a.size(), 50U);
+  EXPECT_EQ(a.front(), "450");
+  a.emplace_front("x");
+  a.emplace_back(3, 'y');
+  EXPECT_EQ(a.front(), "x");
+  EXPECT_EQ(a.back(), "yyy");
+  EXPECT_EQ(a.at(1), "450");
+  EXPECT_ANY_THROW(a.at(52));
+}
+
+TEST(deque_test, copy_move_swap) {
+  s21::deque<int> a = {1, 2, 3};
+  s21::deque<int> b(a);
+  s21::deque<int> c(std::move(a));
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(b.size(), 3U);
+  EXPECT_EQ(c.back(), 3);
+  s21::deque<int> d(5);
+  d = b;
+  EXPECT_EQ(d.size(), 3U);
+  EXPECT_EQ(d[2], 3);
+  d.push_front(0);
+  b = std::move(d);
+  EXPECT_EQ(b.front(), 0);
+  b.swap(c);
+  EXPECT_EQ(b.size(), 3U);
+  EXPECT_EQ(c.size(), 4U);
+  int expected = 0;
+  for (int el : c) {
+    EXPECT_EQ(el, expected++);
+  }
+  const s21::deque<int>& cref = c;
+  auto it = cref.end();
+  --it;
+  EXPECT_EQ(*it, 3);
+  EXPECT_NE(it, cref.begin());
+}
+
+TEST(deque_test, move_only_elements) {
+  s21::deque<std::unique_ptr<int>> a;
+  for (int i = 0; i < 100; ++i) {
+    a.emplace_back(new int(i));
+    a.push_front(std::make_unique<int>(-i));
+  }
+  EXPECT_EQ(*a.front(), -99);
+  EXPECT_EQ(*a.back(), 99);
+  EXPECT_EQ(a.size(), 200U);
+}
+
+TEST(deque_test, adaptor_containers) {
+  s21::queue<int> q;
+  s21::stack<int> s;
+  s21::queue<int, s21::list<int>> ql;
+  s21::stack<int, s21::vector<int>> sv;
+  for (int i = 0; i < 300; ++i) {
+    q.push(i);
+    s.push(i);
+    ql.push(i);
+    sv.push(i);
+  }
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(q.front(), i);
+    EXPECT_EQ(ql.front(), i);
+    EXPECT_EQ(s.top(), 299 - i);
+    EXPECT_EQ(sv.top(), 299 - i);
+    q.pop();
+    ql.pop();
+    s.pop();
+    sv.pop();
+  }
+  EXPECT_TRUE(q.empty());
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(deque_test, empty_pop_and_access_are_safe) {
+  s21::deque<std::string> a;
+  a.pop_back();
+  a.pop_front();
+  EXPECT_TRUE(a.empty());
+  a.push_back("x");
+  a.pop_front();
+  a.pop_front();
+  EXPECT_EQ(a.size(), 0);
+  a.push_front("y");
+  EXPECT_EQ(a.front(), "y");
+  EXPECT_EQ(a.back(), "y");
+
+  s21::queue<std::string> q;
+  q.pop();
+  EXPECT_EQ(q.front(), "");
+  q.back() = "scribble";
+  EXPECT_EQ(q.back(), "");
+  EXPECT_TRUE(q.empty());
+  s21::stack<std::string> s;
+  EXPECT_EQ(s.top(), "");
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(deque_test, queue_move_does_not_copy) {
+  s21::queue<std::string> q;
+  q.push(std::string(64, 'q'));
+  const std::string* front = &q.front();
+  s21::queue<std::string> moved(std::move(q));
+  EXPECT_EQ(&moved.front(), front);
+  EXPECT_TRUE(q.empty());
+  static_assert(std::is_nothrow_move_constructible<s21::queue<int>>::value, "queue move must be noexcept");
+}
+
+#ifdef S21_CONTAINERS_DEBUG
+TEST(deque_test, empty_access_debug_check) {
+  s21::deque<int> a;
+  EXPECT_DEATH(a.front(), "zero sized container");
+  EXPECT_DEATH(a.back(), "zero sized container");
+}
+#endif
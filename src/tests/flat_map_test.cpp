@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "counting_allocator.h"
+
+TEST(flat_map_test, basic_operations) {
+  s21::flat_map<int, std::string> m = {{3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+  EXPECT_EQ(m.size(), 3U);
+  EXPECT_EQ(m.at(1), "one");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+  EXPECT_TRUE(m.insert({4, "four"}).second);
+  EXPECT_FALSE(m.insert(4, "vier").second);
+  EXPECT_EQ(m[4], "four");
+  EXPECT_EQ(m[5], "");
+  EXPECT_FALSE(m.insert_or_assign(5, "five").second);
+  EXPECT_EQ(m.at(5), "five");
+  EXPECT_TRUE(m.contains(2));
+  EXPECT_FALSE(m.contains(6));
+  EXPECT_EQ(m.find(6), m.end());
+  m.erase(m.find(2));
+  EXPECT_FALSE(m.contains(2));
+  int expected[] = {1, 3, 4, 5};
+  int i = 0;
+  for (auto item : m) {
+    EXPECT_EQ(item.first, expected[i++]);
+  }
+  m.begin()->second = "ONE";
+  EXPECT_EQ((*m.find(1)).second, "ONE");
+  const s21::flat_map<int, std::string>& cm = m;
+  EXPECT_EQ(cm.at(1), "ONE");
+  EXPECT_EQ((cm.end() - 1)->first, 5);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(flat_map_test, matches_std_map) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(0, 500);
+  s21::flat_map<int, int> m;
+  std::map<int, int> expected;
+  for (int i = 0; i < 2000; ++i) {
+    int key = dist(gen);
+    if (i % 3 == 0) {
+      auto it = m.find(key);
+      if (it != m.end()) m.erase(it);
+      expected.erase(key);
+    } else {
+      EXPECT_EQ(m.try_emplace(key, i).second, expected.emplace(key, i).second);
+    }
+  }
+  ASSERT_EQ(m.size(), expected.size());
+  auto it = m.begin();
+  for (const auto& item : expected) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+}
+
+TEST(flat_map_test, bulk_insert_keeps_existing_and_first) {
+  s21::flat_map<int, char> m = {{2, 'a'}, {4, 'a'}};
+  std::vector<std::pair<int, char>> items = {{5, 'b'}, {1, 'b'}, {4, 'b'}, {1, 'c'}, {3, 'b'}};
+  m.insert(items.begin(), items.end());
+  EXPECT_EQ(m.size(), 5U);
+  EXPECT_EQ(m.at(1), 'b');
+  EXPECT_EQ(m.at(2), 'a');
+  EXPECT_EQ(m.at(3), 'b');
+  EXPECT_EQ(m.at(4), 'a');
+  EXPECT_EQ(m.at(5), 'b');
+
+  s21::map<int, int> tree = {{1, 10}, {2, 20}, {3, 30}};
+  s21::flat_map<int, int> from_tree(tree.begin(), tree.end());
+  EXPECT_EQ(from_tree.size(), 3U);
+  EXPECT_EQ(from_tree.at(3), 30);
+}
+
+TEST(flat_map_test, hint_and_insert_many) {
+  s21::flat_map<int, int> m;
+  for (int i = 0; i < 100; ++i) {
+    m.insert(m.end(), {i, i});
+  }
+  // Неверная подсказка - обычная вставка
+  auto it = m.insert(m.begin(), {200, 0});
+  EXPECT_EQ(it->first, 200);
+  EXPECT_EQ(m.emplace_hint(m.end(), 150, 1)->first, 150);
+  EXPECT_EQ((m.end() - 1)->first, 200);
+
+  s21::flat_map<int, int> small = {{5, 5}};
+  auto result = small.insert_many(std::make_pair(7, 7), std::make_pair(1, 1), std::make_pair(5, 0));
+  ASSERT_EQ(result.size(), 3U);
+  EXPECT_EQ(result[0].first->first, 7);
+  EXPECT_TRUE(result[0].second);
+  EXPECT_EQ(result[1].first->first, 1);
+  EXPECT_EQ(result[2].first->first, 5);
+  EXPECT_EQ(result[2].first->second, 5);
+  EXPECT_FALSE(result[2].second);
+}
+
+TEST(flat_map_test, merge_split_join) {
+  s21::flat_map<int, int> a = {{1, 1}, {3, 3}, {5, 5}};
+  s21::flat_map<int, int> b = {{2, 2}, {3, 30}, {6, 6}};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 5U);
+  EXPECT_EQ(a.at(3), 3);
+  ASSERT_EQ(b.size(), 1U);
+  EXPECT_EQ(b.at(3), 30);
+
+  s21::flat_map<int, int> upper = a.split(3);
+  EXPECT_EQ(a.size(), 2U);
+  EXPECT_EQ(upper.size(), 3U);
+  EXPECT_EQ(upper.begin()->first, 3);
+  EXPECT_THROW(upper.join(b), std::invalid_argument);
+  upper.join(a);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(upper.size(), 5U);
+  EXPECT_EQ(upper.begin()->first, 1);
+  EXPECT_EQ((upper.end() - 1)->first, 6);
+}
+
+TEST(flat_map_test, heterogeneous_lookup) {
+  s21::flat_map<std::string, int, std::less<>> m = {{"apple", 1}, {"pear", 2}};
+  std::string_view key = "pear";
+  EXPECT_TRUE(m.contains(key));
+  EXPECT_EQ(m.at(key), 2);
+  EXPECT_EQ(m.find(std::string_view("plum")), m.end());
+  m.try_emplace(std::string("plum"), 3);
+  EXPECT_EQ(m.find(std::string_view("plum"))->second, 3);
+}
+
+TEST(flat_map_test, allocator) {
+  std::ptrdiff_t bytes = 0;
+  {
+    using pair_alloc = CountingAllocator<std::pair<const int, std::string>>;
+    s21::flat_map<int, std::string, std::less<int>, pair_alloc> m{std::less<int>(), pair_alloc(&bytes)};
+    for (int i = 0; i < 100; ++i) {
+      m[i] = std::to_string(i);
+    }
+    EXPECT_GT(bytes, 0);
+    auto copy = m;
+    EXPECT_TRUE(copy.get_allocator() == pair_alloc(&bytes));
+    EXPECT_EQ(copy.at(42), "42");
+    std::vector<std::pair<int, std::string>> more = {{150, "150"}, {120, "120"}, {42, "dup"}};
+    copy.insert(more.begin(), more.end());
+    EXPECT_EQ(copy.size(), 102U);
+    EXPECT_EQ(copy.at(42), "42");
+  }
+  EXPECT_EQ(bytes, 0);
+}
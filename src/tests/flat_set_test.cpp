@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../s21_containersplus.h"
+
+TEST(flat_set_test, basic_operations) {
+  s21::flat_set<int> s = {5, 1, 3, 1};
+  EXPECT_EQ(s.size(), 3U);
+  EXPECT_TRUE(s.insert(2).second);
+  EXPECT_FALSE(s.insert(3).second);
+  EXPECT_EQ(*s.emplace(4).first, 4);
+  EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+  EXPECT_TRUE(s.contains(4));
+  EXPECT_EQ(s.find(6), s.end());
+  s.erase(s.find(1));
+  EXPECT_FALSE(s.contains(1));
+  EXPECT_EQ(*s.nth_element(0), 2);
+  EXPECT_EQ(s.nth_element(10), s.end());
+  EXPECT_EQ(s.rank(4), 2U);
+  EXPECT_EQ(s.count_range(3, 5), 2U);
+  EXPECT_EQ(s.count_range(5, 3), 0U);
+}
+
+TEST(flat_set_test, branchless_lower_bound) {
+  std::vector<int> values = {1, 3, 3, 5, 7, 9};
+  for (int key = 0; key <= 10; ++key) {
+    for (size_t n = 0; n <= values.size(); ++n) {
+      size_t expected = std::lower_bound(values.begin(), values.begin() + n, key) - values.begin();
+      EXPECT_EQ(s21::branchlessLowerBound(values.data(), n, key, std::less<int>()), expected);
+    }
+  }
+}
+
+TEST(flat_set_test, matches_std_set) {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> dist(0, 300);
+  s21::flat_set<int> s;
+  std::set<int> expected;
+  std::vector<int> batch;
+  for (int i = 0; i < 1000; ++i) {
+    int key = dist(gen);
+    if (i % 4 == 0) {
+      auto it = s.find(key);
+      if (it != s.end()) s.erase(it);
+      expected.erase(key);
+    } else if (i % 4 == 1) {
+      batch.push_back(key);
+    } else {
+      EXPECT_EQ(s.insert(key).second, expected.insert(key).second);
+    }
+  }
+  s.insert(batch.begin(), batch.end());
+  expected.insert(batch.begin(), batch.end());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(), expected.end()));
+}
+
+TEST(flat_set_test, set_algebra) {
+  s21::flat_set<int> a = {1, 2, 3, 4};
+  s21::flat_set<int> b = {3, 4, 5};
+  EXPECT_EQ((a | b).size(), 5U);
+  EXPECT_EQ((a & b).size(), 2U);
+  EXPECT_EQ(*(a - b).begin(), 1);
+  EXPECT_EQ((a ^ b).size(), 3U);
+  a.difference_with(b).union_with({9});
+  std::vector<int> expected = {1, 2, 9};
+  EXPECT_TRUE(std::equal(a.begin(), a.end(), expected.begin(), expected.end()));
+}
+
+TEST(flat_set_test, merge_split_join_hint) {
+  s21::flat_set<int> a = {1, 3, 5};
+  s21::flat_set<int> b = {2, 3, 6};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 5U);
+  ASSERT_EQ(b.size(), 1U);
+  EXPECT_EQ(*b.begin(), 3);
+
+  s21::flat_set<int> upper = a.split(4);
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(*upper.begin(), 5);
+  EXPECT_THROW(a.join(b), std::invalid_argument);
+  upper.join(a);
+  EXPECT_EQ(upper.size(), 5U);
+  EXPECT_TRUE(a.empty());
+
+  EXPECT_EQ(*upper.insert(upper.end(), 10), 10);
+  EXPECT_EQ(*upper.emplace_hint(upper.begin(), 4), 4);
+  auto result = upper.insert_many(0, 7, 4);
+  EXPECT_EQ(*result[0].first, 0);
+  EXPECT_EQ(*result[1].first, 7);
+  EXPECT_FALSE(result[2].second);
+  EXPECT_EQ(*result[2].first, 4);
+  EXPECT_TRUE(std::is_sorted(upper.begin(), upper.end()));
+}
+
+TEST(flat_set_test, heterogeneous_lookup) {
+  s21::flat_set<std::string, std::less<>> s = {"b", "a", "c"};
+  EXPECT_TRUE(s.contains(std::string_view("a")));
+  EXPECT_EQ(*s.find(std::string_view("c")), "c");
+  EXPECT_FALSE(s.contains(std::string_view("d")));
+}
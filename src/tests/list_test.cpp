@@ -1,6 +1,40 @@
 #include "../s21_containers.h"
 #include <gtest/gtest.h>
 #include <list>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include "counting_allocator.h"
+
+TEST(list_test, allocator) {
+  std::ptrdiff_t bytes = 0;
+  std::ptrdiff_t other_bytes = 0;
+  {
+    using alloc_list = s21::list<int, CountingAllocator<int>>;
+    alloc_list a({3, 1, 2}, CountingAllocator<int>(&bytes));
+    EXPECT_GT(bytes, 0);
+    alloc_list b{CountingAllocator<int>(&other_bytes)};
+    std::ptrdiff_t empty_bytes = other_bytes;
+    b = std::move(a);
+    EXPECT_EQ(b.size(), 3U);
+    EXPECT_TRUE(a.empty());
+    EXPECT_GT(other_bytes, empty_bytes);
+    EXPECT_EQ(b.front(), 3);
+    EXPECT_EQ(b.back(), 2);
+
+    s21::stack<int, alloc_list> s{CountingAllocator<int>(&bytes)};
+    s.push(1);
+    s.push(2);
+    EXPECT_EQ(s.top(), 2);
+    s21::queue<int, alloc_list> q{CountingAllocator<int>(&bytes)};
+    q.push(1);
+    q.push(2);
+    EXPECT_EQ(q.front(), 1);
+  }
+  EXPECT_EQ(bytes, 0);
+  EXPECT_EQ(other_bytes, 0);
+}
 
 TEST(list_test, front) {
   s21::list<int> a = {1, 2, 3};
@@ -223,6 +257,35 @@ TEST(list_test, merge) {
   EXPECT_EQ(b.empty(), true);
 }
 
+TEST(list_test, merge_relink) {
+  s21::list<std::pair<int, char>> a = {{1, 'a'}, {3, 'a'}, {3, 'a'}, {8, 'a'}};
+  s21::list<std::pair<int, char>> b = {{0, 'b'}, {3, 'b'}, {5, 'b'}, {9, 'b'}, {10, 'b'}};
+  const std::pair<int, char>* moved = &b.front();
+  auto by_key = [](const std::pair<int, char>& x, const std::pair<int, char>& y) { return x.first < y.first; };
+  a.merge(b, by_key);
+  std::list<std::pair<int, char>> res = {{0, 'b'}, {1, 'a'}, {3, 'a'}, {3, 'a'}, {3, 'b'},
+                                         {5, 'b'}, {8, 'a'}, {9, 'b'}, {10, 'b'}};
+  EXPECT_EQ(&a.front(), moved);
+  EXPECT_EQ(a.size(), res.size());
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(b.begin(), b.end());
+  auto it = res.begin();
+  for (auto& el : a) {
+    EXPECT_EQ(el, *it);
+    ++it;
+  }
+  auto rit = res.rbegin();
+  for (auto i = --a.end(); i != a.end(); --i, ++rit) {
+    EXPECT_EQ(*i, *rit);
+  }
+  s21::list<int> c;
+  s21::list<int> d = {3, 2, 1};
+  c.merge(d, [](int x, int y) { return x > y; });
+  EXPECT_EQ(c.front(), 3);
+  EXPECT_EQ(c.back(), 1);
+  EXPECT_EQ(c.size(), 3U);
+}
+
 TEST(list_test, sort_1) {
   s21::list<int> a = {100000, 43, 2, 3, 41, -11, 3, 0, 32};
   std::list<int> b = {100000, 43, 2, 3, 41, -11, 3, 0, 32};
@@ -256,6 +319,40 @@ TEST(list_test, sort_3) {
   }
 }
 
+TEST(list_test, sort_comparator) {
+  s21::list<int> a = {5, 8, 1, 4, 2, 3, 6, 7, 0};
+  a.sort([](int x, int y) { return x > y; });
+  auto it = a.begin();
+  for (int i = 8; i >= 0; --i, ++it) {
+    EXPECT_EQ(*it, i);
+  }
+  EXPECT_EQ(a.back(), 0);
+  EXPECT_EQ(*(--a.end()), 0);
+}
+
+TEST(list_test, sort_stable_large) {
+  s21::list<std::pair<int, int>> a;
+  std::list<std::pair<int, int>> b;
+  for (int i = 0; i < 10000; ++i) {
+    int key = (i * 7919) % 101;
+    a.push_back({key, i});
+    b.push_back({key, i});
+  }
+  auto by_key = [](const std::pair<int, int>& x, const std::pair<int, int>& y) { return x.first < y.first; };
+  a.sort(by_key);
+  b.sort(by_key);
+  EXPECT_EQ(a.size(), b.size());
+  auto it = b.begin();
+  for (auto& el : a) {
+    EXPECT_EQ(el, *it);
+    ++it;
+  }
+  auto rit = b.rbegin();
+  for (auto i = --a.end(); i != a.end(); --i, ++rit) {
+    EXPECT_EQ(*i, *rit);
+  }
+}
+
 TEST(list_test, erase_1) {
   s21::list<int> a = {10, 10, 20, 30, 40, 50, 60};
   s21::list<int>::iterator it = a.begin();
@@ -298,9 +395,9 @@ TEST(list_test, splice) {
 }
 
 
-TEST(list_test, emplace_front) {
+TEST(list_test, insert_many_front) {
   s21::list<int> a = {6, 7, 8};
-  a.emplace_front(1, 2, 3, 4, 5);
+  a.insert_many_front(1, 2, 3, 4, 5);
   auto it = a.begin();
   for (int i = 1; i <= 8; i++, ++it) {
     EXPECT_EQ(*it, i);
@@ -325,9 +422,9 @@ TEST(list_test, const_list) {
 
 }
 
-TEST(list_test, emplace_back_1) {
+TEST(list_test, insert_many_back) {
     s21::list<int> a = {1, 2, 3, 4};
-    a.emplace_back(1, 1, 2, 5, 6);
+    a.insert_many_back(1, 1, 2, 5, 6);
     auto it = a.size();
     EXPECT_EQ(9, it);
     EXPECT_EQ(a.front(), 1);
@@ -347,3 +444,107 @@ TEST(list_test, operator_copy) {
     b = a;
     EXPECT_EQ(b.size(), 4);
 }
+
+TEST(list_test, emplace_in_place) {
+  s21::list<std::unique_ptr<int>> a;
+  a.emplace_back(new int(2));
+  a.emplace_front(new int(1));
+  auto it = a.emplace(a.end(), new int(3));
+  EXPECT_EQ(**it, 3);
+  EXPECT_EQ(a.size(), 3U);
+  int expected = 1;
+  for (auto& ptr : a) {
+    EXPECT_EQ(*ptr, expected++);
+  }
+  s21::list<std::pair<std::string, int>> b;
+  auto& ref = b.emplace_back("x", 1);
+  EXPECT_EQ(ref.first, "x");
+  EXPECT_EQ(b.front().second, 1);
+}
+
+TEST(list_test, adaptor_emplace) {
+  s21::stack<std::pair<int, char>> s;
+  s.emplace(1, 'a');
+  s.insert_many_front(std::make_pair(2, 'b'), std::make_pair(3, 'c'));
+  EXPECT_EQ(s.size(), 3U);
+  EXPECT_EQ(s.top().second, 'c');
+  s21::queue<std::pair<int, char>> q;
+  q.emplace(1, 'a');
+  q.insert_many_back(std::make_pair(2, 'b'));
+  EXPECT_EQ(q.front().second, 'a');
+  EXPECT_EQ(q.back().first, 2);
+}
+
+namespace {
+
+// Сравнение, которое бросает на calls-м вызове
+struct ThrowingLess {
+  int* calls;
+  bool operator()(const std::string& a, const std::string& b) const {
+    if (--*calls == 0) throw std::runtime_error("compare");
+    return a < b;
+  }
+};
+
+std::multiset<std::string> Items(const s21::list<std::string>& l) {
+  std::multiset<std::string> items;
+  for (auto it = l.begin(); it != l.end(); ++it) items.insert(*it);
+  return items;
+}
+
+// Список цел: обход в обе стороны дает size() элементов, и набор элементов тот же
+void ExpectIntact(const s21::list<std::string>& l, const std::multiset<std::string>& expected) {
+  EXPECT_EQ(Items(l), expected);
+  std::size_t backward = 0;
+  auto it = l.end();
+  while (it != l.begin()) {
+    --it;
+    ++backward;
+  }
+  EXPECT_EQ(backward, l.size());
+}
+
+}  // namespace
+
+TEST(list_test, merge_with_throwing_comparator_leaves_two_valid_lists) {
+  for (int fail_at = 1; fail_at < 12; ++fail_at) {
+    s21::list<std::string> a = {"a1", "c1", "e1", "g1"};
+    s21::list<std::string> b = {"b2", "d2", "f2", "h2"};
+    std::multiset<std::string> all = {"a1", "c1", "e1", "g1", "b2", "d2", "f2", "h2"};
+    int calls = fail_at;
+    try {
+      a.merge(b, ThrowingLess{&calls});
+    } catch (const std::runtime_error&) {
+    }
+    EXPECT_EQ(a.size() + b.size(), 8U);
+    std::multiset<std::string> in_a = Items(a);
+    std::multiset<std::string> in_b = Items(b);
+    ExpectIntact(a, in_a);
+    ExpectIntact(b, in_b);
+    in_a.insert(in_b.begin(), in_b.end());
+    EXPECT_EQ(in_a, all);
+  }
+}
+
+TEST(list_test, sort_with_throwing_comparator_keeps_all_nodes) {
+  std::multiset<std::string> all;
+  s21::list<std::string> source;
+  for (int i = 0; i < 37; ++i) {
+    std::string value = std::to_string((i * 17) % 23) + std::string(20, 'x');
+    source.push_back(value);
+    all.insert(value);
+  }
+  for (int fail_at = 1; fail_at < 90; fail_at += 4) {
+    s21::list<std::string> l = source;
+    int calls = fail_at;
+    EXPECT_THROW(l.sort(ThrowingLess{&calls}), std::runtime_error);
+    EXPECT_EQ(l.size(), 37U);
+    ExpectIntact(l, all);
+    l.sort();
+    std::string prev;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+      EXPECT_LE(prev, *it);
+      prev = *it;
+    }
+  }
+}
@@ -1,6 +1,40 @@
 #include "../s21_containers.h"
 #include <gtest/gtest.h>
 #include <map>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "counting_allocator.h"
+
+TEST(map_test, allocator) {
+  std::ptrdiff_t bytes = 0;
+  std::ptrdiff_t other_bytes = 0;
+  {
+    using pair_alloc = CountingAllocator<std::pair<const int, int>>;
+    using alloc_map = s21::map<int, int, std::less<int>, pair_alloc>;
+    alloc_map m1({{1, 1}, {2, 2}, {3, 3}}, std::less<int>(), pair_alloc(&bytes));
+    EXPECT_GT(bytes, 0);
+    alloc_map m2 = m1;
+    EXPECT_TRUE(m2.get_allocator() == pair_alloc(&bytes));
+
+    // Пулы с разными аллокаторами объединить нельзя - узлы пересоздаются
+    alloc_map m3({{0, 0}, {4, 4}}, std::less<int>(), pair_alloc(&other_bytes));
+    m3.merge(m1);
+    EXPECT_EQ(m3.size(), 5U);
+    EXPECT_TRUE(m1.empty());
+    EXPECT_EQ(m3.at(2), 2);
+
+    s21::set<int, std::greater<int>, CountingAllocator<int>> s({1, 3, 2}, std::greater<int>(),
+                                                              CountingAllocator<int>(&bytes));
+    EXPECT_EQ(*s.begin(), 3);
+  }
+  EXPECT_EQ(bytes, 0);
+  EXPECT_EQ(other_bytes, 0);
+}
 
 TEST(map_test, Modifier_Insert) {
   s21::map<char, int> s21_map_1 = {{'b', 228}, {'c', 1337}};
@@ -544,7 +578,299 @@ TEST(map_test, emplace) {
     s21::map<structure, int> map1= {{elemap1 , 1}};
     std::pair<structure, int> pair1 = {expecting_result, 3};
     auto v1 = map1.emplace(pair1);
+    EXPECT_TRUE(v1.second);
     auto it_res = map1.begin();
     EXPECT_TRUE((*it_res).first == expecting_result);
     EXPECT_TRUE((*it_res).second == 3);
 }
+
+TEST(map_test, insert_hint) {
+  s21::map<int, std::string> m;
+  std::map<int, std::string> mc;
+  for (int i = 100; i > 0; --i) {
+    m.insert(m.begin(), {i, std::to_string(i)});
+    mc.insert(mc.begin(), {i, std::to_string(i)});
+  }
+  auto it = m.emplace_hint(m.end(), 50, "fifty");
+  EXPECT_EQ((*it).second, "50");
+  m.emplace_hint(m.end(), 101, "101");
+  mc.emplace_hint(mc.end(), 101, "101");
+  ASSERT_EQ(m.size(), mc.size());
+  auto y = mc.begin();
+  for (auto x = m.begin(); x != m.end(); ++x, ++y) {
+    EXPECT_EQ((*x).first, (*y).first);
+    EXPECT_EQ((*x).second, (*y).second);
+  }
+}
+
+TEST(map_test, constructor_range) {
+  std::vector<std::pair<int, std::string>> items = {{3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}};
+  s21::map<int, std::string> m(items.begin(), items.end());
+  std::map<int, std::string> mc(items.begin(), items.end());
+  ASSERT_EQ(m.size(), mc.size());
+  auto y = mc.begin();
+  for (auto x = m.begin(); x != m.end(); ++x, ++y) {
+    EXPECT_EQ((*x).first, (*y).first);
+    EXPECT_EQ((*x).second, (*y).second);
+  }
+  m.assign_sorted(mc.rbegin(), mc.rbegin());
+  EXPECT_TRUE(m.empty());
+  m.assign_sorted(mc.begin(), mc.end());
+  EXPECT_EQ(m.at(3), "c");
+  m[4] = "d";
+  EXPECT_EQ(m.size(), 4U);
+}
+
+TEST(map_test, transparent_lookup) {
+  s21::map<std::string, int, std::less<>> m = {{"one", 1}, {"two", 2}, {"three", 3}};
+  std::string_view key = "two";
+  EXPECT_TRUE(m.contains(key));
+  EXPECT_FALSE(m.contains("four"));
+  EXPECT_EQ(m.at(key), 2);
+  EXPECT_EQ((*m.find("three")).second, 3);
+  EXPECT_EQ(m.find(std::string_view("zero")), m.end());
+  EXPECT_THROW(m.at("zero"), std::out_of_range);
+  const auto& cm = m;
+  EXPECT_EQ(cm.at(std::string_view("one")), 1);
+}
+
+namespace {
+struct CountedValue {
+  static int defaults;
+  CountedValue() { ++defaults; }
+  CountedValue(int v) : value(v) {}
+  int value = 0;
+};
+int CountedValue::defaults = 0;
+}  // namespace
+
+TEST(map_test, lookup_without_temporaries) {
+  s21::map<int, CountedValue> m;
+  m.insert(1, CountedValue(10));
+  m.insert(2, CountedValue(20));
+  CountedValue::defaults = 0;
+  EXPECT_TRUE(m.contains(1));
+  EXPECT_FALSE(m.contains(3));
+  EXPECT_EQ(m.at(2).value, 20);
+  EXPECT_EQ(m[1].value, 10);
+  EXPECT_EQ((*m.find(2)).second.value, 20);
+  m.insert_or_assign(1, CountedValue(11));
+  EXPECT_EQ(CountedValue::defaults, 0);
+  EXPECT_EQ(m[3].value, 0);
+  EXPECT_EQ(CountedValue::defaults, 1);
+}
+
+TEST(map_test, try_emplace) {
+  s21::map<std::string, std::unique_ptr<int>> m;
+  auto res = m.try_emplace("a", new int(1));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(*(*res.first).second, 1);
+  // Ключ уже есть: аргумент не трогаем
+  std::unique_ptr<int> value(new int(2));
+  res = m.try_emplace("a", std::move(value));
+  EXPECT_FALSE(res.second);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*(*res.first).second, 1);
+  std::string key = "b";
+  res = m.try_emplace(std::move(key), std::move(value));
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(value, nullptr);
+  EXPECT_EQ((*res.first).first, "b");
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_EQ(m["c"], nullptr);
+  EXPECT_EQ(m.size(), 3U);
+}
+
+TEST(map_test, subscript_counter) {
+  s21::map<int, int> m;
+  std::map<int, int> mc;
+  for (int i = 0; i < 1000; ++i) {
+    ++m[i % 37];
+    ++mc[i % 37];
+  }
+  auto res = m.insert_or_assign(5, -5);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(m[5], -5);
+  mc[5] = -5;
+  ASSERT_EQ(m.size(), mc.size());
+  auto y = mc.begin();
+  for (auto x = m.begin(); x != m.end(); ++x, ++y) {
+    EXPECT_EQ((*x).first, (*y).first);
+    EXPECT_EQ((*x).second, (*y).second);
+  }
+}
+
+TEST(map_test, split_and_join_archive) {
+  s21::map<int, std::string> live;
+  s21::map<int, std::string> archive;
+  for (int minute = 0; minute < 10; ++minute) {
+    for (int t = minute * 1000; t < (minute + 1) * 1000; ++t) {
+      live.insert(t, std::to_string(t));
+    }
+    // Все старше последних 2000 значений уходит в архив
+    s21::map<int, std::string> recent = live.split((minute + 1) * 1000 - 2000);
+    archive.join(live);
+    EXPECT_TRUE(live.empty());
+    live.swap(recent);
+  }
+  EXPECT_EQ(live.size(), 2000U);
+  EXPECT_EQ(archive.size(), 8000U);
+  EXPECT_EQ((*live.begin()).first, 8000);
+  EXPECT_EQ((*std::prev(archive.end())).first, 7999);
+  int expected = 0;
+  for (auto it = archive.begin(); it != archive.end(); ++it, ++expected) {
+    ASSERT_EQ((*it).first, expected);
+    ASSERT_EQ((*it).second, std::to_string(expected));
+  }
+  // Деревья остаются рабочими после склеек
+  archive.insert(-1, "x");
+  archive.erase(archive.find(4000));
+  EXPECT_EQ(archive.at(-1), "x");
+  EXPECT_FALSE(archive.contains(4000));
+  EXPECT_EQ(archive.size(), 8000U);
+
+  s21::map<int, std::string> overlapping = {{100, "a"}};
+  EXPECT_THROW(archive.join(overlapping), std::invalid_argument);
+  EXPECT_EQ(overlapping.size(), 1U);
+  s21::map<int, std::string> before = {{-5, "b"}, {-3, "c"}};
+  archive.join(before);
+  EXPECT_EQ((*archive.begin()).first, -5);
+}
+
+TEST(map_test, join_different_allocators) {
+  using pair_alloc = CountingAllocator<std::pair<const int, int>>;
+  std::ptrdiff_t bytes = 0;
+  std::ptrdiff_t other_bytes = 0;
+  {
+    s21::map<int, int, std::less<int>, pair_alloc> a{pair_alloc(&bytes)};
+    s21::map<int, int, std::less<int>, pair_alloc> b{pair_alloc(&other_bytes)};
+    for (int i = 0; i < 100; ++i) {
+      a.insert(i, i);
+      b.insert(100 + i, i);
+    }
+    a.join(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.size(), 200U);
+    EXPECT_EQ((*std::prev(a.end())).first, 199);
+    auto upper = a.split(150);
+    EXPECT_EQ(upper.size(), 50U);
+    EXPECT_EQ(a.size(), 150U);
+    EXPECT_EQ(upper.get_allocator(), pair_alloc(&bytes));
+  }
+  EXPECT_EQ(bytes, 0);
+  EXPECT_EQ(other_bytes, 0);
+}
+
+struct ThrowingCopy {
+  static int alive;
+  static int copies_left;
+  int value = 0;
+  ThrowingCopy() { ++alive; }
+  ThrowingCopy(int v) : value(v) { ++alive; }
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left-- == 0) throw std::runtime_error("copy");
+    ++alive;
+  }
+  ~ThrowingCopy() { --alive; }
+};
+int ThrowingCopy::alive = 0;
+int ThrowingCopy::copies_left = -1;
+
+TEST(map_test, copy_is_iterative_and_cleans_up) {
+  {
+    s21::map<int, ThrowingCopy> m;
+    for (int i = 0; i < 5000; ++i) {
+      m.emplace(i, i);
+    }
+    int before = ThrowingCopy::alive;
+    ThrowingCopy::copies_left = 2500;
+    using throwing_map = s21::map<int, ThrowingCopy>;
+    EXPECT_THROW(throwing_map failed(m), std::runtime_error);
+    // Все элементы, скопированные до исключения, уничтожены
+    EXPECT_EQ(ThrowingCopy::alive, before);
+    ThrowingCopy::copies_left = -1;
+    s21::map<int, ThrowingCopy> copy(m);
+    EXPECT_EQ(copy.size(), 5000U);
+    int expected = 0;
+    for (auto it = copy.begin(); it != copy.end(); ++it, ++expected) {
+      ASSERT_EQ((*it).first, expected);
+      ASSERT_EQ((*it).second.value, expected);
+    }
+    copy.clear();
+    // + значение по умолчанию в служебном узле copy
+    EXPECT_EQ(ThrowingCopy::alive, before + 1);
+    copy = m;
+    copy.erase(copy.find(10));
+    EXPECT_EQ(copy.size(), 4999U);
+  }
+  EXPECT_EQ(ThrowingCopy::alive, 0);
+}
+
+static_assert(std::is_nothrow_move_constructible<s21::map<int, std::string>>::value,
+              "map move must not allocate");
+static_assert(std::is_nothrow_swappable<s21::map<int, std::string>>::value, "map swap must not allocate");
+
+TEST(map_test, move_and_swap_do_not_allocate) {
+  std::ptrdiff_t bytes = 0;
+  {
+    using pair_alloc = CountingAllocator<std::pair<const int, std::string>>;
+    using alloc_map = s21::map<int, std::string, std::less<int>, pair_alloc>;
+    alloc_map a({{1, "one"}, {2, "two"}}, std::less<int>(), pair_alloc(&bytes));
+    alloc_map b({{3, "three"}}, std::less<int>(), pair_alloc(&bytes));
+    const std::string* one = &a.at(1);
+    std::ptrdiff_t before = bytes;
+
+    alloc_map moved(std::move(a));
+    EXPECT_EQ(bytes, before);
+    EXPECT_EQ(&moved.at(1), one);
+    EXPECT_TRUE(a.empty());
+
+    moved.swap(b);
+    EXPECT_EQ(bytes, before);
+    EXPECT_EQ(&b.at(1), one);
+    EXPECT_EQ(moved.at(3), "three");
+    EXPECT_EQ(b.size(), 2U);
+  }
+  EXPECT_EQ(bytes, 0);
+}
+
+TEST(map_test, vector_growth_moves_maps) {
+  std::vector<s21::map<int, std::string>> maps;
+  maps.emplace_back();
+  maps[0].insert(1, "one");
+  const std::string* one = &maps[0].at(1);
+  for (int i = 0; i < 100; ++i) {
+    maps.emplace_back();
+  }
+  // Вектор перемещает карты, а не копирует: узлы остаются на месте
+  EXPECT_EQ(&maps[0].at(1), one);
+}
+
+TEST(map_test, merge_relinks_nodes) {
+  std::ptrdiff_t bytes = 0;
+  {
+    using pair_alloc = CountingAllocator<std::pair<const int, std::string>>;
+    using alloc_map = s21::map<int, std::string, std::less<int>, pair_alloc>;
+    alloc_map a({{1, "one"}, {3, "three"}}, std::less<int>(), pair_alloc(&bytes));
+    alloc_map b({{2, "two"}, {3, "other"}, {4, "four"}}, std::less<int>(), pair_alloc(&bytes));
+    const std::string* two = &b.at(2);
+    const std::string* four = &b.at(4);
+
+    a.merge(b);
+    EXPECT_EQ(a.size(), 4U);
+    EXPECT_EQ(b.size(), 1U);
+    EXPECT_EQ(b.at(3), "other");
+    // Узлы перевешены, а не созданы заново
+    EXPECT_EQ(&a.at(2), two);
+    EXPECT_EQ(&a.at(4), four);
+
+    // Память b теперь держат оба дерева: она живет, пока жив хотя бы один
+    {
+      alloc_map gone(std::move(b));
+    }
+    EXPECT_EQ(a.at(2), "two");
+    a.insert(5, "five");
+    EXPECT_EQ(a.at(4), "four");
+  }
+  EXPECT_EQ(bytes, 0);
+}
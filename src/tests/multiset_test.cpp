@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 #include "../s21_containersplus.h"
 #include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "counting_allocator.h"
 
 auto test1 = {'1', '2', '3', '4', '5'};
 auto test2 = {'1', '2', '3', '4', '5'};
@@ -222,9 +230,9 @@ TEST(multiset_test, lower_bound) {
   ASSERT_EQ(*x, 2);
 }
 
-TEST(multiset_test, emplace_4) {
+TEST(multiset_test, insert_many) {
   s21::multiset<double> v = {2, -3, 20, -5, 1, -6};
-  v.emplace(8, 42, 26, 1, 1, 1);
+  v.insert_many(8, 42, 26, 1, 1, 1);
   s21::multiset<double>::iterator x = v.lower_bound(8);
   --x;
   ASSERT_EQ(*x, 2);
@@ -258,6 +266,46 @@ TEST(multiset_test, equal_range) {
   ASSERT_EQ(*x.second, 20);
 }
 
+TEST(multiset_test, equal_range_bounds) {
+  s21::multiset<int> v = {5, 5, 5, 7, 9, 9};
+  auto past_end = v.equal_range(10);
+  EXPECT_EQ(past_end.first, v.end());
+  EXPECT_EQ(past_end.second, v.end());
+  auto last = v.equal_range(9);
+  EXPECT_EQ(*last.first, 9);
+  EXPECT_EQ(last.second, v.end());
+  auto missing = v.equal_range(6);
+  EXPECT_EQ(missing.first, missing.second);
+  EXPECT_EQ(*missing.first, 7);
+  const s21::multiset<int>& cref = v;
+  auto first = cref.equal_range(5);
+  EXPECT_EQ(first.first, cref.begin());
+  EXPECT_EQ(std::distance(first.first, first.second), 3);
+  EXPECT_EQ(v.count(10), 0U);
+  EXPECT_EQ(v.count(9), 2U);
+}
+
+TEST(multiset_test, count_many_duplicates) {
+  std::vector<int> keys;
+  for (int i = 0; i < 30000; ++i) {
+    keys.push_back(i % 3);
+  }
+  s21::multiset<int> plain(keys.begin(), keys.end());
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> ranked(keys.begin(), keys.end());
+  for (int i = 0; i < 5000; ++i) {
+    plain.insert(1);
+    ranked.insert(1);
+  }
+  ranked.erase(ranked.find(2));
+  EXPECT_EQ(plain.count(1), 15000U);
+  EXPECT_EQ(ranked.count(1), 15000U);
+  EXPECT_EQ(ranked.count(2), 9999U);
+  EXPECT_EQ(ranked.count(3), 0U);
+  auto range = ranked.equal_range(1);
+  EXPECT_EQ(ranked.rank(1), 10000U);
+  EXPECT_EQ(static_cast<size_t>(std::distance(range.first, range.second)), 15000U);
+}
+
 TEST(multiset_test, cont) {
   s21::multiset<double> v = {2, -3, 20, -5, 1, -6, 8, 42, 26, 1, 1, 1, 8, 8, 8};
   EXPECT_EQ(v.count(1), 4);
@@ -304,6 +352,89 @@ TEST(multiset_test, merge_4) {
   }
 }
 
+TEST(multiset_test, merge_5) {
+  s21::multiset<std::string> v = {"b", "d", "d"};
+  {
+    s21::multiset<std::string> v1 = {"a", "d", "e"};
+    v.merge(v1);
+    EXPECT_TRUE(v1.empty());
+  }
+  std::multiset<std::string> vc = {"a", "b", "d", "d", "d", "e"};
+  v.erase(v.begin());
+  vc.erase(vc.begin());
+  v.insert("c");
+  vc.insert("c");
+  ASSERT_EQ(v.size(), vc.size());
+  auto x = v.begin();
+  for (auto y = vc.begin(); y != vc.end(); ++x, ++y) {
+    EXPECT_EQ(*x, *y);
+  }
+}
+
+TEST(multiset_test, allocator) {
+  std::ptrdiff_t bytes = 0;
+  {
+    s21::multiset<int, std::greater<int>, CountingAllocator<int>> v{std::greater<int>(),
+                                                                   CountingAllocator<int>(&bytes)};
+    v.insert(1);
+    v.insert(3);
+    v.insert(1);
+    EXPECT_GT(bytes, 0);
+    EXPECT_EQ(v.size(), 3U);
+    EXPECT_EQ(*v.begin(), 3);
+    auto copy = v;
+    EXPECT_EQ(copy.count(1), 2U);
+  }
+  EXPECT_EQ(bytes, 0);
+}
+
+TEST(multiset_test, insert_hint) {
+  s21::multiset<int> v;
+  std::multiset<int> vc;
+  for (int i = 0; i < 100; ++i) {
+    auto it = v.insert(v.end(), i / 3);
+    vc.insert(vc.end(), i / 3);
+    EXPECT_EQ(*it, i / 3);
+  }
+  for (int i = 0; i < 100; i += 7) {
+    v.insert(v.find(i / 2), i / 2);
+    vc.insert(vc.find(i / 2), i / 2);
+    v.emplace_hint(v.begin(), i);
+    vc.emplace_hint(vc.begin(), i);
+  }
+  ASSERT_EQ(v.size(), vc.size());
+  EXPECT_EQ(v.count(5), vc.count(5));
+  auto y = vc.begin();
+  for (auto x = v.begin(); x != v.end(); ++x, ++y) {
+    EXPECT_EQ(*x, *y);
+  }
+}
+
+TEST(multiset_test, constructor_range) {
+  std::vector<int> items = {4, 1, 4, 2, 1, 4, 0};
+  s21::multiset<int> v(items.begin(), items.end());
+  std::multiset<int> vc(items.begin(), items.end());
+  ASSERT_EQ(v.size(), vc.size());
+  EXPECT_EQ(v.count(4), 3U);
+  auto y = vc.begin();
+  for (auto x = v.begin(); x != v.end(); ++x, ++y) {
+    EXPECT_EQ(*x, *y);
+  }
+  v.assign_sorted(vc.begin(), vc.end());
+  EXPECT_EQ(v.size(), vc.size());
+  EXPECT_EQ(*v.begin(), 0);
+}
+
+TEST(multiset_test, contains_missing) {
+  s21::multiset<int> v = {1, 2, 2};
+  EXPECT_FALSE(v.contains(0));
+  EXPECT_FALSE(v.contains(3));
+  EXPECT_TRUE(v.contains(2));
+  s21::multiset<std::string, std::less<>> words = {"a", "b", "b"};
+  EXPECT_TRUE(words.contains(std::string_view("b")));
+  EXPECT_EQ(words.find("c"), words.end());
+}
+
 TEST(multiset_test, operator_eq) {
   s21::multiset<double> v = {-3, 1, -5, 42, 2, -6, 8, 20, 26};
   s21::multiset<double> v1 = {100, 200, 300, 400, 500};
@@ -543,42 +674,199 @@ TEST(multiset_test, insert3) {
 //     EXPECT_EQ(*(it1), *(it2));
 // }
 
-// TEST(multiset_test, emplace) {
-//     struct structure {
-//         int x_;
-//         long double y_;
-//         char z_;
-//         bool operator==(const structure &other) const {
-//             return (x_ == other.x_ && y_ == other.y_ && z_ == other.z_);
-//         }
-//         bool operator>(const structure &other) const { return x_ > other.x_; }
-//         bool operator<(const structure &other) const { return x_ < other.x_; }
-//         bool operator>=(const structure &other) const { return x_ >= other.x_; }
-//         bool operator<=(const structure &other) const { return x_ <= other.x_; }
-//         structure() {
-//             x_ = 0;
-//             y_ = 0;
-//             z_ = 0;
-//         }
-//         structure(int x, long double y, char z) : x_(x), y_(y), z_(z) {}
-//     };
-//     const structure elem1 = {6, 7., '8'};
-//     const structure elem2 = {7, 8., '9'};
-//     const structure expecting_result = {1, 2., '3'};
-//     std::initializer_list<structure> a = {elem1, elem2};
-//     s21::multiset<structure> set1(a);
-//     auto v1 = set1.emplace(1, 2., '3');
-//     auto it_res = set1.begin();
-//     EXPECT_TRUE(*it_res == expecting_result);
-//     ++it_res;
-//     EXPECT_TRUE(*it_res == elem1);
-//     ++it_res;
-//     EXPECT_TRUE(*it_res == elem2);
-//     EXPECT_EQ(v1.at(0).second, true);
-// }
+TEST(multiset_test, emplace) {
+    struct structure {
+        int x_;
+        long double y_;
+        char z_;
+        bool operator==(const structure &other) const {
+            return (x_ == other.x_ && y_ == other.y_ && z_ == other.z_);
+        }
+        bool operator>(const structure &other) const { return x_ > other.x_; }
+        bool operator<(const structure &other) const { return x_ < other.x_; }
+        bool operator>=(const structure &other) const { return x_ >= other.x_; }
+        bool operator<=(const structure &other) const { return x_ <= other.x_; }
+        structure() {
+            x_ = 0;
+            y_ = 0;
+            z_ = 0;
+        }
+        structure(int x, long double y, char z) : x_(x), y_(y), z_(z) {}
+    };
+    const structure elem1 = {6, 7., '8'};
+    const structure elem2 = {7, 8., '9'};
+    const structure expecting_result = {1, 2., '3'};
+    std::initializer_list<structure> a = {elem1, elem2};
+    s21::multiset<structure> set1(a);
+    auto v1 = set1.emplace(1, 2., '3');
+    auto it_res = set1.begin();
+    EXPECT_TRUE(*it_res == expecting_result);
+    ++it_res;
+    EXPECT_TRUE(*it_res == elem1);
+    ++it_res;
+    EXPECT_TRUE(*it_res == elem2);
+    EXPECT_TRUE(*v1 == expecting_result);
+}
+
+namespace {
+using ranked_multiset = s21::multiset<int, std::less<int>, std::allocator<int>, true>;
+
+// Сверяет nth_element, rank и count_range со значениями, посчитанными обходом std::multiset
+void expect_order_statistics(const ranked_multiset& actual, const std::multiset<int>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  size_t k = 0;
+  for (int value : expected) {
+    auto it = actual.nth_element(k);
+    ASSERT_NE(it, actual.end());
+    EXPECT_EQ(*it, value);
+    ++k;
+  }
+  EXPECT_EQ(actual.nth_element(k), actual.end());
+  for (int key = -1; key <= 41; key += 3) {
+    size_t rank = static_cast<size_t>(std::distance(expected.begin(), expected.lower_bound(key)));
+    EXPECT_EQ(actual.rank(key), rank);
+    size_t in_range = static_cast<size_t>(std::distance(expected.lower_bound(key), expected.lower_bound(key + 7)));
+    EXPECT_EQ(actual.count_range(key, key + 7), in_range);
+  }
+}
+}  // namespace
+
+TEST(multiset_test, order_statistics_after_modifications) {
+  ranked_multiset a;
+  std::multiset<int> b;
+  unsigned seed = 7;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    int value = static_cast<int>((seed >> 16) % 40);
+    if (i % 3 == 2 && !b.empty()) {
+      a.erase(a.find(value) != a.end() ? a.find(value) : a.begin());
+      b.erase(b.find(value) != b.end() ? b.find(value) : b.begin());
+    } else if (i % 5 == 0) {
+      a.insert(a.end(), value);
+      b.insert(value);
+    } else {
+      a.insert(value);
+      b.insert(value);
+    }
+  }
+  expect_order_statistics(a, b);
+
+  ranked_multiset copy(a);
+  expect_order_statistics(copy, b);
+
+  ranked_multiset other = {5, 5, 17, 39, 0};
+  b.insert({5, 5, 17, 39, 0});
+  a.merge(other);
+  EXPECT_TRUE(other.empty());
+  expect_order_statistics(a, b);
+
+  std::vector<int> sorted(b.begin(), b.end());
+  ranked_multiset built(sorted.begin(), sorted.end());
+  expect_order_statistics(built, b);
+  EXPECT_EQ(a.count_range(30, 10), 0U);
+}
+
+TEST(multiset_test, order_statistics_percentiles) {
+  ranked_multiset samples;
+  for (int i = 1000; i >= 1; --i) {
+    samples.insert(i);
+  }
+  EXPECT_EQ(*samples.nth_element(samples.size() / 2), 501);
+  EXPECT_EQ(*samples.nth_element(samples.size() * 99 / 100), 991);
+  // Окно последних значений: старые выбрасываем, перцентили двигаются
+  for (int i = 1; i <= 500; ++i) {
+    samples.erase(samples.find(i));
+    samples.insert(2000 + i);
+  }
+  EXPECT_EQ(*samples.nth_element(0), 501);
+  EXPECT_EQ(*samples.nth_element(samples.size() / 2 - 1), 1000);
+  EXPECT_EQ(*samples.nth_element(samples.size() / 2), 2001);
+  EXPECT_EQ(samples.rank(2001), 500U);
+  EXPECT_EQ(samples.count_range(900, 2100), 200U);
+}
+
+TEST(multiset_test, set_algebra_counts) {
+  s21::multiset<int> a = {1, 1, 1, 2, 3, 3, 5};
+  s21::multiset<int> b = {1, 2, 2, 3, 3, 3, 4};
+  std::multiset<int> sa(a.begin(), a.end()), sb(b.begin(), b.end());
+  auto as_vector = [](const s21::multiset<int>& s) { return std::vector<int>(s.begin(), s.end()); };
+  std::vector<int> expected;
+  std::set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expected));
+  EXPECT_EQ(as_vector(a | b), expected);
+  s21::multiset<int> c = a;
+  EXPECT_EQ(as_vector(c.union_with(b)), expected);
+
+  expected.clear();
+  std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expected));
+  EXPECT_EQ(as_vector(a & b), expected);
+  c = a;
+  EXPECT_EQ(as_vector(c.intersect_with(b)), expected);
+
+  expected.clear();
+  std::set_difference(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expected));
+  EXPECT_EQ(as_vector(a - b), expected);
+  c = a;
+  EXPECT_EQ(as_vector(c.difference_with(b)), expected);
+
+  expected.clear();
+  std::set_symmetric_difference(sa.begin(), sa.end(), sb.begin(), sb.end(), std::back_inserter(expected));
+  EXPECT_EQ(as_vector(a ^ b), expected);
+  c = a;
+  EXPECT_EQ(as_vector(c.symmetric_difference_with(b)), expected);
+  EXPECT_EQ(c.count(1), 2U);
+}
+
+TEST(multiset_test, set_algebra_throwing_copy_keeps_tree) {
+  struct Fragile {
+    int value;
+    bool fail;
+    Fragile() : Fragile(0) {}
+    Fragile(int v, bool f = false) : value(v), fail(f) {}
+    Fragile(const Fragile& other) : value(other.value), fail(other.fail) {
+      if (fail) throw std::runtime_error("copy");
+    }
+    bool operator<(const Fragile& other) const { return value < other.value; }
+  };
+  s21::multiset<Fragile> a;
+  a.insert(Fragile(1));
+  a.insert(Fragile(3));
+  s21::multiset<Fragile> b;
+  b.insert(Fragile(2));
+  b.emplace(4, true);
+  EXPECT_THROW(a.union_with(b), std::runtime_error);
+  ASSERT_EQ(a.size(), 2U);
+  EXPECT_EQ((*a.begin()).value, 1);
+  EXPECT_EQ((*std::prev(a.end())).value, 3);
+  EXPECT_THROW(a | b, std::runtime_error);
+}
+
+TEST(multiset_test, split_and_join_duplicates) {
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> a;
+  for (int i = 0; i < 3000; ++i) {
+    a.insert(i % 30);
+  }
+  auto upper = a.split(10);
+  EXPECT_EQ(a.size(), 1000U);
+  EXPECT_EQ(upper.size(), 2000U);
+  EXPECT_EQ(upper.count(10), 100U);
+  EXPECT_EQ(*upper.nth_element(100), 11);
+  EXPECT_EQ(*a.nth_element(999), 9);
+  // Равные ключи на стыке допустимы
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> tail = {29, 29, 40};
+  upper.join(tail);
+  EXPECT_EQ(upper.count(29), 102U);
+  upper.join(a);
+  EXPECT_EQ(upper.size(), 3003U);
+  EXPECT_EQ(upper.rank(10), 1000U);
+  EXPECT_EQ(*upper.nth_element(3002), 40);
+}
 
 // int main(int argc, char **argv) {
 //     ::testing::InitGoogleTest(&argc, argv);
 //     return RUN_ALL_TESTS();
 // }
 
+
+static_assert(std::is_nothrow_move_constructible<s21::multiset<std::string>>::value,
+              "multiset move must not allocate");
+static_assert(std::is_nothrow_swappable<s21::multiset<std::string>>::value, "multiset swap must not allocate");
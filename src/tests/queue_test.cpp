@@ -66,12 +66,12 @@ TEST(queue_test, size) {
     EXPECT_EQ(0, it2);
 }
 
-TEST(queue_test, emplace_back) {
+TEST(queue_test, insert_many_back) {
     s21::queue<int> a;
     a.push(1);
     a.push(2);
     a.push(3);
-    a.emplace_back(1, 1, 2, 5, 6);
+    a.insert_many_back(1, 1, 2, 5, 6);
     auto it = a.size();
     EXPECT_EQ(8, it);
     EXPECT_EQ(a.front(), 1);
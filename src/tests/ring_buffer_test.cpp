@@ -0,0 +1,116 @@
+#include "../s21_containersplus.h"
+#include <gtest/gtest.h>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+constexpr int DrainAtCompileTime() {
+  s21::ring_buffer<int, 4> r = {1, 2, 3};
+  r.pop();
+  r.push(4);
+  r.push(5);
+  int first = 0;
+  r.try_pop(first);
+  bool pushed = r.try_push(6);
+  bool overflow = r.try_push(7);
+  int sum = 0;
+  for (std::size_t i = 0; i < r.size(); ++i) sum = sum * 10 + r[i];
+  return sum * 100 + first * 10 + (pushed ? 1 : 0) + (overflow ? 5 : 0);
+}
+
+static_assert(DrainAtCompileTime() == 3456 * 100 + 2 * 10 + 1, "ring_buffer must work in constexpr");
+static_assert(std::is_trivially_copyable<s21::ring_buffer<int, 8>>::value,
+              "ring_buffer of trivial elements stays trivially copyable");
+
+}  // namespace
+
+TEST(ring_buffer_test, fifo_with_wraparound) {
+  s21::ring_buffer<int, 4> r;
+  EXPECT_TRUE(r.empty());
+  EXPECT_THROW(r.pop(), std::out_of_range);
+  EXPECT_THROW(r.front(), std::out_of_range);
+  for (int round = 0; round < 10; ++round) {
+    r.push(round);
+    r.push(round + 100);
+    EXPECT_EQ(r.front(), round);
+    EXPECT_EQ(r.back(), round + 100);
+    r.pop();
+    r.pop();
+  }
+  r.push(1);
+  r.push(2);
+  r.push(3);
+  r.emplace(4);
+  EXPECT_TRUE(r.full());
+  EXPECT_THROW(r.push(5), std::out_of_range);
+  EXPECT_FALSE(r.try_push(5));
+  EXPECT_EQ(r[0], 1);
+  EXPECT_EQ(r[3], 4);
+  int out = 0;
+  EXPECT_TRUE(r.try_pop(out));
+  EXPECT_EQ(out, 1);
+  EXPECT_EQ(r.size(), 3);
+  r.clear();
+  EXPECT_FALSE(r.try_pop(out));
+  EXPECT_THROW((s21::ring_buffer<int, 2>{1, 2, 3}), std::out_of_range);
+}
+
+TEST(ring_buffer_test, matches_std_deque_with_strings) {
+  std::mt19937 rng(11);
+  s21::ring_buffer<std::string, 8> r;
+  std::deque<std::string> expected;
+  for (int step = 0; step < 5000; ++step) {
+    if (rng() % 2 == 0) {
+      std::string value = std::to_string(step) + std::string(rng() % 30, 'x');
+      bool pushed = r.try_push(value);
+      EXPECT_EQ(pushed, expected.size() < 8);
+      if (pushed) expected.push_back(value);
+    } else {
+      std::string value;
+      bool popped = r.try_pop(value);
+      EXPECT_EQ(popped, !expected.empty());
+      if (popped) {
+        EXPECT_EQ(value, expected.front());
+        expected.pop_front();
+      }
+    }
+    ASSERT_EQ(r.size(), expected.size());
+    if (!expected.empty()) {
+      EXPECT_EQ(r.front(), expected.front());
+      EXPECT_EQ(r.back(), expected.back());
+    }
+  }
+}
+
+TEST(ring_buffer_test, copy_move_swap) {
+  s21::ring_buffer<std::unique_ptr<int>, 4> owners;
+  owners.push(std::make_unique<int>(1));
+  owners.push(std::make_unique<int>(2));
+  owners.pop();
+  owners.push(std::make_unique<int>(3));
+  owners.push(std::make_unique<int>(4));
+  owners.push(std::make_unique<int>(5));
+  s21::ring_buffer<std::unique_ptr<int>, 4> moved(std::move(owners));
+  EXPECT_TRUE(owners.empty());
+  ASSERT_EQ(moved.size(), 4);
+  EXPECT_EQ(*moved.front(), 2);
+  EXPECT_EQ(*moved.back(), 5);
+
+  s21::ring_buffer<std::string, 2> a = {"a"};
+  s21::ring_buffer<std::string, 2> b = {"x", "y"};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 2);
+  EXPECT_EQ(a.front(), "x");
+  EXPECT_EQ(b.front(), "a");
+  s21::ring_buffer<std::string, 2> c(a);
+  c.pop();
+  c.push("z");
+  EXPECT_EQ(c[0], "y");
+  EXPECT_EQ(c[1], "z");
+  a = c;
+  EXPECT_EQ(a.back(), "z");
+}
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
 #include "../s21_containers.h"
 #include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "counting_allocator.h"
 
 struct structure {
         int x_;
@@ -265,6 +273,46 @@ TEST(set_test, merge_3) {
     }
 }
 
+TEST(set_test, merge_4) {
+    s21::set<std::string> a = {"one", "two", "three"};
+    {
+        s21::set<std::string> set1 = {"two", "four"};
+        set1.merge(a);
+        EXPECT_EQ(set1.size(), 4U);
+        EXPECT_EQ(a.size(), 1U);
+    }
+    // Узлы set1 уже удалены, а оставшийся в a узел должен быть жив
+    EXPECT_EQ(*a.begin(), "two");
+    a.insert("five");
+    EXPECT_EQ(a.size(), 2U);
+}
+
+TEST(set_test, erase_reuse) {
+    s21::set<int> set1;
+    std::set<int> set2;
+    for (int i = 0; i < 1000; i++) {
+        set1.insert(i * 7 % 1000);
+        set2.insert(i * 7 % 1000);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        set1.erase(set1.find(i));
+        set2.erase(i);
+    }
+    for (int i = 1000; i < 1500; i++) {
+        set1.insert(i);
+        set2.insert(i);
+    }
+    EXPECT_EQ(set1.size(), set2.size());
+    auto it1 = set1.begin();
+    for (auto it2 = set2.begin(); it2 != set2.end(); it1++, it2++) {
+        EXPECT_EQ(*it1, *it2);
+    }
+    set1.clear();
+    EXPECT_TRUE(set1.empty());
+    set1.insert(42);
+    EXPECT_EQ(*set1.begin(), 42);
+}
+
 TEST(set_test, iterator_1) {
     s21::set<char> set1 = {'a', '2', 'c', '4', 'e', '6'};
     s21::set<char> set2 = {'a', '2', 'c', '4', 'e', '6'};
@@ -306,3 +354,281 @@ TEST(set_test, contains_1) {
     EXPECT_EQ(set2.contains('a'), true);
 }
 
+
+TEST(set_test, insert_hint) {
+    s21::set<int> s;
+    std::set<int> sc;
+    // Возрастающие ключи с подсказкой end()
+    for (int i = 0; i < 200; i += 2) {
+        auto it = s.insert(s.end(), i);
+        sc.insert(sc.end(), i);
+        EXPECT_EQ(*it, i);
+    }
+    // Верные подсказки внутри дерева и заведомо неверные
+    for (int i = 1; i < 200; i += 4) {
+        s.insert(s.find(i + 1), i);
+        sc.insert(i);
+        s.insert(s.begin(), i + 2);
+        sc.insert(i + 2);
+    }
+    // Повтор с подсказкой возвращает уже имеющийся элемент
+    auto it = s.insert(s.find(10), 10);
+    EXPECT_EQ(it, s.find(10));
+    s.emplace_hint(s.begin(), -1);
+    sc.emplace_hint(sc.begin(), -1);
+    ASSERT_EQ(s.size(), sc.size());
+    auto y = sc.begin();
+    for (auto x = s.begin(); x != s.end(); ++x, ++y) {
+        EXPECT_EQ(*x, *y);
+    }
+    for (int i = -1; i < 200; i += 3) {
+        s.erase(s.find(i));
+        sc.erase(i);
+    }
+    y = sc.begin();
+    for (auto x = s.begin(); x != s.end(); ++x, ++y) {
+        EXPECT_EQ(*x, *y);
+    }
+}
+
+TEST(set_test, constructor_range) {
+    std::vector<int> items = {5, 3, 9, 3, 1, 7, 5, 0};
+    s21::set<int> s(items.begin(), items.end());
+    std::set<int> sc(items.begin(), items.end());
+    ASSERT_EQ(s.size(), sc.size());
+    auto y = sc.begin();
+    for (auto x = s.begin(); x != s.end(); ++x, ++y) {
+        EXPECT_EQ(*x, *y);
+    }
+    s21::set<int> copy(s.begin(), s.end());
+    EXPECT_EQ(copy.size(), s.size());
+    EXPECT_TRUE(copy.contains(9));
+}
+
+TEST(set_test, assign_sorted) {
+    std::vector<int> items;
+    for (int i = 0; i < 1000; ++i) {
+        items.push_back(i / 2);
+    }
+    s21::set<int> s = {42, -1};
+    s.assign_sorted(items.begin(), items.end());
+    EXPECT_EQ(s.size(), 500U);
+    EXPECT_EQ(*s.begin(), 0);
+    EXPECT_EQ(*(--s.end()), 499);
+    EXPECT_FALSE(s.contains(-1));
+    // После сборки дерево продолжает нормально работать
+    s.insert(1000);
+    s.erase(s.find(250));
+    EXPECT_EQ(s.size(), 500U);
+    int expected = 0;
+    for (int value : s) {
+        if (expected == 250) ++expected;
+        if (expected == 500) expected = 1000;
+        EXPECT_EQ(value, expected++);
+    }
+}
+
+TEST(set_test, transparent_lookup) {
+    s21::set<std::string, std::less<>> s = {"alpha", "beta", "gamma"};
+    std::string_view key = "beta";
+    EXPECT_TRUE(s.contains(key));
+    EXPECT_FALSE(s.contains("delta"));
+    EXPECT_EQ(*s.find(key), "beta");
+    EXPECT_EQ(s.find("omega"), s.end());
+}
+
+TEST(set_test, emplace_in_place) {
+    s21::set<std::string> s;
+    auto res = s.emplace(3, 'x');
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(*res.first, "xxx");
+    res = s.emplace("xxx");
+    EXPECT_FALSE(res.second);
+    auto many = s.insert_many("a", std::string("b"), "a");
+    ASSERT_EQ(many.size(), 3U);
+    EXPECT_TRUE(many[0].second);
+    EXPECT_FALSE(many[2].second);
+    EXPECT_EQ(s.size(), 3U);
+}
+
+TEST(set_test, order_statistics) {
+  s21::set<std::string, std::less<std::string>, std::allocator<std::string>, true> a;
+  for (int i = 0; i < 100; ++i) {
+    a.insert(std::to_string(1000 + i * 2));
+  }
+  a.insert("1000");
+  EXPECT_EQ(a.size(), 100U);
+  EXPECT_EQ(*a.nth_element(0), "1000");
+  EXPECT_EQ(*a.nth_element(99), "1198");
+  EXPECT_EQ(a.nth_element(100), a.end());
+  EXPECT_EQ(a.rank("1001"), 1U);
+  for (int i = 0; i < 100; i += 2) {
+    a.erase(a.find(std::to_string(1000 + i * 2)));
+  }
+  EXPECT_EQ(*a.nth_element(0), "1002");
+  EXPECT_EQ(a.rank("1100"), 25U);
+  EXPECT_EQ(a.count_range("1050", "1150"), 25U);
+  const auto& cref = a;
+  EXPECT_EQ(*cref.nth_element(49), "1198");
+}
+
+TEST(set_test, set_algebra) {
+  s21::set<int> a = {1, 3, 5, 7, 9, 11};
+  s21::set<int> b = {3, 4, 5, 6, 11, 20};
+  std::vector<int> expected_union, expected_inter, expected_diff, expected_sym;
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_union));
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_inter));
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_diff));
+  std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected_sym));
+
+  auto as_vector = [](const s21::set<int>& s) { return std::vector<int>(s.begin(), s.end()); };
+  EXPECT_EQ(as_vector(a | b), expected_union);
+  EXPECT_EQ(as_vector(a & b), expected_inter);
+  EXPECT_EQ(as_vector(a - b), expected_diff);
+  EXPECT_EQ(as_vector(a ^ b), expected_sym);
+
+  s21::set<int> c = a;
+  auto kept = c.find(5);
+  c.intersect_with(b);
+  EXPECT_EQ(as_vector(c), expected_inter);
+  // Свои узлы переиспользуются, итераторы на оставшиеся элементы валидны
+  EXPECT_EQ(kept, c.find(5));
+  c = a;
+  EXPECT_EQ(as_vector(c.union_with(b)), expected_union);
+  EXPECT_EQ(*c.begin(), 1);
+  EXPECT_EQ(*std::prev(c.end()), 20);
+  c = a;
+  EXPECT_EQ(as_vector(c.difference_with(b)), expected_diff);
+  c = a;
+  EXPECT_EQ(as_vector(c.symmetric_difference_with(b)), expected_sym);
+  c.symmetric_difference_with(c);
+  EXPECT_TRUE(c.empty());
+  c.union_with(a).union_with(s21::set<int>{});
+  EXPECT_EQ(c.size(), a.size());
+  c.insert(100);
+  EXPECT_EQ(*std::prev(c.end()), 100);
+}
+
+TEST(set_test, set_algebra_large) {
+  s21::set<int, std::less<int>, std::allocator<int>, true> a, b;
+  for (int i = 0; i < 20000; ++i) {
+    a.insert(i * 2);
+    b.insert(i * 3);
+  }
+  auto inter = a & b;
+  EXPECT_EQ(inter.size(), 6667U);
+  EXPECT_EQ(*inter.nth_element(1), 6);
+  a.difference_with(b);
+  EXPECT_EQ(a.size(), 20000U - 6667U);
+  EXPECT_EQ(a.rank(12), 4U);
+  EXPECT_FALSE(a.contains(6));
+  EXPECT_TRUE(a.contains(39998));
+}
+
+TEST(set_test, split_and_join) {
+  s21::set<int> a;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(i);
+  }
+  s21::set<int> upper = a.split(600);
+  EXPECT_EQ(a.size(), 600U);
+  EXPECT_EQ(upper.size(), 400U);
+  EXPECT_EQ(*std::prev(a.end()), 599);
+  EXPECT_EQ(*upper.begin(), 600);
+  EXPECT_EQ(a.split(-1).size(), 600U);
+  EXPECT_TRUE(a.empty());
+  s21::set<int> none = upper.split(5000);
+  EXPECT_TRUE(none.empty());
+  EXPECT_EQ(upper.size(), 400U);
+
+  s21::set<int> low = {1, 2, 3};
+  upper.join(low);
+  EXPECT_EQ(upper.size(), 403U);
+  EXPECT_EQ(*upper.begin(), 1);
+  s21::set<int> same = {999};
+  EXPECT_THROW(upper.join(same), std::invalid_argument);
+  a.join(upper);
+  EXPECT_EQ(a.size(), 403U);
+  EXPECT_TRUE(upper.empty());
+  int previous = 0;
+  for (int value : a) {
+    EXPECT_LT(previous, value);
+    previous = value;
+  }
+}
+
+TEST(set_test, split_and_merge_leave_independent_pools) {
+  // После split, merge и join у каждого дерева свой пул - их можно менять из разных потоков
+  s21::set<int> a;
+  for (int i = 0; i < 2000; ++i) a.insert(i);
+  s21::set<int> b = a.split(1000);
+  s21::set<int> c = {1500, 5000, 5001};
+  b.merge(c);
+  EXPECT_EQ(c.size(), 1U);
+  s21::set<int> d = {-3, -2, -1};
+  a.join(d);
+  std::thread left([&a] {
+    for (int i = 0; i < 20000; ++i) a.insert(10000 + i);
+    for (int i = 0; i < 20000; ++i) a.erase(a.find(10000 + i));
+  });
+  std::thread right([&b, &c] {
+    for (int i = 0; i < 20000; ++i) b.insert(100000 + i);
+    for (int i = 0; i < 20000; ++i) c.insert(200000 + i);
+  });
+  left.join();
+  right.join();
+  EXPECT_EQ(a.size(), 1003U);
+  EXPECT_EQ(b.size(), 21002U);
+  EXPECT_EQ(c.size(), 20001U);
+}
+
+
+static_assert(std::is_nothrow_move_constructible<s21::set<std::string>>::value, "set move must not allocate");
+static_assert(std::is_nothrow_swappable<s21::set<std::string>>::value, "set swap must not allocate");
+
+TEST(set_test, merge_keeps_references) {
+  s21::set<std::string> a = {"a", "c"};
+  s21::set<std::string> b = {"b", "c", "d"};
+  const std::string* b_ptr = &*b.find("b");
+  const std::string* d_ptr = &*b.find("d");
+  a.merge(b);
+  EXPECT_EQ(&*a.find("b"), b_ptr);
+  EXPECT_EQ(&*a.find("d"), d_ptr);
+  EXPECT_EQ(b.size(), 1U);
+  b.clear();
+  b.insert("e");
+  EXPECT_EQ(*a.find("d"), "d");
+}
+
+TEST(set_test, split_does_not_allocate) {
+  std::ptrdiff_t bytes = 0;
+  {
+    using alloc_set = s21::set<std::string, std::less<std::string>, CountingAllocator<std::string>>;
+    alloc_set upper((CountingAllocator<std::string>(&bytes)));
+    const std::string* last = nullptr;
+    {
+      alloc_set lower((CountingAllocator<std::string>(&bytes)));
+      for (int i = 0; i < 1000; ++i) {
+        lower.insert("key" + std::to_string(1000 + i));
+      }
+      last = &*lower.find("key1999");
+      std::ptrdiff_t before = bytes;
+
+      upper = lower.split("key1500");
+      EXPECT_EQ(bytes, before);
+      EXPECT_EQ(lower.size(), 500U);
+      EXPECT_EQ(upper.size(), 500U);
+      EXPECT_EQ(*std::prev(lower.end()), "key1499");
+      EXPECT_EQ(*upper.begin(), "key1500");
+      // Узлы перевешены, а не созданы заново
+      EXPECT_EQ(&*upper.find("key1999"), last);
+    }
+    // Память lower держит и upper, поэтому его узлы живут после lower
+    EXPECT_EQ(*upper.find("key1999"), "key1999");
+    upper.insert("key2000");
+    upper.erase(upper.find("key1500"));
+    EXPECT_EQ(upper.size(), 500U);
+    EXPECT_EQ(&*upper.find("key1999"), last);
+  }
+  EXPECT_EQ(bytes, 0);
+}
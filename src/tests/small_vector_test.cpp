@@ -0,0 +1,164 @@
+#include "../s21_containersplus.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "counting_allocator.h"
+
+namespace {
+
+template<typename Vector, typename T>
+void ExpectSame(const Vector& v, const std::vector<T>& expected) {
+  ASSERT_EQ(v.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(v[i], expected[i]) << "index " << i;
+  }
+}
+
+}  // namespace
+
+TEST(small_vector_test, stays_inline_without_allocations) {
+  std::ptrdiff_t bytes = 0;
+  using Alloc = CountingAllocator<int>;
+  {
+    s21::small_vector<int, 4, Alloc> v{Alloc(&bytes)};
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 4);
+    EXPECT_NE(v.data(), nullptr);
+    for (int i = 0; i < 4; ++i) v.push_back(i);
+    EXPECT_EQ(bytes, 0);
+    EXPECT_EQ(v.capacity(), 4);
+    v.insert(v.begin(), 10);
+    EXPECT_GT(bytes, 0);
+    EXPECT_EQ(v.capacity(), 8);
+    ExpectSame(v, std::vector<int>{10, 0, 1, 2, 3});
+    v.pop_back();
+    v.pop_back();
+    v.shrink_to_fit();
+    EXPECT_EQ(bytes, 0);
+    EXPECT_EQ(v.capacity(), 4);
+    ExpectSame(v, std::vector<int>{10, 0, 1});
+    v.reserve(3);
+    EXPECT_EQ(bytes, 0);
+  }
+  EXPECT_EQ(bytes, 0);
+}
+
+TEST(small_vector_test, constructors_and_access) {
+  s21::small_vector<int, 2> sized(5);
+  ExpectSame(sized, std::vector<int>(5, 0));
+  s21::small_vector<int, 8> list = {1, 2, 3};
+  EXPECT_EQ(list.front(), 1);
+  EXPECT_EQ(list.back(), 3);
+  EXPECT_EQ(list.at(1), 2);
+  EXPECT_ANY_THROW(list.at(3));
+  const s21::small_vector<int, 1> empty;
+  EXPECT_ANY_THROW(empty.front());
+  EXPECT_ANY_THROW(empty.back());
+  s21::small_vector<int, 1> popped;
+  EXPECT_ANY_THROW(popped.pop_back());
+}
+
+TEST(small_vector_test, move_inline_and_heap) {
+  s21::small_vector<std::string, 3> small = {"a", "bb", std::string(40, 'c')};
+  s21::small_vector<std::string, 3> moved(std::move(small));
+  EXPECT_TRUE(small.empty());
+  ExpectSame(moved, std::vector<std::string>{"a", "bb", std::string(40, 'c')});
+
+  s21::small_vector<std::string, 3> big = {"1", "2", "3", "4", "5"};
+  const std::string* heap = big.data();
+  s21::small_vector<std::string, 3> stolen(std::move(big));
+  EXPECT_EQ(stolen.data(), heap);
+  EXPECT_TRUE(big.empty());
+  EXPECT_EQ(big.capacity(), 3);
+  big.push_back("again");
+  EXPECT_EQ(big.front(), "again");
+
+  moved = std::move(stolen);
+  EXPECT_EQ(moved.data(), heap);
+  EXPECT_EQ(moved.size(), 5);
+  stolen = std::move(big);
+  ExpectSame(stolen, std::vector<std::string>{"again"});
+}
+
+TEST(small_vector_test, copy_keeps_contents) {
+  s21::small_vector<std::string, 2> a = {"x", "y", "z"};
+  s21::small_vector<std::string, 2> b(a);
+  ExpectSame(b, std::vector<std::string>{"x", "y", "z"});
+  s21::small_vector<std::string, 2> c = {"only"};
+  b = c;
+  ExpectSame(b, std::vector<std::string>{"only"});
+  c = a;
+  ExpectSame(c, std::vector<std::string>{"x", "y", "z"});
+  ExpectSame(a, std::vector<std::string>{"x", "y", "z"});
+}
+
+TEST(small_vector_test, swap_all_storage_combinations) {
+  using V = s21::small_vector<std::string, 3>;
+  std::vector<std::string> one = {"a"}, three = {"p", "q", "r"};
+  std::vector<std::string> five = {"1", "2", "3", "4", "5"}, six = {"u", "v", "w", "x", "y", "z"};
+  auto make = [](const std::vector<std::string>& items) {
+    V v;
+    for (const auto& item : items) v.push_back(item);
+    return v;
+  };
+  std::vector<std::vector<std::string>> cases = {one, three, five, six, {}};
+  for (const auto& left : cases) {
+    for (const auto& right : cases) {
+      V a = make(left), b = make(right);
+      a.swap(b);
+      ExpectSame(a, right);
+      ExpectSame(b, left);
+      a.push_back("tail");
+      b.push_back("tail");
+    }
+  }
+}
+
+TEST(small_vector_test, insert_erase_emplace) {
+  s21::small_vector<std::string, 4> v;
+  v.emplace_back(3, 'a');
+  v.emplace(v.begin(), "first");
+  auto it = v.insert_many(v.begin() + 1, "x", "y", "z");
+  EXPECT_EQ(*it, "z");
+  v.insert_many_back("end");
+  ExpectSame(v, std::vector<std::string>{"first", "x", "y", "z", "aaa", "end"});
+  v.erase(v.begin() + 1);
+  v.erase(v.end() - 1);
+  ExpectSame(v, std::vector<std::string>{"first", "y", "z", "aaa"});
+  EXPECT_ANY_THROW(v.erase(v.end()));
+  EXPECT_ANY_THROW(v.insert(v.end() + 1, "bad"));
+  v.push_back(v[0]);
+  EXPECT_EQ(v.back(), "first");
+  v.clear();
+  EXPECT_TRUE(v.empty());
+}
+
+TEST(small_vector_test, matches_std_vector_on_random_ops) {
+  std::mt19937 rng(7);
+  s21::small_vector<int, 5> v;
+  std::vector<int> expected;
+  for (int step = 0; step < 3000; ++step) {
+    int op = static_cast<int>(rng() % 6);
+    int value = static_cast<int>(rng() % 1000);
+    if (op < 2) {
+      v.push_back(value);
+      expected.push_back(value);
+    } else if (op == 2) {
+      size_t pos = expected.empty() ? 0 : rng() % (expected.size() + 1);
+      v.insert(v.begin() + pos, value);
+      expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), value);
+    } else if (op == 3 && !expected.empty()) {
+      size_t pos = rng() % expected.size();
+      v.erase(v.begin() + pos);
+      expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+    } else if (op == 4 && !expected.empty()) {
+      v.pop_back();
+      expected.pop_back();
+    } else if (op == 5) {
+      v.shrink_to_fit();
+    }
+    ASSERT_NO_FATAL_FAILURE(ExpectSame(v, expected));
+  }
+}
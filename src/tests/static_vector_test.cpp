@@ -0,0 +1,121 @@
+#include "../s21_containersplus.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Считает живые объекты, чтобы проверить, что контейнер уничтожает ровно то, что создал
+struct Tracked {
+  static int live;
+  std::string value;
+  Tracked(const char* v = "") : value(v) { ++live; }
+  Tracked(const Tracked& other) : value(other.value) { ++live; }
+  Tracked(Tracked&& other) noexcept : value(std::move(other.value)) { ++live; }
+  Tracked& operator=(const Tracked&) = default;
+  Tracked& operator=(Tracked&&) = default;
+  ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+
+template<typename Vector>
+std::vector<std::string> Values(const Vector& v) {
+  std::vector<std::string> out;
+  for (const auto& item : v) out.push_back(item.value);
+  return out;
+}
+
+constexpr int BuildAtCompileTime() {
+  s21::static_vector<int, 8> v = {1, 4, 9, 16};
+  v.erase(v.begin());
+  v.insert(v.begin() + 1, 100);
+  v.emplace_back(25);
+  v.pop_back();
+  s21::static_vector<int, 8> other(2);
+  other.swap(v);
+  int sum = 0;
+  for (int x : other) sum += x;
+  return sum * 10 + static_cast<int>(v.size());
+}
+
+static_assert(BuildAtCompileTime() == (4 + 100 + 9 + 16) * 10 + 2, "static_vector must work in constexpr");
+static_assert(std::is_trivially_copyable<s21::static_vector<int, 4>>::value,
+              "static_vector of trivial elements stays trivially copyable");
+static_assert(s21::static_vector<std::string, 3>::capacity() == 3, "capacity is Cap");
+
+}  // namespace
+
+TEST(static_vector_test, push_pop_and_capacity_limit) {
+  s21::static_vector<int, 3> v;
+  EXPECT_TRUE(v.empty());
+  v.push_back(1);
+  v.push_back(2);
+  v.emplace_back(3);
+  EXPECT_TRUE(v.full());
+  EXPECT_THROW(v.push_back(4), std::out_of_range);
+  EXPECT_THROW(v.insert(v.begin(), 0), std::out_of_range);
+  EXPECT_THROW(v.insert_many_back(5), std::out_of_range);
+  EXPECT_EQ(v.size(), 3);
+  EXPECT_EQ(v.front(), 1);
+  EXPECT_EQ(v.back(), 3);
+  EXPECT_EQ(v.at(1), 2);
+  EXPECT_THROW(v.at(3), std::out_of_range);
+  v.pop_back();
+  v.pop_back();
+  v.pop_back();
+  EXPECT_THROW(v.pop_back(), std::out_of_range);
+  EXPECT_THROW(v.front(), std::out_of_range);
+  EXPECT_THROW((s21::static_vector<int, 2>{1, 2, 3}), std::out_of_range);
+  EXPECT_THROW((s21::static_vector<int, 2>(3)), std::out_of_range);
+}
+
+TEST(static_vector_test, insert_erase_keep_order) {
+  s21::static_vector<std::string, 8> v = {"b", "d"};
+  v.insert(v.begin(), "a");
+  v.emplace(v.begin() + 2, 1, 'c');
+  auto it = v.insert_many(v.end(), "e", "f");
+  EXPECT_EQ(*it, "f");
+  v.insert_many_back("g");
+  EXPECT_EQ(std::vector<std::string>(v.begin(), v.end()),
+            (std::vector<std::string>{"a", "b", "c", "d", "e", "f", "g"}));
+  v.erase(v.begin());
+  v.erase(v.begin() + 2);
+  v.erase(v.end() - 1);
+  EXPECT_EQ(std::vector<std::string>(v.begin(), v.end()), (std::vector<std::string>{"b", "c", "e", "f"}));
+  EXPECT_THROW(v.erase(v.end()), std::out_of_range);
+  v.push_back(v[0]);
+  EXPECT_EQ(v.back(), "b");
+}
+
+TEST(static_vector_test, copy_move_swap_destroy_every_element) {
+  Tracked::live = 0;
+  {
+    s21::static_vector<Tracked, 4> a;
+    a.emplace_back("x");
+    a.emplace_back("y");
+    s21::static_vector<Tracked, 4> b(a);
+    EXPECT_EQ(Values(b), Values(a));
+    s21::static_vector<Tracked, 4> c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(Values(c), (std::vector<std::string>{"x", "y"}));
+    s21::static_vector<Tracked, 4> d;
+    d.emplace_back("1");
+    d.emplace_back("2");
+    d.emplace_back("3");
+    c = d;
+    EXPECT_EQ(Values(c), (std::vector<std::string>{"1", "2", "3"}));
+    c = a;
+    EXPECT_EQ(Values(c), (std::vector<std::string>{"x", "y"}));
+    d.swap(c);
+    EXPECT_EQ(Values(d), (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(Values(c), (std::vector<std::string>{"1", "2", "3"}));
+    a = std::move(c);
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(Tracked::live, 5);
+    a.erase(a.begin());
+    a.clear();
+    EXPECT_EQ(Tracked::live, 2);
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
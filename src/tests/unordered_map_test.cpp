@@ -0,0 +1,299 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include "../s21_containersplus.h"
+#include "counting_allocator.h"
+
+// Плохой хеш: все ключи в нескольких длинных цепочках, проверяет сдвиг при удалении
+struct ClusteredHash {
+  std::size_t operator()(int key) const { return static_cast<std::size_t>(key % 4); }
+};
+
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+
+TEST(unordered_map_test, basic_operations) {
+  s21::unordered_map<int, std::string> m = {{1, "one"}, {2, "two"}, {1, "uno"}};
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_EQ(m.at(1), "one");
+  EXPECT_THROW(m.at(3), std::out_of_range);
+  EXPECT_TRUE(m.insert({3, "three"}).second);
+  EXPECT_FALSE(m.insert(3, "drei").second);
+  EXPECT_EQ(m[3], "three");
+  EXPECT_EQ(m[4], "");
+  EXPECT_FALSE(m.insert_or_assign(4, "four").second);
+  EXPECT_EQ(m.at(4), "four");
+  EXPECT_TRUE(m.try_emplace(5, 3, 'x').second);
+  EXPECT_EQ(m.at(5), "xxx");
+  EXPECT_TRUE(m.emplace(6, "six").second);
+  EXPECT_TRUE(m.contains(6));
+  m.erase(m.find(6));
+  EXPECT_FALSE(m.contains(6));
+  EXPECT_EQ(m.find(6), m.end());
+  size_t count = 0;
+  for (const auto& item : m) {
+    EXPECT_EQ(m.at(item.first), item.second);
+    ++count;
+  }
+  EXPECT_EQ(count, m.size());
+  const auto& cm = m;
+  EXPECT_EQ(cm.at(1), "one");
+  EXPECT_NE(cm.find(2), cm.end());
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST(unordered_map_test, matches_std_with_collisions) {
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> dist(0, 3000);
+  s21::unordered_map<int, int, ClusteredHash> m;
+  std::unordered_map<int, int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    int key = dist(gen);
+    if (i % 2 == 0) {
+      auto it = m.find(key);
+      if (it != m.end()) m.erase(it);
+      expected.erase(key);
+    } else {
+      EXPECT_EQ(m.try_emplace(key, i).second, expected.emplace(key, i).second);
+    }
+  }
+  ASSERT_EQ(m.size(), expected.size());
+  for (const auto& item : expected) {
+    ASSERT_TRUE(m.contains(item.first));
+    EXPECT_EQ(m.at(item.first), item.second);
+  }
+  size_t count = 0;
+  for (auto it = m.begin(); it != m.end(); ++it) ++count;
+  EXPECT_EQ(count, expected.size());
+}
+
+TEST(unordered_map_test, reserve_and_rehash) {
+  s21::unordered_map<int, int> m;
+  EXPECT_EQ(m.bucket_count(), 0U);
+  m.reserve(1000);
+  size_t buckets = m.bucket_count();
+  EXPECT_GE(buckets * 7 / 8, 1000U);
+  for (int i = 0; i < 1000; ++i) m[i] = i;
+  EXPECT_EQ(m.bucket_count(), buckets);
+  EXPECT_LE(m.load_factor(), 0.875f);
+  for (int i = 0; i < 990; ++i) m.erase(m.find(i));
+  m.rehash(0);
+  EXPECT_LT(m.bucket_count(), buckets);
+  EXPECT_EQ(m.size(), 10U);
+  EXPECT_EQ(m.at(995), 995);
+  m.clear();
+  m.rehash(0);
+  EXPECT_EQ(m.bucket_count(), 0U);
+}
+
+TEST(unordered_map_test, copy_move_merge) {
+  s21::unordered_map<int, int> a;
+  for (int i = 0; i < 100; ++i) a[i] = i;
+  s21::unordered_map<int, int> b = a;
+  EXPECT_EQ(b.size(), 100U);
+  EXPECT_EQ(b.at(42), 42);
+  s21::unordered_map<int, int> c = std::move(b);
+  EXPECT_EQ(c.size(), 100U);
+  EXPECT_TRUE(b.empty());
+
+  s21::unordered_map<int, int> other = {{50, -1}, {150, 150}, {200, 200}};
+  a.merge(other);
+  EXPECT_EQ(a.size(), 102U);
+  EXPECT_EQ(a.at(50), 50);
+  ASSERT_EQ(other.size(), 1U);
+  EXPECT_EQ(other.at(50), -1);
+  a.swap(other);
+  EXPECT_EQ(a.size(), 1U);
+}
+
+TEST(unordered_map_test, insert_many_iterators_stay_valid) {
+  s21::unordered_map<int, int> m = {{1, 1}};
+  auto result = m.insert_many(std::make_pair(2, 2), std::make_pair(1, 0), std::make_pair(3, 3));
+  ASSERT_EQ(result.size(), 3U);
+  EXPECT_EQ(result[0].first->first, 2);
+  EXPECT_TRUE(result[0].second);
+  EXPECT_EQ(result[1].first->second, 1);
+  EXPECT_FALSE(result[1].second);
+  EXPECT_EQ(result[2].first->first, 3);
+}
+
+TEST(unordered_map_test, heterogeneous_lookup) {
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> m = {{"apple", 1}, {"pear", 2}};
+  std::string_view key = "pear";
+  EXPECT_TRUE(m.contains(key));
+  EXPECT_EQ(m.at(key), 2);
+  EXPECT_EQ(m.find(std::string_view("plum")), m.end());
+}
+
+TEST(unordered_map_test, allocator) {
+  std::ptrdiff_t bytes = 0;
+  {
+    using pair_alloc = CountingAllocator<std::pair<const int, std::string>>;
+    s21::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, pair_alloc> m{pair_alloc(&bytes)};
+    for (int i = 0; i < 100; ++i) m[i] = std::to_string(i);
+    EXPECT_GT(bytes, 0);
+    auto copy = m;
+    EXPECT_TRUE(copy.get_allocator() == pair_alloc(&bytes));
+    EXPECT_EQ(copy.at(42), "42");
+  }
+  EXPECT_EQ(bytes, 0);
+}
+
+namespace {
+
+// Ключ, который считает свои копии: таблица должна перемещать ключи, а не копировать
+struct CopyCountedKey {
+  static int copies;
+  int value;
+  explicit CopyCountedKey(int v) : value(v) {}
+  CopyCountedKey(const CopyCountedKey& other) : value(other.value) { ++copies; }
+  CopyCountedKey(CopyCountedKey&& other) noexcept : value(other.value) {}
+  CopyCountedKey& operator=(const CopyCountedKey&) = default;
+  CopyCountedKey& operator=(CopyCountedKey&&) = default;
+  bool operator==(const CopyCountedKey& other) const { return value == other.value; }
+};
+int CopyCountedKey::copies = 0;
+
+struct CopyCountedKeyHash {
+  std::size_t operator()(const CopyCountedKey& key) const { return static_cast<std::size_t>(key.value); }
+};
+
+}  // namespace
+
+namespace {
+
+// Ключ не standard-layout: пары с const и изменяемым ключом нельзя читать друг через друга,
+// и ячейка хранит пару с const ключом (ключ при переносе копируется)
+struct PolymorphicKey {
+  int value;
+  explicit PolymorphicKey(int v) : value(v) {}
+  virtual ~PolymorphicKey() = default;
+  PolymorphicKey(const PolymorphicKey&) = default;
+  PolymorphicKey& operator=(const PolymorphicKey&) = default;
+  bool operator==(const PolymorphicKey& other) const { return value == other.value; }
+};
+
+struct PolymorphicKeyHash {
+  std::size_t operator()(const PolymorphicKey& key) const { return static_cast<std::size_t>(key.value % 8); }
+};
+
+}  // namespace
+
+// Ключ переносится через пару с изменяемым ключом, только если раскладка пар совпадает
+static_assert(s21::SlotPolicy<std::pair<const std::string, std::string>>::kMutableKeys,
+              "string keys must be moved, not copied");
+static_assert(s21::SlotPolicy<std::pair<const CopyCountedKey, int>>::kMutableKeys,
+              "plain keys must be moved, not copied");
+static_assert(!s21::SlotPolicy<std::pair<const PolymorphicKey, int>>::kMutableKeys,
+              "non-standard-layout pairs must not be read through each other");
+
+TEST(unordered_map_test, non_standard_layout_keys) {
+  s21::unordered_map<PolymorphicKey, std::string, PolymorphicKeyHash> m;
+  for (int i = 0; i < 500; ++i) m.try_emplace(PolymorphicKey(i), std::to_string(i));
+  for (int i = 0; i < 500; i += 3) m.erase(m.find(PolymorphicKey(i)));
+  s21::unordered_map<PolymorphicKey, std::string, PolymorphicKeyHash> copy(m);
+  m.rehash(0);
+  EXPECT_EQ(m.size(), 333U);
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(m.contains(PolymorphicKey(i)), i % 3 != 0);
+    if (i % 3 != 0) {
+      EXPECT_EQ(m.at(PolymorphicKey(i)), std::to_string(i));
+      EXPECT_EQ(copy.at(PolymorphicKey(i)), std::to_string(i));
+    }
+  }
+}
+
+TEST(unordered_map_test, grow_and_erase_move_keys) {
+  s21::unordered_map<CopyCountedKey, std::string, CopyCountedKeyHash> m;
+  CopyCountedKey::copies = 0;
+  for (int i = 0; i < 2000; ++i) m.try_emplace(CopyCountedKey(i), std::to_string(i));
+  for (int i = 0; i < 2000; i += 2) m.erase(m.find(CopyCountedKey(i)));
+  m.rehash(0);
+  EXPECT_EQ(CopyCountedKey::copies, 0);
+  EXPECT_EQ(m.size(), 1000U);
+  for (int i = 1; i < 2000; i += 2) EXPECT_EQ(m.at(CopyCountedKey(i)), std::to_string(i));
+  EXPECT_FALSE(m.contains(CopyCountedKey(0)));
+}
+
+namespace {
+
+// Значение, перемещение которого может бросить: сдвиг при удалении не должен
+// оставить уничтоженную ячейку занятой или потерять элементы
+struct ThrowingMove {
+  // сколько копий и перемещений пройдет до исключения, отрицательное - без исключений
+  static int fuse;
+  // длинная строка в куче: двойное уничтожение заметит ASan
+  std::string value;
+  explicit ThrowingMove(int v) : value(std::to_string(v) + std::string(32, '#')) {}
+  ThrowingMove(const ThrowingMove& other) : value(other.value) { Burn(); }
+  ThrowingMove(ThrowingMove&& other) : value(other.value) { Burn(); }
+  static void Burn() {
+    if (fuse >= 0 && fuse-- == 0) throw std::runtime_error("move");
+  }
+};
+int ThrowingMove::fuse = -1;
+
+// Все ключи в одной цепочке длиннее группы: пустая ячейка посреди цепочки
+// обрывает поиск следующих за ней ключей
+struct ConstantHash {
+  std::size_t operator()(int) const { return 0; }
+};
+
+}  // namespace
+
+TEST(unordered_map_test, throwing_move_during_erase_keeps_table_valid) {
+  s21::unordered_map<int, ThrowingMove, ClusteredHash> m;
+  for (int i = 0; i < 40; ++i) m.try_emplace(i, i);
+  int erased = -1;
+  for (int i = 0; i < 40 && erased < 0; ++i) {
+    ThrowingMove::fuse = 0;
+    try {
+      m.erase(m.find(i));
+    } catch (const std::runtime_error&) {
+      erased = i;
+    }
+    ThrowingMove::fuse = -1;
+  }
+  ASSERT_GE(erased, 0);
+  EXPECT_EQ(m.size(), static_cast<std::size_t>(40 - erased - 1));
+  for (int i = 0; i < 40; ++i) {
+    if (i <= erased) {
+      EXPECT_FALSE(m.contains(i));
+    } else {
+      EXPECT_EQ(m.at(i).value, std::to_string(i) + std::string(32, '#'));
+    }
+  }
+}
+
+TEST(unordered_map_test, throwing_move_during_merge_keeps_both_tables_valid) {
+  for (int fuse = 0; fuse < 60; fuse += 3) {
+    s21::unordered_map<int, ThrowingMove, ConstantHash> a;
+    s21::unordered_map<int, ThrowingMove, ConstantHash> other;
+    for (int i = 0; i < 10; ++i) a.try_emplace(100 + i, 100 + i);
+    for (int i = 0; i < 40; ++i) other.try_emplace(i, i);
+    ThrowingMove::fuse = fuse;
+    try {
+      a.merge(other);
+    } catch (const std::runtime_error&) {
+    }
+    ThrowingMove::fuse = -1;
+    EXPECT_EQ(a.size() + other.size(), 50U);
+    for (int i = 0; i < 40; ++i) {
+      EXPECT_NE(a.contains(i), other.contains(i)) << i;
+      const auto& table = a.contains(i) ? a : other;
+      EXPECT_EQ(table.at(i).value, std::to_string(i) + std::string(32, '#'));
+    }
+    std::size_t count = 0;
+    for (auto it = other.begin(); it != other.end(); ++it) ++count;
+    EXPECT_EQ(count, other.size());
+  }
+}
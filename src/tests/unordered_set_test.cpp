@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include "../s21_containersplus.h"
+
+TEST(unordered_set_test, basic_operations) {
+  s21::unordered_set<int> s = {3, 1, 2, 3};
+  EXPECT_EQ(s.size(), 3U);
+  EXPECT_TRUE(s.insert(4).second);
+  EXPECT_FALSE(s.insert(1).second);
+  EXPECT_EQ(*s.emplace(5).first, 5);
+  EXPECT_TRUE(s.contains(5));
+  s.erase(s.find(5));
+  EXPECT_FALSE(s.contains(5));
+  int sum = 0;
+  for (int value : s) sum += value;
+  EXPECT_EQ(sum, 10);
+  auto result = s.insert_many(7, 1);
+  EXPECT_TRUE(result[0].second);
+  EXPECT_EQ(*result[1].first, 1);
+  EXPECT_FALSE(result[1].second);
+}
+
+TEST(unordered_set_test, matches_std) {
+  std::mt19937 gen(9);
+  std::uniform_int_distribution<int> dist(0, 5000);
+  s21::unordered_set<std::string> s;
+  std::unordered_set<std::string> expected;
+  for (int i = 0; i < 20000; ++i) {
+    std::string key = std::to_string(dist(gen));
+    if (i % 3 == 0) {
+      auto it = s.find(key);
+      if (it != s.end()) s.erase(it);
+      expected.erase(key);
+    } else {
+      EXPECT_EQ(s.insert(key).second, expected.insert(key).second);
+    }
+  }
+  ASSERT_EQ(s.size(), expected.size());
+  for (const auto& key : expected) {
+    EXPECT_TRUE(s.contains(key));
+  }
+}
+
+TEST(unordered_set_test, merge) {
+  s21::unordered_set<int> a = {1, 2, 3};
+  s21::unordered_set<int> b = {3, 4};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 4U);
+  ASSERT_EQ(b.size(), 1U);
+  EXPECT_EQ(*b.begin(), 3);
+}
@@ -1,6 +1,35 @@
 #include "../s21_containers.h"
+#include "../s21_containersplus.h"
 #include <gtest/gtest.h>
 #include <vector>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "counting_allocator.h"
+
+// Вектор при росте перемещает элементы, только если их перемещение не бросает
+// (std::move_if_noexcept), иначе вектор контейнеров копировал бы их целиком
+static_assert(std::is_nothrow_move_constructible<s21::vector<std::string>>::value, "vector move must be noexcept");
+static_assert(noexcept(std::declval<s21::vector<int>&>().swap(std::declval<s21::vector<int>&>())),
+              "vector swap must be noexcept");
+static_assert(std::is_nothrow_move_constructible<s21::deque<int>>::value, "deque move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<s21::flat_map<int, std::string>>::value,
+              "flat_map move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<s21::flat_set<std::string>>::value,
+              "flat_set move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<s21::unordered_map<std::string, int>>::value,
+              "unordered_map move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<s21::unordered_set<int>>::value,
+              "unordered_set move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<
+                  s21::set<int, std::less<int>, std::allocator<int>, false, s21::BTreePolicy>>::value,
+              "B-tree set move must be noexcept");
+static_assert(std::is_nothrow_move_constructible<s21::small_vector<std::string, 4>>::value,
+              "small_vector of nothrow movable elements must move without exceptions");
+static_assert(noexcept(std::declval<s21::small_vector<std::string, 4>&>().swap(
+                  std::declval<s21::small_vector<std::string, 4>&>())),
+              "small_vector of nothrow movable elements must swap without exceptions");
 
 TEST(vector_test, at_throw) {
     const s21::vector<int> v;
@@ -156,13 +185,13 @@ TEST(vector_test, push_back) {
     EXPECT_EQ(a1.capacity(), b1.capacity());
 }
 
-TEST(vector_test, emplace) {
+TEST(vector_test, insert_many) {
     s21::vector<int> v1 = {0, 1, 2, 7, 8};
     auto it = v1.begin();
     ++it;
     ++it;
     ++it;
-    v1.emplace(it, 3, 4, 5, 6);
+    v1.insert_many(it, 3, 4, 5, 6);
 
     for (size_t i = 0; i < 9; i++) {
         EXPECT_EQ(v1[i], i);
@@ -170,13 +199,9 @@ TEST(vector_test, emplace) {
 
 }
 
-TEST(vector_test, emplace_back) {
+TEST(vector_test, insert_many_back) {
     s21::vector<int> v1 = {0, 1, 2};
-    auto it = v1.begin();
-    ++it;
-    ++it;
-    ++it;
-    v1.emplace_back(3, 4, 5, 6);
+    v1.insert_many_back(3, 4, 5, 6);
 
     for (size_t i = 0; i < 6; i++) {
         EXPECT_EQ(v1[i], i);
@@ -314,8 +339,139 @@ TEST(vector_test, insert) {
     }
 }
 
+TEST(vector_test, allocator) {
+    std::ptrdiff_t bytes = 0;
+    std::ptrdiff_t other_bytes = 0;
+    {
+        CountingAllocator<int> alloc(&bytes);
+        s21::vector<int, CountingAllocator<int>> v1({1, 2, 3}, alloc);
+        EXPECT_EQ(bytes, static_cast<std::ptrdiff_t>(3 * sizeof(int)));
+        for (int i = 0; i < 100; i++) {
+            v1.push_back(i);
+        }
+        EXPECT_EQ(bytes, static_cast<std::ptrdiff_t>(v1.capacity() * sizeof(int)));
+
+        s21::vector<int, CountingAllocator<int>> v2 = v1;
+        EXPECT_TRUE(v2.get_allocator() == alloc);
+        // Аллокаторы не равны - элементы перемещаются по одному в память v3
+        s21::vector<int, CountingAllocator<int>> v3{CountingAllocator<int>(&other_bytes)};
+        v3 = std::move(v2);
+        EXPECT_EQ(v3.size(), v1.size());
+        EXPECT_EQ(v3[50], v1[50]);
+        EXPECT_GT(other_bytes, 0);
+    }
+    EXPECT_EQ(bytes, 0);
+    EXPECT_EQ(other_bytes, 0);
+}
+
+
+TEST(vector_test, emplace_in_place) {
+    s21::vector<std::pair<std::string, int>> v;
+    auto& ref = v.emplace_back("b", 2);
+    EXPECT_EQ(ref.first, "b");
+    v.emplace(v.begin(), "a", 1);
+    v.emplace(v.end(), std::string(3, 'c'), 3);
+    ASSERT_EQ(v.size(), 3U);
+    EXPECT_EQ(v[0].first, "a");
+    EXPECT_EQ(v[1].second, 2);
+    EXPECT_EQ(v[2].first, "ccc");
+
+    s21::vector<std::unique_ptr<int>> ptrs;
+    for (int i = 0; i < 10; ++i) {
+        ptrs.emplace_back(new int(i));
+    }
+    ptrs.emplace(ptrs.begin() + 5, new int(-1));
+    ptrs.push_back(std::make_unique<int>(10));
+    ptrs.erase(ptrs.begin());
+    ASSERT_EQ(ptrs.size(), 11U);
+    EXPECT_EQ(*ptrs[4], -1);
+    EXPECT_EQ(*ptrs[0], 1);
+    EXPECT_EQ(*ptrs[10], 10);
+}
+
+TEST(vector_test, insert_self_reference) {
+    s21::vector<std::string> v = {"one", "two", "three"};
+    v.shrink_to_fit();
+    v.push_back(v[0]);
+    v.insert(v.begin(), v[2]);
+    v.emplace(v.begin() + 1, v[0]);
+    std::vector<std::string> expected = {"three", "three", "one", "two", "three", "one"};
+    ASSERT_EQ(v.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(v[i], expected[i]);
+    }
+}
+
+// Считает живые объекты и копирования, перемещение бросать может
+struct Tracked {
+    static int alive;
+    static int copies;
+    int value;
+    Tracked() : value(0) { alive++; }
+    Tracked(int v) : value(v) { alive++; }
+    Tracked(const Tracked& o) : value(o.value) { alive++; copies++; }
+    Tracked(Tracked&& o) : value(o.value) { alive++; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+    ~Tracked() { alive--; }
+};
+int Tracked::alive = 0;
+int Tracked::copies = 0;
+
+TEST(vector_test, uninitialized_storage) {
+    {
+        s21::vector<Tracked> v;
+        v.reserve(100);
+        EXPECT_EQ(Tracked::alive, 0);
+        for (int i = 0; i < 10; i++) {
+            v.emplace_back(i);
+        }
+        EXPECT_EQ(Tracked::alive, 10);
+        v.pop_back();
+        v.erase(v.begin());
+        EXPECT_EQ(Tracked::alive, 8);
+        v.insert(v.begin() + 2, Tracked(42));
+        EXPECT_EQ(Tracked::alive, 9);
+        EXPECT_EQ(v[2].value, 42);
+        // Перемещение не noexcept - при переносе в новый буфер элементы копируются
+        Tracked::copies = 0;
+        v.shrink_to_fit();
+        EXPECT_EQ(Tracked::copies, 9);
+        EXPECT_EQ(Tracked::alive, 9);
+        v.clear();
+        EXPECT_EQ(Tracked::alive, 0);
+        EXPECT_EQ(v.capacity(), 9U);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+
+    s21::vector<double> d(4);
+    for (int i = 0; i < 1000; i++) {
+        d.push_back(i);
+    }
+    EXPECT_EQ(d[0], 0.0);
+    EXPECT_EQ(d[1003], 999.0);
+}
+
+#ifdef S21_CONTAINERS_DEBUG
+TEST(vector_test, subscript_debug_check) {
+    s21::vector<int> v = {1, 2, 3};
+    v.reserve(10);
+    EXPECT_EQ(v[2], 3);
+    EXPECT_DEATH(v[3], "out of range");
+}
+#endif
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
+TEST(vector_test, nested_vectors_move_on_growth) {
+    s21::vector<s21::vector<int>> outer;
+    outer.push_back(s21::vector<int>{1, 2, 3});
+    const int* inner = outer[0].data();
+    for (int i = 0; i < 100; ++i) {
+        outer.emplace_back(static_cast<std::size_t>(i));
+    }
+    EXPECT_EQ(outer[0].data(), inner);
+    EXPECT_EQ(outer[0][2], 3);
+}